@@ -88,6 +88,7 @@ async def run(
         event_router=event_router,
         connect_timeout_s=config.ue.connect_timeout_s,
         ping_interval_s=config.ue.ping_interval_s,
+        response_encoding=config.ue.response_encoding,
         reconnect_initial_delay_s=config.ue.reconnect.initial_delay_s,
         reconnect_max_delay_s=config.ue.reconnect.max_delay_s,
         metrics=metrics,
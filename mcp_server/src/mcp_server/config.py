@@ -25,6 +25,7 @@ class UeConfig:
     project_root: str = ""
     connect_timeout_s: float = 10.0
     ping_interval_s: float = 10.0
+    response_encoding: str = "object"
     reconnect: ReconnectConfig = ReconnectConfig()
 
 
@@ -110,6 +111,7 @@ def load_config(path: str | Path | None) -> AppConfig:
             project_root=str(ue_data.get("project_root", UeConfig.project_root)),
             connect_timeout_s=float(ue_data.get("connect_timeout_s", UeConfig.connect_timeout_s)),
             ping_interval_s=float(ue_data.get("ping_interval_s", UeConfig.ping_interval_s)),
+            response_encoding=str(ue_data.get("response_encoding", UeConfig.response_encoding)),
             reconnect=ReconnectConfig(
                 initial_delay_s=float(
                     reconnect_data.get("initial_delay_s", ReconnectConfig.initial_delay_s)
@@ -184,6 +186,8 @@ def _validate_config(config: AppConfig) -> None:
         raise ConfigError("ue.connect_timeout_s must be > 0")
     if config.ue.ping_interval_s <= 0:
         raise ConfigError("ue.ping_interval_s must be > 0")
+    if config.ue.response_encoding not in {"object", "json_string"}:
+        raise ConfigError("ue.response_encoding must be 'object' or 'json_string'")
 
     if config.ue.reconnect.initial_delay_s <= 0:
         raise ConfigError("ue.reconnect.initial_delay_s must be > 0")
@@ -192,6 +192,7 @@ class EventRouter:
             "event_id": str(event.get("event_id", "") or ""),
             "event_type": event_type,
             "request_id": request_id,
+            "session_id": str(event.get("session_id", "") or ""),
             "timestamp_ms": timestamp_ms,
             "payload": payload,
             "notification_kind": "other",
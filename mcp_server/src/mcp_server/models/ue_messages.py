@@ -33,17 +33,19 @@ def parse_mcp_response(message: dict[str, Any]) -> UeResponse | None:
     if message.get("type") != "mcp.response":
         return None
 
-    response_json = message.get("response_json")
-    if not isinstance(response_json, str):
-        raise MessageParseError("mcp.response.response_json must be a string.")
+    envelope = message.get("response")
+    if envelope is None:
+        response_json = message.get("response_json")
+        if not isinstance(response_json, str):
+            raise MessageParseError("mcp.response.response_json must be a string.")
 
-    try:
-        envelope = json.loads(response_json)
-    except json.JSONDecodeError as exc:
-        raise MessageParseError(f"Invalid response_json payload: {exc}") from exc
+        try:
+            envelope = json.loads(response_json)
+        except json.JSONDecodeError as exc:
+            raise MessageParseError(f"Invalid response_json payload: {exc}") from exc
 
     if not isinstance(envelope, dict):
-        raise MessageParseError("mcp.response.response_json must decode to an object.")
+        raise MessageParseError("mcp.response envelope must be an object.")
 
     request_id = envelope.get("request_id")
     if not isinstance(request_id, str) or not request_id:
@@ -4,6 +4,13 @@ from dataclasses import dataclass
 from typing import Any
 
 from mcp_server.mcp_facade import ToolCallResult
+from mcp_server.tool_batch import (
+    BATCH_CAPABILITY,
+    BATCH_TOOL_NAME,
+    batch_stop_diagnostics,
+    build_batch_params,
+    unpack_batch_results,
+)
 from mcp_server.tool_passthrough import MCPPassThroughService, UnknownToolError
 
 
@@ -36,6 +43,9 @@ class SequencerOrchestrationService:
         "seq.save",
     }
 
+    # These steps resolve the sequence later steps operate on, so their object_path must be threaded sequentially.
+    _PATH_PRODUCING_KINDS = {"asset.create", "asset.load"}
+
     def __init__(self, pass_through: MCPPassThroughService) -> None:
         self._pass_through = pass_through
 
@@ -133,33 +143,41 @@ class SequencerOrchestrationService:
         auto_save = bool(arguments.get("auto_save", False))
         continue_on_error = bool(arguments.get("continue_on_error", False))
 
+        resolved_actions = [self._resolve_action(action) for action in actions]
+
+        batched = self._can_batch() and self._keeps_object_path(resolved_actions, current_object_path)
+        batched_results: list[ToolCallResult] = []
+        stop_diagnostics: list[dict[str, Any]] = []
+        if batched:
+            planned_calls = [
+                (
+                    resolved.delegated_tool,
+                    self._build_step_params(resolved, current_object_path=current_object_path, auto_save=auto_save),
+                    self._step_request_id(request_id, index),
+                )
+                for index, resolved in enumerate(resolved_actions)
+            ]
+            batch_result = await self._pass_through.call_tool(
+                tool=BATCH_TOOL_NAME,
+                params=build_batch_params(planned_calls, continue_on_error=continue_on_error),
+                request_id=f"{request_id}-batch" if isinstance(request_id, str) and request_id else None,
+            )
+            batched_results = unpack_batch_results(batch_result, len(planned_calls))
+            stop_diagnostics = batch_stop_diagnostics(batch_result)
+
         steps: list[dict[str, Any]] = []
         errors: list[dict[str, Any]] = []
         touched_packages: list[str] = []
 
-        for index, action in enumerate(actions):
-            resolved = self._resolve_action(action)
-            params = dict(resolved.params)
-            if current_object_path and "object_path" not in params and resolved.requested_kind != "asset.create":
-                params["object_path"] = current_object_path
-
-            if auto_save and resolved.delegated_tool in self._SAVE_AWARE_TOOLS:
-                save = params.get("save")
-                if not isinstance(save, dict):
-                    save = {}
-                save["auto_save"] = True
-                params["save"] = save
-
-            step_request_id = (
-                f"{request_id}-step{index + 1}"
-                if isinstance(request_id, str) and request_id
-                else None
-            )
-            call_result = await self._pass_through.call_tool(
-                tool=resolved.delegated_tool,
-                params=params,
-                request_id=step_request_id,
-            )
+        for index, resolved in enumerate(resolved_actions):
+            if batched:
+                call_result = batched_results[index]
+            else:
+                call_result = await self._pass_through.call_tool(
+                    tool=resolved.delegated_tool,
+                    params=self._build_step_params(resolved, current_object_path=current_object_path, auto_save=auto_save),
+                    request_id=self._step_request_id(request_id, index),
+                )
 
             step_payload = {
                 "index": index + 1,
@@ -167,7 +185,7 @@ class SequencerOrchestrationService:
                 "delegated_tool": resolved.delegated_tool,
                 "request_id": call_result.request_id,
                 "status": call_result.status,
-                "ok": call_result.ok and call_result.status != "error",
+                "ok": call_result.ok and call_result.status not in ("error", "skipped"),
                 "fallback": resolved.fallback_note,
                 "diagnostics": call_result.diagnostics,
             }
@@ -206,6 +224,7 @@ class SequencerOrchestrationService:
             "strategy": {
                 "auto_save": auto_save,
                 "continue_on_error": continue_on_error,
+                "batched": batched,
                 "sequencer_core_capability": self._pass_through.has_capability(self.CORE_CAPABILITY),
                 "sequencer_keys_capability": self._pass_through.has_capability(self.KEYS_CAPABILITY),
                 "capabilities": list(self._pass_through.capabilities),
@@ -214,8 +233,9 @@ class SequencerOrchestrationService:
 
         status = "error" if errors else "ok"
         diagnostics: dict[str, Any] = {
-            "errors": errors,
-            "warnings": [],
+            # A stop that skipped nothing this workflow needed is only a warning.
+            "errors": errors + stop_diagnostics if errors else [],
+            "warnings": [] if errors else stop_diagnostics,
             "infos": [],
         }
         return ToolCallResult(
@@ -231,6 +251,42 @@ class SequencerOrchestrationService:
             },
         )
 
+    def _keeps_object_path(self, resolved_actions: list[_ResolvedSequencerAction], object_path: str) -> bool:
+        # Batched calls all get the initial object_path, so only batch when no step can redirect later steps:
+        # create/load return a new path, and a step targeting another object echoes that path back.
+        for resolved in resolved_actions:
+            if resolved.requested_kind in self._PATH_PRODUCING_KINDS:
+                return False
+            step_path = resolved.params.get("object_path")
+            if step_path is not None and (not isinstance(step_path, str) or step_path.strip() != object_path):
+                return False
+        return True
+
+    def _build_step_params(
+        self,
+        resolved: _ResolvedSequencerAction,
+        *,
+        current_object_path: str,
+        auto_save: bool,
+    ) -> dict[str, Any]:
+        params = dict(resolved.params)
+        if current_object_path and "object_path" not in params and resolved.requested_kind != "asset.create":
+            params["object_path"] = current_object_path
+
+        if auto_save and resolved.delegated_tool in self._SAVE_AWARE_TOOLS:
+            save = params.get("save")
+            if not isinstance(save, dict):
+                save = {}
+            save["auto_save"] = True
+            params["save"] = save
+        return params
+
+    @staticmethod
+    def _step_request_id(request_id: str | None, index: int) -> str | None:
+        if isinstance(request_id, str) and request_id:
+            return f"{request_id}-step{index + 1}"
+        return None
+
     def _resolve_action(self, action: Any) -> _ResolvedSequencerAction:
         if not isinstance(action, dict):
             raise ValueError("Each action must be an object with kind/args.")
@@ -298,6 +354,9 @@ class SequencerOrchestrationService:
         translated.update(first_key)
         return translated
 
+    def _can_batch(self) -> bool:
+        return self._pass_through.has_capability(BATCH_CAPABILITY) and self._has_tool(BATCH_TOOL_NAME)
+
     def _has_tool(self, tool_name: str) -> bool:
         return any(tool.name == tool_name and tool.enabled for tool in self._pass_through.list_tools())
 
@@ -0,0 +1,115 @@
+from __future__ import annotations
+
+from typing import Any
+
+from mcp_server.mcp_facade import ToolCallResult
+
+BATCH_CAPABILITY = "batch_v1"
+BATCH_TOOL_NAME = "mcp.batch"
+BATCH_STOP_CODES = frozenset({"MCP.JOB.TIMEOUT", "MCP.JOB.CANCELED"})
+BATCH_CALL_SKIPPED_CODE = "MCP.SERVER.BATCH_CALL_SKIPPED"
+
+
+def build_batch_params(
+    calls: list[tuple[str, dict[str, Any], str | None]],
+    *,
+    continue_on_error: bool,
+) -> dict[str, Any]:
+    batch_calls: list[dict[str, Any]] = []
+    for tool, params, request_id in calls:
+        call: dict[str, Any] = {"tool": tool, "params": params}
+        if request_id:
+            call["request_id"] = request_id
+        batch_calls.append(call)
+    return {
+        "calls": batch_calls,
+        "mode": "continue" if continue_on_error else "stop_on_error",
+    }
+
+
+def batch_stop_diagnostics(batch_result: ToolCallResult) -> list[dict[str, Any]]:
+    """Batch-level diagnostics explaining why the batch stopped before running every call."""
+    stop_diagnostics: list[dict[str, Any]] = []
+    for severity in ("errors", "warnings"):
+        entries = batch_result.diagnostics.get(severity)
+        if not isinstance(entries, list):
+            continue
+        for entry in entries:
+            if isinstance(entry, dict) and entry.get("code") in BATCH_STOP_CODES:
+                stop_diagnostics.append(entry)
+    return stop_diagnostics
+
+
+def unpack_batch_results(batch_result: ToolCallResult, call_count: int) -> list[ToolCallResult]:
+    """Split an mcp.batch response into one result per planned call, keyed by each entry's index.
+
+    Calls the batch skipped (timeout, cancel or stop_on_error) come back with status "skipped"
+    and the batch-level stop diagnostic as their error, so callers never report them as done.
+    When the batch was rejected before any call ran there are no per-call entries; the batch
+    failure is returned for the first call and the rest are skipped.
+    """
+    entries = batch_result.result.get("results")
+    if not isinstance(entries, list):
+        status = batch_result.status if batch_result.status != "ok" else "error"
+        rejected = ToolCallResult(
+            ok=False,
+            status=status,
+            request_id=batch_result.request_id,
+            result={},
+            diagnostics=batch_result.diagnostics,
+            raw_envelope=batch_result.raw_envelope,
+        )
+        return [rejected] + [_skipped_result(batch_result, index, None) for index in range(1, call_count)]
+
+    by_index: dict[int, dict[str, Any]] = {}
+    for entry in entries:
+        if isinstance(entry, dict) and isinstance(entry.get("index"), int):
+            by_index[entry["index"]] = entry
+
+    unpacked: list[ToolCallResult] = []
+    for index in range(call_count):
+        entry = by_index.get(index)
+        status = entry.get("status") if entry is not None else None
+        if entry is None or not isinstance(status, str) or status == "skipped":
+            unpacked.append(_skipped_result(batch_result, index, entry))
+            continue
+        result = entry.get("result")
+        if not isinstance(result, dict):
+            result = {}
+        diagnostics = entry.get("diagnostics")
+        if not isinstance(diagnostics, dict):
+            diagnostics = {"errors": [], "warnings": [], "infos": []}
+        request_id = entry.get("request_id")
+        unpacked.append(
+            ToolCallResult(
+                ok=status != "error",
+                status=status,
+                request_id=request_id if isinstance(request_id, str) else batch_result.request_id,
+                result=result,
+                diagnostics=diagnostics,
+                raw_envelope=entry,
+            )
+        )
+    return unpacked
+
+
+def _skipped_result(batch_result: ToolCallResult, index: int, entry: dict[str, Any] | None) -> ToolCallResult:
+    errors = batch_stop_diagnostics(batch_result)
+    if not errors:
+        errors = [
+            {
+                "code": BATCH_CALL_SKIPPED_CODE,
+                "message": "Batch call was skipped before it ran.",
+                "detail": f"index={index}",
+                "retriable": False,
+            }
+        ]
+    request_id = entry.get("request_id") if entry is not None else None
+    return ToolCallResult(
+        ok=False,
+        status="skipped",
+        request_id=request_id if isinstance(request_id, str) else batch_result.request_id,
+        result={},
+        diagnostics={"errors": errors, "warnings": [], "infos": []},
+        raw_envelope=entry or {},
+    )
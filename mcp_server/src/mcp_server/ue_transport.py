@@ -3,6 +3,7 @@ from __future__ import annotations
 import asyncio
 import json
 import logging
+from collections import deque
 from typing import TYPE_CHECKING
 from typing import Any
 
@@ -19,6 +20,8 @@ if TYPE_CHECKING:
 
 LOGGER = logging.getLogger("mcp_server.ue_transport")
 
+EVENT_SEQUENCE_WINDOW = 4096
+
 
 class UeWsTransport:
     def __init__(
@@ -29,6 +32,7 @@ class UeWsTransport:
         event_router: EventRouter,
         connect_timeout_s: float = 10.0,
         ping_interval_s: float = 10.0,
+        response_encoding: str = "object",
         reconnect_initial_delay_s: float = 0.5,
         reconnect_max_delay_s: float = 10.0,
         metrics: "RuntimeMetrics | None" = None,
@@ -43,6 +47,13 @@ class UeWsTransport:
 
         self._connect_timeout_s = connect_timeout_s
         self._ping_interval_s = ping_interval_s
+        self._response_encoding = response_encoding
+        self._event_filters: dict[str, list[str]] = {}
+        self._event_instance_id: str | None = None
+        self._last_event_sequence = 0
+        self._seen_event_sequences: set[int] = set()
+        self._seen_event_order: deque[int] = deque()
+        self._seen_event_floor = 0
         self._reconnect_initial_delay_s = reconnect_initial_delay_s
         self._reconnect_max_delay_s = reconnect_max_delay_s
         self._metrics = metrics
@@ -134,6 +145,21 @@ class UeWsTransport:
             session_id=session_id or "default-session",
         )
 
+    async def subscribe(
+        self,
+        *,
+        event_types: list[str] | None = None,
+        request_id_prefixes: list[str] | None = None,
+        session_ids: list[str] | None = None,
+    ) -> None:
+        # 빈 목록은 해당 축의 필터 없음(전체 수신)을 의미한다.
+        self._event_filters = {
+            "event_types": list(event_types or []),
+            "request_id_prefixes": list(request_id_prefixes or []),
+            "session_ids": list(session_ids or []),
+        }
+        await self.send_json({"type": "subscribe", **self._event_filters})
+
     async def send_json(self, message: dict[str, Any]) -> None:
         payload = json.dumps(message, separators=(",", ":"), ensure_ascii=False)
 
@@ -290,6 +316,16 @@ class UeWsTransport:
             LOGGER.info("UE transport handshake: %s", message)
             if self._metrics is not None:
                 self._metrics.inc("ue_transport.handshake")
+            await self._negotiate_response_encoding(message)
+            await self._resume_event_stream(message)
+            return
+
+        if msg_type == "mcp.transport.configured":
+            LOGGER.info("UE transport configured: response_encoding=%s", message.get("response_encoding"))
+            return
+
+        if msg_type == "mcp.transport.subscribed":
+            LOGGER.info("UE event subscription updated: %s", message)
             return
 
         if msg_type == "mcp.transport.error":
@@ -299,6 +335,12 @@ class UeWsTransport:
             return
 
         if "event_type" in message:
+            sequence = message.get("sequence")
+            if isinstance(sequence, (int, float)) and sequence > 0:
+                if not self._mark_event_sequence_seen(int(sequence)):
+                    if self._metrics is not None:
+                        self._metrics.inc("ue_transport.event_duplicate_skipped")
+                    return
             self._event_router.publish(message)
             if self._metrics is not None:
                 self._metrics.inc("ue_transport.event_forwarded")
@@ -306,6 +348,65 @@ class UeWsTransport:
 
         LOGGER.debug("Unhandled WS message: %s", message)
 
+    async def _negotiate_response_encoding(self, handshake: dict[str, Any]) -> None:
+        # 구버전 UE 플러그인은 response_encodings를 광고하지 않으므로 기본(json_string)을 유지한다.
+        supported = handshake.get("response_encodings")
+        if self._response_encoding == "json_string" or not isinstance(supported, list):
+            return
+        if self._response_encoding not in supported:
+            return
+
+        try:
+            await self.send_json(
+                {"type": "mcp.transport.configure", "response_encoding": self._response_encoding}
+            )
+        except ConnectionError as exc:
+            LOGGER.debug("Response encoding negotiation skipped: %s", exc)
+
+    async def _resume_event_stream(self, handshake: dict[str, Any]) -> None:
+        # 같은 UE 인스턴스에 재연결한 경우에만 마지막 sequence 이후 이벤트를 replay 요청한다.
+        instance_id = handshake.get("instance_id")
+        if instance_id != self._event_instance_id:
+            self._event_instance_id = instance_id if isinstance(instance_id, str) else None
+            self._reset_event_sequences()
+            if self._event_filters:
+                await self._send_subscribe_quietly({"type": "subscribe", **self._event_filters})
+            return
+
+        if self._last_event_sequence <= 0 and not self._event_filters:
+            return
+
+        message: dict[str, Any] = {"type": "subscribe", **self._event_filters}
+        if self._last_event_sequence > 0:
+            message["after_sequence"] = self._last_event_sequence
+        await self._send_subscribe_quietly(message)
+
+    def _mark_event_sequence_seen(self, sequence: int) -> bool:
+        # resume 중에는 live 이벤트가 replay보다 먼저 도착할 수 있으므로 high-water mark가 아닌
+        # 최근 sequence 집합으로 중복을 판단한다. 창 밖으로 밀려난 sequence는 floor로 처리한다.
+        if sequence <= self._seen_event_floor or sequence in self._seen_event_sequences:
+            return False
+        self._seen_event_sequences.add(sequence)
+        self._seen_event_order.append(sequence)
+        while len(self._seen_event_order) > EVENT_SEQUENCE_WINDOW:
+            evicted = self._seen_event_order.popleft()
+            self._seen_event_sequences.discard(evicted)
+            self._seen_event_floor = max(self._seen_event_floor, evicted)
+        self._last_event_sequence = max(self._last_event_sequence, sequence)
+        return True
+
+    def _reset_event_sequences(self) -> None:
+        self._last_event_sequence = 0
+        self._seen_event_sequences.clear()
+        self._seen_event_order.clear()
+        self._seen_event_floor = 0
+
+    async def _send_subscribe_quietly(self, message: dict[str, Any]) -> None:
+        try:
+            await self.send_json(message)
+        except ConnectionError as exc:
+            LOGGER.debug("Event stream resume skipped: %s", exc)
+
     async def _ping_loop(self) -> None:
         while not self._stop_event.is_set() and self.is_connected:
             await asyncio.sleep(self._ping_interval_s)
@@ -4,6 +4,13 @@ from dataclasses import dataclass
 from typing import Any
 
 from mcp_server.mcp_facade import ToolCallResult
+from mcp_server.tool_batch import (
+    BATCH_CAPABILITY,
+    BATCH_TOOL_NAME,
+    batch_stop_diagnostics,
+    build_batch_params,
+    unpack_batch_results,
+)
 from mcp_server.tool_passthrough import MCPPassThroughService, UnknownToolError
 
 
@@ -149,10 +156,7 @@ class UMGOrchestrationService:
                 )
             )
 
-        steps: list[dict[str, Any]] = []
-        touched_packages: list[str] = []
-        errors: list[dict[str, Any]] = []
-
+        planned_calls: list[tuple[str, dict[str, Any], str | None]] = []
         for index, resolved in enumerate(resolved_actions):
             params = dict(resolved.params)
             is_last_action = index == len(resolved_actions) - 1
@@ -172,11 +176,34 @@ class UMGOrchestrationService:
                 if isinstance(request_id, str) and request_id
                 else None
             )
-            call_result = await self._pass_through.call_tool(
-                tool=resolved.delegated_tool,
-                params=params,
-                request_id=step_request_id,
+            planned_calls.append((resolved.delegated_tool, params, step_request_id))
+
+        batched = self._can_batch()
+        batched_results: list[ToolCallResult] = []
+        stop_diagnostics: list[dict[str, Any]] = []
+        if batched:
+            batch_result = await self._pass_through.call_tool(
+                tool=BATCH_TOOL_NAME,
+                params=build_batch_params(planned_calls, continue_on_error=continue_on_error),
+                request_id=f"{request_id}-batch" if isinstance(request_id, str) and request_id else None,
             )
+            batched_results = unpack_batch_results(batch_result, len(planned_calls))
+            stop_diagnostics = batch_stop_diagnostics(batch_result)
+
+        steps: list[dict[str, Any]] = []
+        touched_packages: list[str] = []
+        errors: list[dict[str, Any]] = []
+
+        for index, resolved in enumerate(resolved_actions):
+            if batched:
+                call_result = batched_results[index]
+            else:
+                tool, params, step_request_id = planned_calls[index]
+                call_result = await self._pass_through.call_tool(
+                    tool=tool,
+                    params=params,
+                    request_id=step_request_id,
+                )
 
             step_payload = {
                 "index": index + 1,
@@ -184,7 +211,7 @@ class UMGOrchestrationService:
                 "delegated_tool": resolved.delegated_tool,
                 "request_id": call_result.request_id,
                 "status": call_result.status,
-                "ok": call_result.ok and call_result.status != "error",
+                "ok": call_result.ok and call_result.status not in ("error", "skipped"),
                 "fallback": resolved.fallback_note,
                 "diagnostics": call_result.diagnostics,
             }
@@ -221,6 +248,7 @@ class UMGOrchestrationService:
                 "compile_on_finish": compile_on_finish,
                 "auto_save": auto_save,
                 "continue_on_error": continue_on_error,
+                "batched": batched,
                 "k2_event_capability": self._pass_through.has_capability(self.K2_EVENT_CAPABILITY),
                 "capabilities": list(self._pass_through.capabilities),
             },
@@ -228,8 +256,9 @@ class UMGOrchestrationService:
 
         status = "error" if errors else "ok"
         diagnostics: dict[str, Any] = {
-            "errors": errors,
-            "warnings": [],
+            # A stop that skipped nothing this workflow needed is only a warning.
+            "errors": errors + stop_diagnostics if errors else [],
+            "warnings": [] if errors else stop_diagnostics,
             "infos": [],
         }
         return ToolCallResult(
@@ -358,6 +387,9 @@ class UMGOrchestrationService:
             translated["property_name"] = event_name
         return translated
 
+    def _can_batch(self) -> bool:
+        return self._pass_through.has_capability(BATCH_CAPABILITY) and self._has_tool(BATCH_TOOL_NAME)
+
     def _has_tool(self, tool_name: str) -> bool:
         return any(
             tool_def.name == tool_name and tool_def.enabled
@@ -10,9 +10,18 @@ from mcp_server.tool_catalog import ToolDefinition
 
 
 class FakePassThrough:
-    def __init__(self, tool_names: list[str], *, capabilities: tuple[str, ...] = ()) -> None:
+    def __init__(
+        self,
+        tool_names: list[str],
+        *,
+        capabilities: tuple[str, ...] = (),
+        batch_statuses: list[str] | None = None,
+        batch_stop_code: str | None = None,
+    ) -> None:
         self.calls: list[dict[str, Any]] = []
         self.capabilities = capabilities
+        self.batch_statuses = batch_statuses
+        self.batch_stop_code = batch_stop_code
         self._tools = [
             ToolDefinition(
                 name=tool_name,
@@ -54,9 +63,37 @@ class FakePassThrough:
             }
         )
 
+        if tool == "mcp.batch":
+            batch_results = [
+                {
+                    "index": index,
+                    "tool": call["tool"],
+                    "request_id": call.get("request_id", f"batch.{index}"),
+                    "status": self.batch_statuses[index] if self.batch_statuses else "ok",
+                    "result": {"touched_packages": ["/Game/Seq/Touched"]},
+                    "diagnostics": {"errors": [], "warnings": [], "infos": []},
+                }
+                for index, call in enumerate(params.get("calls", []))
+            ]
+            batch_warnings: list[dict[str, Any]] = []
+            if self.batch_stop_code:
+                batch_warnings.append(
+                    {"code": self.batch_stop_code, "message": "Batch stopped; remaining calls were skipped."}
+                )
+            return ToolCallResult(
+                ok=True,
+                status="partial" if self.batch_stop_code else "ok",
+                request_id=request_id or "batch",
+                result={"call_count": len(batch_results), "results": batch_results},
+                diagnostics={"errors": [], "warnings": batch_warnings, "infos": []},
+                raw_envelope={},
+            )
+
         result: dict[str, Any] = {"touched_packages": ["/Game/Seq/Touched"]}
         if tool == "seq.asset.create":
             result["object_path"] = "/Game/Seq/LS_Test.LS_Test"
+        elif tool == "seq.asset.load":
+            result["object_path"] = "/Game/Seq/LS_Loaded.LS_Loaded"
         elif tool == "seq.inspect":
             result["object_path"] = params.get("object_path", "")
 
@@ -139,3 +176,167 @@ async def test_seq_compose_fallbacks_bulk_set_to_key_set_without_capability() ->
     assert fake.calls[0]["params"]["frame"] == 0
     assert fake.calls[0]["params"]["value"] == 0.0
     assert result.result["steps"][0]["fallback"] == "fallback: seq.key.bulk_set -> seq.key.set(first key)"
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_batches_when_no_create_step() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.inspect", "seq.key.set"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "object_path": "/Game/Seq/LS_Test.LS_Test",
+            "continue_on_error": True,
+            "actions": [
+                {"kind": "inspect", "args": {}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 0, "value": 1.0}},
+            ],
+        },
+    )
+
+    assert result.ok is True
+    assert len(fake.calls) == 1
+    assert fake.calls[0]["tool"] == "mcp.batch"
+    assert fake.calls[0]["params"]["mode"] == "continue"
+    assert all(
+        call["params"]["object_path"] == "/Game/Seq/LS_Test.LS_Test" for call in fake.calls[0]["params"]["calls"]
+    )
+    assert result.result["step_count"] == 2
+    assert result.result["strategy"]["batched"] is True
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_stays_sequential_when_create_feeds_later_steps() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.asset.create", "seq.inspect"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "actions": [
+                {"kind": "asset.create", "args": {"package_path": "/Game/Seq", "asset_name": "LS_Test"}},
+                {"kind": "inspect", "args": {}},
+            ],
+        },
+    )
+
+    assert result.ok is True
+    assert [call["tool"] for call in fake.calls] == ["seq.asset.create", "seq.inspect"]
+    assert fake.calls[1]["params"]["object_path"] == "/Game/Seq/LS_Test.LS_Test"
+    assert result.result["strategy"]["batched"] is False
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_stays_sequential_when_load_feeds_later_steps() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.asset.load", "seq.key.set"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "actions": [
+                {"kind": "asset.load", "args": {"object_path": "/Game/Seq/LS_Loaded"}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 0, "value": 1.0}},
+            ],
+        },
+    )
+
+    assert result.ok is True
+    assert [call["tool"] for call in fake.calls] == ["seq.asset.load", "seq.key.set"]
+    assert fake.calls[1]["params"]["object_path"] == "/Game/Seq/LS_Loaded.LS_Loaded"
+    assert result.result["strategy"]["batched"] is False
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_stays_sequential_when_step_targets_another_sequence() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.inspect", "seq.key.set"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "object_path": "/Game/Seq/LS_Test.LS_Test",
+            "actions": [
+                {"kind": "inspect", "args": {"object_path": "/Game/Seq/LS_Other.LS_Other"}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 0, "value": 1.0}},
+            ],
+        },
+    )
+
+    assert [call["tool"] for call in fake.calls] == ["seq.inspect", "seq.key.set"]
+    assert fake.calls[1]["params"]["object_path"] == "/Game/Seq/LS_Other.LS_Other"
+    assert result.result["strategy"]["batched"] is False
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_reports_calls_skipped_by_batch_timeout() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.inspect", "seq.key.set"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+        batch_statuses=["ok", "skipped", "skipped"],
+        batch_stop_code="MCP.JOB.TIMEOUT",
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "object_path": "/Game/Seq/LS_Test.LS_Test",
+            "actions": [
+                {"kind": "inspect", "args": {}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 0, "value": 1.0}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 10, "value": 2.0}},
+            ],
+        },
+    )
+
+    assert result.ok is False
+    assert result.status == "error"
+    assert [step["status"] for step in result.result["steps"]] == ["ok", "skipped"]
+    assert result.result["steps"][1]["diagnostics"]["errors"][0]["code"] == "MCP.JOB.TIMEOUT"
+    error_codes = [error["code"] for error in result.diagnostics["errors"]]
+    assert error_codes == ["MCP.SERVER.SEQ_WORKFLOW_STEP_FAILED", "MCP.JOB.TIMEOUT"]
+
+
+@pytest.mark.asyncio
+async def test_seq_compose_keys_batch_results_by_index_after_cancel() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "seq.inspect", "seq.key.set"],
+        capabilities=("sequencer_core_v1", "batch_v1"),
+        batch_statuses=["ok", "skipped", "error"],
+        batch_stop_code="MCP.JOB.CANCELED",
+    )
+    service = SequencerOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="seq.workflow.compose",
+        arguments={
+            "object_path": "/Game/Seq/LS_Test.LS_Test",
+            "continue_on_error": True,
+            "actions": [
+                {"kind": "inspect", "args": {}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 0, "value": 1.0}},
+                {"kind": "key.set", "args": {"channel_id": "SectionA|float|0", "frame": 10, "value": 2.0}},
+            ],
+        },
+    )
+
+    assert result.ok is False
+    assert [step["status"] for step in result.result["steps"]] == ["ok", "skipped", "error"]
+    assert result.result["failed_count"] == 2
+    assert "index=2" in result.diagnostics["errors"][0]["detail"]
+    assert "index=3" in result.diagnostics["errors"][1]["detail"]
+    assert result.diagnostics["errors"][-1]["code"] == "MCP.JOB.CANCELED"
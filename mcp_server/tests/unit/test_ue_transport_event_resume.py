@@ -0,0 +1,128 @@
+from __future__ import annotations
+
+import asyncio
+import json
+from typing import Any
+
+import pytest
+import websockets
+
+from mcp_server.event_router import EventRouter
+from mcp_server.request_broker import RequestBroker
+from mcp_server.ue_transport import UeWsTransport
+
+
+def _event(sequence: int) -> dict[str, Any]:
+    return {
+        "event_id": f"evt-{sequence}",
+        "event_type": "event.log",
+        "request_id": "req-1",
+        "sequence": sequence,
+        "timestamp_ms": 0,
+        "payload": {"level": "info", "message": f"m{sequence}"},
+    }
+
+
+@pytest.mark.asyncio
+async def test_ue_transport_resumes_event_stream_after_reconnect() -> None:
+    connection_count = 0
+    resume_messages: list[dict[str, Any]] = []
+    resumed = asyncio.Event()
+
+    async def handler(conn: Any) -> None:
+        nonlocal connection_count
+        connection_count += 1
+        await conn.send(json.dumps({"type": "mcp.transport.connected", "instance_id": "instance-a"}))
+
+        if connection_count == 1:
+            await conn.send(json.dumps(_event(5)))
+            await asyncio.sleep(0.05)
+            await conn.close()
+            return
+
+        async for raw in conn:
+            msg = json.loads(raw)
+            if msg.get("type") == "subscribe":
+                resume_messages.append(msg)
+                await conn.send(json.dumps(_event(5)))
+                await conn.send(json.dumps(_event(6)))
+                resumed.set()
+
+    event_router = EventRouter()
+    async with websockets.serve(handler, "127.0.0.1", 0) as server:
+        port = server.sockets[0].getsockname()[1]
+        transport = UeWsTransport(
+            ws_url=f"ws://127.0.0.1:{port}",
+            request_broker=RequestBroker(default_timeout_ms=1000),
+            event_router=event_router,
+            connect_timeout_s=1.0,
+            ping_interval_s=1000.0,
+            reconnect_initial_delay_s=0.01,
+            reconnect_max_delay_s=0.05,
+        )
+
+        await transport.start()
+        try:
+            await asyncio.wait_for(resumed.wait(), timeout=2.0)
+            await asyncio.sleep(0.05)
+        finally:
+            await transport.stop()
+
+    assert resume_messages[0]["after_sequence"] == 5
+    sequences = [event["payload"]["message"] for event in event_router.get_recent_events()]
+    assert sequences == ["m5", "m6"]
+
+
+@pytest.mark.asyncio
+async def test_ue_transport_keeps_replay_when_live_events_arrive_first() -> None:
+    connection_count = 0
+    resume_messages: list[dict[str, Any]] = []
+    resumed = asyncio.Event()
+
+    async def handler(conn: Any) -> None:
+        nonlocal connection_count
+        connection_count += 1
+        await conn.send(json.dumps({"type": "mcp.transport.connected", "instance_id": "instance-a"}))
+
+        if connection_count == 1:
+            await conn.send(json.dumps(_event(5)))
+            await asyncio.sleep(0.05)
+            await conn.close()
+            return
+
+        # 구독이 처리되기 전에 live 이벤트가 먼저 전달되고, replay가 뒤따라온다.
+        await conn.send(json.dumps(_event(8)))
+        await conn.send(json.dumps(_event(9)))
+        async for raw in conn:
+            msg = json.loads(raw)
+            if msg.get("type") == "subscribe":
+                resume_messages.append(msg)
+                for sequence in (6, 7, 8, 9):
+                    await conn.send(json.dumps(_event(sequence)))
+                await conn.send(json.dumps(_event(10)))
+                resumed.set()
+
+    event_router = EventRouter()
+    async with websockets.serve(handler, "127.0.0.1", 0) as server:
+        port = server.sockets[0].getsockname()[1]
+        transport = UeWsTransport(
+            ws_url=f"ws://127.0.0.1:{port}",
+            request_broker=RequestBroker(default_timeout_ms=1000),
+            event_router=event_router,
+            connect_timeout_s=1.0,
+            ping_interval_s=1000.0,
+            reconnect_initial_delay_s=0.01,
+            reconnect_max_delay_s=0.05,
+        )
+
+        await transport.start()
+        try:
+            await asyncio.wait_for(resumed.wait(), timeout=2.0)
+            await asyncio.sleep(0.05)
+        finally:
+            await transport.stop()
+
+    assert resume_messages[0]["after_sequence"] == 5
+    messages = [event["payload"]["message"] for event in event_router.get_recent_events()]
+    assert sorted(messages) == ["m10", "m5", "m6", "m7", "m8", "m9"]
+    assert len(messages) == 6
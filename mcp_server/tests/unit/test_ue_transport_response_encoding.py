@@ -0,0 +1,95 @@
+from __future__ import annotations
+
+import asyncio
+import json
+from typing import Any
+
+import pytest
+import websockets
+
+from mcp_server.event_router import EventRouter
+from mcp_server.request_broker import RequestBroker
+from mcp_server.ue_transport import UeWsTransport
+
+
+def _build_envelope(request_id: str) -> dict[str, Any]:
+    return {
+        "request_id": request_id,
+        "status": "ok",
+        "result": {"ok": True},
+        "diagnostics": {"errors": [], "warnings": [], "infos": []},
+    }
+
+
+async def _run_request(handler: Any, *, wait_for: asyncio.Event | None = None) -> Any:
+    async with websockets.serve(handler, "127.0.0.1", 0) as server:
+        port = server.sockets[0].getsockname()[1]
+        transport = UeWsTransport(
+            ws_url=f"ws://127.0.0.1:{port}",
+            request_broker=RequestBroker(default_timeout_ms=1000),
+            event_router=EventRouter(),
+            connect_timeout_s=1.0,
+            ping_interval_s=1000.0,
+        )
+
+        await transport.start()
+        try:
+            await transport.wait_until_connected(timeout_s=1.0)
+            if wait_for is not None:
+                await asyncio.wait_for(wait_for.wait(), timeout=1.0)
+            return await transport.request(tool="system.health", params={})
+        finally:
+            await transport.stop()
+
+
+@pytest.mark.asyncio
+async def test_ue_transport_negotiates_object_response_encoding() -> None:
+    configured = asyncio.Event()
+
+    async def handler(conn: Any) -> None:
+        await conn.send(
+            json.dumps(
+                {
+                    "type": "mcp.transport.connected",
+                    "connection_id": 1,
+                    "response_encodings": ["json_string", "object"],
+                }
+            )
+        )
+
+        object_encoding = False
+        async for raw in conn:
+            msg = json.loads(raw)
+            if msg.get("type") == "mcp.transport.configure":
+                object_encoding = msg.get("response_encoding") == "object"
+                await conn.send(json.dumps({"type": "mcp.transport.configured", "response_encoding": "object"}))
+                configured.set()
+            elif msg.get("type") == "mcp.request":
+                assert object_encoding
+                envelope = _build_envelope(msg["request"]["request_id"])
+                await conn.send(json.dumps({"type": "mcp.response", "ok": True, "response": envelope}))
+
+    response = await _run_request(handler, wait_for=configured)
+    assert response.ok is True
+    assert response.envelope["result"] == {"ok": True}
+
+
+@pytest.mark.asyncio
+async def test_ue_transport_keeps_json_string_for_legacy_plugin() -> None:
+    received_types: list[str] = []
+
+    async def handler(conn: Any) -> None:
+        await conn.send(json.dumps({"type": "mcp.transport.connected", "connection_id": 1}))
+
+        async for raw in conn:
+            msg = json.loads(raw)
+            received_types.append(msg.get("type"))
+            if msg.get("type") == "mcp.request":
+                envelope = _build_envelope(msg["request"]["request_id"])
+                await conn.send(
+                    json.dumps({"type": "mcp.response", "ok": True, "response_json": json.dumps(envelope)})
+                )
+
+    response = await _run_request(handler)
+    assert "mcp.transport.configure" not in received_types
+    assert response.envelope["status"] == "ok"
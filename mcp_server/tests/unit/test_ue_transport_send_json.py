@@ -41,3 +41,38 @@ async def test_ue_transport_send_json_works_with_websockets_15_client_connection
         finally:
             await transport.stop()
 
+
+
+@pytest.mark.asyncio
+async def test_ue_transport_subscribe_sends_filter_message() -> None:
+    received: list[dict[str, Any]] = []
+
+    async def handler(conn: Any) -> None:
+        async for raw in conn:
+            received.append(json.loads(raw))
+
+    async with websockets.serve(handler, "127.0.0.1", 0) as server:
+        port = server.sockets[0].getsockname()[1]
+        transport = UeWsTransport(
+            ws_url=f"ws://127.0.0.1:{port}",
+            request_broker=RequestBroker(default_timeout_ms=1000),
+            event_router=EventRouter(),
+            connect_timeout_s=1.0,
+            ping_interval_s=1000.0,
+        )
+
+        await transport.start()
+        try:
+            await transport.wait_until_connected(timeout_s=1.0)
+            await transport.subscribe(event_types=["event.log"], session_ids=["session-a"])
+            await asyncio.sleep(0.05)
+            assert received == [
+                {
+                    "type": "subscribe",
+                    "event_types": ["event.log"],
+                    "request_id_prefixes": [],
+                    "session_ids": ["session-a"],
+                }
+            ]
+        finally:
+            await transport.stop()
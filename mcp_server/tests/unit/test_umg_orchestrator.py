@@ -10,9 +10,18 @@ from mcp_server.umg_orchestrator import UMGOrchestrationService
 
 
 class FakePassThrough:
-    def __init__(self, tool_names: list[str], *, capabilities: tuple[str, ...] = ()) -> None:
+    def __init__(
+        self,
+        tool_names: list[str],
+        *,
+        capabilities: tuple[str, ...] = (),
+        batch_statuses: list[str] | None = None,
+        batch_stop_code: str | None = None,
+    ) -> None:
         self.calls: list[dict[str, Any]] = []
         self.capabilities = capabilities
+        self.batch_statuses = batch_statuses
+        self.batch_stop_code = batch_stop_code
         self._tools = [
             ToolDefinition(
                 name=tool_name,
@@ -52,6 +61,31 @@ class FakePassThrough:
                 "allow_retry": allow_retry,
             }
         )
+        if tool == "mcp.batch":
+            batch_results = [
+                {
+                    "index": index,
+                    "tool": call["tool"],
+                    "request_id": call.get("request_id", f"batch.{index}"),
+                    "status": self.batch_statuses[index] if self.batch_statuses else "ok",
+                    "result": {"touched_packages": [f"/Game/Touched/Batch{index}"]},
+                    "diagnostics": {"errors": [], "warnings": [], "infos": []},
+                }
+                for index, call in enumerate((params or {}).get("calls", []))
+            ]
+            batch_warnings: list[dict[str, Any]] = []
+            if self.batch_stop_code:
+                batch_warnings.append(
+                    {"code": self.batch_stop_code, "message": "Batch stopped; remaining calls were skipped."}
+                )
+            return ToolCallResult(
+                ok=True,
+                status="partial" if self.batch_stop_code else "ok",
+                request_id=request_id or "batch",
+                result={"call_count": len(batch_results), "results": batch_results},
+                diagnostics={"errors": [], "warnings": batch_warnings, "infos": []},
+                raw_envelope={},
+            )
         return ToolCallResult(
             ok=True,
             status="ok",
@@ -148,6 +182,56 @@ async def test_compose_fallbacks_event_bind_to_binding_set() -> None:
     assert result.result["steps"][0]["fallback"] == "fallback: umg.widget.event.bind -> umg.binding.set"
 
 
+@pytest.mark.asyncio
+async def test_compose_uses_single_batch_call_when_advertised() -> None:
+    fake = FakePassThrough(
+        [
+            "mcp.batch",
+            "umg.widget.patch.v2",
+            "umg.slot.patch.v2",
+        ],
+        capabilities=("batch_v1",),
+    )
+    service = UMGOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="umg.workflow.compose",
+        request_id="mcp-12",
+        arguments={
+            "object_path": "/Game/UI/WBP_Test.WBP_Test",
+            "actions": [
+                {
+                    "kind": "widget.patch",
+                    "args": {
+                        "widget_ref": {"name": "RootCanvas"},
+                        "patch": [{"op": "replace", "path": "/RenderOpacity", "value": 0.5}],
+                    },
+                },
+                {
+                    "kind": "slot.patch",
+                    "args": {
+                        "widget_ref": {"name": "RuntimeButton"},
+                        "patch": [{"op": "replace", "path": "/Padding/Left", "value": 4}],
+                    },
+                },
+            ],
+        },
+    )
+
+    assert result.ok is True
+    assert len(fake.calls) == 1
+    assert fake.calls[0]["tool"] == "mcp.batch"
+    assert fake.calls[0]["request_id"] == "mcp-12-batch"
+    batch_params = fake.calls[0]["params"]
+    assert batch_params["mode"] == "stop_on_error"
+    assert [call["tool"] for call in batch_params["calls"]] == ["umg.widget.patch.v2", "umg.slot.patch.v2"]
+    assert batch_params["calls"][1]["request_id"] == "mcp-12-step2"
+    assert batch_params["calls"][1]["params"]["compile_on_success"] is True
+    assert result.result["step_count"] == 2
+    assert result.result["strategy"]["batched"] is True
+    assert result.result["touched_packages"] == ["/Game/Touched/Batch0", "/Game/Touched/Batch1"]
+
+
 @pytest.mark.asyncio
 async def test_compose_rejects_invalid_actions() -> None:
     fake = FakePassThrough(["umg.widget.patch"])
@@ -161,3 +245,72 @@ async def test_compose_rejects_invalid_actions() -> None:
                 "actions": [{"kind": "unknown.kind", "args": {}}],
             },
         )
+
+
+def _two_step_umg_actions() -> list[dict[str, Any]]:
+    return [
+        {
+            "kind": "widget.patch",
+            "args": {
+                "widget_ref": {"name": "RootCanvas"},
+                "patch": [{"op": "replace", "path": "/RenderOpacity", "value": 0.5}],
+            },
+        },
+        {
+            "kind": "slot.patch",
+            "args": {
+                "widget_ref": {"name": "RuntimeButton"},
+                "patch": [{"op": "replace", "path": "/Padding/Left", "value": 4}],
+            },
+        },
+    ]
+
+
+@pytest.mark.asyncio
+async def test_compose_reports_calls_skipped_by_batch_timeout() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "umg.widget.patch.v2", "umg.slot.patch.v2"],
+        capabilities=("batch_v1",),
+        batch_statuses=["skipped", "skipped"],
+        batch_stop_code="MCP.JOB.TIMEOUT",
+    )
+    service = UMGOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="umg.workflow.compose",
+        request_id="mcp-20",
+        arguments={"object_path": "/Game/UI/WBP_Test.WBP_Test", "actions": _two_step_umg_actions()},
+    )
+
+    assert result.ok is False
+    assert result.status == "error"
+    assert [step["status"] for step in result.result["steps"]] == ["skipped"]
+    assert result.result["touched_packages"] == []
+    assert result.diagnostics["errors"][-1]["code"] == "MCP.JOB.TIMEOUT"
+
+
+@pytest.mark.asyncio
+async def test_compose_reports_calls_skipped_by_batch_cancel_in_continue_mode() -> None:
+    fake = FakePassThrough(
+        ["mcp.batch", "umg.widget.patch.v2", "umg.slot.patch.v2"],
+        capabilities=("batch_v1",),
+        batch_statuses=["ok", "skipped"],
+        batch_stop_code="MCP.JOB.CANCELED",
+    )
+    service = UMGOrchestrationService(fake)  # type: ignore[arg-type]
+
+    result = await service.call_virtual_tool(
+        tool_name="umg.workflow.compose",
+        request_id="mcp-21",
+        arguments={
+            "object_path": "/Game/UI/WBP_Test.WBP_Test",
+            "continue_on_error": True,
+            "actions": _two_step_umg_actions(),
+        },
+    )
+
+    assert result.ok is False
+    assert [step["status"] for step in result.result["steps"]] == ["ok", "skipped"]
+    assert result.result["failed_count"] == 1
+    assert result.result["steps"][1]["diagnostics"]["errors"][0]["code"] == "MCP.JOB.CANCELED"
+    assert result.diagnostics["errors"][-1]["code"] == "MCP.JOB.CANCELED"
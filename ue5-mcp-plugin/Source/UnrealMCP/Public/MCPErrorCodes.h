@@ -38,6 +38,8 @@ namespace MCPErrorCodes
 	static constexpr TCHAR MATERIAL_PARAM_NOT_FOUND[] = TEXT("MCP.MATERIAL.PARAM_NOT_FOUND");
 	static constexpr TCHAR NIAGARA_MODULE_KEY_NOT_FOUND[] = TEXT("MCP.NIAGARA.MODULE_KEY_NOT_FOUND");
 	static constexpr TCHAR UMG_WIDGET_NOT_FOUND[] = TEXT("MCP.UMG.WIDGET_NOT_FOUND");
+	static constexpr TCHAR BATCH_CALL_FAILED[] = TEXT("MCP.BATCH.CALL_FAILED");
+	static constexpr TCHAR TRANSPORT_BUSY[] = TEXT("MCP.TRANSPORT.BUSY");
 	static constexpr TCHAR SAVE_FAILED[] = TEXT("MCP.SAVE.FAILED");
 	static constexpr TCHAR INTERNAL_EXCEPTION[] = TEXT("MCP.INTERNAL.EXCEPTION");
 }
@@ -0,0 +1,633 @@
+#include "MCPAssetIndexSubsystem.h"
+
+#include "Algo/BinarySearch.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "MCPLog.h"
+#include "MCPTime.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	constexpr int32 MaxIncrementalInserts = 64;
+	constexpr int32 MinDeadEntriesBeforeCompact = 1024;
+	constexpr int32 StopCheckInterval = 1024;
+	// Beyond this backlog (a mass import or a branch switch) a fresh registry snapshot is cheaper than replaying events.
+	constexpr int32 MaxPendingRegistryEvents = 16384;
+
+	bool IsGlobWildcard(const TCHAR Character)
+	{
+		return Character == TEXT('*') || Character == TEXT('?');
+	}
+
+	int32 GetLiteralPrefixLength(const FString& Glob)
+	{
+		for (int32 Index = 0; Index < Glob.Len(); ++Index)
+		{
+			if (IsGlobWildcard(Glob[Index]))
+			{
+				return Index;
+			}
+		}
+		return Glob.Len();
+	}
+
+	// True for globs like "/Game/UI/**", where every path under the literal prefix matches.
+	bool IsPrefixOnlyGlob(const FString& Glob, const int32 PrefixLength)
+	{
+		if (PrefixLength >= Glob.Len())
+		{
+			return false;
+		}
+
+		for (int32 Index = PrefixLength; Index < Glob.Len(); ++Index)
+		{
+			if (Glob[Index] != TEXT('*'))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	uint64 MakeTrigramKey(const TCHAR First, const TCHAR Second, const TCHAR Third)
+	{
+		constexpr uint64 CharMask = 0x1FFFFF;
+		return ((static_cast<uint64>(First) & CharMask) << 42)
+			| ((static_cast<uint64>(Second) & CharMask) << 21)
+			| (static_cast<uint64>(Third) & CharMask);
+	}
+
+	void AppendTrigrams(const TCHAR* Text, const int32 Length, TArray<uint64>& OutKeys)
+	{
+		for (int32 Index = 0; Index + 2 < Length; ++Index)
+		{
+			OutKeys.AddUnique(MakeTrigramKey(Text[Index], Text[Index + 1], Text[Index + 2]));
+		}
+	}
+
+	// Only literal runs between wildcards constrain a name glob, so trigrams come from those runs alone.
+	void CollectGlobTrigrams(const FString& LowerGlob, TArray<uint64>& OutKeys)
+	{
+		int32 RunStart = 0;
+		for (int32 Index = 0; Index <= LowerGlob.Len(); ++Index)
+		{
+			if (Index == LowerGlob.Len() || IsGlobWildcard(LowerGlob[Index]))
+			{
+				AppendTrigrams(*LowerGlob + RunStart, Index - RunStart, OutKeys);
+				RunStart = Index + 1;
+			}
+		}
+	}
+}
+
+void UMCPAssetIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddUObject(this, &UMCPAssetIndexSubsystem::HandleAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddUObject(this, &UMCPAssetIndexSubsystem::HandleAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddUObject(this, &UMCPAssetIndexSubsystem::HandleAssetRenamed);
+}
+
+void UMCPAssetIndexSubsystem::Deinitialize()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	{
+		FScopeLock EventLock(&RegistryEventGuard);
+		PendingRegistryEvents.Empty();
+		bRecordRegistryEvents = false;
+		bRegistryEventsOverflowed = false;
+	}
+
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		Assets.Reset();
+		IdByObjectPath.Reset();
+		SortedIds.Reset();
+		UnsortedIds.Reset();
+		IdsByClassPath.Reset();
+		IdsByNameTrigram.Reset();
+		DeadCount = 0;
+		bBuilt = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UMCPAssetIndexSubsystem::PrepareForQuery()
+{
+	check(IsInGameThread());
+
+	FWriteScopeLock WriteLock(IndexLock);
+	bool bNeedsBuild = false;
+	{
+		FScopeLock EventLock(&RegistryEventGuard);
+		bNeedsBuild = bRegistryEventsOverflowed;
+		bRegistryEventsOverflowed = false;
+	}
+
+	if (!bBuilt || bNeedsBuild)
+	{
+		if (bBuilt)
+		{
+			UE_LOG(LogUnrealMCP, Log, TEXT("MCP asset index rebuilding: more than %d registry events were pending"), MaxPendingRegistryEvents);
+		}
+		BuildFromRegistryLocked();
+		return;
+	}
+
+	ApplyRegistryEventsLocked();
+	MergePendingLocked();
+}
+
+bool UMCPAssetIndexSubsystem::Query(const FMCPAssetQuery& InQuery, FMCPAssetQueryResult& OutResult, TFunctionRef<bool()> ShouldStop) const
+{
+	FReadScopeLock ReadLock(IndexLock);
+	OutResult = FMCPAssetQueryResult();
+
+	const int32 PrefixLength = GetLiteralPrefixLength(InQuery.PathGlob);
+	const FString PathPrefix = InQuery.PathGlob.Left(PrefixLength).ToLower();
+	const bool bPathNeedsWildcardMatch = !InQuery.PathGlob.IsEmpty() && !IsPrefixOnlyGlob(InQuery.PathGlob, PrefixLength);
+
+	// Sorted lowercase paths make the prefix range contiguous; a package path match implies the object path shares the prefix.
+	int32 RangeBegin = Algo::LowerBoundBy(SortedIds, PathPrefix, [this](const int32 Id) -> const FString&
+	{
+		return Assets[Id].ObjectPathLower;
+	}, [](const FString& Left, const FString& Right)
+	{
+		return Left.Compare(Right, ESearchCase::CaseSensitive) < 0;
+	});
+	int32 RangeEnd = SortedIds.Num();
+	if (!PathPrefix.IsEmpty())
+	{
+		int32 Low = RangeBegin;
+		int32 High = SortedIds.Num();
+		while (Low < High)
+		{
+			const int32 Mid = Low + (High - Low) / 2;
+			if (Assets[SortedIds[Mid]].ObjectPathLower.StartsWith(PathPrefix, ESearchCase::CaseSensitive))
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		RangeEnd = Low;
+	}
+
+	const FString AfterPathLower = InQuery.AfterObjectPath.ToLower();
+	auto IsAfterCursor = [&InQuery, &AfterPathLower](const FIndexedAsset& Asset)
+	{
+		if (InQuery.AfterObjectPath.IsEmpty())
+		{
+			return true;
+		}
+
+		const int32 LowerCompare = Asset.ObjectPathLower.Compare(AfterPathLower, ESearchCase::CaseSensitive);
+		return LowerCompare != 0
+			? LowerCompare > 0
+			: Asset.ObjectPath.Compare(InQuery.AfterObjectPath, ESearchCase::CaseSensitive) > 0;
+	};
+
+	if (!InQuery.AfterObjectPath.IsEmpty())
+	{
+		int32 Low = RangeBegin;
+		int32 High = RangeEnd;
+		while (Low < High)
+		{
+			const int32 Mid = Low + (High - Low) / 2;
+			if (IsAfterCursor(Assets[SortedIds[Mid]]))
+			{
+				High = Mid;
+			}
+			else
+			{
+				Low = Mid + 1;
+			}
+		}
+		RangeBegin = Low;
+	}
+	const int32 RangeCount = RangeEnd - RangeBegin;
+
+	TArray<const TArray<int32>*> CandidateLists;
+	int32 CandidateCount = MAX_int32;
+	if (InQuery.ClassPaths.Num() > 0)
+	{
+		TArray<const TArray<int32>*> ClassLists;
+		int32 ClassCount = 0;
+		for (const FString& ClassPath : InQuery.ClassPaths)
+		{
+			if (const TArray<int32>* ClassIds = IdsByClassPath.Find(ClassPath))
+			{
+				ClassLists.Add(ClassIds);
+				ClassCount += ClassIds->Num();
+			}
+		}
+
+		if (ClassCount == 0)
+		{
+			return true;
+		}
+
+		CandidateLists = MoveTemp(ClassLists);
+		CandidateCount = ClassCount;
+	}
+
+	if (!InQuery.NameGlob.IsEmpty())
+	{
+		TArray<uint64> NameTrigrams;
+		CollectGlobTrigrams(InQuery.NameGlob.ToLower(), NameTrigrams);
+		for (const uint64 TrigramKey : NameTrigrams)
+		{
+			const TArray<int32>* TrigramIds = IdsByNameTrigram.Find(TrigramKey);
+			if (TrigramIds == nullptr)
+			{
+				return true;
+			}
+
+			if (TrigramIds->Num() < CandidateCount)
+			{
+				CandidateLists.Reset();
+				CandidateLists.Add(TrigramIds);
+				CandidateCount = TrigramIds->Num();
+			}
+		}
+	}
+
+	const int32 SafeOffset = FMath::Max(0, InQuery.Offset);
+	const int32 SafeLimit = FMath::Max(1, InQuery.Limit);
+	int32 MatchIndex = 0;
+
+	auto MatchesQuery = [&InQuery, &PathPrefix, bPathNeedsWildcardMatch, &IsAfterCursor](const FIndexedAsset& Asset)
+	{
+		if (!Asset.bAlive || !Asset.ObjectPathLower.StartsWith(PathPrefix, ESearchCase::CaseSensitive) || !IsAfterCursor(Asset))
+		{
+			return false;
+		}
+
+		if (bPathNeedsWildcardMatch
+			&& !Asset.ObjectPath.MatchesWildcard(InQuery.PathGlob)
+			&& !Asset.PackagePath.MatchesWildcard(InQuery.PathGlob))
+		{
+			return false;
+		}
+
+		if (!InQuery.NameGlob.IsEmpty() && !Asset.AssetName.MatchesWildcard(InQuery.NameGlob))
+		{
+			return false;
+		}
+
+		return InQuery.ClassPaths.Num() == 0 || InQuery.ClassPaths.Contains(Asset.ClassPath);
+	};
+
+	// Returns false once the page is full and one more match proves there is a next page.
+	auto AcceptMatch = [&OutResult, &MatchIndex, SafeOffset, SafeLimit](const FIndexedAsset& Asset)
+	{
+		if (MatchIndex++ < SafeOffset)
+		{
+			return true;
+		}
+
+		if (OutResult.Rows.Num() >= SafeLimit)
+		{
+			OutResult.bHasMore = true;
+			return false;
+		}
+
+		FMCPAssetQueryRow& Row = OutResult.Rows.AddDefaulted_GetRef();
+		Row.ObjectPath = Asset.ObjectPath;
+		Row.ClassPath = Asset.ClassPath;
+		Row.PackagePath = Asset.PackagePath;
+		Row.AssetName = Asset.AssetName;
+		return true;
+	};
+
+	if (CandidateLists.Num() > 0 && static_cast<int64>(CandidateCount) * 4 < RangeCount)
+	{
+		TArray<int32> MatchedIds;
+		for (const TArray<int32>* CandidateIds : CandidateLists)
+		{
+			for (const int32 Id : *CandidateIds)
+			{
+				if ((++OutResult.ScannedCount % StopCheckInterval) == 0 && ShouldStop())
+				{
+					return false;
+				}
+
+				if (MatchesQuery(Assets[Id]))
+				{
+					MatchedIds.Add(Id);
+				}
+			}
+		}
+
+		MatchedIds.Sort([this](const int32 Left, const int32 Right)
+		{
+			return LessByPath(Left, Right);
+		});
+		for (const int32 Id : MatchedIds)
+		{
+			if (!AcceptMatch(Assets[Id]))
+			{
+				break;
+			}
+		}
+		return true;
+	}
+
+	for (int32 SortedIndex = RangeBegin; SortedIndex < RangeEnd; ++SortedIndex)
+	{
+		if ((++OutResult.ScannedCount % StopCheckInterval) == 0 && ShouldStop())
+		{
+			return false;
+		}
+
+		const FIndexedAsset& Asset = Assets[SortedIds[SortedIndex]];
+		if (MatchesQuery(Asset) && !AcceptMatch(Asset))
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+int32 UMCPAssetIndexSubsystem::GetIndexedAssetCount() const
+{
+	FReadScopeLock ReadLock(IndexLock);
+	return IdByObjectPath.Num();
+}
+
+UMCPAssetIndexSubsystem::FIndexedAsset UMCPAssetIndexSubsystem::MakeIndexedAsset(const FAssetData& AssetData)
+{
+	FIndexedAsset Asset;
+	Asset.ObjectPath = AssetData.GetObjectPathString();
+	Asset.PackagePath = AssetData.PackagePath.ToString();
+	Asset.ClassPath = AssetData.AssetClassPath.ToString();
+	Asset.AssetName = AssetData.AssetName.ToString();
+	return Asset;
+}
+
+void UMCPAssetIndexSubsystem::HandleAssetAdded(const FAssetData& AssetData)
+{
+	FRegistryEvent Event;
+	Event.Asset = MakeIndexedAsset(AssetData);
+	QueueRegistryEvent(MoveTemp(Event));
+}
+
+void UMCPAssetIndexSubsystem::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	FRegistryEvent Event;
+	Event.Asset.ObjectPath = AssetData.GetObjectPathString();
+	Event.bRemoved = true;
+	QueueRegistryEvent(MoveTemp(Event));
+}
+
+void UMCPAssetIndexSubsystem::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	FRegistryEvent Event;
+	Event.Asset = MakeIndexedAsset(AssetData);
+	Event.OldObjectPath = OldObjectPath;
+	QueueRegistryEvent(MoveTemp(Event));
+}
+
+void UMCPAssetIndexSubsystem::QueueRegistryEvent(FRegistryEvent&& Event)
+{
+	FScopeLock EventLock(&RegistryEventGuard);
+	if (!bRecordRegistryEvents)
+	{
+		return;
+	}
+
+	if (PendingRegistryEvents.Num() >= MaxPendingRegistryEvents)
+	{
+		// Stop queueing until the next PrepareForQuery rebuilds from a registry snapshot.
+		PendingRegistryEvents.Empty();
+		bRecordRegistryEvents = false;
+		bRegistryEventsOverflowed = true;
+		return;
+	}
+
+	PendingRegistryEvents.Add(MoveTemp(Event));
+}
+
+void UMCPAssetIndexSubsystem::ApplyRegistryEventsLocked()
+{
+	TArray<FRegistryEvent> Events;
+	{
+		FScopeLock EventLock(&RegistryEventGuard);
+		Events = MoveTemp(PendingRegistryEvents);
+		PendingRegistryEvents.Reset();
+	}
+
+	for (FRegistryEvent& Event : Events)
+	{
+		if (!Event.OldObjectPath.IsEmpty())
+		{
+			RemoveAssetLocked(Event.OldObjectPath);
+		}
+
+		if (Event.bRemoved)
+		{
+			RemoveAssetLocked(Event.Asset.ObjectPath);
+		}
+		else
+		{
+			AddAssetLocked(MoveTemp(Event.Asset));
+		}
+	}
+}
+
+void UMCPAssetIndexSubsystem::BuildFromRegistryLocked()
+{
+	const uint64 BuildStartCycles = MCPTime::NowCycles();
+
+	// Start queueing before the snapshot; replaying an event the snapshot already reflects is a no-op.
+	{
+		FScopeLock EventLock(&RegistryEventGuard);
+		bRecordRegistryEvents = true;
+	}
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+	TArray<FAssetData> AssetDataList;
+	AssetRegistryModule.Get().GetAllAssets(AssetDataList, true);
+
+	bBuilt = true;
+	Assets.Reset(AssetDataList.Num());
+	IdByObjectPath.Reset();
+	IdByObjectPath.Reserve(AssetDataList.Num());
+	SortedIds.Reset(AssetDataList.Num());
+	UnsortedIds.Reset(AssetDataList.Num());
+	IdsByClassPath.Reset();
+	IdsByNameTrigram.Reset();
+	DeadCount = 0;
+
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		AddAssetLocked(MakeIndexedAsset(AssetData));
+	}
+	ApplyRegistryEventsLocked();
+	MergePendingLocked();
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("MCP asset index built: %d assets in %.1f ms"),
+		IdByObjectPath.Num(), MCPTime::MicrosecondsToMilliseconds(MCPTime::MicrosecondsSince(BuildStartCycles)));
+}
+
+void UMCPAssetIndexSubsystem::RebuildSecondaryIndexesLocked()
+{
+	IdsByClassPath.Reset();
+	IdsByNameTrigram.Reset();
+
+	TArray<uint64> NameTrigrams;
+	for (int32 Id = 0; Id < Assets.Num(); ++Id)
+	{
+		const FIndexedAsset& Asset = Assets[Id];
+		if (!Asset.bAlive)
+		{
+			continue;
+		}
+
+		IdsByClassPath.FindOrAdd(Asset.ClassPath).Add(Id);
+
+		NameTrigrams.Reset();
+		const FString NameLower = Asset.AssetName.ToLower();
+		AppendTrigrams(*NameLower, NameLower.Len(), NameTrigrams);
+		for (const uint64 TrigramKey : NameTrigrams)
+		{
+			IdsByNameTrigram.FindOrAdd(TrigramKey).Add(Id);
+		}
+	}
+}
+
+int32 UMCPAssetIndexSubsystem::AddAssetLocked(FIndexedAsset&& NewAsset)
+{
+	if (!bBuilt)
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ExistingId = IdByObjectPath.Find(NewAsset.ObjectPath))
+	{
+		if (Assets[*ExistingId].ClassPath == NewAsset.ClassPath)
+		{
+			return *ExistingId;
+		}
+		RemoveAssetLocked(NewAsset.ObjectPath);
+	}
+
+	NewAsset.ObjectPathLower = NewAsset.ObjectPath.ToLower();
+	NewAsset.bAlive = true;
+	const int32 Id = Assets.Add(MoveTemp(NewAsset));
+	const FIndexedAsset& Asset = Assets[Id];
+
+	IdByObjectPath.Add(Asset.ObjectPath, Id);
+	IdsByClassPath.FindOrAdd(Asset.ClassPath).Add(Id);
+
+	TArray<uint64> NameTrigrams;
+	const FString NameLower = Asset.AssetName.ToLower();
+	AppendTrigrams(*NameLower, NameLower.Len(), NameTrigrams);
+	for (const uint64 TrigramKey : NameTrigrams)
+	{
+		IdsByNameTrigram.FindOrAdd(TrigramKey).Add(Id);
+	}
+
+	UnsortedIds.Add(Id);
+	return Id;
+}
+
+void UMCPAssetIndexSubsystem::RemoveAssetLocked(const FString& ObjectPath)
+{
+	int32 RemovedId = INDEX_NONE;
+	if (!IdByObjectPath.RemoveAndCopyValue(ObjectPath, RemovedId))
+	{
+		return;
+	}
+
+	// Sorted and posting lists skip dead entries until the next compaction.
+	Assets[RemovedId].bAlive = false;
+	++DeadCount;
+}
+
+void UMCPAssetIndexSubsystem::MergePendingLocked()
+{
+	if (DeadCount > FMath::Max(MinDeadEntriesBeforeCompact, Assets.Num() / 4))
+	{
+		TArray<FIndexedAsset> AliveAssets;
+		AliveAssets.Reserve(Assets.Num() - DeadCount);
+		for (FIndexedAsset& Asset : Assets)
+		{
+			if (Asset.bAlive)
+			{
+				AliveAssets.Add(MoveTemp(Asset));
+			}
+		}
+
+		Assets = MoveTemp(AliveAssets);
+		IdByObjectPath.Reset();
+		SortedIds.Reset(Assets.Num());
+		for (int32 Id = 0; Id < Assets.Num(); ++Id)
+		{
+			IdByObjectPath.Add(Assets[Id].ObjectPath, Id);
+			SortedIds.Add(Id);
+		}
+		UnsortedIds.Reset();
+		DeadCount = 0;
+
+		SortedIds.Sort([this](const int32 Left, const int32 Right)
+		{
+			return LessByPath(Left, Right);
+		});
+		RebuildSecondaryIndexesLocked();
+		return;
+	}
+
+	if (UnsortedIds.Num() == 0)
+	{
+		return;
+	}
+
+	if (UnsortedIds.Num() <= MaxIncrementalInserts)
+	{
+		for (const int32 Id : UnsortedIds)
+		{
+			const int32 InsertIndex = Algo::LowerBound(SortedIds, Id, [this](const int32 Left, const int32 Right)
+			{
+				return LessByPath(Left, Right);
+			});
+			SortedIds.Insert(Id, InsertIndex);
+		}
+	}
+	else
+	{
+		SortedIds.Append(UnsortedIds);
+		SortedIds.Sort([this](const int32 Left, const int32 Right)
+		{
+			return LessByPath(Left, Right);
+		});
+	}
+	UnsortedIds.Reset();
+}
+
+bool UMCPAssetIndexSubsystem::LessByPath(const int32 LeftId, const int32 RightId) const
+{
+	const int32 LowerCompare = Assets[LeftId].ObjectPathLower.Compare(Assets[RightId].ObjectPathLower, ESearchCase::CaseSensitive);
+	if (LowerCompare != 0)
+	{
+		return LowerCompare < 0;
+	}
+	return Assets[LeftId].ObjectPath.Compare(Assets[RightId].ObjectPath, ESearchCase::CaseSensitive) < 0;
+}
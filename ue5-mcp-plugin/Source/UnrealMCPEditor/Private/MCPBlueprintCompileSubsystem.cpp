@@ -0,0 +1,266 @@
+#include "MCPBlueprintCompileSubsystem.h"
+
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "MCPErrorCodes.h"
+#include "MCPEventStreamSubsystem.h"
+#include "MCPLog.h"
+#include "MCPObservabilitySubsystem.h"
+#include "MCPTime.h"
+#include "MCPTraceSubsystem.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Tools/Common/MCPToolAssetUtils.h"
+
+void UMCPBlueprintCompileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LoadSettings();
+
+	if (bDeferCompile)
+	{
+		IdleTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UMCPBlueprintCompileSubsystem::HandleIdleTicker),
+			0.1f);
+	}
+}
+
+void UMCPBlueprintCompileSubsystem::Deinitialize()
+{
+	if (IdleTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(IdleTickHandle);
+		IdleTickHandle.Reset();
+	}
+
+	FMCPBlueprintFlushResult FlushResult;
+	Flush(FlushResult);
+	Super::Deinitialize();
+}
+
+bool UMCPBlueprintCompileSubsystem::IsDeferredCompileEnabled() const
+{
+	return bDeferCompile;
+}
+
+bool UMCPBlueprintCompileSubsystem::RequestCompile(UBlueprint* Blueprint, const bool bSaveAfterCompile, const FString& RequestId)
+{
+	if (Blueprint == nullptr)
+	{
+		return false;
+	}
+
+	if (!bDeferCompile)
+	{
+		FMCPBlueprintFlushResult FlushResult;
+		FlushBlueprint(Blueprint, false, FlushResult);
+		return false;
+	}
+
+	LastRequestCycles = MCPTime::NowCycles();
+	if (PendingCompiles.Num() == 0)
+	{
+		FirstPendingCycles = LastRequestCycles;
+	}
+
+	FPendingCompile& Pending = PendingCompiles.FindOrAdd(Blueprint->GetPathName());
+	Pending.Blueprint = Blueprint;
+	Pending.bSaveAfterCompile |= bSaveAfterCompile;
+	++Pending.RequestCount;
+	if (!RequestId.IsEmpty())
+	{
+		Pending.RequestIds.AddUnique(RequestId);
+	}
+	return true;
+}
+
+void UMCPBlueprintCompileSubsystem::BeginBatchScope()
+{
+	++BatchScopeDepth;
+}
+
+void UMCPBlueprintCompileSubsystem::EndBatchScope(FMCPBlueprintFlushResult& OutResult)
+{
+	BatchScopeDepth = FMath::Max(0, BatchScopeDepth - 1);
+	if (BatchScopeDepth == 0)
+	{
+		Flush(OutResult);
+	}
+}
+
+void UMCPBlueprintCompileSubsystem::Flush(FMCPBlueprintFlushResult& OutResult)
+{
+	if (PendingCompiles.Num() == 0)
+	{
+		return;
+	}
+
+	TMap<FString, FPendingCompile> CompilesToRun = MoveTemp(PendingCompiles);
+	PendingCompiles.Reset();
+
+	TArray<FString> ObjectPaths;
+	CompilesToRun.GetKeys(ObjectPaths);
+	ObjectPaths.Sort();
+	for (const FString& ObjectPath : ObjectPaths)
+	{
+		CompilePending(ObjectPath, MoveTemp(CompilesToRun[ObjectPath]), OutResult);
+	}
+}
+
+void UMCPBlueprintCompileSubsystem::FlushBlueprint(UBlueprint* Blueprint, const bool bSaveAfterCompile, FMCPBlueprintFlushResult& OutResult)
+{
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	const FString ObjectPath = Blueprint->GetPathName();
+	FPendingCompile Pending;
+	PendingCompiles.RemoveAndCopyValue(ObjectPath, Pending);
+	Pending.Blueprint = Blueprint;
+	Pending.bSaveAfterCompile |= bSaveAfterCompile;
+	Pending.RequestCount = FMath::Max(1, Pending.RequestCount);
+	CompilePending(ObjectPath, MoveTemp(Pending), OutResult);
+}
+
+int32 UMCPBlueprintCompileSubsystem::GetPendingCount() const
+{
+	return PendingCompiles.Num();
+}
+
+void UMCPBlueprintCompileSubsystem::LoadSettings()
+{
+	const TCHAR* Section = TEXT("UnrealMCP.BlueprintCompile");
+
+	bool bConfiguredDeferCompile = bDeferCompile;
+	if (GConfig->GetBool(Section, TEXT("bDeferCompile"), bConfiguredDeferCompile, GEditorPerProjectIni))
+	{
+		bDeferCompile = bConfiguredDeferCompile;
+	}
+
+	int32 ConfiguredIdleDebounceMs = IdleDebounceMs;
+	if (GConfig->GetInt(Section, TEXT("IdleDebounceMs"), ConfiguredIdleDebounceMs, GEditorPerProjectIni))
+	{
+		IdleDebounceMs = FMath::Clamp(ConfiguredIdleDebounceMs, 50, 60000);
+	}
+
+	int32 ConfiguredMaxDeferralMs = MaxDeferralMs;
+	if (GConfig->GetInt(Section, TEXT("MaxDeferralMs"), ConfiguredMaxDeferralMs, GEditorPerProjectIni))
+	{
+		MaxDeferralMs = ConfiguredMaxDeferralMs;
+	}
+	MaxDeferralMs = FMath::Clamp(MaxDeferralMs, IdleDebounceMs, 600000);
+}
+
+bool UMCPBlueprintCompileSubsystem::HandleIdleTicker(float DeltaSeconds)
+{
+	(void)DeltaSeconds;
+
+	if (PendingCompiles.Num() == 0 || BatchScopeDepth > 0)
+	{
+		return true;
+	}
+
+	const bool bIdle = MCPTime::MicrosecondsSince(LastRequestCycles) >= static_cast<int64>(IdleDebounceMs) * 1000;
+	const bool bOverdue = MCPTime::MicrosecondsSince(FirstPendingCycles) >= static_cast<int64>(MaxDeferralMs) * 1000;
+	if (bIdle || bOverdue)
+	{
+		FMCPBlueprintFlushResult FlushResult;
+		Flush(FlushResult);
+		ReportFailedIdleSaves(FlushResult);
+	}
+
+	return true;
+}
+
+void UMCPBlueprintCompileSubsystem::ReportFailedIdleSaves(const FMCPBlueprintFlushResult& FlushResult) const
+{
+	if (FlushResult.FailedSavePackages.Num() == 0)
+	{
+		return;
+	}
+
+	UMCPEventStreamSubsystem* EventStream = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr;
+	if (EventStream == nullptr)
+	{
+		return;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> PackageValues;
+	for (const FString& PackageName : FlushResult.FailedSavePackages)
+	{
+		PackageValues.Add(MakeShared<FJsonValueString>(PackageName));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> RequestIdValues;
+	for (const FString& RequestId : FlushResult.FailedSaveRequestIds)
+	{
+		RequestIdValues.Add(MakeShared<FJsonValueString>(RequestId));
+	}
+
+	TSharedRef<FJsonObject> Detail = MakeShared<FJsonObject>();
+	Detail->SetStringField(TEXT("code"), MCPErrorCodes::SAVE_FAILED);
+	Detail->SetArrayField(TEXT("packages"), PackageValues);
+	Detail->SetArrayField(TEXT("request_ids"), RequestIdValues);
+	const FString Message = FString::Printf(TEXT("Deferred save failed for %d package(s) after blueprint compile."), FlushResult.FailedSavePackages.Num());
+
+	// Emitted once per request so clients filtering by request or session still see it.
+	if (FlushResult.FailedSaveRequestIds.Num() == 0)
+	{
+		EventStream->EmitLog(FString(), TEXT("warning"), Message, Detail);
+		return;
+	}
+	for (const FString& RequestId : FlushResult.FailedSaveRequestIds)
+	{
+		EventStream->EmitLog(RequestId, TEXT("warning"), Message, Detail);
+	}
+}
+
+void UMCPBlueprintCompileSubsystem::CompilePending(const FString& ObjectPath, FPendingCompile&& Pending, FMCPBlueprintFlushResult& OutResult)
+{
+	UBlueprint* Blueprint = Pending.Blueprint.Get();
+	if (Blueprint == nullptr)
+	{
+		UE_LOG(LogUnrealMCP, Verbose, TEXT("Skipped deferred compile for unloaded blueprint: %s"), *ObjectPath);
+		return;
+	}
+
+	const uint64 CompileStartCycles = MCPTime::NowCycles();
+	{
+		const FMCPTraceScope CompileTraceScope(TEXT("mcp.phase"), TEXT("blueprint_compile"), TEXT(""), ObjectPath);
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	}
+	const int64 CompileDurationUs = MCPTime::MicrosecondsSince(CompileStartCycles);
+
+	OutResult.CompiledObjectPaths.Add(ObjectPath);
+	OutResult.CoalescedRequestCount += Pending.RequestCount;
+	OutResult.CompileDurationUs += CompileDurationUs;
+
+	if (UMCPObservabilitySubsystem* Observability = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+	{
+		Observability->RecordBlueprintCompile(Pending.RequestCount, CompileDurationUs);
+	}
+
+	if (Pending.bSaveAfterCompile)
+	{
+		const FString PackageName = Blueprint->GetOutermost()->GetName();
+		FMCPToolExecutionResult SaveResult;
+		if (MCPToolAssetUtils::SavePackageByName(PackageName, SaveResult))
+		{
+			OutResult.SavedPackages.AddUnique(PackageName);
+		}
+		else
+		{
+			OutResult.FailedSavePackages.AddUnique(PackageName);
+			for (const FString& RequestId : Pending.RequestIds)
+			{
+				OutResult.FailedSaveRequestIds.AddUnique(RequestId);
+			}
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Deferred save failed after blueprint compile: %s request_ids=%s"), *PackageName, *FString::Join(Pending.RequestIds, TEXT(",")));
+			if (UMCPObservabilitySubsystem* Observability = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+			{
+				Observability->RecordBlueprintSaveFailure(1);
+			}
+		}
+	}
+}
@@ -0,0 +1,333 @@
+#include "MCPChangeSetJournal.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "MCPLog.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	constexpr uint32 JournalSegmentMagic = 0x4A50434D; // "MCPJ"
+	constexpr uint32 JournalSegmentVersion = 1;
+	constexpr int64 SegmentHeaderBytes = 8;
+	const TCHAR* SegmentFilePrefix = TEXT("segment-");
+	const TCHAR* SegmentFileExtension = TEXT(".mcpj");
+
+	void WriteUInt32(uint8* Destination, const uint32 Value)
+	{
+		Destination[0] = static_cast<uint8>(Value & 0xFF);
+		Destination[1] = static_cast<uint8>((Value >> 8) & 0xFF);
+		Destination[2] = static_cast<uint8>((Value >> 16) & 0xFF);
+		Destination[3] = static_cast<uint8>((Value >> 24) & 0xFF);
+	}
+
+	uint32 ReadUInt32(const uint8* Source)
+	{
+		return static_cast<uint32>(Source[0])
+			| (static_cast<uint32>(Source[1]) << 8)
+			| (static_cast<uint32>(Source[2]) << 16)
+			| (static_cast<uint32>(Source[3]) << 24);
+	}
+
+	bool TryParseSegmentId(const FString& FileName, int32& OutSegmentId)
+	{
+		FString BaseName = FPaths::GetBaseFilename(FileName);
+		if (!BaseName.RemoveFromStart(SegmentFilePrefix) || BaseName.IsEmpty() || !BaseName.IsNumeric())
+		{
+			return false;
+		}
+		OutSegmentId = FCString::Atoi(*BaseName);
+		return OutSegmentId >= 0;
+	}
+
+	FString PayloadToString(const uint8* PayloadBytes, const int32 PayloadLength)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(PayloadBytes), PayloadLength);
+		return FString(Converted.Length(), Converted.Get());
+	}
+}
+
+FMCPChangeSetJournal::FMCPChangeSetJournal(const FString& InJournalDir, const int64 InMaxSegmentBytes)
+	: JournalDir(InJournalDir)
+	, MaxSegmentBytes(FMath::Max<int64>(InMaxSegmentBytes, 64 * 1024))
+{
+}
+
+FMCPChangeSetJournal::~FMCPChangeSetJournal()
+{
+	Seal();
+}
+
+bool FMCPChangeSetJournal::Append(const FString& Payload, FMCPJournalRecordLocation& OutLocation)
+{
+	OutLocation = FMCPJournalRecordLocation();
+
+	const FTCHARToUTF8 PayloadUtf8(*Payload);
+	const int32 PayloadLength = PayloadUtf8.Length();
+
+	FScopeLock ScopeLock(&JournalGuard);
+	// Oversized records still get a segment of their own rather than being rejected.
+	const bool bSegmentFull = ActiveSegmentBytes > SegmentHeaderBytes && ActiveSegmentBytes + RecordHeaderBytes + PayloadLength > MaxSegmentBytes;
+	if ((!ActiveHandle.IsValid() || bSegmentFull) && !OpenNextSegmentLocked())
+	{
+		return false;
+	}
+
+	TArray<uint8> RecordBytes;
+	RecordBytes.SetNumUninitialized(RecordHeaderBytes + PayloadLength);
+	WriteUInt32(RecordBytes.GetData(), static_cast<uint32>(PayloadLength));
+	WriteUInt32(RecordBytes.GetData() + 4, FCrc::MemCrc32(PayloadUtf8.Get(), PayloadLength));
+	FMemory::Memcpy(RecordBytes.GetData() + RecordHeaderBytes, PayloadUtf8.Get(), PayloadLength);
+
+	if (!ActiveHandle->Write(RecordBytes.GetData(), RecordBytes.Num()))
+	{
+		// The segment may now end in a partial record; seal it so later records start clean.
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to append to changeset journal segment %d"), ActiveSegmentId);
+		ActiveHandle.Reset();
+		ActiveSegmentId = INDEX_NONE;
+		ActiveSegmentBytes = 0;
+		return false;
+	}
+
+	OutLocation.SegmentId = ActiveSegmentId;
+	OutLocation.Offset = ActiveSegmentBytes;
+	OutLocation.Length = PayloadLength;
+	ActiveSegmentBytes += RecordBytes.Num();
+	bActiveDirty = true;
+	return true;
+}
+
+bool FMCPChangeSetJournal::Flush()
+{
+	FScopeLock ScopeLock(&JournalGuard);
+	if (!ActiveHandle.IsValid() || !bActiveDirty)
+	{
+		return true;
+	}
+
+	bActiveDirty = false;
+	return ActiveHandle->Flush(true);
+}
+
+bool FMCPChangeSetJournal::Read(const FMCPJournalRecordLocation& Location, FString& OutPayload) const
+{
+	OutPayload.Reset();
+	if (!Location.IsValid() || Location.Length < 0 || Location.Offset < SegmentHeaderBytes)
+	{
+		return false;
+	}
+
+	TArray<uint8> RecordBytes;
+	{
+		FScopeLock ScopeLock(&JournalGuard);
+		if (Location.SegmentId == ActiveSegmentId && ActiveHandle.IsValid())
+		{
+			// Push buffered appends to the OS so the read handle sees them.
+			ActiveHandle->Flush(false);
+		}
+
+		IFileHandle* ReadHandle = GetReadHandleLocked(Location.SegmentId);
+		RecordBytes.SetNumUninitialized(RecordHeaderBytes + Location.Length);
+		if (ReadHandle == nullptr
+			|| !ReadHandle->Seek(Location.Offset)
+			|| !ReadHandle->Read(RecordBytes.GetData(), RecordBytes.Num()))
+		{
+			return false;
+		}
+	}
+
+	const uint8* PayloadBytes = RecordBytes.GetData() + RecordHeaderBytes;
+	if (ReadUInt32(RecordBytes.GetData()) != static_cast<uint32>(Location.Length)
+		|| ReadUInt32(RecordBytes.GetData() + 4) != FCrc::MemCrc32(PayloadBytes, Location.Length))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Changeset journal record is corrupt: segment=%d offset=%lld"), Location.SegmentId, Location.Offset);
+		return false;
+	}
+
+	OutPayload = PayloadToString(PayloadBytes, Location.Length);
+	return true;
+}
+
+void FMCPChangeSetJournal::ForEachRecord(TFunctionRef<void(const FMCPJournalRecordLocation&, const FString&)> Visitor) const
+{
+	for (const int32 SegmentId : GetSegmentIds())
+	{
+		if (!ForEachSegmentRecord(SegmentId, Visitor))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Skipping unreadable changeset journal segment %d"), SegmentId);
+		}
+	}
+}
+
+bool FMCPChangeSetJournal::ForEachSegmentRecord(const int32 SegmentId, TFunctionRef<void(const FMCPJournalRecordLocation&, const FString&)> Visitor) const
+{
+	{
+		FScopeLock ScopeLock(&JournalGuard);
+		if (SegmentId == ActiveSegmentId && ActiveHandle.IsValid())
+		{
+			ActiveHandle->Flush(false);
+		}
+	}
+
+	TArray<uint8> SegmentBytes;
+	if (!FFileHelper::LoadFileToArray(SegmentBytes, *GetSegmentPath(SegmentId), FILEREAD_Silent)
+		|| SegmentBytes.Num() < SegmentHeaderBytes
+		|| ReadUInt32(SegmentBytes.GetData()) != JournalSegmentMagic
+		|| ReadUInt32(SegmentBytes.GetData() + 4) != JournalSegmentVersion)
+	{
+		return false;
+	}
+
+	int64 Offset = SegmentHeaderBytes;
+	while (Offset + RecordHeaderBytes <= SegmentBytes.Num())
+	{
+		const uint32 PayloadLength = ReadUInt32(SegmentBytes.GetData() + Offset);
+		const uint32 PayloadCrc = ReadUInt32(SegmentBytes.GetData() + Offset + 4);
+		const uint8* PayloadBytes = SegmentBytes.GetData() + Offset + RecordHeaderBytes;
+		if (Offset + RecordHeaderBytes + PayloadLength > SegmentBytes.Num()
+			|| FCrc::MemCrc32(PayloadBytes, static_cast<int32>(PayloadLength)) != PayloadCrc)
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Changeset journal segment %d ends in a torn record at offset %lld"), SegmentId, Offset);
+			break;
+		}
+
+		FMCPJournalRecordLocation Location;
+		Location.SegmentId = SegmentId;
+		Location.Offset = Offset;
+		Location.Length = static_cast<int32>(PayloadLength);
+		Visitor(Location, PayloadToString(PayloadBytes, Location.Length));
+		Offset += RecordHeaderBytes + PayloadLength;
+	}
+	return true;
+}
+
+TArray<int32> FMCPChangeSetJournal::GetSegmentIds() const
+{
+	TArray<FString> SegmentFiles;
+	IFileManager::Get().FindFiles(SegmentFiles, *FPaths::Combine(JournalDir, FString::Printf(TEXT("%s*%s"), SegmentFilePrefix, SegmentFileExtension)), true, false);
+
+	TArray<int32> SegmentIds;
+	SegmentIds.Reserve(SegmentFiles.Num());
+	for (const FString& SegmentFile : SegmentFiles)
+	{
+		int32 SegmentId = INDEX_NONE;
+		if (TryParseSegmentId(SegmentFile, SegmentId))
+		{
+			SegmentIds.Add(SegmentId);
+		}
+	}
+	SegmentIds.Sort();
+	return SegmentIds;
+}
+
+int32 FMCPChangeSetJournal::GetActiveSegmentId() const
+{
+	FScopeLock ScopeLock(&JournalGuard);
+	return ActiveSegmentId;
+}
+
+int64 FMCPChangeSetJournal::GetSegmentSizeBytes(const int32 SegmentId) const
+{
+	const int64 SizeBytes = IFileManager::Get().FileSize(*GetSegmentPath(SegmentId));
+	return FMath::Max<int64>(0, SizeBytes);
+}
+
+bool FMCPChangeSetJournal::DeleteSegment(const int32 SegmentId)
+{
+	FScopeLock ScopeLock(&JournalGuard);
+	if (SegmentId == ActiveSegmentId)
+	{
+		return false;
+	}
+
+	ReadHandles.Remove(SegmentId);
+	return IFileManager::Get().Delete(*GetSegmentPath(SegmentId), false, true, true);
+}
+
+void FMCPChangeSetJournal::Seal()
+{
+	FScopeLock ScopeLock(&JournalGuard);
+	if (ActiveHandle.IsValid())
+	{
+		ActiveHandle->Flush(true);
+		ActiveHandle.Reset();
+	}
+	ActiveSegmentId = INDEX_NONE;
+	ActiveSegmentBytes = 0;
+	bActiveDirty = false;
+}
+
+FDateTime FMCPChangeSetJournal::GetLatestTimeStamp() const
+{
+	IFileManager& FileManager = IFileManager::Get();
+	FDateTime LatestTimeStamp = FileManager.GetTimeStamp(*JournalDir);
+	for (const int32 SegmentId : GetSegmentIds())
+	{
+		LatestTimeStamp = FMath::Max(LatestTimeStamp, FileManager.GetTimeStamp(*GetSegmentPath(SegmentId)));
+	}
+	return LatestTimeStamp;
+}
+
+FString FMCPChangeSetJournal::GetSegmentPath(const int32 SegmentId) const
+{
+	return FPaths::Combine(JournalDir, FString::Printf(TEXT("%s%06d%s"), SegmentFilePrefix, SegmentId, SegmentFileExtension));
+}
+
+bool FMCPChangeSetJournal::OpenNextSegmentLocked()
+{
+	if (ActiveHandle.IsValid())
+	{
+		ActiveHandle->Flush(true);
+		ActiveHandle.Reset();
+	}
+	ActiveSegmentId = INDEX_NONE;
+	ActiveSegmentBytes = 0;
+	bActiveDirty = false;
+
+	// Segments left by an earlier session are sealed; appends always start a fresh segment.
+	const TArray<int32> SegmentIds = GetSegmentIds();
+	const int32 NextSegmentId = SegmentIds.Num() > 0 ? SegmentIds.Last() + 1 : 0;
+	const FString SegmentPath = GetSegmentPath(NextSegmentId);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*JournalDir);
+	TUniquePtr<IFileHandle> SegmentHandle(PlatformFile.OpenWrite(*SegmentPath, false, true));
+	if (!SegmentHandle.IsValid())
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to open changeset journal segment: %s"), *SegmentPath);
+		return false;
+	}
+
+	uint8 SegmentHeader[SegmentHeaderBytes];
+	WriteUInt32(SegmentHeader, JournalSegmentMagic);
+	WriteUInt32(SegmentHeader + 4, JournalSegmentVersion);
+	if (!SegmentHandle->Write(SegmentHeader, SegmentHeaderBytes))
+	{
+		return false;
+	}
+
+	ReadHandles.Remove(NextSegmentId);
+	ActiveHandle = MoveTemp(SegmentHandle);
+	ActiveSegmentId = NextSegmentId;
+	ActiveSegmentBytes = SegmentHeaderBytes;
+	bActiveDirty = true;
+	return true;
+}
+
+IFileHandle* FMCPChangeSetJournal::GetReadHandleLocked(const int32 SegmentId) const
+{
+	if (TUniquePtr<IFileHandle>* ExistingHandle = ReadHandles.Find(SegmentId))
+	{
+		return ExistingHandle->Get();
+	}
+
+	TUniquePtr<IFileHandle> ReadHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetSegmentPath(SegmentId), true));
+	if (!ReadHandle.IsValid())
+	{
+		return nullptr;
+	}
+	return ReadHandles.Add(SegmentId, MoveTemp(ReadHandle)).Get();
+}
@@ -1,19 +1,122 @@
 #include "MCPChangeSetSubsystem.h"
 
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Editor.h"
 #include "MCPErrorCodes.h"
 #include "MCPLog.h"
+#include "MCPObservabilitySubsystem.h"
+#include "MCPSnapshotStoreSubsystem.h"
+#include "MCPTime.h"
+#include "Misc/ConfigCacheIni.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Guid.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "PackageTools.h"
+#include "HAL/Event.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
 
 namespace
 {
-	FString ToIso8601Now()
+	constexpr int32 ChangeSetIndexVersion = 1;
+	const TCHAR* ChangeSetSettingsSection = TEXT("UnrealMCP.ChangeSets");
+	constexpr int64 MillisecondsPerDay = 24ll * 60 * 60 * 1000;
+	// Blobs younger than this may belong to a capture whose changeset is not indexed yet.
+	const FTimespan UnreferencedBlobMinAge = FTimespan::FromHours(1.0);
+
+	int64 ComputeDirectorySizeBytes(const FString& Directory)
+	{
+		int64 SizeBytes = 0;
+		IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&SizeBytes](const TCHAR*, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				SizeBytes += FMath::Max<int64>(0, StatData.FileSize);
+			}
+			return true;
+		});
+		return SizeBytes;
+	}
+
+	void CollectSnapshotBlobHashes(const TArray<TSharedPtr<FJsonValue>>& SnapshotRefs, TArray<FString>& OutBlobHashes)
+	{
+		for (const TSharedPtr<FJsonValue>& SnapshotRef : SnapshotRefs)
+		{
+			const TSharedPtr<FJsonObject>* SnapshotObject = nullptr;
+			FString BlobHash;
+			if (SnapshotRef.IsValid() && SnapshotRef->TryGetObject(SnapshotObject) && SnapshotObject != nullptr
+				&& (*SnapshotObject)->TryGetStringField(TEXT("blob"), BlobHash) && !BlobHash.IsEmpty())
+			{
+				OutBlobHashes.AddUnique(BlobHash);
+			}
+		}
+	}
+
+	int64 ToUnixMilliseconds(const FDateTime& DateTime)
+	{
+		return static_cast<int64>((DateTime - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+	}
+
+	// Zero-padded so lexical order of sort keys matches creation order; the sequence orders
+	// changesets that share a millisecond.
+	FString MakeIndexSortKey(const int64 CreatedAtMs, const int64 Sequence, const FString& ChangeSetId)
+	{
+		return FString::Printf(TEXT("%016lld:%016lld:%s"), FMath::Max<int64>(0, CreatedAtMs), FMath::Max<int64>(0, Sequence), *ChangeSetId);
+	}
+
+	// Journal records are never rewritten, so deleting a journaled changeset appends a tombstone naming it.
+	// RecordSegmentId is the segment of the record's newest copy; older copies only live in lower segments.
+	// The tombstone key comes first so scans can recognize one without parsing every record.
+	const TCHAR* JournalTombstonePrefix = TEXT("{\"tombstone\":true,");
+
+	FString MakeJournalTombstonePayload(const FString& ChangeSetId, const int32 RecordSegmentId)
+	{
+		return FString::Printf(TEXT("%s\"changeset_id\":\"%s\",\"record_segment\":%d}"), JournalTombstonePrefix, *ChangeSetId, RecordSegmentId);
+	}
+
+	bool TryParseJournalTombstone(const FString& Payload, FString& OutChangeSetId, int32& OutRecordSegmentId)
+	{
+		TSharedPtr<FJsonObject> TombstoneObject;
+		double RecordSegmentId = 0.0;
+		if (!Payload.StartsWith(JournalTombstonePrefix, ESearchCase::CaseSensitive)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Payload), TombstoneObject)
+			|| !TombstoneObject.IsValid()
+			|| !TombstoneObject->TryGetStringField(TEXT("changeset_id"), OutChangeSetId)
+			|| !TombstoneObject->TryGetNumberField(TEXT("record_segment"), RecordSegmentId))
+		{
+			return false;
+		}
+		OutRecordSegmentId = static_cast<int32>(RecordSegmentId);
+		return true;
+	}
+
+	FString ToCondensedJson(const TSharedRef<FJsonObject>& JsonObject)
+	{
+		FString Content;
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Content);
+		FJsonSerializer::Serialize(JsonObject, Writer);
+		return Content;
+	}
+
+	bool HasGlobWildcard(const FString& Glob)
+	{
+		int32 WildcardIndex = INDEX_NONE;
+		return Glob.FindChar(TEXT('*'), WildcardIndex) || Glob.FindChar(TEXT('?'), WildcardIndex);
+	}
+
+	FString MakeSnapshotFileName(const FString& PackageName)
 	{
-		return FDateTime::UtcNow().ToIso8601();
+		FString FileName = PackageName;
+		FileName.RemoveFromStart(TEXT("/"));
+		FileName.ReplaceCharInline(TEXT('/'), TEXT('_'));
+		return FPaths::MakeValidFileName(FileName, TEXT('_')) + TEXT(".before");
 	}
 
 	TArray<TSharedPtr<FJsonValue>> ToJsonStringArrayForChangeSet(const TArray<FString>& Values)
@@ -28,35 +131,132 @@ namespace
 	}
 }
 
+void UMCPChangeSetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	BackgroundTasksIdleEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	SnapshotStore = Cast<UMCPSnapshotStoreSubsystem>(Collection.InitializeDependency(UMCPSnapshotStoreSubsystem::StaticClass()));
+	LoadSettings();
+	LoadPins();
+
+	if (GarbageCollectionIntervalSeconds > 0.0f)
+	{
+		GarbageCollectionTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UMCPChangeSetSubsystem::HandleGarbageCollectionTicker),
+			GarbageCollectionIntervalSeconds);
+		ScheduleGarbageCollection();
+	}
+}
+
+void UMCPChangeSetSubsystem::Deinitialize()
+{
+	if (GarbageCollectionTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(GarbageCollectionTickHandle);
+		GarbageCollectionTickHandle.Reset();
+	}
+
+	// Background tasks that have not started yet see the flag and bail; running ones are waited out
+	// before the final flush so nothing touches the journal after it is reset.
+	bool bWaitForBackgroundTasks = false;
+	{
+		FScopeLock ScopeLock(&WriterGuard);
+		bShuttingDown = true;
+		bWaitForBackgroundTasks = InFlightBackgroundTasks > 0;
+	}
+	if (bWaitForBackgroundTasks)
+	{
+		BackgroundTasksIdleEvent->Wait();
+	}
+	FPlatformProcess::ReturnSynchEventToPool(BackgroundTasksIdleEvent);
+	BackgroundTasksIdleEvent = nullptr;
+
+	FlushPendingWrites();
+
+	bool bRewriteIndexFile = false;
+	{
+		FScopeLock ScopeLock(&IndexGuard);
+		bRewriteIndexFile = bIndexFileDirty;
+	}
+	if (bRewriteIndexFile)
+	{
+		RewriteIndexFile();
+	}
+
+	Journal.Reset();
+	Super::Deinitialize();
+}
+
+void UMCPChangeSetSubsystem::LoadSettings()
+{
+	FString Durability = TEXT("async");
+	FString StorageMode = TEXT("directory");
+	int32 ConfigMaxWriteBatchRecords = MaxWriteBatchRecords;
+	int32 JournalSegmentMaxMB = 64;
+	int32 ConfigJournalCompactLivePercent = JournalCompactLivePercent;
+	int32 RetentionMaxMB = static_cast<int32>(RetentionPolicy.MaxBytes / (1024 * 1024));
+	int32 ConfigGarbageCollectionBatchSize = GarbageCollectionBatchSize;
+	float ConfigGarbageCollectionIntervalSeconds = GarbageCollectionIntervalSeconds;
+	if (GConfig != nullptr)
+	{
+		GConfig->GetString(ChangeSetSettingsSection, TEXT("Durability"), Durability, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("WriterBatchMaxRecords"), ConfigMaxWriteBatchRecords, GEditorPerProjectIni);
+		GConfig->GetString(ChangeSetSettingsSection, TEXT("StorageMode"), StorageMode, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("JournalSegmentMaxMB"), JournalSegmentMaxMB, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("JournalCompactLivePercent"), ConfigJournalCompactLivePercent, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("RetentionMaxAgeDays"), RetentionPolicy.MaxAgeDays, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("RetentionMaxCount"), RetentionPolicy.MaxCount, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("RetentionMaxMB"), RetentionMaxMB, GEditorPerProjectIni);
+		GConfig->GetBool(ChangeSetSettingsSection, TEXT("RetentionKeepPinned"), RetentionPolicy.bKeepPinned, GEditorPerProjectIni);
+		GConfig->GetInt(ChangeSetSettingsSection, TEXT("GCBatchSize"), ConfigGarbageCollectionBatchSize, GEditorPerProjectIni);
+		GConfig->GetFloat(ChangeSetSettingsSection, TEXT("GCIntervalSeconds"), ConfigGarbageCollectionIntervalSeconds, GEditorPerProjectIni);
+	}
+
+	bSyncDurabilityByDefault = Durability.Equals(TEXT("sync"), ESearchCase::IgnoreCase);
+	bJournalStorage = StorageMode.Equals(TEXT("journal"), ESearchCase::IgnoreCase);
+	MaxWriteBatchRecords = FMath::Clamp(ConfigMaxWriteBatchRecords, 1, 1024);
+	JournalCompactLivePercent = FMath::Clamp(ConfigJournalCompactLivePercent, 0, 100);
+	RetentionPolicy.MaxAgeDays = FMath::Max(0, RetentionPolicy.MaxAgeDays);
+	RetentionPolicy.MaxCount = FMath::Max(0, RetentionPolicy.MaxCount);
+	RetentionPolicy.MaxBytes = static_cast<int64>(FMath::Max(0, RetentionMaxMB)) * 1024 * 1024;
+	GarbageCollectionBatchSize = FMath::Clamp(ConfigGarbageCollectionBatchSize, 1, 1024);
+	// Zero turns off the periodic pass; CollectGarbage can still be called directly.
+	GarbageCollectionIntervalSeconds = ConfigGarbageCollectionIntervalSeconds > 0.0f ? FMath::Max(ConfigGarbageCollectionIntervalSeconds, 10.0f) : 0.0f;
+
+	// Created in directory mode too so journaled records from an earlier session stay readable.
+	const int64 JournalSegmentMaxBytes = static_cast<int64>(FMath::Clamp(JournalSegmentMaxMB, 1, 1024)) * 1024 * 1024;
+	Journal = MakeUnique<FMCPChangeSetJournal>(GetChangeSetJournalDir(), JournalSegmentMaxBytes);
+}
+
 bool UMCPChangeSetSubsystem::CreateChangeSetRecord(
 	const FMCPRequestEnvelope& Request,
 	const FMCPToolExecutionResult& Result,
 	const FString& PolicyVersion,
 	const FString& SchemaHash,
+	const TArray<FMCPPackageSnapshot>& Snapshots,
 	FString& OutChangeSetId,
+	FMCPChangeSetRecordStats& OutStats,
 	FMCPDiagnostic& OutDiagnostic) const
 {
-	OutChangeSetId = FString::Printf(TEXT("cs-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
-	const FString ChangeSetDir = BuildChangeSetDirectory(OutChangeSetId);
-	const FString DomainDiffDir = FPaths::Combine(ChangeSetDir, TEXT("domain_diffs"));
-	const FString SnapshotDir = FPaths::Combine(ChangeSetDir, TEXT("snapshots"));
-
-	IFileManager& FileManager = IFileManager::Get();
-	if (!FileManager.MakeDirectory(*SnapshotDir, true) || !FileManager.MakeDirectory(*DomainDiffDir, true))
+	OutStats = FMCPChangeSetRecordStats();
 	{
-		OutDiagnostic.Code = MCPErrorCodes::SAVE_FAILED;
-		OutDiagnostic.Message = TEXT("Failed to create changeset directories.");
-		OutDiagnostic.Detail = ChangeSetDir;
-		OutDiagnostic.Suggestion = TEXT("Check write permission for Saved/UnrealMCP.");
-		return false;
+		// Load (or rebuild) before queueing the record so the new changeset is only indexed once.
+		FScopeLock ScopeLock(&IndexGuard);
+		EnsureIndexLoadedLocked();
 	}
 
+	const FDateTime CreatedAt = FDateTime::UtcNow();
+	const int64 Sequence = ++NextChangeSetSequence;
+	OutChangeSetId = FString::Printf(TEXT("cs-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+
 	TSharedRef<FJsonObject> MetaObject = MakeShared<FJsonObject>();
 	MetaObject->SetStringField(TEXT("changeset_id"), OutChangeSetId);
 	MetaObject->SetStringField(TEXT("request_id"), Request.RequestId);
 	MetaObject->SetStringField(TEXT("session_id"), Request.SessionId);
 	MetaObject->SetStringField(TEXT("tool"), Request.Tool);
-	MetaObject->SetStringField(TEXT("created_at"), ToIso8601Now());
+	MetaObject->SetStringField(TEXT("created_at"), CreatedAt.ToIso8601());
+	MetaObject->SetNumberField(TEXT("created_at_ms"), static_cast<double>(ToUnixMilliseconds(CreatedAt)));
+	MetaObject->SetNumberField(TEXT("sequence"), static_cast<double>(Sequence));
 	MetaObject->SetStringField(TEXT("status"), MCPJson::StatusToString(Result.Status));
 	MetaObject->SetStringField(TEXT("policy_version"), PolicyVersion);
 	MetaObject->SetStringField(TEXT("schema_hash"), SchemaHash);
@@ -69,213 +269,642 @@ bool UMCPChangeSetSubsystem::CreateChangeSetRecord(
 	{
 		Targets.Add(MakeShared<FJsonValueObject>((*TargetObject).ToSharedRef()));
 	}
-	MetaObject->SetArrayField(TEXT("targets"), Targets);
 
-	const FString MetaFilePath = FPaths::Combine(ChangeSetDir, TEXT("meta.json"));
-	if (!WriteJsonFile(MetaFilePath, MetaObject))
+	// mcp.batch records one changeset for all of its calls, so collect each call's target and tool.
+	const TArray<TSharedPtr<FJsonValue>>* BatchCallValues = nullptr;
+	if (Request.Tool == TEXT("mcp.batch") && Request.Params.IsValid() && Request.Params->TryGetArrayField(TEXT("calls"), BatchCallValues) && BatchCallValues != nullptr)
 	{
-		OutDiagnostic.Code = MCPErrorCodes::SAVE_FAILED;
-		OutDiagnostic.Message = TEXT("Failed to write changeset meta.json");
-		OutDiagnostic.Detail = MetaFilePath;
-		OutDiagnostic.Suggestion = TEXT("Check disk status and retry.");
-		return false;
-	}
-
-	const FString LogFilePath = FPaths::Combine(ChangeSetDir, TEXT("logs.jsonl"));
-	FFileHelper::SaveStringToFile(TEXT(""), *LogFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
-
-	UE_LOG(LogUnrealMCP, Log, TEXT("Created changeset %s"), *OutChangeSetId);
-	return true;
-}
+		TArray<FString> BatchTools;
+		for (const TSharedPtr<FJsonValue>& BatchCallValue : *BatchCallValues)
+		{
+			const TSharedPtr<FJsonObject>* BatchCallObject = nullptr;
+			if (!BatchCallValue.IsValid() || !BatchCallValue->TryGetObject(BatchCallObject) || BatchCallObject == nullptr || !BatchCallObject->IsValid())
+			{
+				continue;
+			}
 
-bool UMCPChangeSetSubsystem::ListChangeSets(
-	const int32 Limit,
-	const int32 Cursor,
-	const TArray<FString>& StatusFilter,
-	const FString& ToolGlob,
-	const FString& SessionId,
-	TArray<TSharedPtr<FJsonObject>>& OutItems,
-	int32& OutNextCursor,
-	FMCPDiagnostic& OutDiagnostic) const
-{
-	OutItems.Reset();
-	OutNextCursor = -1;
+			FString BatchTool;
+			(*BatchCallObject)->TryGetStringField(TEXT("tool"), BatchTool);
+			BatchTools.Add(BatchTool);
 
-	const FString RootDir = GetChangeSetRootDir();
-	if (!IFileManager::Get().DirectoryExists(*RootDir))
-	{
-		return true;
+			const TSharedPtr<FJsonObject>* BatchParams = nullptr;
+			const TSharedPtr<FJsonObject>* BatchTarget = nullptr;
+			if ((*BatchCallObject)->TryGetObjectField(TEXT("params"), BatchParams) && BatchParams != nullptr && BatchParams->IsValid()
+				&& (*BatchParams)->TryGetObjectField(TEXT("target"), BatchTarget) && BatchTarget != nullptr && BatchTarget->IsValid())
+			{
+				Targets.Add(MakeShared<FJsonValueObject>((*BatchTarget).ToSharedRef()));
+			}
+		}
+		MetaObject->SetArrayField(TEXT("batch_tools"), ToJsonStringArrayForChangeSet(BatchTools));
 	}
+	MetaObject->SetArrayField(TEXT("targets"), Targets);
 
-	TArray<FString> Directories;
-	IFileManager::Get().FindFiles(Directories, *(FPaths::Combine(RootDir, TEXT("*"))), false, true);
+	FPendingWrite PendingWrite;
+	PendingWrite.ChangeSetId = OutChangeSetId;
+	PendingWrite.bJournal = bJournalStorage;
+	PendingWrite.MetaJson = ToCondensedJson(MetaObject);
+	OutStats.ApproximateBytes = FTCHARToUTF8(*PendingWrite.MetaJson).Length();
 
-	TArray<TSharedPtr<FJsonObject>> MetaItems;
-	for (const FString& DirectoryName : Directories)
+	// Snapshot refs point into the shared blob store; the package bytes themselves are never copied per changeset.
+	for (const FMCPPackageSnapshot& Snapshot : Snapshots)
 	{
-		const FString MetaPath = FPaths::Combine(RootDir, DirectoryName, TEXT("meta.json"));
-		TSharedPtr<FJsonObject> MetaObject;
-		if (!ReadJsonFile(MetaPath, MetaObject))
-		{
-			continue;
-		}
+		TSharedRef<FJsonObject> SnapshotObject = MakeShared<FJsonObject>();
+		SnapshotObject->SetStringField(TEXT("package"), Snapshot.PackageName);
+		SnapshotObject->SetStringField(TEXT("file"), Snapshot.RelativeFilename);
+		SnapshotObject->SetBoolField(TEXT("existed"), !Snapshot.BlobHash.IsEmpty());
+		SnapshotObject->SetStringField(TEXT("blob"), Snapshot.BlobHash);
+		SnapshotObject->SetNumberField(TEXT("size_bytes"), static_cast<double>(Snapshot.SizeBytes));
 
-		FString Status;
-		MetaObject->TryGetStringField(TEXT("status"), Status);
-		if (StatusFilter.Num() > 0 && !StatusFilter.Contains(Status))
-		{
-			continue;
-		}
-
-		FString Tool;
-		MetaObject->TryGetStringField(TEXT("tool"), Tool);
-		if (!ToolGlob.IsEmpty() && !Tool.MatchesWildcard(ToolGlob))
-		{
-			continue;
-		}
+		TPair<FString, FString>& SnapshotRef = PendingWrite.SnapshotRefs.Emplace_GetRef(MakeSnapshotFileName(Snapshot.PackageName), ToCondensedJson(SnapshotObject));
+		OutStats.ApproximateBytes += FTCHARToUTF8(*SnapshotRef.Value).Length();
+	}
+	OutStats.SnapshotCount = PendingWrite.SnapshotRefs.Num();
 
-		FString ExistingSessionId;
-		MetaObject->TryGetStringField(TEXT("session_id"), ExistingSessionId);
-		if (!SessionId.IsEmpty() && ExistingSessionId != SessionId)
+	FIndexEntry& IndexEntry = PendingWrite.IndexEntry;
+	IndexEntry.ChangeSetId = OutChangeSetId;
+	IndexEntry.RequestId = Request.RequestId;
+	IndexEntry.SessionId = Request.SessionId;
+	IndexEntry.Tool = Request.Tool;
+	IndexEntry.Status = MCPJson::StatusToString(Result.Status);
+	IndexEntry.CreatedAt = CreatedAt.ToIso8601();
+	IndexEntry.CreatedAtMs = ToUnixMilliseconds(CreatedAt);
+	IndexEntry.Sequence = Sequence;
+	IndexEntry.SortKey = MakeIndexSortKey(IndexEntry.CreatedAtMs, IndexEntry.Sequence, IndexEntry.ChangeSetId);
+	IndexEntry.SizeBytes = OutStats.ApproximateBytes;
+	for (const FMCPPackageSnapshot& Snapshot : Snapshots)
+	{
+		if (!Snapshot.BlobHash.IsEmpty())
 		{
-			continue;
+			IndexEntry.BlobHashes.AddUnique(Snapshot.BlobHash);
 		}
-
-		MetaItems.Add(MetaObject);
+	}
+	{
+		// Listed immediately; the index file only gets the record once its directory has been written.
+		FScopeLock ScopeLock(&IndexGuard);
+		AddIndexEntryLocked(FIndexEntry(IndexEntry));
 	}
 
-	MetaItems.Sort([](const TSharedPtr<FJsonObject>& Left, const TSharedPtr<FJsonObject>& Right)
+	const bool bJournalRecord = PendingWrite.bJournal;
+	const bool bSyncWrite = Request.Context.Durability.IsEmpty()
+		? bSyncDurabilityByDefault
+		: Request.Context.Durability.Equals(TEXT("sync"), ESearchCase::IgnoreCase);
 	{
-		FString LeftCreatedAt;
-		FString RightCreatedAt;
-		Left->TryGetStringField(TEXT("created_at"), LeftCreatedAt);
-		Right->TryGetStringField(TEXT("created_at"), RightCreatedAt);
-		return LeftCreatedAt > RightCreatedAt;
-	});
+		FScopeLock ScopeLock(&WriterGuard);
+		PendingChangeSetIds.Add(OutChangeSetId);
+		PendingWrites.Add(MoveTemp(PendingWrite));
+	}
+	UE_LOG(LogUnrealMCP, Log, TEXT("Created changeset %s"), *OutChangeSetId);
 
-	const int32 SafeCursor = FMath::Max(0, Cursor);
-	const int32 SafeLimit = FMath::Clamp(Limit, 1, 200);
-	if (SafeCursor >= MetaItems.Num())
+	if (!bSyncWrite)
 	{
+		SchedulePendingWrites();
 		return true;
 	}
 
-	const int32 EndIndex = FMath::Min(SafeCursor + SafeLimit, MetaItems.Num());
-	for (int32 Index = SafeCursor; Index < EndIndex; ++Index)
+	// The background writer may have taken this record already, so check where it landed rather than this drain.
+	FlushPendingWrites();
+	FMCPJournalRecordLocation JournalLocation;
+	const bool bPersisted = bJournalRecord
+		? FindJournalLocation(OutChangeSetId, JournalLocation)
+		: IFileManager::Get().FileExists(*FPaths::Combine(BuildChangeSetDirectory(OutChangeSetId), TEXT("meta.json")));
+	if (!bPersisted)
 	{
-		OutItems.Add(MetaItems[Index]);
+		OutDiagnostic.Code = MCPErrorCodes::SAVE_FAILED;
+		OutDiagnostic.Message = TEXT("Failed to write changeset record.");
+		OutDiagnostic.Detail = GetChangeSetLocation(OutChangeSetId);
+		OutDiagnostic.Suggestion = TEXT("Check write permission for Saved/UnrealMCP and disk status, then retry.");
+		return false;
 	}
+	OutStats.bDurable = true;
+	return true;
+}
 
-	if (EndIndex < MetaItems.Num())
+FString UMCPChangeSetSubsystem::MakeIndexRecordLine(const FIndexEntry& Entry)
+{
+	TSharedRef<FJsonObject> RecordObject = MakeShared<FJsonObject>();
+	RecordObject->SetStringField(TEXT("changeset_id"), Entry.ChangeSetId);
+	RecordObject->SetStringField(TEXT("request_id"), Entry.RequestId);
+	RecordObject->SetStringField(TEXT("session_id"), Entry.SessionId);
+	RecordObject->SetStringField(TEXT("tool"), Entry.Tool);
+	RecordObject->SetStringField(TEXT("status"), Entry.Status);
+	RecordObject->SetStringField(TEXT("created_at"), Entry.CreatedAt);
+	RecordObject->SetNumberField(TEXT("created_at_ms"), static_cast<double>(Entry.CreatedAtMs));
+	RecordObject->SetNumberField(TEXT("sequence"), static_cast<double>(Entry.Sequence));
+	RecordObject->SetNumberField(TEXT("size_bytes"), static_cast<double>(Entry.SizeBytes));
+	if (Entry.BlobHashes.Num() > 0)
+	{
+		RecordObject->SetArrayField(TEXT("blobs"), ToJsonStringArrayForChangeSet(Entry.BlobHashes));
+	}
+	if (Entry.JournalLocation.IsValid())
 	{
-		OutNextCursor = EndIndex;
+		RecordObject->SetNumberField(TEXT("journal_segment"), Entry.JournalLocation.SegmentId);
+		RecordObject->SetNumberField(TEXT("journal_offset"), static_cast<double>(Entry.JournalLocation.Offset));
+		RecordObject->SetNumberField(TEXT("journal_length"), Entry.JournalLocation.Length);
 	}
 
-	return true;
+	FString Line = ToCondensedJson(RecordObject);
+	Line.AppendChar(TEXT('\n'));
+	return Line;
 }
 
-bool UMCPChangeSetSubsystem::GetChangeSet(
-	const FString& ChangeSetId,
-	const bool bIncludeLogs,
-	const bool bIncludeSnapshots,
-	TSharedPtr<FJsonObject>& OutResult,
-	FMCPDiagnostic& OutDiagnostic) const
+void UMCPChangeSetSubsystem::FlushPendingWrites() const
 {
-	const FString ChangeSetDir = BuildChangeSetDirectory(ChangeSetId);
-	const FString MetaPath = FPaths::Combine(ChangeSetDir, TEXT("meta.json"));
+	DrainPendingWrites();
+}
 
-	TSharedPtr<FJsonObject> MetaObject;
-	if (!ReadJsonFile(MetaPath, MetaObject))
+int32 UMCPChangeSetSubsystem::GetPendingWriteCount() const
+{
+	FScopeLock ScopeLock(&WriterGuard);
+	return PendingChangeSetIds.Num();
+}
+
+void UMCPChangeSetSubsystem::SchedulePendingWrites() const
+{
 	{
-		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_NOT_FOUND;
-		OutDiagnostic.Message = TEXT("Requested changeset does not exist.");
-		OutDiagnostic.Detail = ChangeSetId;
-		OutDiagnostic.Suggestion = TEXT("Run changeset.list and retry with a valid changeset_id.");
-		return false;
+		FScopeLock ScopeLock(&WriterGuard);
+		if (bWriterScheduled || bShuttingDown)
+		{
+			return;
+		}
+		bWriterScheduled = true;
+		++InFlightBackgroundTasks;
 	}
 
-	OutResult = MakeShared<FJsonObject>();
-	OutResult->SetStringField(TEXT("changeset_id"), ChangeSetId);
-	OutResult->SetObjectField(TEXT("meta"), MetaObject.ToSharedRef());
-
-	const TArray<TSharedPtr<FJsonValue>>* TouchedPackages = nullptr;
-	if (!MetaObject->TryGetArrayField(TEXT("touched_packages"), TouchedPackages) || TouchedPackages == nullptr)
+	const TWeakObjectPtr<const UMCPChangeSetSubsystem> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis]()
 	{
-		TArray<TSharedPtr<FJsonValue>> EmptyTouchedPackages;
-		OutResult->SetArrayField(TEXT("touched_packages"), EmptyTouchedPackages);
-	}
-	else
+		// Deinitialize waits for counted tasks, so the subsystem outlives every task scheduled before it.
+		if (const UMCPChangeSetSubsystem* ChangeSetSubsystem = WeakThis.Get())
+		{
+			if (!ChangeSetSubsystem->IsShuttingDown())
+			{
+				ChangeSetSubsystem->DrainPendingWrites();
+			}
+			ChangeSetSubsystem->FinishBackgroundTask();
+		}
+	});
+}
+
+bool UMCPChangeSetSubsystem::IsShuttingDown() const
+{
+	FScopeLock ScopeLock(&WriterGuard);
+	return bShuttingDown;
+}
+
+void UMCPChangeSetSubsystem::FinishBackgroundTask() const
+{
+	FScopeLock ScopeLock(&WriterGuard);
+	--InFlightBackgroundTasks;
+	if (InFlightBackgroundTasks == 0 && bShuttingDown && BackgroundTasksIdleEvent != nullptr)
 	{
-		OutResult->SetArrayField(TEXT("touched_packages"), *TouchedPackages);
+		BackgroundTasksIdleEvent->Trigger();
 	}
+}
 
-	TArray<TSharedPtr<FJsonValue>> Logs;
-	if (bIncludeLogs)
+void UMCPChangeSetSubsystem::DrainPendingWrites() const
+{
+	// Serializes the background writer with synchronous callers so records reach the index file in order.
+	FScopeLock DrainLock(&DrainGuard);
+
+	for (;;)
 	{
-		const FString LogFilePath = FPaths::Combine(ChangeSetDir, TEXT("logs.jsonl"));
-		FString RawLogs;
-		if (FFileHelper::LoadFileToString(RawLogs, *LogFilePath))
+		TArray<FPendingWrite> Batch;
 		{
-			TArray<FString> Lines;
-			RawLogs.ParseIntoArrayLines(Lines, true);
-			for (const FString& Line : Lines)
+			FScopeLock ScopeLock(&WriterGuard);
+			if (PendingWrites.Num() == 0)
 			{
-				TSharedPtr<FJsonObject> LogObject;
-				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
-				if (FJsonSerializer::Deserialize(Reader, LogObject) && LogObject.IsValid())
+				bWriterScheduled = false;
+				return;
+			}
+
+			const int32 BatchCount = FMath::Min(PendingWrites.Num(), MaxWriteBatchRecords);
+			Batch.Reserve(BatchCount);
+			for (int32 Index = 0; Index < BatchCount; ++Index)
+			{
+				Batch.Add(MoveTemp(PendingWrites[Index]));
+			}
+			PendingWrites.RemoveAt(0, BatchCount, false);
+		}
+
+		TArray<FIndexEntry> WrittenEntries;
+		WrittenEntries.Reserve(Batch.Num());
+		TSet<FString> FailedChangeSetIds;
+		bool bJournalAppended = false;
+		for (const FPendingWrite& Write : Batch)
+		{
+			FMCPJournalRecordLocation JournalLocation;
+			if (WritePendingRecord(Write, JournalLocation))
+			{
+				bJournalAppended |= JournalLocation.IsValid();
+				FIndexEntry& WrittenEntry = WrittenEntries.Add_GetRef(Write.IndexEntry);
+				WrittenEntry.JournalLocation = JournalLocation;
+				if (JournalLocation.IsValid())
 				{
-					Logs.Add(MakeShared<FJsonValueObject>(LogObject));
+					WrittenEntry.SizeBytes = FMCPChangeSetJournal::RecordHeaderBytes + JournalLocation.Length;
 				}
 			}
+			else
+			{
+				FailedChangeSetIds.Add(Write.ChangeSetId);
+				UE_LOG(LogUnrealMCP, Error, TEXT("Failed to persist changeset %s"), *Write.ChangeSetId);
+			}
 		}
-	}
-	OutResult->SetArrayField(TEXT("logs"), Logs);
 
-	TArray<TSharedPtr<FJsonValue>> Snapshots;
-	if (bIncludeSnapshots)
-	{
-		const FString SnapshotDir = FPaths::Combine(ChangeSetDir, TEXT("snapshots"));
-		TArray<FString> SnapshotFiles;
-		IFileManager::Get().FindFiles(SnapshotFiles, *(FPaths::Combine(SnapshotDir, TEXT("*.before"))), true, false);
-		for (const FString& SnapshotFile : SnapshotFiles)
+		// Journaled records become durable with one flush per batch, before the index points at them.
+		if (bJournalAppended && Journal.IsValid() && !Journal->Flush())
 		{
-			Snapshots.Add(MakeShared<FJsonValueString>(FPaths::Combine(SnapshotDir, SnapshotFile)));
+			UE_LOG(LogUnrealMCP, Error, TEXT("Failed to flush changeset journal; dropping %d record(s) from the index"), WrittenEntries.Num());
+			for (const FIndexEntry& WrittenEntry : WrittenEntries)
+			{
+				FailedChangeSetIds.Add(WrittenEntry.ChangeSetId);
+			}
+			WrittenEntries.Reset();
+		}
+
+		FString IndexLines;
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			for (const FIndexEntry& WrittenEntry : WrittenEntries)
+			{
+				IndexLines += MakeIndexRecordLine(WrittenEntry);
+				if (const int32* Position = EntriesById.Find(WrittenEntry.ChangeSetId))
+				{
+					IndexEntries[*Position].JournalLocation = WrittenEntry.JournalLocation;
+					IndexEntries[*Position].SizeBytes = WrittenEntry.SizeBytes;
+				}
+			}
+
+			// Records that never reached disk were listed when they were created; unlist them so list,
+			// get and rollback stop offering a changeset that does not exist.
+			if (FailedChangeSetIds.Num() > 0)
+			{
+				IndexEntries.RemoveAll([&FailedChangeSetIds](const FIndexEntry& Entry)
+				{
+					return FailedChangeSetIds.Contains(Entry.ChangeSetId);
+				});
+				RebuildSecondaryIndexesLocked();
+			}
+		}
+		ReportWriteFailures(FailedChangeSetIds.Num());
+
+		// One flushed append commits the whole batch to the index. The records stay pending until the
+		// append is done, so a concurrent rewrite either includes them or runs before they are appended.
+		FScopeLock IndexFileLock(&IndexFileGuard);
+		if (!IndexLines.IsEmpty() && !AppendIndexLines(IndexLines))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to append %d changeset index record(s); the index will be rebuilt on next load."), Batch.Num());
+		}
+
+		{
+			FScopeLock ScopeLock(&WriterGuard);
+			for (const FPendingWrite& Write : Batch)
+			{
+				PendingChangeSetIds.Remove(Write.ChangeSetId);
+			}
+		}
+
+		bool bRewriteIndexFile = false;
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			bRewriteIndexFile = bIndexFileDirty;
+		}
+		if (bRewriteIndexFile && !RewriteIndexFile())
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write changeset index: %s"), *GetChangeSetIndexPath());
 		}
 	}
-	OutResult->SetArrayField(TEXT("snapshots"), Snapshots);
-	return true;
 }
 
-bool UMCPChangeSetSubsystem::PreviewRollback(
-	const FString& ChangeSetId,
-	const FString& Mode,
-	TSharedPtr<FJsonObject>& OutResult,
-	FMCPDiagnostic& OutDiagnostic) const
+bool UMCPChangeSetSubsystem::WritePendingRecord(const FPendingWrite& Write, FMCPJournalRecordLocation& OutJournalLocation) const
 {
-	TSharedPtr<FJsonObject> ChangeSetInfo;
-	if (!GetChangeSet(ChangeSetId, false, true, ChangeSetInfo, OutDiagnostic))
+	OutJournalLocation = FMCPJournalRecordLocation();
+	if (Write.bJournal && Journal.IsValid())
 	{
-		return false;
+		// Meta and snapshot refs are already serialized JSON objects, so the record is assembled without reparsing.
+		FString SnapshotRefs;
+		for (const TPair<FString, FString>& SnapshotRef : Write.SnapshotRefs)
+		{
+			if (!SnapshotRefs.IsEmpty())
+			{
+				SnapshotRefs.AppendChar(TEXT(','));
+			}
+			SnapshotRefs += SnapshotRef.Value;
+		}
+
+		const FString Payload = FString::Printf(
+			TEXT("{\"changeset_id\":\"%s\",\"meta\":%s,\"logs\":[],\"domain_diffs\":[],\"snapshots\":[%s]}"),
+			*Write.ChangeSetId,
+			*Write.MetaJson,
+			*SnapshotRefs);
+		return Journal->Append(Payload, OutJournalLocation);
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* PackageValues = nullptr;
-	ChangeSetInfo->TryGetArrayField(TEXT("touched_packages"), PackageValues);
-	TArray<TSharedPtr<FJsonValue>> PackageValuesCopy = PackageValues != nullptr ? *PackageValues : TArray<TSharedPtr<FJsonValue>>();
+	const FString ChangeSetDir = BuildChangeSetDirectory(Write.ChangeSetId);
+	const FString SnapshotDir = FPaths::Combine(ChangeSetDir, TEXT("snapshots"));
 
-	TArray<TSharedPtr<FJsonValue>> MissingSnapshots;
-	if (Mode.Equals(TEXT("local_snapshot"), ESearchCase::IgnoreCase))
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FileManager.MakeDirectory(*SnapshotDir, true) || !FileManager.MakeDirectory(*FPaths::Combine(ChangeSetDir, TEXT("domain_diffs")), true))
 	{
-		const TArray<TSharedPtr<FJsonValue>>* ExistingSnapshots = nullptr;
-		ChangeSetInfo->TryGetArrayField(TEXT("snapshots"), ExistingSnapshots);
-		const int32 SnapshotCount = ExistingSnapshots != nullptr ? ExistingSnapshots->Num() : 0;
-		if (SnapshotCount == 0 && PackageValuesCopy.Num() > 0)
-		{
-			MissingSnapshots = PackageValuesCopy;
-		}
+		return false;
 	}
 
-	OutResult = MakeShared<FJsonObject>();
-	OutResult->SetStringField(TEXT("changeset_id"), ChangeSetId);
+	if (!FFileHelper::SaveStringToFile(Write.MetaJson, *FPaths::Combine(ChangeSetDir, TEXT("meta.json")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		return false;
+	}
+	FFileHelper::SaveStringToFile(TEXT(""), *FPaths::Combine(ChangeSetDir, TEXT("logs.jsonl")), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+	for (const TPair<FString, FString>& SnapshotRef : Write.SnapshotRefs)
+	{
+		const FString SnapshotPath = FPaths::Combine(SnapshotDir, SnapshotRef.Key);
+		if (!FFileHelper::SaveStringToFile(SnapshotRef.Value, *SnapshotPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write snapshot ref %s for changeset %s"), *SnapshotPath, *Write.ChangeSetId);
+		}
+	}
+	return true;
+}
+
+void UMCPChangeSetSubsystem::WaitForPendingWrite(const FString& ChangeSetId) const
+{
+	{
+		FScopeLock ScopeLock(&WriterGuard);
+		if (!PendingChangeSetIds.Contains(ChangeSetId))
+		{
+			return;
+		}
+	}
+
+	FlushPendingWrites();
+}
+
+bool UMCPChangeSetSubsystem::ListChangeSets(
+	const FMCPChangeSetListQuery& Query,
+	TArray<TSharedPtr<FJsonObject>>& OutItems,
+	FString& OutNextSortKey,
+	FMCPDiagnostic& OutDiagnostic) const
+{
+	OutItems.Reset();
+	OutNextSortKey.Reset();
+
+	FScopeLock ScopeLock(&IndexGuard);
+	EnsureIndexLoadedLocked();
+
+	// Walk the most selective position list; every list is in ascending sort key order.
+	static const TArray<int32> EmptyPositions;
+	const TArray<int32>* CandidatePositions = nullptr;
+	auto ConsiderPositions = [&CandidatePositions](const TArray<int32>* Positions)
+	{
+		const TArray<int32>* SafePositions = Positions != nullptr ? Positions : &EmptyPositions;
+		if (CandidatePositions == nullptr || SafePositions->Num() < CandidatePositions->Num())
+		{
+			CandidatePositions = SafePositions;
+		}
+	};
+
+	if (!Query.SessionId.IsEmpty())
+	{
+		ConsiderPositions(EntriesBySession.Find(Query.SessionId));
+	}
+	if (Query.StatusFilter.Num() == 1)
+	{
+		ConsiderPositions(EntriesByStatus.Find(Query.StatusFilter[0]));
+	}
+	if (!Query.ToolGlob.IsEmpty() && !HasGlobWildcard(Query.ToolGlob))
+	{
+		ConsiderPositions(EntriesByTool.Find(Query.ToolGlob));
+	}
+
+	const int32 CandidateCount = CandidatePositions != nullptr ? CandidatePositions->Num() : IndexEntries.Num();
+	auto GetEntryAt = [this, CandidatePositions](const int32 CandidateIndex) -> const FIndexEntry&
+	{
+		return IndexEntries[CandidatePositions != nullptr ? (*CandidatePositions)[CandidateIndex] : CandidateIndex];
+	};
+
+	int32 CandidateIndex = CandidateCount - 1;
+	if (!Query.AfterSortKey.IsEmpty())
+	{
+		int32 Low = 0;
+		int32 High = CandidateCount;
+		while (Low < High)
+		{
+			const int32 Mid = Low + (High - Low) / 2;
+			if (GetEntryAt(Mid).SortKey < Query.AfterSortKey)
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		CandidateIndex = Low - 1;
+	}
+
+	const int32 SafeLimit = FMath::Clamp(Query.Limit, 1, 200);
+	int32 SkippedCount = 0;
+	FString LastReturnedSortKey;
+	for (; CandidateIndex >= 0; --CandidateIndex)
+	{
+		const FIndexEntry& Entry = GetEntryAt(CandidateIndex);
+		if (Query.StatusFilter.Num() > 0 && !Query.StatusFilter.Contains(Entry.Status))
+		{
+			continue;
+		}
+		if (!Query.ToolGlob.IsEmpty() && !Entry.Tool.MatchesWildcard(Query.ToolGlob))
+		{
+			continue;
+		}
+		if (!Query.SessionId.IsEmpty() && Entry.SessionId != Query.SessionId)
+		{
+			continue;
+		}
+		if (SkippedCount < Query.Offset)
+		{
+			++SkippedCount;
+			continue;
+		}
+
+		if (OutItems.Num() >= SafeLimit)
+		{
+			OutNextSortKey = LastReturnedSortKey;
+			break;
+		}
+
+		TSharedRef<FJsonObject> Item = MakeShared<FJsonObject>();
+		Item->SetStringField(TEXT("changeset_id"), Entry.ChangeSetId);
+		Item->SetStringField(TEXT("created_at"), Entry.CreatedAt);
+		Item->SetStringField(TEXT("tool"), Entry.Tool);
+		Item->SetStringField(TEXT("status"), Entry.Status);
+		Item->SetStringField(TEXT("request_id"), Entry.RequestId);
+		OutItems.Add(Item);
+		LastReturnedSortKey = Entry.SortKey;
+	}
+
+	return true;
+}
+
+bool UMCPChangeSetSubsystem::GetChangeSet(
+	const FString& ChangeSetId,
+	const bool bIncludeLogs,
+	const bool bIncludeSnapshots,
+	TSharedPtr<FJsonObject>& OutResult,
+	FMCPDiagnostic& OutDiagnostic) const
+{
+	WaitForPendingWrite(ChangeSetId);
+
+	// Journaled records are served by a single positioned read; older records still live in directories.
+	TSharedPtr<FJsonObject> JournalRecord;
+	const bool bJournaled = ReadJournalRecord(ChangeSetId, JournalRecord);
+	const FString ChangeSetDir = BuildChangeSetDirectory(ChangeSetId);
+
+	TSharedPtr<FJsonObject> MetaObject;
+	const TSharedPtr<FJsonObject>* JournalMetaObject = nullptr;
+	if (bJournaled)
+	{
+		if (JournalRecord->TryGetObjectField(TEXT("meta"), JournalMetaObject) && JournalMetaObject != nullptr)
+		{
+			MetaObject = *JournalMetaObject;
+		}
+	}
+	else
+	{
+		ReadJsonFile(FPaths::Combine(ChangeSetDir, TEXT("meta.json")), MetaObject);
+	}
+
+	if (!MetaObject.IsValid())
+	{
+		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_NOT_FOUND;
+		OutDiagnostic.Message = TEXT("Requested changeset does not exist.");
+		OutDiagnostic.Detail = ChangeSetId;
+		OutDiagnostic.Suggestion = TEXT("Run changeset.list and retry with a valid changeset_id.");
+		return false;
+	}
+
+	OutResult = MakeShared<FJsonObject>();
+	OutResult->SetStringField(TEXT("changeset_id"), ChangeSetId);
+	OutResult->SetObjectField(TEXT("meta"), MetaObject.ToSharedRef());
+
+	const TArray<TSharedPtr<FJsonValue>>* TouchedPackages = nullptr;
+	if (!MetaObject->TryGetArrayField(TEXT("touched_packages"), TouchedPackages) || TouchedPackages == nullptr)
+	{
+		TArray<TSharedPtr<FJsonValue>> EmptyTouchedPackages;
+		OutResult->SetArrayField(TEXT("touched_packages"), EmptyTouchedPackages);
+	}
+	else
+	{
+		OutResult->SetArrayField(TEXT("touched_packages"), *TouchedPackages);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Logs;
+	if (bIncludeLogs && bJournaled)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* JournalLogs = nullptr;
+		if (JournalRecord->TryGetArrayField(TEXT("logs"), JournalLogs) && JournalLogs != nullptr)
+		{
+			Logs = *JournalLogs;
+		}
+	}
+	else if (bIncludeLogs)
+	{
+		const FString LogFilePath = FPaths::Combine(ChangeSetDir, TEXT("logs.jsonl"));
+		FString RawLogs;
+		if (FFileHelper::LoadFileToString(RawLogs, *LogFilePath))
+		{
+			TArray<FString> Lines;
+			RawLogs.ParseIntoArrayLines(Lines, true);
+			for (const FString& Line : Lines)
+			{
+				TSharedPtr<FJsonObject> LogObject;
+				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+				if (FJsonSerializer::Deserialize(Reader, LogObject) && LogObject.IsValid())
+				{
+					Logs.Add(MakeShared<FJsonValueObject>(LogObject));
+				}
+			}
+		}
+	}
+	OutResult->SetArrayField(TEXT("logs"), Logs);
+
+	TArray<TSharedPtr<FJsonValue>> Snapshots;
+	if (bIncludeSnapshots && bJournaled)
+	{
+		// Journaled snapshot refs have no file of their own; report the blob each one points at.
+		const UMCPSnapshotStoreSubsystem* SnapshotStore = GEditor ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* SnapshotRefs = nullptr;
+		if (SnapshotStore != nullptr && JournalRecord->TryGetArrayField(TEXT("snapshots"), SnapshotRefs) && SnapshotRefs != nullptr)
+		{
+			for (const TSharedPtr<FJsonValue>& SnapshotRef : *SnapshotRefs)
+			{
+				const TSharedPtr<FJsonObject>* SnapshotObject = nullptr;
+				FString BlobHash;
+				if (SnapshotRef.IsValid() && SnapshotRef->TryGetObject(SnapshotObject) && SnapshotObject != nullptr
+					&& (*SnapshotObject)->TryGetStringField(TEXT("blob"), BlobHash) && !BlobHash.IsEmpty())
+				{
+					Snapshots.Add(MakeShared<FJsonValueString>(SnapshotStore->GetBlobPath(BlobHash)));
+				}
+			}
+		}
+	}
+	else if (bIncludeSnapshots)
+	{
+		const FString SnapshotDir = FPaths::Combine(ChangeSetDir, TEXT("snapshots"));
+		TArray<FString> SnapshotFiles;
+		IFileManager::Get().FindFiles(SnapshotFiles, *(FPaths::Combine(SnapshotDir, TEXT("*.before"))), true, false);
+		for (const FString& SnapshotFile : SnapshotFiles)
+		{
+			Snapshots.Add(MakeShared<FJsonValueString>(FPaths::Combine(SnapshotDir, SnapshotFile)));
+		}
+	}
+	OutResult->SetArrayField(TEXT("snapshots"), Snapshots);
+	return true;
+}
+
+bool UMCPChangeSetSubsystem::PreviewRollback(
+	const FString& ChangeSetId,
+	const FString& Mode,
+	TSharedPtr<FJsonObject>& OutResult,
+	FMCPDiagnostic& OutDiagnostic) const
+{
+	TSharedPtr<FJsonObject> ChangeSetInfo;
+	if (!GetChangeSet(ChangeSetId, false, true, ChangeSetInfo, OutDiagnostic))
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* PackageValues = nullptr;
+	ChangeSetInfo->TryGetArrayField(TEXT("touched_packages"), PackageValues);
+	TArray<TSharedPtr<FJsonValue>> PackageValuesCopy = PackageValues != nullptr ? *PackageValues : TArray<TSharedPtr<FJsonValue>>();
+
+	TArray<TSharedPtr<FJsonValue>> MissingSnapshots;
+	if (Mode.Equals(TEXT("local_snapshot"), ESearchCase::IgnoreCase))
+	{
+		const UMCPSnapshotStoreSubsystem* SnapshotStore = GEditor ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+		TMap<FString, TSharedPtr<FJsonObject>> SnapshotsByPackage;
+		LoadSnapshotRefs(ChangeSetId, SnapshotsByPackage);
+		for (const TSharedPtr<FJsonValue>& PackageValue : PackageValuesCopy)
+		{
+			FString PackageName;
+			if (!PackageValue.IsValid() || !PackageValue->TryGetString(PackageName))
+			{
+				continue;
+			}
+
+			// Packages created by the changeset have no prior contents to restore.
+			const TSharedPtr<FJsonObject>* SnapshotObject = SnapshotsByPackage.Find(PackageName);
+			FString BlobHash;
+			if (SnapshotObject == nullptr
+				|| !(*SnapshotObject)->TryGetStringField(TEXT("blob"), BlobHash)
+				|| SnapshotStore == nullptr
+				|| !SnapshotStore->HasBlob(BlobHash))
+			{
+				MissingSnapshots.Add(PackageValue);
+			}
+		}
+	}
+
+	OutResult = MakeShared<FJsonObject>();
+	OutResult->SetStringField(TEXT("changeset_id"), ChangeSetId);
 	OutResult->SetStringField(TEXT("mode"), Mode);
 
 	TSharedRef<FJsonObject> ImpactObject = MakeShared<FJsonObject>();
@@ -351,39 +980,1174 @@ bool UMCPChangeSetSubsystem::ApplyRollback(
 		return true;
 	}
 
-	OutDiagnostic.Code = MCPErrorCodes::CHANGESET_ROLLBACK_FAILED;
-	OutDiagnostic.Message = TEXT("Rollback apply is not fully implemented for non-empty changesets yet.");
-	OutDiagnostic.Detail = FString::Printf(TEXT("changeset_id=%s package_count=%d"), *ChangeSetId, OutTouchedPackages.Num());
-	OutDiagnostic.Suggestion = TEXT("Use VCS-based revert or implement package snapshot restore.");
-	return false;
+	UMCPSnapshotStoreSubsystem* SnapshotStore = GEditor ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+	if (SnapshotStore == nullptr)
+	{
+		OutDiagnostic.Code = MCPErrorCodes::INTERNAL_EXCEPTION;
+		OutDiagnostic.Message = TEXT("Snapshot store subsystem is unavailable.");
+		return false;
+	}
+
+	TSet<FString> MissingPackages;
+	if (MissingSnapshots != nullptr)
+	{
+		for (const TSharedPtr<FJsonValue>& MissingValue : *MissingSnapshots)
+		{
+			FString MissingPackage;
+			if (MissingValue.IsValid() && MissingValue->TryGetString(MissingPackage))
+			{
+				MissingPackages.Add(MissingPackage);
+			}
+		}
+	}
+
+	TMap<FString, TSharedPtr<FJsonObject>> SnapshotsByPackage;
+	LoadSnapshotRefs(ChangeSetId, SnapshotsByPackage);
+
+	struct FRestoreTarget
+	{
+		FString PackageName;
+		FString Filename;
+	};
+
+	// Every file is staged before any package is touched, so a missing blob or full disk leaves the project unchanged.
+	TArray<FRestoreTarget> RestoreTargets;
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	for (const FString& PackageName : OutTouchedPackages)
+	{
+		const TSharedPtr<FJsonObject>* SnapshotObject = SnapshotsByPackage.Find(PackageName);
+		if (MissingPackages.Contains(PackageName) || SnapshotObject == nullptr)
+		{
+			continue;
+		}
+
+		FString BlobHash;
+		FString RelativeFilename;
+		(*SnapshotObject)->TryGetStringField(TEXT("blob"), BlobHash);
+		(*SnapshotObject)->TryGetStringField(TEXT("file"), RelativeFilename);
+		const FRestoreTarget Target { PackageName, FPaths::ConvertRelativePathToFull(ProjectDir, RelativeFilename) };
+		if (!SnapshotStore->StageRestore(BlobHash, Target.Filename, OutDiagnostic))
+		{
+			for (const FRestoreTarget& StagedTarget : RestoreTargets)
+			{
+				SnapshotStore->DiscardRestore(StagedTarget.Filename);
+			}
+			OutDiagnostic.Detail = FString::Printf(TEXT("changeset_id=%s package=%s restored=0"), *ChangeSetId, *PackageName);
+			OutTouchedPackages.Reset();
+			return false;
+		}
+		RestoreTargets.Add(Target);
+	}
+
+	TArray<FString> RestoredPackages;
+	TArray<UPackage*> PackagesToReload;
+	FString FailedPackage;
+	for (int32 TargetIndex = 0; TargetIndex < RestoreTargets.Num(); ++TargetIndex)
+	{
+		const FRestoreTarget& Target = RestoreTargets[TargetIndex];
+
+		// Lets the router's capture record the current contents, so the rollback is itself reversible.
+		SnapshotStore->CapturePackage(Target.PackageName);
+
+		UPackage* LoadedPackage = FindPackage(nullptr, *Target.PackageName);
+		if (LoadedPackage != nullptr)
+		{
+			// Release the linker's file handle before the package file is replaced. The package is reloaded
+			// below even if the swap fails, because its loader is gone either way.
+			ResetLoaders(LoadedPackage);
+			PackagesToReload.Add(LoadedPackage);
+		}
+
+		if (!SnapshotStore->CommitRestore(Target.Filename, OutDiagnostic))
+		{
+			FailedPackage = Target.PackageName;
+			for (int32 RemainingIndex = TargetIndex + 1; RemainingIndex < RestoreTargets.Num(); ++RemainingIndex)
+			{
+				SnapshotStore->DiscardRestore(RestoreTargets[RemainingIndex].Filename);
+			}
+			break;
+		}
+		RestoredPackages.Add(Target.PackageName);
+	}
+
+	FText ReloadErrorMessage;
+	const bool bReloaded = PackagesToReload.Num() == 0
+		|| UPackageTools::ReloadPackages(PackagesToReload, ReloadErrorMessage, UPackageTools::EReloadPackagesInteractionMode::AssumePositive);
+	OutTouchedPackages = RestoredPackages;
+
+	if (!FailedPackage.IsEmpty())
+	{
+		OutDiagnostic.Detail = FString::Printf(
+			TEXT("changeset_id=%s package=%s restored=%d restored_packages=%s"),
+			*ChangeSetId,
+			*FailedPackage,
+			RestoredPackages.Num(),
+			*FString::Join(RestoredPackages, TEXT(",")));
+		if (!bReloaded)
+		{
+			OutDiagnostic.Suggestion = TEXT("Restart the editor to pick up the restored packages.");
+		}
+		return false;
+	}
+
+	if (!bReloaded)
+	{
+		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_ROLLBACK_FAILED;
+		OutDiagnostic.Message = TEXT("Package files were restored but reloading them failed.");
+		OutDiagnostic.Detail = ReloadErrorMessage.ToString();
+		OutDiagnostic.Suggestion = TEXT("Restart the editor to pick up the restored packages.");
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Rolled back changeset %s: restored %d package(s), reloaded %d"), *ChangeSetId, RestoredPackages.Num(), PackagesToReload.Num());
+	OutTouchedPackages = RestoredPackages;
+	bOutApplied = true;
+	return true;
 }
 
-FString UMCPChangeSetSubsystem::GetChangeSetRootDir() const
+FString UMCPChangeSetSubsystem::GetChangeSetIndexPath() const
 {
-	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/ChangeSets"));
+	// Kept outside the changeset root so rewriting it never bumps the root directory timestamp used for staleness.
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/ChangeSetIndex.jsonl"));
 }
 
-FString UMCPChangeSetSubsystem::BuildChangeSetDirectory(const FString& ChangeSetId) const
+FString UMCPChangeSetSubsystem::GetChangeSetJournalDir() const
 {
-	return FPaths::Combine(GetChangeSetRootDir(), ChangeSetId);
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/ChangeSetJournal"));
 }
 
-bool UMCPChangeSetSubsystem::ReadJsonFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson) const
+FString UMCPChangeSetSubsystem::GetChangeSetLocation(const FString& ChangeSetId) const
 {
-	FString Content;
-	if (!FFileHelper::LoadFileToString(Content, *FilePath))
+	FMCPJournalRecordLocation JournalLocation;
+	return bJournalStorage || FindJournalLocation(ChangeSetId, JournalLocation)
+		? GetChangeSetJournalDir()
+		: BuildChangeSetDirectory(ChangeSetId);
+}
+
+void UMCPChangeSetSubsystem::EnsureIndexLoadedLocked() const
+{
+	if (bIndexLoaded)
 	{
-		return false;
+		return;
 	}
+	bIndexLoaded = true;
 
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
-	return FJsonSerializer::Deserialize(Reader, OutJson) && OutJson.IsValid();
+	// Changeset directories or journal segments changed behind our back are newer than the index.
+	IFileManager& FileManager = IFileManager::Get();
+	const FString RootDir = GetChangeSetRootDir();
+	const FDateTime IndexTimeStamp = FileManager.GetTimeStamp(*GetChangeSetIndexPath());
+	const FDateTime RootTimeStamp = FileManager.GetTimeStamp(*RootDir);
+	const bool bIndexMissing = IndexTimeStamp == FDateTime::MinValue();
+	// A journal-only store never creates the changeset root, so a missing root only means the records
+	// were wiped when the journal is empty too.
+	const bool bJournalEmpty = !Journal.IsValid() || Journal->GetSegmentIds().Num() == 0;
+	const bool bIndexStale = (!FileManager.DirectoryExists(*RootDir) && bJournalEmpty)
+		|| RootTimeStamp > IndexTimeStamp
+		|| (Journal.IsValid() && Journal->GetLatestTimeStamp() > IndexTimeStamp);
+	if (bIndexMissing || bIndexStale || !LoadIndexFileLocked())
+	{
+		RebuildIndexLocked();
+	}
 }
 
-bool UMCPChangeSetSubsystem::WriteJsonFile(const FString& FilePath, const TSharedRef<FJsonObject>& JsonObject) const
+bool UMCPChangeSetSubsystem::LoadIndexFileLocked() const
+{
+	FString RawIndex;
+	if (!FFileHelper::LoadFileToString(RawIndex, *GetChangeSetIndexPath()))
+	{
+		return false;
+	}
+
+	TArray<FString> Lines;
+	RawIndex.ParseIntoArrayLines(Lines, true);
+	if (Lines.Num() == 0)
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> HeaderObject;
+	int32 IndexVersion = 0;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Lines[0]), HeaderObject)
+		|| !HeaderObject.IsValid()
+		|| !HeaderObject->TryGetNumberField(TEXT("index_version"), IndexVersion)
+		|| IndexVersion != ChangeSetIndexVersion)
+	{
+		return false;
+	}
+
+	IndexEntries.Reset(Lines.Num() - 1);
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TSharedPtr<FJsonObject> RecordObject;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Lines[LineIndex]), RecordObject) || !RecordObject.IsValid())
+		{
+			// A torn final line from a crash mid-append is dropped; the directory still holds the record.
+			continue;
+		}
+
+		FIndexEntry& Entry = IndexEntries.AddDefaulted_GetRef();
+		RecordObject->TryGetStringField(TEXT("changeset_id"), Entry.ChangeSetId);
+		RecordObject->TryGetStringField(TEXT("request_id"), Entry.RequestId);
+		RecordObject->TryGetStringField(TEXT("session_id"), Entry.SessionId);
+		RecordObject->TryGetStringField(TEXT("tool"), Entry.Tool);
+		RecordObject->TryGetStringField(TEXT("status"), Entry.Status);
+		RecordObject->TryGetStringField(TEXT("created_at"), Entry.CreatedAt);
+		double CreatedAtMs = 0.0;
+		RecordObject->TryGetNumberField(TEXT("created_at_ms"), CreatedAtMs);
+		Entry.CreatedAtMs = static_cast<int64>(CreatedAtMs);
+		double Sequence = 0.0;
+		RecordObject->TryGetNumberField(TEXT("sequence"), Sequence);
+		Entry.Sequence = static_cast<int64>(Sequence);
+		Entry.SortKey = MakeIndexSortKey(Entry.CreatedAtMs, Entry.Sequence, Entry.ChangeSetId);
+
+		double SizeBytes = 0.0;
+		RecordObject->TryGetNumberField(TEXT("size_bytes"), SizeBytes);
+		Entry.SizeBytes = static_cast<int64>(SizeBytes);
+		RecordObject->TryGetStringArrayField(TEXT("blobs"), Entry.BlobHashes);
+
+		int32 JournalSegment = INDEX_NONE;
+		double JournalOffset = 0.0;
+		int32 JournalLength = 0;
+		if (RecordObject->TryGetNumberField(TEXT("journal_segment"), JournalSegment)
+			&& RecordObject->TryGetNumberField(TEXT("journal_offset"), JournalOffset)
+			&& RecordObject->TryGetNumberField(TEXT("journal_length"), JournalLength))
+		{
+			Entry.JournalLocation.SegmentId = JournalSegment;
+			Entry.JournalLocation.Offset = static_cast<int64>(JournalOffset);
+			Entry.JournalLocation.Length = JournalLength;
+		}
+	}
+
+	IndexEntries.Sort([](const FIndexEntry& Left, const FIndexEntry& Right)
+	{
+		return Left.SortKey < Right.SortKey;
+	});
+	RebuildSecondaryIndexesLocked();
+	return true;
+}
+
+void UMCPChangeSetSubsystem::RebuildIndexLocked() const
+{
+	const uint64 RebuildStartCycles = MCPTime::NowCycles();
+	IndexEntries.Reset();
+
+	const FString RootDir = GetChangeSetRootDir();
+	TArray<FString> Directories;
+	if (IFileManager::Get().DirectoryExists(*RootDir))
+	{
+		IFileManager::Get().FindFiles(Directories, *(FPaths::Combine(RootDir, TEXT("*"))), false, true);
+	}
+
+	auto AddEntryFromMeta = [this](const TSharedPtr<FJsonObject>& MetaObject, const FMCPJournalRecordLocation& JournalLocation, const int64 SizeBytes, TArray<FString>&& BlobHashes)
+	{
+		FIndexEntry& Entry = IndexEntries.AddDefaulted_GetRef();
+		MetaObject->TryGetStringField(TEXT("changeset_id"), Entry.ChangeSetId);
+		MetaObject->TryGetStringField(TEXT("request_id"), Entry.RequestId);
+		MetaObject->TryGetStringField(TEXT("session_id"), Entry.SessionId);
+		MetaObject->TryGetStringField(TEXT("tool"), Entry.Tool);
+		MetaObject->TryGetStringField(TEXT("status"), Entry.Status);
+		MetaObject->TryGetStringField(TEXT("created_at"), Entry.CreatedAt);
+
+		double CreatedAtMs = 0.0;
+		FDateTime ParsedCreatedAt;
+		if (MetaObject->TryGetNumberField(TEXT("created_at_ms"), CreatedAtMs))
+		{
+			Entry.CreatedAtMs = static_cast<int64>(CreatedAtMs);
+		}
+		else if (FDateTime::ParseIso8601(*Entry.CreatedAt, ParsedCreatedAt))
+		{
+			Entry.CreatedAtMs = ToUnixMilliseconds(ParsedCreatedAt);
+		}
+		double Sequence = 0.0;
+		MetaObject->TryGetNumberField(TEXT("sequence"), Sequence);
+		Entry.Sequence = static_cast<int64>(Sequence);
+		Entry.SortKey = MakeIndexSortKey(Entry.CreatedAtMs, Entry.Sequence, Entry.ChangeSetId);
+		Entry.JournalLocation = JournalLocation;
+		Entry.SizeBytes = SizeBytes;
+		Entry.BlobHashes = MoveTemp(BlobHashes);
+	};
+
+	for (const FString& DirectoryName : Directories)
+	{
+		const FString ChangeSetDir = FPaths::Combine(RootDir, DirectoryName);
+		TSharedPtr<FJsonObject> MetaObject;
+		if (!ReadJsonFile(FPaths::Combine(ChangeSetDir, TEXT("meta.json")), MetaObject))
+		{
+			continue;
+		}
+
+		TArray<FString> BlobHashes;
+		const FString SnapshotDir = FPaths::Combine(ChangeSetDir, TEXT("snapshots"));
+		TArray<FString> SnapshotFiles;
+		IFileManager::Get().FindFiles(SnapshotFiles, *(FPaths::Combine(SnapshotDir, TEXT("*.before"))), true, false);
+		for (const FString& SnapshotFile : SnapshotFiles)
+		{
+			TSharedPtr<FJsonObject> SnapshotObject;
+			FString BlobHash;
+			if (ReadJsonFile(FPaths::Combine(SnapshotDir, SnapshotFile), SnapshotObject)
+				&& SnapshotObject->TryGetStringField(TEXT("blob"), BlobHash)
+				&& !BlobHash.IsEmpty())
+			{
+				BlobHashes.AddUnique(BlobHash);
+			}
+		}
+		AddEntryFromMeta(MetaObject, FMCPJournalRecordLocation(), ComputeDirectorySizeBytes(ChangeSetDir), MoveTemp(BlobHashes));
+	}
+
+	if (Journal.IsValid())
+	{
+		// A compaction interrupted before its old segment was deleted leaves two copies; the later one wins.
+		TMap<FString, int32> JournalEntryPositions;
+		TSet<FString> TombstonedChangeSetIds;
+		Journal->ForEachRecord([this, &AddEntryFromMeta, &JournalEntryPositions, &TombstonedChangeSetIds](const FMCPJournalRecordLocation& Location, const FString& Payload)
+		{
+			FString TombstonedChangeSetId;
+			int32 RecordSegmentId = INDEX_NONE;
+			if (TryParseJournalTombstone(Payload, TombstonedChangeSetId, RecordSegmentId))
+			{
+				TombstonedChangeSetIds.Add(TombstonedChangeSetId);
+				return;
+			}
+
+			TSharedPtr<FJsonObject> RecordObject;
+			const TSharedPtr<FJsonObject>* MetaObject = nullptr;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Payload), RecordObject)
+				|| !RecordObject.IsValid()
+				|| !RecordObject->TryGetObjectField(TEXT("meta"), MetaObject)
+				|| MetaObject == nullptr)
+			{
+				return;
+			}
+
+			FString ChangeSetId;
+			RecordObject->TryGetStringField(TEXT("changeset_id"), ChangeSetId);
+			if (const int32* ExistingPosition = JournalEntryPositions.Find(ChangeSetId))
+			{
+				IndexEntries[*ExistingPosition].JournalLocation = Location;
+				return;
+			}
+
+			TArray<FString> BlobHashes;
+			const TArray<TSharedPtr<FJsonValue>>* SnapshotRefs = nullptr;
+			if (RecordObject->TryGetArrayField(TEXT("snapshots"), SnapshotRefs) && SnapshotRefs != nullptr)
+			{
+				CollectSnapshotBlobHashes(*SnapshotRefs, BlobHashes);
+			}
+
+			JournalEntryPositions.Add(ChangeSetId, IndexEntries.Num());
+			AddEntryFromMeta(*MetaObject, Location, FMCPChangeSetJournal::RecordHeaderBytes + Location.Length, MoveTemp(BlobHashes));
+		});
+
+		// Applied after the scan because a copy left by an interrupted compaction can follow its tombstone.
+		if (TombstonedChangeSetIds.Num() > 0)
+		{
+			IndexEntries.RemoveAll([&TombstonedChangeSetIds](const FIndexEntry& Entry)
+			{
+				return Entry.JournalLocation.IsValid() && TombstonedChangeSetIds.Contains(Entry.ChangeSetId);
+			});
+		}
+	}
+
+	IndexEntries.Sort([](const FIndexEntry& Left, const FIndexEntry& Right)
+	{
+		return Left.SortKey < Right.SortKey;
+	});
+	RebuildSecondaryIndexesLocked();
+
+	// IndexFileGuard is normally taken before IndexGuard, so only try for it here. If the writer or a
+	// rewrite holds it, the file is marked dirty and that thread rewrites it once it gets IndexGuard.
+	if (IndexFileGuard.TryLock())
+	{
+		bIndexFileDirty = false;
+		if (!WriteIndexFile(BuildIndexFileContentLocked()))
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write changeset index: %s"), *GetChangeSetIndexPath());
+		}
+		IndexFileGuard.Unlock();
+	}
+	else
+	{
+		bIndexFileDirty = true;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Rebuilt changeset index: %d changesets in %.1f ms"),
+		IndexEntries.Num(), MCPTime::MicrosecondsToMilliseconds(MCPTime::MicrosecondsSince(RebuildStartCycles)));
+}
+
+bool UMCPChangeSetSubsystem::RewriteIndexFile() const
+{
+	// Only the snapshot is taken under IndexGuard; list and get are not blocked by the file write.
+	FScopeLock IndexFileLock(&IndexFileGuard);
+	FString IndexContent;
+	{
+		FScopeLock ScopeLock(&IndexGuard);
+		EnsureIndexLoadedLocked();
+		IndexContent = BuildIndexFileContentLocked();
+		bIndexFileDirty = false;
+	}
+	return WriteIndexFile(IndexContent);
+}
+
+FString UMCPChangeSetSubsystem::BuildIndexFileContentLocked() const
+{
+	TSharedRef<FJsonObject> HeaderObject = MakeShared<FJsonObject>();
+	HeaderObject->SetNumberField(TEXT("index_version"), ChangeSetIndexVersion);
+	FString IndexContent = ToCondensedJson(HeaderObject);
+	IndexContent.AppendChar(TEXT('\n'));
+
+	// Queued records are appended by the writer once they are on disk.
+	TSet<FString> UnwrittenChangeSetIds;
+	{
+		FScopeLock WriterLock(&WriterGuard);
+		UnwrittenChangeSetIds = PendingChangeSetIds;
+	}
+	for (const FIndexEntry& Entry : IndexEntries)
+	{
+		if (!UnwrittenChangeSetIds.Contains(Entry.ChangeSetId))
+		{
+			IndexContent += MakeIndexRecordLine(Entry);
+		}
+	}
+	return IndexContent;
+}
+
+bool UMCPChangeSetSubsystem::WriteIndexFile(const FString& IndexContent) const
+{
+	// Written aside and moved over the old index so readers never see a partial file.
+	const FString IndexPath = GetChangeSetIndexPath();
+	const FString TempIndexPath = IndexPath + TEXT(".tmp");
+	return FFileHelper::SaveStringToFile(IndexContent, *TempIndexPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		&& IFileManager::Get().Move(*IndexPath, *TempIndexPath, true, true);
+}
+
+void UMCPChangeSetSubsystem::AddIndexEntryLocked(FIndexEntry&& Entry) const
+{
+	if (IndexEntries.Num() == 0 || IndexEntries.Last().SortKey < Entry.SortKey)
+	{
+		const int32 Position = IndexEntries.Add(MoveTemp(Entry));
+		const FIndexEntry& Added = IndexEntries[Position];
+		EntriesByStatus.FindOrAdd(Added.Status).Add(Position);
+		EntriesByTool.FindOrAdd(Added.Tool).Add(Position);
+		EntriesBySession.FindOrAdd(Added.SessionId).Add(Position);
+		EntriesById.Add(Added.ChangeSetId, Position);
+		return;
+	}
+
+	// The wall clock stepped backwards; insert in order and renumber the secondary lists.
+	const int32 InsertIndex = Algo::LowerBoundBy(IndexEntries, Entry.SortKey, [](const FIndexEntry& Existing) -> const FString&
+	{
+		return Existing.SortKey;
+	});
+	IndexEntries.Insert(MoveTemp(Entry), InsertIndex);
+	RebuildSecondaryIndexesLocked();
+}
+
+void UMCPChangeSetSubsystem::RebuildSecondaryIndexesLocked() const
+{
+	EntriesByStatus.Reset();
+	EntriesByTool.Reset();
+	EntriesBySession.Reset();
+	EntriesById.Reset();
+	for (int32 Position = 0; Position < IndexEntries.Num(); ++Position)
+	{
+		const FIndexEntry& Entry = IndexEntries[Position];
+		EntriesByStatus.FindOrAdd(Entry.Status).Add(Position);
+		EntriesByTool.FindOrAdd(Entry.Tool).Add(Position);
+		EntriesBySession.FindOrAdd(Entry.SessionId).Add(Position);
+		EntriesById.Add(Entry.ChangeSetId, Position);
+	}
+}
+
+bool UMCPChangeSetSubsystem::AppendIndexLines(const FString& Lines) const
+{
+	FScopeLock IndexFileLock(&IndexFileGuard);
+	const FString IndexPath = GetChangeSetIndexPath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(IndexPath));
+
+	TUniquePtr<IFileHandle> IndexHandle(PlatformFile.OpenWrite(*IndexPath, true, false));
+	if (!IndexHandle.IsValid())
+	{
+		return false;
+	}
+
+	const FTCHARToUTF8 LinesUtf8(*Lines);
+	return IndexHandle->Write(reinterpret_cast<const uint8*>(LinesUtf8.Get()), LinesUtf8.Length())
+		&& IndexHandle->Flush(true);
+}
+
+FString UMCPChangeSetSubsystem::GetChangeSetRootDir() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/ChangeSets"));
+}
+
+FString UMCPChangeSetSubsystem::BuildChangeSetDirectory(const FString& ChangeSetId) const
+{
+	return FPaths::Combine(GetChangeSetRootDir(), ChangeSetId);
+}
+
+bool UMCPChangeSetSubsystem::ReadJsonFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson) const
 {
 	FString Content;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
-	FJsonSerializer::Serialize(JsonObject, Writer);
-	return FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	if (!FFileHelper::LoadFileToString(Content, *FilePath))
+	{
+		return false;
+	}
+
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	return FJsonSerializer::Deserialize(Reader, OutJson) && OutJson.IsValid();
+}
+
+bool UMCPChangeSetSubsystem::LoadSnapshotRefs(const FString& ChangeSetId, TMap<FString, TSharedPtr<FJsonObject>>& OutSnapshotsByPackage) const
+{
+	OutSnapshotsByPackage.Reset();
+
+	TSharedPtr<FJsonObject> JournalRecord;
+	if (ReadJournalRecord(ChangeSetId, JournalRecord))
+	{
+		const TArray<TSharedPtr<FJsonValue>>* SnapshotRefs = nullptr;
+		JournalRecord->TryGetArrayField(TEXT("snapshots"), SnapshotRefs);
+		if (SnapshotRefs != nullptr)
+		{
+			for (const TSharedPtr<FJsonValue>& SnapshotRef : *SnapshotRefs)
+			{
+				const TSharedPtr<FJsonObject>* SnapshotObject = nullptr;
+				FString PackageName;
+				if (SnapshotRef.IsValid() && SnapshotRef->TryGetObject(SnapshotObject) && SnapshotObject != nullptr
+					&& (*SnapshotObject)->TryGetStringField(TEXT("package"), PackageName))
+				{
+					OutSnapshotsByPackage.Add(PackageName, *SnapshotObject);
+				}
+			}
+		}
+		return OutSnapshotsByPackage.Num() > 0;
+	}
+
+	const FString SnapshotDir = FPaths::Combine(BuildChangeSetDirectory(ChangeSetId), TEXT("snapshots"));
+	TArray<FString> SnapshotFiles;
+	IFileManager::Get().FindFiles(SnapshotFiles, *(FPaths::Combine(SnapshotDir, TEXT("*.before"))), true, false);
+	for (const FString& SnapshotFile : SnapshotFiles)
+	{
+		TSharedPtr<FJsonObject> SnapshotObject;
+		FString PackageName;
+		if (ReadJsonFile(FPaths::Combine(SnapshotDir, SnapshotFile), SnapshotObject)
+			&& SnapshotObject->TryGetStringField(TEXT("package"), PackageName))
+		{
+			OutSnapshotsByPackage.Add(PackageName, SnapshotObject);
+		}
+	}
+	return OutSnapshotsByPackage.Num() > 0;
+}
+
+bool UMCPChangeSetSubsystem::FindJournalLocation(const FString& ChangeSetId, FMCPJournalRecordLocation& OutLocation) const
+{
+	FScopeLock ScopeLock(&IndexGuard);
+	EnsureIndexLoadedLocked();
+	const int32* Position = EntriesById.Find(ChangeSetId);
+	OutLocation = Position != nullptr ? IndexEntries[*Position].JournalLocation : FMCPJournalRecordLocation();
+	return OutLocation.IsValid();
+}
+
+bool UMCPChangeSetSubsystem::ReadJournalRecord(const FString& ChangeSetId, TSharedPtr<FJsonObject>& OutRecord) const
+{
+	FMCPJournalRecordLocation Location;
+	FString Payload;
+	if (!Journal.IsValid() || !FindJournalLocation(ChangeSetId, Location) || !Journal->Read(Location, Payload))
+	{
+		return false;
+	}
+
+	FString RecordChangeSetId;
+	return FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Payload), OutRecord)
+		&& OutRecord.IsValid()
+		&& OutRecord->TryGetStringField(TEXT("changeset_id"), RecordChangeSetId)
+		&& RecordChangeSetId == ChangeSetId;
+}
+
+bool UMCPChangeSetSubsystem::CompactJournal(int32& OutDeletedSegments, int64& OutReclaimedBytes) const
+{
+	OutDeletedSegments = 0;
+	OutReclaimedBytes = 0;
+	if (!Journal.IsValid())
+	{
+		return false;
+	}
+
+	// Deletes are held off for the whole pass so the live record snapshot stays valid. The writer is only
+	// excluded while planning and while one segment moves, so record writes are not stalled behind a pass.
+	FScopeLock GarbageCollectionLock(&GarbageCollectionGuard);
+
+	auto GetLiveBytes = [](const TArray<TPair<FString, FMCPJournalRecordLocation>>* LiveRecords)
+	{
+		int64 LiveBytes = 0;
+		if (LiveRecords != nullptr)
+		{
+			for (const TPair<FString, FMCPJournalRecordLocation>& LiveRecord : *LiveRecords)
+			{
+				LiveBytes += FMCPChangeSetJournal::RecordHeaderBytes + LiveRecord.Value.Length;
+			}
+		}
+		return LiveBytes;
+	};
+
+	// Planned under DrainGuard so every record already appended to a sealed segment is in the snapshot.
+	// Segments sealed later are newer than the active segment seen here and are left alone.
+	TMap<int32, TArray<TPair<FString, FMCPJournalRecordLocation>>> LiveRecordsBySegment;
+	TArray<int32> SegmentsToCompact;
+	int32 MinRetainedSegmentId = MAX_int32;
+	{
+		FScopeLock DrainLock(&DrainGuard);
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			EnsureIndexLoadedLocked();
+			for (const FIndexEntry& Entry : IndexEntries)
+			{
+				if (Entry.JournalLocation.IsValid())
+				{
+					LiveRecordsBySegment.FindOrAdd(Entry.JournalLocation.SegmentId).Emplace(Entry.ChangeSetId, Entry.JournalLocation);
+				}
+			}
+		}
+
+		// With no active segment only the sealed segments kept below bound it; anything appended later is newer.
+		const int32 ActiveSegmentId = Journal->GetActiveSegmentId();
+		if (ActiveSegmentId != INDEX_NONE)
+		{
+			MinRetainedSegmentId = ActiveSegmentId;
+		}
+		for (const int32 SegmentId : Journal->GetSegmentIds())
+		{
+			if (SegmentId == ActiveSegmentId)
+			{
+				continue;
+			}
+
+			const TArray<TPair<FString, FMCPJournalRecordLocation>>* LiveRecords = LiveRecordsBySegment.Find(SegmentId);
+			if (LiveRecords != nullptr && GetLiveBytes(LiveRecords) * 100 >= Journal->GetSegmentSizeBytes(SegmentId) * JournalCompactLivePercent)
+			{
+				MinRetainedSegmentId = FMath::Min(MinRetainedSegmentId, SegmentId);
+				continue;
+			}
+			SegmentsToCompact.Add(SegmentId);
+		}
+	}
+
+	int32 MovedRecordCount = 0;
+	int32 CarriedTombstones = 0;
+	bool bFlushFailed = false;
+	for (const int32 SegmentId : SegmentsToCompact)
+	{
+		FScopeLock DrainLock(&DrainGuard);
+		const TArray<TPair<FString, FMCPJournalRecordLocation>>* LiveRecords = LiveRecordsBySegment.Find(SegmentId);
+
+		bool bSegmentMoved = true;
+		TArray<TPair<FString, FMCPJournalRecordLocation>> MovedRecords;
+		if (LiveRecords != nullptr)
+		{
+			for (const TPair<FString, FMCPJournalRecordLocation>& LiveRecord : *LiveRecords)
+			{
+				FString Payload;
+				FMCPJournalRecordLocation NewLocation;
+				if (!Journal->Read(LiveRecord.Value, Payload) || !Journal->Append(Payload, NewLocation))
+				{
+					bSegmentMoved = false;
+					break;
+				}
+				MovedRecords.Emplace(LiveRecord.Key, NewLocation);
+			}
+		}
+
+		// A tombstone is still needed while a segment that may hold a copy of its record survives.
+		// Records only ever move to higher segments, so that is any retained segment at or below RecordSegmentId.
+		int32 SegmentTombstones = 0;
+		if (bSegmentMoved)
+		{
+			bool bTombstonesCarried = true;
+			const bool bSegmentRead = Journal->ForEachSegmentRecord(SegmentId, [this, MinRetainedSegmentId, &bTombstonesCarried, &SegmentTombstones](const FMCPJournalRecordLocation&, const FString& Payload)
+			{
+				FString TombstonedChangeSetId;
+				int32 RecordSegmentId = INDEX_NONE;
+				if (bTombstonesCarried
+					&& TryParseJournalTombstone(Payload, TombstonedChangeSetId, RecordSegmentId)
+					&& RecordSegmentId >= MinRetainedSegmentId)
+				{
+					FMCPJournalRecordLocation NewLocation;
+					bTombstonesCarried = Journal->Append(Payload, NewLocation);
+					SegmentTombstones += bTombstonesCarried ? 1 : 0;
+				}
+			});
+			bSegmentMoved = bSegmentRead && bTombstonesCarried;
+		}
+
+		if (bSegmentMoved && (MovedRecords.Num() > 0 || SegmentTombstones > 0) && !Journal->Flush())
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to flush changeset journal during compaction"));
+			bFlushFailed = true;
+			break;
+		}
+
+		if (!bSegmentMoved)
+		{
+			// Copies already appended are harmless duplicates; the index keeps pointing at the originals.
+			MinRetainedSegmentId = FMath::Min(MinRetainedSegmentId, SegmentId);
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Skipping compaction of changeset journal segment %d"), SegmentId);
+			continue;
+		}
+
+		if (MovedRecords.Num() > 0)
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			for (const TPair<FString, FMCPJournalRecordLocation>& MovedRecord : MovedRecords)
+			{
+				if (const int32* Position = EntriesById.Find(MovedRecord.Key))
+				{
+					IndexEntries[*Position].JournalLocation = MovedRecord.Value;
+				}
+			}
+		}
+		MovedRecordCount += MovedRecords.Num();
+		CarriedTombstones += SegmentTombstones;
+
+		const int64 SegmentBytes = Journal->GetSegmentSizeBytes(SegmentId);
+		if (Journal->DeleteSegment(SegmentId))
+		{
+			++OutDeletedSegments;
+			OutReclaimedBytes += FMath::Max<int64>(0, SegmentBytes - GetLiveBytes(LiveRecords));
+		}
+		else
+		{
+			MinRetainedSegmentId = FMath::Min(MinRetainedSegmentId, SegmentId);
+		}
+	}
+
+	if (OutDeletedSegments == 0)
+	{
+		return !bFlushFailed;
+	}
+
+	// Rewritten after the deletes so the index is newer than the journal directory.
+	const bool bIndexWritten = RewriteIndexFile();
+	if (!bIndexWritten)
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to rewrite changeset index after journal compaction; it will be rebuilt on next load."));
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Compacted changeset journal: deleted %d segment(s), moved %d record(s) and %d tombstone(s), reclaimed %lld bytes"),
+		OutDeletedSegments, MovedRecordCount, CarriedTombstones, OutReclaimedBytes);
+	return bIndexWritten && !bFlushFailed;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+void UMCPChangeSetSubsystem::RebuildIndex() const
+{
+	FScopeLock ScopeLock(&IndexGuard);
+	bIndexLoaded = true;
+	RebuildIndexLocked();
+}
+
+void UMCPChangeSetSubsystem::SetJournalStorage(const bool bEnabled)
+{
+	bJournalStorage = bEnabled;
+}
+
+bool UMCPChangeSetSubsystem::IsJournalStorage() const
+{
+	return bJournalStorage;
+}
+
+void UMCPChangeSetSubsystem::SealJournal() const
+{
+	FlushPendingWrites();
+	FScopeLock DrainLock(&DrainGuard);
+	if (Journal.IsValid())
+	{
+		Journal->Seal();
+	}
+}
+#endif
+
+void UMCPChangeSetSubsystem::PlanGarbageCollection(const FMCPChangeSetRetentionPolicy& Policy, TArray<FString>& OutChangeSetIds) const
+{
+	OutChangeSetIds.Reset();
+
+	TSet<FString> PinnedIds;
+	if (Policy.bKeepPinned)
+	{
+		FScopeLock PinLock(&PinGuard);
+		PinnedIds = PinnedChangeSetIds;
+	}
+
+	TSet<FString> UnwrittenChangeSetIds;
+	{
+		FScopeLock WriterLock(&WriterGuard);
+		UnwrittenChangeSetIds = PendingChangeSetIds;
+	}
+
+	FScopeLock ScopeLock(&IndexGuard);
+	EnsureIndexLoadedLocked();
+
+	// Kept pinned changesets sit outside the limits, so a pile of pins cannot push newer work out.
+	int32 RemainingCount = 0;
+	int64 RemainingBytes = 0;
+	for (const FIndexEntry& Entry : IndexEntries)
+	{
+		if (!PinnedIds.Contains(Entry.ChangeSetId))
+		{
+			++RemainingCount;
+			RemainingBytes += Entry.SizeBytes;
+		}
+	}
+
+	const int64 CutoffMs = Policy.MaxAgeDays > 0
+		? MCPTime::GetUnixTimestampMs() - static_cast<int64>(Policy.MaxAgeDays) * MillisecondsPerDay
+		: 0;
+
+	// Oldest first; once an entry is within every limit, so is everything newer.
+	for (const FIndexEntry& Entry : IndexEntries)
+	{
+		const bool bExpired = Policy.MaxAgeDays > 0 && Entry.CreatedAtMs < CutoffMs;
+		const bool bOverCount = Policy.MaxCount > 0 && RemainingCount > Policy.MaxCount;
+		const bool bOverBytes = Policy.MaxBytes > 0 && RemainingBytes > Policy.MaxBytes;
+		if (!bExpired && !bOverCount && !bOverBytes)
+		{
+			break;
+		}
+
+		if (PinnedIds.Contains(Entry.ChangeSetId) || UnwrittenChangeSetIds.Contains(Entry.ChangeSetId))
+		{
+			continue;
+		}
+
+		OutChangeSetIds.Add(Entry.ChangeSetId);
+		--RemainingCount;
+		RemainingBytes -= Entry.SizeBytes;
+	}
+}
+
+void UMCPChangeSetSubsystem::DeleteChangeSets(const TArray<FString>& ChangeSetIds, FMCPChangeSetGCStats& OutStats) const
+{
+	OutStats = FMCPChangeSetGCStats();
+	if (ChangeSetIds.Num() == 0)
+	{
+		return;
+	}
+
+	FScopeLock GarbageCollectionLock(&GarbageCollectionGuard);
+	const uint64 StartCycles = MCPTime::NowCycles();
+	bool bDeletedJournalRecords = false;
+
+	for (int32 BatchStart = 0; BatchStart < ChangeSetIds.Num(); BatchStart += GarbageCollectionBatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + GarbageCollectionBatchSize, ChangeSetIds.Num());
+		TSet<FString> BatchIds;
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			BatchIds.Add(ChangeSetIds[Index]);
+		}
+
+		{
+			// Records still being written are left for a later pass.
+			FScopeLock WriterLock(&WriterGuard);
+			for (const FString& PendingChangeSetId : PendingChangeSetIds)
+			{
+				BatchIds.Remove(PendingChangeSetId);
+			}
+		}
+
+		// Unlisted before anything is removed, so list and get never see a half-deleted changeset.
+		TArray<FString> DirectoriesToDelete;
+		TArray<FString> JournalTombstones;
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			EnsureIndexLoadedLocked();
+			const int32 RemovedCount = IndexEntries.RemoveAll([&BatchIds, &DirectoriesToDelete, &JournalTombstones](const FIndexEntry& Entry)
+			{
+				if (!BatchIds.Contains(Entry.ChangeSetId))
+				{
+					return false;
+				}
+
+				if (Entry.JournalLocation.IsValid())
+				{
+					JournalTombstones.Add(MakeJournalTombstonePayload(Entry.ChangeSetId, Entry.JournalLocation.SegmentId));
+				}
+				else
+				{
+					DirectoriesToDelete.Add(Entry.ChangeSetId);
+				}
+				return true;
+			});
+
+			if (RemovedCount == 0)
+			{
+				continue;
+			}
+			RebuildSecondaryIndexesLocked();
+			OutStats.DeletedChangeSets += RemovedCount;
+		}
+
+		// Without a tombstone the next index rebuild would find the record in its segment and list it again.
+		if (JournalTombstones.Num() > 0 && Journal.IsValid())
+		{
+			bDeletedJournalRecords = true;
+			bool bTombstonesWritten = true;
+			for (const FString& Tombstone : JournalTombstones)
+			{
+				FMCPJournalRecordLocation TombstoneLocation;
+				bTombstonesWritten &= Journal->Append(Tombstone, TombstoneLocation);
+			}
+			if (!bTombstonesWritten || !Journal->Flush())
+			{
+				UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to journal %d changeset deletion(s); they may be listed again after an index rebuild."), JournalTombstones.Num());
+			}
+		}
+
+		IFileManager& FileManager = IFileManager::Get();
+		for (const FString& ChangeSetId : DirectoriesToDelete)
+		{
+			const FString ChangeSetDir = BuildChangeSetDirectory(ChangeSetId);
+			const int64 SizeBytes = ComputeDirectorySizeBytes(ChangeSetDir);
+			if (FileManager.DeleteDirectory(*ChangeSetDir, false, true))
+			{
+				OutStats.ReclaimedBytes += SizeBytes;
+			}
+			else
+			{
+				UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to delete changeset directory: %s"), *ChangeSetDir);
+			}
+		}
+
+		// Rewritten after the deletes so the index is newer than the changeset root.
+		if (!RewriteIndexFile())
+		{
+			UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to rewrite changeset index after GC; it will be rebuilt on next load."));
+		}
+	}
+
+	{
+		FScopeLock PinLock(&PinGuard);
+		const int32 PinCount = PinnedChangeSetIds.Num();
+		for (const FString& ChangeSetId : ChangeSetIds)
+		{
+			PinnedChangeSetIds.Remove(ChangeSetId);
+		}
+		if (PinnedChangeSetIds.Num() != PinCount)
+		{
+			SavePinsLocked();
+		}
+	}
+
+	// Journaled records only free space once their whole segment goes.
+	if (bDeletedJournalRecords)
+	{
+		int64 JournalReclaimedBytes = 0;
+		CompactJournal(OutStats.DeletedSegments, JournalReclaimedBytes);
+		OutStats.ReclaimedBytes += JournalReclaimedBytes;
+	}
+
+	UMCPSnapshotStoreSubsystem* Store = SnapshotStore.Get();
+	if (Store != nullptr && OutStats.DeletedChangeSets > 0)
+	{
+		TSet<FString> ReferencedBlobHashes;
+		{
+			FScopeLock ScopeLock(&IndexGuard);
+			for (const FIndexEntry& Entry : IndexEntries)
+			{
+				ReferencedBlobHashes.Append(Entry.BlobHashes);
+			}
+		}
+
+		int64 BlobReclaimedBytes = 0;
+		OutStats.DeletedBlobs = Store->DeleteUnreferencedBlobs(ReferencedBlobHashes, UnreferencedBlobMinAge, BlobReclaimedBytes);
+		OutStats.ReclaimedBytes += BlobReclaimedBytes;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Changeset GC: deleted %d changeset(s), %d segment(s), %d blob(s), reclaimed %lld bytes in %.1f ms"),
+		OutStats.DeletedChangeSets, OutStats.DeletedSegments, OutStats.DeletedBlobs, OutStats.ReclaimedBytes,
+		MCPTime::MicrosecondsToMilliseconds(MCPTime::MicrosecondsSince(StartCycles)));
+	ReportGarbageCollected(OutStats);
+}
+
+void UMCPChangeSetSubsystem::CollectGarbage(FMCPChangeSetGCStats& OutStats) const
+{
+	OutStats = FMCPChangeSetGCStats();
+	FScopeLock GarbageCollectionLock(&GarbageCollectionGuard);
+
+	TArray<FString> ChangeSetIds;
+	PlanGarbageCollection(RetentionPolicy, ChangeSetIds);
+	DeleteChangeSets(ChangeSetIds, OutStats);
+}
+
+void UMCPChangeSetSubsystem::ScheduleGarbageCollection() const
+{
+	{
+		FScopeLock ScopeLock(&WriterGuard);
+		if (bGarbageCollectionScheduled || bShuttingDown)
+		{
+			return;
+		}
+		bGarbageCollectionScheduled = true;
+		++InFlightBackgroundTasks;
+	}
+
+	const TWeakObjectPtr<const UMCPChangeSetSubsystem> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis]()
+	{
+		if (const UMCPChangeSetSubsystem* ChangeSetSubsystem = WeakThis.Get())
+		{
+			if (!ChangeSetSubsystem->IsShuttingDown())
+			{
+				FMCPChangeSetGCStats Stats;
+				ChangeSetSubsystem->CollectGarbage(Stats);
+			}
+
+			{
+				FScopeLock ScopeLock(&ChangeSetSubsystem->WriterGuard);
+				ChangeSetSubsystem->bGarbageCollectionScheduled = false;
+			}
+			ChangeSetSubsystem->FinishBackgroundTask();
+		}
+	});
+}
+
+const FMCPChangeSetRetentionPolicy& UMCPChangeSetSubsystem::GetRetentionPolicy() const
+{
+	return RetentionPolicy;
+}
+
+bool UMCPChangeSetSubsystem::HandleGarbageCollectionTicker(float DeltaSeconds)
+{
+	(void)DeltaSeconds;
+	ScheduleGarbageCollection();
+	return true;
+}
+
+void UMCPChangeSetSubsystem::ReportGarbageCollected(const FMCPChangeSetGCStats& Stats) const
+{
+	if (Stats.DeletedChangeSets == 0 && Stats.ReclaimedBytes == 0)
+	{
+		return;
+	}
+
+	// Subsystems are looked up on the game thread only.
+	const int32 DeletedCount = Stats.DeletedChangeSets;
+	const int64 ReclaimedBytes = Stats.ReclaimedBytes;
+	AsyncTask(ENamedThreads::GameThread, [DeletedCount, ReclaimedBytes]()
+	{
+		if (UMCPObservabilitySubsystem* Observability = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+		{
+			Observability->RecordChangeSetGarbageCollected(DeletedCount, ReclaimedBytes);
+		}
+	});
+}
+
+void UMCPChangeSetSubsystem::ReportWriteFailures(const int32 FailedCount) const
+{
+	if (FailedCount == 0)
+	{
+		return;
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [FailedCount]()
+	{
+		if (UMCPObservabilitySubsystem* Observability = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+		{
+			Observability->RecordChangeSetWriteFailure(FailedCount);
+		}
+	});
+}
+
+bool UMCPChangeSetSubsystem::SetChangeSetPinned(const FString& ChangeSetId, const bool bPinned, FMCPDiagnostic& OutDiagnostic) const
+{
+	if (bPinned)
+	{
+		FScopeLock ScopeLock(&IndexGuard);
+		EnsureIndexLoadedLocked();
+		if (!EntriesById.Contains(ChangeSetId))
+		{
+			OutDiagnostic.Code = MCPErrorCodes::CHANGESET_NOT_FOUND;
+			OutDiagnostic.Message = TEXT("Requested changeset does not exist.");
+			OutDiagnostic.Detail = ChangeSetId;
+			OutDiagnostic.Suggestion = TEXT("Run changeset.list and retry with a valid changeset_id.");
+			return false;
+		}
+	}
+
+	FScopeLock PinLock(&PinGuard);
+	const bool bChanged = bPinned ? !PinnedChangeSetIds.Contains(ChangeSetId) : PinnedChangeSetIds.Contains(ChangeSetId);
+	if (!bChanged)
+	{
+		return true;
+	}
+
+	if (bPinned)
+	{
+		PinnedChangeSetIds.Add(ChangeSetId);
+	}
+	else
+	{
+		PinnedChangeSetIds.Remove(ChangeSetId);
+	}
+
+	if (!SavePinsLocked())
+	{
+		// Reverted so the reported pin state matches what the next session will load.
+		if (bPinned)
+		{
+			PinnedChangeSetIds.Remove(ChangeSetId);
+		}
+		else
+		{
+			PinnedChangeSetIds.Add(ChangeSetId);
+		}
+		OutDiagnostic.Code = MCPErrorCodes::SAVE_FAILED;
+		OutDiagnostic.Message = TEXT("Failed to save changeset pins.");
+		OutDiagnostic.Detail = GetChangeSetPinsPath();
+		OutDiagnostic.Suggestion = TEXT("Check write permission for Saved/UnrealMCP and disk status, then retry.");
+		return false;
+	}
+	return true;
+}
+
+bool UMCPChangeSetSubsystem::IsChangeSetPinned(const FString& ChangeSetId) const
+{
+	FScopeLock PinLock(&PinGuard);
+	return PinnedChangeSetIds.Contains(ChangeSetId);
+}
+
+FString UMCPChangeSetSubsystem::GetChangeSetPinsPath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/ChangeSetPins.json"));
+}
+
+void UMCPChangeSetSubsystem::LoadPins()
+{
+	FScopeLock PinLock(&PinGuard);
+	PinnedChangeSetIds.Reset();
+
+	TSharedPtr<FJsonObject> PinsObject;
+	TArray<FString> PinnedIds;
+	if (ReadJsonFile(GetChangeSetPinsPath(), PinsObject) && PinsObject->TryGetStringArrayField(TEXT("pinned"), PinnedIds))
+	{
+		PinnedChangeSetIds.Append(PinnedIds);
+	}
+}
+
+bool UMCPChangeSetSubsystem::SavePinsLocked() const
+{
+	TArray<FString> PinnedIds = PinnedChangeSetIds.Array();
+	PinnedIds.Sort();
+
+	TSharedRef<FJsonObject> PinsObject = MakeShared<FJsonObject>();
+	PinsObject->SetArrayField(TEXT("pinned"), ToJsonStringArrayForChangeSet(PinnedIds));
+
+	const FString PinsPath = GetChangeSetPinsPath();
+	const FString TempPinsPath = PinsPath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(ToCondensedJson(PinsObject), *TempPinsPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*PinsPath, *TempPinsPath, true, true))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write changeset pins: %s"), *PinsPath);
+		return false;
+	}
+	return true;
 }
@@ -1,15 +1,22 @@
 #include "MCPCommandRouterSubsystem.h"
 
 #include "Editor.h"
+#include "MCPBlueprintCompileSubsystem.h"
 #include "MCPChangeSetSubsystem.h"
 #include "MCPErrorCodes.h"
 #include "MCPEventStreamSubsystem.h"
 #include "MCPLockSubsystem.h"
 #include "MCPObservabilitySubsystem.h"
 #include "MCPPolicySubsystem.h"
+#include "MCPSnapshotStoreSubsystem.h"
+#include "MCPTime.h"
+#include "MCPTraceSubsystem.h"
 #include "MCPJobSubsystem.h"
 #include "MCPToolRegistrySubsystem.h"
 #include "HAL/FileManager.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Misc/ConfigCacheIni.h"
 #include "Misc/PackageName.h"
 #include "Misc/Paths.h"
 #include "Misc/ScopeExit.h"
@@ -19,11 +26,40 @@
 
 namespace
 {
-	int64 GetCurrentUnixTimestampMs()
+	constexpr int32 BatchLockLeaseMs = 30000;
+	const TCHAR* const BatchToolName = TEXT("mcp.batch");
+
+	UMCPObservabilitySubsystem* GetObservabilitySubsystem()
 	{
-		return FDateTime::UtcNow().ToUnixTimestamp() * 1000LL;
+		return GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
 	}
 
+	class FMCPPhaseScope
+	{
+	public:
+		FMCPPhaseScope(UMCPObservabilitySubsystem* InObservability, const EMCPLatencyPhase InPhase, const FString& RequestId, const FString& Tool)
+			: TraceScope(TEXT("mcp.phase"), UMCPObservabilitySubsystem::LatencyPhaseToString(InPhase), RequestId, Tool)
+			, Observability(InObservability)
+			, Phase(InPhase)
+			, StartCycles(MCPTime::NowCycles())
+		{
+		}
+
+		~FMCPPhaseScope()
+		{
+			if (Observability != nullptr)
+			{
+				Observability->RecordPhaseLatency(Phase, MCPTime::MicrosecondsSince(StartCycles));
+			}
+		}
+
+	private:
+		FMCPTraceScope TraceScope;
+		UMCPObservabilitySubsystem* Observability = nullptr;
+		EMCPLatencyPhase Phase = EMCPLatencyPhase::Count;
+		uint64 StartCycles = 0;
+	};
+
 	FString NormalizeLockKeyPath(const FString& CandidatePath)
 	{
 		if (CandidatePath.IsEmpty())
@@ -196,95 +232,158 @@ namespace
 		return (Status == EMCPResponseStatus::Error) ? EMCPJobStatus::Failed : EMCPJobStatus::Succeeded;
 	}
 
-	EMCPResponseStatus ParseResponseStatus(const FString& ResponseJson)
+	// Finishes a job whose router went away before it could complete, so pollers see a terminal status instead of Running.
+	void CancelOrphanedAsyncJob(const FMCPRequestEnvelope& Request, const FString& JobId, const TSharedPtr<FMCPCancellationToken>& Cancellation)
 	{
-		TSharedPtr<FJsonObject> RootObject;
-		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
-		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+		if (JobSubsystem == nullptr)
 		{
-			return EMCPResponseStatus::Ok;
+			return;
 		}
 
-		FString StatusString;
-		if (!RootObject->TryGetStringField(TEXT("status"), StatusString))
+		if (Cancellation.IsValid())
 		{
-			return EMCPResponseStatus::Ok;
+			const TSharedRef<FMCPCancellationToken> CancellationRef = Cancellation.ToSharedRef();
+			JobSubsystem->UnregisterCancellationToken(JobId, CancellationRef);
+			if (Request.Context.bHasCancelToken)
+			{
+				JobSubsystem->UnregisterCancellationToken(Request.Context.CancelToken, CancellationRef);
+			}
 		}
 
-		if (StatusString.Equals(TEXT("error"), ESearchCase::IgnoreCase))
+		FMCPDiagnostic Diagnostic;
+		Diagnostic.Code = MCPErrorCodes::JOB_CANCELED;
+		Diagnostic.Message = TEXT("Job was canceled because the command router shut down.");
+		Diagnostic.Detail = FString::Printf(TEXT("job_id=%s tool=%s"), *JobId, *Request.Tool);
+		Diagnostic.bRetriable = true;
+		JobSubsystem->FinalizeJob(JobId, EMCPJobStatus::Canceled, MakeShared<FJsonObject>(), { Diagnostic });
+	}
+
+	FString BuildReplayResponseJson(const FString& ResponseJson)
+	{
+		static const FString OriginalSuffix = TEXT("\"idempotent_replay\":false}");
+		static const FString ReplaySuffix = TEXT("\"idempotent_replay\":true}");
+		if (ResponseJson.EndsWith(OriginalSuffix, ESearchCase::CaseSensitive))
 		{
-			return EMCPResponseStatus::Error;
+			return ResponseJson.LeftChop(OriginalSuffix.Len()) + ReplaySuffix;
 		}
 
-		if (StatusString.Equals(TEXT("partial"), ESearchCase::IgnoreCase))
+		TSharedPtr<FJsonObject> RootObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
 		{
-			return EMCPResponseStatus::Partial;
+			return ResponseJson;
 		}
 
-		return EMCPResponseStatus::Ok;
+		RootObject->SetBoolField(TEXT("idempotent_replay"), true);
+		return MCPJson::SerializeJsonObject(RootObject);
 	}
+}
 
-	int64 ComputeDirectorySizeBytes(const FString& DirectoryPath)
-	{
-		TArray<FString> FilePaths;
-		IFileManager::Get().FindFilesRecursive(FilePaths, *DirectoryPath, TEXT("*"), true, false, false);
+void UMCPCommandRouterSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	IdempotencyCache = MakeUnique<FMCPToolResultCache>(LoadIdempotencySettings());
+}
 
-		int64 TotalBytes = 0;
-		for (const FString& FilePath : FilePaths)
-		{
-			const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
-			if (FileSize > 0)
-			{
-				TotalBytes += FileSize;
-			}
-		}
-		return TotalBytes;
+void UMCPCommandRouterSubsystem::Deinitialize()
+{
+	if (IdempotencyCache.IsValid())
+	{
+		IdempotencyCache->EvictAll();
+		IdempotencyCache.Reset();
 	}
 
-	int32 CountSnapshotFiles(const FString& SnapshotDirectoryPath)
+	Super::Deinitialize();
+}
+
+FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJson, bool& bOutSuccess)
+{
+	bOutSuccess = false;
+	const uint64 StartCycles = MCPTime::NowCycles();
+
+	FMCPRequestEnvelope Request;
+	FMCPDiagnostic ParseDiagnostic;
+	bool bParsed = false;
 	{
-		TArray<FString> SnapshotFiles;
-		IFileManager::Get().FindFiles(SnapshotFiles, *(FPaths::Combine(SnapshotDirectoryPath, TEXT("*.before"))), true, false);
-		return SnapshotFiles.Num();
+		const FMCPPhaseScope PhaseScope(GetObservabilitySubsystem(), EMCPLatencyPhase::Parse, FString(), FString());
+		bParsed = MCPJson::ParseRequestEnvelope(RequestJson, Request, ParseDiagnostic);
 	}
+	if (!bParsed)
+	{
+		return BuildParseFailureResponse(ParseDiagnostic, StartCycles);
+	}
+
+	return ExecuteParsedRequest(Request, StartCycles, bOutSuccess);
 }
 
-FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJson, bool& bOutSuccess)
+FString UMCPCommandRouterSubsystem::ExecuteRequestObject(const TSharedPtr<FJsonObject>& RequestObject, bool& bOutSuccess)
 {
 	bOutSuccess = false;
-	const int64 StartMs = GetCurrentUnixTimestampMs();
+	const uint64 StartCycles = MCPTime::NowCycles();
 
 	FMCPRequestEnvelope Request;
 	FMCPDiagnostic ParseDiagnostic;
-	if (!MCPJson::ParseRequestEnvelope(RequestJson, Request, ParseDiagnostic))
+	bool bParsed = false;
 	{
-		if (GEditor != nullptr)
-		{
-			if (UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>())
-			{
-				EventStreamSubsystem->EmitLog(TEXT("invalid-request"), TEXT("error"), ParseDiagnostic.Message);
-			}
+		const FMCPPhaseScope PhaseScope(GetObservabilitySubsystem(), EMCPLatencyPhase::Parse, FString(), FString());
+		bParsed = MCPJson::ParseRequestEnvelopeObject(RequestObject, Request, ParseDiagnostic);
+	}
+	if (!bParsed)
+	{
+		return BuildParseFailureResponse(ParseDiagnostic, StartCycles);
+	}
 
-			if (UMCPObservabilitySubsystem* ObservabilitySubsystem = GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>())
-			{
-				ObservabilitySubsystem->RecordSchemaValidationError();
-			}
+	return ExecuteParsedRequest(Request, StartCycles, bOutSuccess);
+}
+
+FString UMCPCommandRouterSubsystem::BuildParseFailureResponse(const FMCPDiagnostic& ParseDiagnostic, const uint64 StartCycles) const
+{
+	if (GEditor != nullptr)
+	{
+		if (UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>())
+		{
+			EventStreamSubsystem->EmitLog(TEXT("invalid-request"), TEXT("error"), ParseDiagnostic.Message);
 		}
 
-		FMCPRequestEnvelope FallbackRequest;
-		FallbackRequest.RequestId = TEXT("invalid-request");
-		FMCPToolExecutionResult ErrorResult;
-		ErrorResult.Status = EMCPResponseStatus::Error;
-		ErrorResult.Diagnostics.Add(ParseDiagnostic);
-		return MCPJson::BuildResponseEnvelope(FallbackRequest, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
+		if (UMCPObservabilitySubsystem* ObservabilitySubsystem = GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>())
+		{
+			ObservabilitySubsystem->RecordSchemaValidationError();
+		}
 	}
 
+	FMCPRequestEnvelope FallbackRequest;
+	FallbackRequest.RequestId = TEXT("invalid-request");
+	FMCPToolExecutionResult ErrorResult;
+	ErrorResult.Status = EMCPResponseStatus::Error;
+	ErrorResult.Diagnostics.Add(ParseDiagnostic);
+	return MCPJson::BuildResponseEnvelope(FallbackRequest, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+}
+
+FString UMCPCommandRouterSubsystem::ExecuteParsedRequest(const FMCPRequestEnvelope& Request, const uint64 StartCycles, bool& bOutSuccess)
+{
+	bOutSuccess = false;
+
 	UMCPEventStreamSubsystem* EventStream = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr;
-	UMCPObservabilitySubsystem* Observability = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
+	UMCPObservabilitySubsystem* Observability = GetObservabilitySubsystem();
+	UMCPTraceSubsystem::TraceRequestBegin(Request.RequestId, Request.Tool);
+	const FMCPTraceScope RequestTraceScope(TEXT("mcp.request"), TEXT("request"), Request.RequestId, Request.Tool);
 
-	const auto EmitProgress = [EventStream, &Request](const double Percent, const TCHAR* Phase)
+	if (EventStream != nullptr)
 	{
-		if (EventStream != nullptr)
+		EventStream->RegisterRequestSession(Request.RequestId, Request.SessionId);
+	}
+
+	bool bSuppressIntermediateProgress = false;
+	if (EventStream != nullptr && EventStream->ShouldSuppressReadOnlyIntermediateProgress())
+	{
+		const UMCPToolRegistrySubsystem* ProgressToolRegistry = GEditor->GetEditorSubsystem<UMCPToolRegistrySubsystem>();
+		bSuppressIntermediateProgress = ProgressToolRegistry != nullptr && !ProgressToolRegistry->IsWriteTool(Request.Tool);
+	}
+
+	const auto EmitProgress = [EventStream, &Request, bSuppressIntermediateProgress](const double Percent, const TCHAR* Phase)
+	{
+		if (EventStream != nullptr && (Percent >= 100.0 || !bSuppressIntermediateProgress))
 		{
 			EventStream->EmitProgress(Request.RequestId, Percent, Phase);
 		}
@@ -312,11 +411,11 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EventStream->EmitLog(Request.RequestId, Diagnostic.Severity, Diagnostic.Message, DetailObject);
 	};
 
-	const auto RecordToolMetric = [Observability, &Request, StartMs](const EMCPResponseStatus Status, const bool bIdempotentReplay)
+	const auto RecordToolMetric = [Observability, &Request, StartCycles](const EMCPResponseStatus Status, const bool bIdempotentReplay)
 	{
 		if (Observability != nullptr && !Request.Tool.IsEmpty())
 		{
-			Observability->RecordToolExecution(Request.Tool, Status, GetCurrentUnixTimestampMs() - StartMs, bIdempotentReplay);
+			Observability->RecordToolExecution(Request.Tool, Status, MCPTime::MicrosecondsSince(StartCycles), bIdempotentReplay);
 		}
 	};
 
@@ -337,7 +436,7 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(ProtocolDiagnostic);
 		RecordToolMetric(EMCPResponseStatus::Error, false);
 		EmitProgress(100.0, TEXT("request.failed.protocol"));
-		return MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
+		return MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
 	}
 
 	EmitProgress(10.0, TEXT("request.protocol_validated"));
@@ -361,11 +460,16 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(Diagnostic);
 		RecordToolMetric(EMCPResponseStatus::Error, false);
 		EmitProgress(100.0, TEXT("request.failed.subsystems"));
-		return MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
+		return MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
 	}
 
 	FMCPDiagnostic SchemaDiagnostic;
-	if (!ToolRegistry->ValidateRequest(Request, SchemaDiagnostic))
+	bool bSchemaValid = false;
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::SchemaValidate, Request.RequestId, Request.Tool);
+		bSchemaValid = ToolRegistry->ValidateRequest(Request, SchemaDiagnostic);
+	}
+	if (!bSchemaValid)
 	{
 		if (Observability != nullptr)
 		{
@@ -378,8 +482,8 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(SchemaDiagnostic);
 		RecordToolMetric(EMCPResponseStatus::Error, false);
 		EmitProgress(100.0, TEXT("request.failed.schema"));
-		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-		CacheIdempotencyResponse(Request, ResponseJson);
+		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, ErrorResult.Status);
 		return ResponseJson;
 	}
 
@@ -407,18 +511,23 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 			EmitDiagnosticLog(Diagnostic);
 			RecordToolMetric(EMCPResponseStatus::Error, false);
 			EmitProgress(100.0, TEXT("request.failed.canceled"));
-			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-			CacheIdempotencyResponse(Request, ResponseJson);
+			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+			CacheIdempotencyResponse(Request, ResponseJson, ErrorResult.Status);
 			return ResponseJson;
 		}
 	}
 
 	FString CachedResponse;
+	EMCPResponseStatus ReplayStatus = EMCPResponseStatus::Ok;
 	bool bIdempotencyConflict = false;
 	FMCPDiagnostic IdempotencyConflictDiagnostic;
-	if (CheckIdempotencyReplay(Request, CachedResponse, bIdempotencyConflict, IdempotencyConflictDiagnostic))
+	bool bIdempotentReplay = false;
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Idempotency, Request.RequestId, Request.Tool);
+		bIdempotentReplay = CheckIdempotencyReplay(Request, CachedResponse, ReplayStatus, bIdempotencyConflict, IdempotencyConflictDiagnostic);
+	}
+	if (bIdempotentReplay)
 	{
-		const EMCPResponseStatus ReplayStatus = ParseResponseStatus(CachedResponse);
 		RecordToolMetric(ReplayStatus, true);
 		EmitLog(TEXT("info"), TEXT("Returned cached idempotent response."));
 		EmitProgress(100.0, TEXT("request.idempotent_replay"));
@@ -439,8 +548,8 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(IdempotencyConflictDiagnostic);
 		RecordToolMetric(EMCPResponseStatus::Error, false);
 		EmitProgress(100.0, TEXT("request.failed.idempotency_conflict"));
-		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-		CacheIdempotencyResponse(Request, ResponseJson);
+		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, ErrorResult.Status);
 		return ResponseJson;
 	}
 
@@ -469,8 +578,47 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(Diagnostic);
 		RecordToolMetric(EMCPResponseStatus::Error, false);
 		EmitProgress(100.0, TEXT("request.failed.timeout_validation"));
-		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-		CacheIdempotencyResponse(Request, ResponseJson);
+		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
+		return ResponseJson;
+	}
+
+	if (Request.Tool.Equals(BatchToolName, ESearchCase::CaseSensitive))
+	{
+		return ExecuteBatchRequest(Request, StartCycles, bOutSuccess);
+	}
+
+	if (Request.Context.bAsync)
+	{
+		if (bIsWriteTool)
+		{
+			FMCPDiagnostic Diagnostic;
+			Diagnostic.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
+			Diagnostic.Message = TEXT("context.async is only supported for read-only tools.");
+			Diagnostic.Detail = FString::Printf(TEXT("tool=%s"), *Request.Tool);
+			Diagnostic.Suggestion = TEXT("Call write tools synchronously.");
+			ExecutionResult.Status = EMCPResponseStatus::Error;
+			ExecutionResult.Diagnostics.Add(Diagnostic);
+			EmitDiagnosticLog(Diagnostic);
+			RecordToolMetric(EMCPResponseStatus::Error, false);
+			EmitProgress(100.0, TEXT("request.failed.async"));
+			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+			CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
+			return ResponseJson;
+		}
+
+		const FString AsyncJobId = JobSubsystem->CreateJob(Request.RequestId, true);
+		ScheduleAsyncJob(Request, AsyncJobId);
+
+		ExecutionResult.ResultObject = MakeShared<FJsonObject>();
+		ExecutionResult.ResultObject->SetStringField(TEXT("job_id"), AsyncJobId);
+		ExecutionResult.ResultObject->SetStringField(TEXT("status"), UMCPJobSubsystem::StatusToString(EMCPJobStatus::Queued));
+		ExecutionResult.ResultObject->SetBoolField(TEXT("async"), true);
+		EmitLog(TEXT("info"), FString::Printf(TEXT("Queued async job %s for tool %s"), *AsyncJobId, *Request.Tool));
+		EmitProgress(100.0, TEXT("request.async_queued"));
+		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
+		bOutSuccess = true;
 		return ResponseJson;
 	}
 
@@ -482,14 +630,19 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		}
 	};
 
-	const int64 ExecutionBeginMs = GetCurrentUnixTimestampMs();
+	const uint64 ExecutionBeginCycles = MCPTime::NowCycles();
 
 	if (bIsWriteTool)
 	{
 		EmitProgress(30.0, TEXT("request.write_preflight"));
 
 		FMCPDiagnostic PolicyDiagnostic;
-		if (!PolicySubsystem->PreflightAuthorize(Request, PolicyDiagnostic))
+		bool bAuthorized = false;
+		{
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Policy, Request.RequestId, Request.Tool);
+			bAuthorized = PolicySubsystem->PreflightAuthorize(Request, PolicyDiagnostic);
+		}
+		if (!bAuthorized)
 		{
 			if (Observability != nullptr)
 			{
@@ -502,55 +655,115 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 			EmitDiagnosticLog(PolicyDiagnostic);
 			RecordToolMetric(EMCPResponseStatus::Error, false);
 			EmitProgress(100.0, TEXT("request.failed.policy"));
-			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-			CacheIdempotencyResponse(Request, ResponseJson);
+			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+			CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
 			return ResponseJson;
 		}
 
-		for (const FString& LockKey : LockKeys)
+		FMCPDiagnostic LockDiagnostic;
+		bool bLocksAcquired = true;
 		{
-			FMCPDiagnostic LockDiagnostic;
-			if (!LockSubsystem->AcquireLock(LockKey, LockOwner, 30000, LockDiagnostic))
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Lock, Request.RequestId, Request.Tool);
+			for (const FString& LockKey : LockKeys)
 			{
-				ExecutionResult.Status = EMCPResponseStatus::Error;
-				ExecutionResult.Diagnostics.Add(LockDiagnostic);
-				EmitDiagnosticLog(LockDiagnostic);
-				RecordToolMetric(EMCPResponseStatus::Error, false);
-				EmitProgress(100.0, TEXT("request.failed.lock"));
-				const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), GetCurrentUnixTimestampMs() - StartMs);
-				CacheIdempotencyResponse(Request, ResponseJson);
-				return ResponseJson;
+				if (!LockSubsystem->AcquireLock(LockKey, LockOwner, 30000, LockDiagnostic))
+				{
+					bLocksAcquired = false;
+					break;
+				}
+
+				AcquiredLockKeys.Add(LockKey);
 			}
+		}
 
-			AcquiredLockKeys.Add(LockKey);
+		if (!bLocksAcquired)
+		{
+			ExecutionResult.Status = EMCPResponseStatus::Error;
+			ExecutionResult.Diagnostics.Add(LockDiagnostic);
+			EmitDiagnosticLog(LockDiagnostic);
+			RecordToolMetric(EMCPResponseStatus::Error, false);
+			EmitProgress(100.0, TEXT("request.failed.lock"));
+			const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+			CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
+			return ResponseJson;
 		}
 		EmitProgress(45.0, TEXT("request.lock_acquired"));
 	}
 
 	if (bTrackJob)
 	{
-		TrackedJobId = JobSubsystem->CreateJob();
+		TrackedJobId = JobSubsystem->CreateJob(Request.RequestId);
 		JobSubsystem->UpdateJobStatus(TrackedJobId, EMCPJobStatus::Running, 0.0);
+
+		const TSharedRef<FMCPCancellationToken> Cancellation = MakeShared<FMCPCancellationToken>();
+		if (Request.Context.bHasTimeoutOverride && EffectiveTimeoutMs > 0)
+		{
+			Cancellation->SetDeadlineCycles(ExecutionBeginCycles + MCPTime::MillisecondsToCycles(EffectiveTimeoutMs));
+		}
+		JobSubsystem->RegisterCancellationToken(TrackedJobId, Cancellation);
+		if (Request.Context.bHasCancelToken)
+		{
+			JobSubsystem->RegisterCancellationToken(Request.Context.CancelToken, Cancellation);
+		}
+		ExecutionResult.Cancellation = Cancellation;
 	}
 
+	ON_SCOPE_EXIT
+	{
+		if (ExecutionResult.Cancellation.IsValid())
+		{
+			const TSharedRef<FMCPCancellationToken> Cancellation = ExecutionResult.Cancellation.ToSharedRef();
+			JobSubsystem->UnregisterCancellationToken(TrackedJobId, Cancellation);
+			if (Request.Context.bHasCancelToken)
+			{
+				JobSubsystem->UnregisterCancellationToken(Request.Context.CancelToken, Cancellation);
+			}
+		}
+	};
+
 	EmitProgress(55.0, TEXT("request.executing_tool"));
-	ToolRegistry->ExecuteTool(Request, ExecutionResult);
-	const int64 ExecutionDurationMs = GetCurrentUnixTimestampMs() - ExecutionBeginMs;
-	const bool bTimeoutExceeded = Request.Context.bHasTimeoutOverride && EffectiveTimeoutMs > 0 && ExecutionDurationMs > EffectiveTimeoutMs;
+	UMCPSnapshotStoreSubsystem* SnapshotStore = bIsWriteTool && !Request.Context.bDryRun ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+	if (SnapshotStore != nullptr)
+	{
+		SnapshotStore->BeginCapture();
+	}
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Execute, Request.RequestId, Request.Tool);
+		ToolRegistry->ExecuteTool(Request, ExecutionResult);
+	}
+	TArray<FMCPPackageSnapshot> PackageSnapshots;
+	if (SnapshotStore != nullptr)
+	{
+		SnapshotStore->EndCapture(
+			ExecutionResult.Status != EMCPResponseStatus::Error ? ExecutionResult.TouchedPackages : TArray<FString>(),
+			PackageSnapshots);
+	}
+	const int64 ExecutionDurationUs = MCPTime::MicrosecondsSince(ExecutionBeginCycles);
+	const EMCPStopReason StopReason = ExecutionResult.Cancellation.IsValid() ? ExecutionResult.Cancellation->GetStopReason() : EMCPStopReason::None;
+	const bool bTimeoutExceeded = StopReason == EMCPStopReason::DeadlineExceeded
+		|| (Request.Context.bHasTimeoutOverride && EffectiveTimeoutMs > 0 && ExecutionDurationUs > static_cast<int64>(EffectiveTimeoutMs) * 1000);
 	EmitProgress(75.0, TEXT("request.tool_executed"));
 
 	FString ChangeSetId;
 	if (bIsWriteTool && !Request.Context.bDryRun && ExecutionResult.Status != EMCPResponseStatus::Error)
 	{
 		FMCPDiagnostic ChangeSetDiagnostic;
+		FMCPChangeSetRecordStats ChangeSetStats;
 		const FString PolicyVersion = PolicySubsystem->GetPolicyVersion();
-		if (!ChangeSetSubsystem->CreateChangeSetRecord(
-			Request,
-			ExecutionResult,
-			PolicyVersion,
-			ToolRegistry->GetSchemaHash(),
-			ChangeSetId,
-			ChangeSetDiagnostic))
+		bool bChangeSetCreated = false;
+		{
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::ChangeSetWrite, Request.RequestId, Request.Tool);
+			bChangeSetCreated = ChangeSetSubsystem->CreateChangeSetRecord(
+				Request,
+				ExecutionResult,
+				PolicyVersion,
+				ToolRegistry->GetSchemaHash(),
+				PackageSnapshots,
+				ChangeSetId,
+				ChangeSetStats,
+				ChangeSetDiagnostic);
+		}
+		if (!bChangeSetCreated)
 		{
 			ExecutionResult.Status = EMCPResponseStatus::Error;
 			ExecutionResult.Diagnostics.Add(ChangeSetDiagnostic);
@@ -558,7 +771,7 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		}
 		else
 		{
-			const FString ChangeSetPath = FPaths::Combine(ChangeSetSubsystem->GetChangeSetRootDir(), ChangeSetId);
+			const FString ChangeSetPath = ChangeSetSubsystem->GetChangeSetLocation(ChangeSetId);
 			if (EventStream != nullptr)
 			{
 				EventStream->EmitChangeSetCreated(Request.RequestId, ChangeSetId, ChangeSetPath);
@@ -566,9 +779,7 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 
 			if (Observability != nullptr)
 			{
-				const int64 ChangeSetBytes = ComputeDirectorySizeBytes(ChangeSetPath);
-				const int32 SnapshotCount = CountSnapshotFiles(FPaths::Combine(ChangeSetPath, TEXT("snapshots")));
-				Observability->RecordChangeSetCreated(ChangeSetBytes, SnapshotCount);
+				Observability->RecordChangeSetCreated(ChangeSetStats.ApproximateBytes, ChangeSetStats.SnapshotCount);
 			}
 		}
 	}
@@ -590,7 +801,11 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		TimeoutDiagnostic.Code = MCPErrorCodes::JOB_TIMEOUT;
 		TimeoutDiagnostic.Severity = TEXT("warning");
 		TimeoutDiagnostic.Message = TEXT("Execution exceeded timeout_ms.");
-		TimeoutDiagnostic.Detail = FString::Printf(TEXT("timeout_ms=%d duration_ms=%lld"), EffectiveTimeoutMs, ExecutionDurationMs);
+		TimeoutDiagnostic.Detail = FString::Printf(
+			TEXT("timeout_ms=%d duration_ms=%.3f stopped_early=%s"),
+			EffectiveTimeoutMs,
+			MCPTime::MicrosecondsToMilliseconds(ExecutionDurationUs),
+			StopReason == EMCPStopReason::DeadlineExceeded ? TEXT("true") : TEXT("false"));
 		TimeoutDiagnostic.Suggestion = TEXT("Increase timeout_ms or switch to asynchronous workflow.");
 		TimeoutDiagnostic.bRetriable = true;
 		ExecutionResult.Diagnostics.Add(TimeoutDiagnostic);
@@ -602,14 +817,37 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 		EmitDiagnosticLog(TimeoutDiagnostic);
 	}
 
+	if (StopReason == EMCPStopReason::Canceled)
+	{
+		FMCPDiagnostic CancelDiagnostic;
+		CancelDiagnostic.Code = MCPErrorCodes::JOB_CANCELED;
+		CancelDiagnostic.Severity = TEXT("warning");
+		CancelDiagnostic.Message = TEXT("Execution was canceled; results are partial.");
+		CancelDiagnostic.Detail = FString::Printf(TEXT("job_id=%s cancel_token=%s"), *TrackedJobId, *Request.Context.CancelToken);
+		ExecutionResult.Diagnostics.Add(CancelDiagnostic);
+		if (ExecutionResult.Status == EMCPResponseStatus::Ok)
+		{
+			ExecutionResult.Status = EMCPResponseStatus::Partial;
+		}
+
+		EmitDiagnosticLog(CancelDiagnostic);
+	}
+
 	if (bTrackJob)
 	{
+		if (!ExecutionResult.ResultObject.IsValid() && !ExecutionResult.ResultJson.IsEmpty())
+		{
+			const TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(ExecutionResult.ResultJson);
+			FJsonSerializer::Deserialize(ResultReader, ExecutionResult.ResultObject);
+			ExecutionResult.ResultJson.Empty();
+		}
 		if (!ExecutionResult.ResultObject.IsValid())
 		{
 			ExecutionResult.ResultObject = MakeShared<FJsonObject>();
 		}
 		ExecutionResult.ResultObject->SetStringField(TEXT("job_id"), TrackedJobId);
-		JobSubsystem->FinalizeJob(TrackedJobId, ToJobStatus(ExecutionResult.Status), ExecutionResult.ResultObject, ExecutionResult.Diagnostics);
+		const EMCPJobStatus FinalJobStatus = StopReason == EMCPStopReason::Canceled ? EMCPJobStatus::Canceled : ToJobStatus(ExecutionResult.Status);
+		JobSubsystem->FinalizeJob(TrackedJobId, FinalJobStatus, ExecutionResult.ResultObject, ExecutionResult.Diagnostics);
 	}
 
 	if (EventStream != nullptr)
@@ -641,12 +879,621 @@ FString UMCPCommandRouterSubsystem::ExecuteRequestJson(const FString& RequestJso
 	EmitLog(TEXT("info"), FString::Printf(TEXT("Completed request for tool %s with status %s"), *Request.Tool, *MCPJson::StatusToString(ExecutionResult.Status)));
 	EmitProgress(100.0, TEXT("request.completed"));
 
-	const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, ChangeSetId, GetCurrentUnixTimestampMs() - StartMs);
-	CacheIdempotencyResponse(Request, ResponseJson);
+	FString ResponseJson;
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::ResponseBuild, Request.RequestId, Request.Tool);
+		ResponseJson = MCPJson::BuildResponseEnvelope(Request, ExecutionResult, ChangeSetId, MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, ExecutionResult.Status);
+	}
 	bOutSuccess = ExecutionResult.Status != EMCPResponseStatus::Error;
 	return ResponseJson;
 }
 
+FString UMCPCommandRouterSubsystem::ExecuteBatchRequest(const FMCPRequestEnvelope& Request, const uint64 StartCycles, bool& bOutSuccess)
+{
+	bOutSuccess = false;
+
+	UMCPEventStreamSubsystem* EventStream = GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>();
+	UMCPObservabilitySubsystem* Observability = GetObservabilitySubsystem();
+	UMCPToolRegistrySubsystem* ToolRegistry = GEditor->GetEditorSubsystem<UMCPToolRegistrySubsystem>();
+	UMCPPolicySubsystem* PolicySubsystem = GEditor->GetEditorSubsystem<UMCPPolicySubsystem>();
+	UMCPLockSubsystem* LockSubsystem = GEditor->GetEditorSubsystem<UMCPLockSubsystem>();
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>();
+	UMCPJobSubsystem* JobSubsystem = GEditor->GetEditorSubsystem<UMCPJobSubsystem>();
+
+	FMCPToolExecutionResult BatchResult;
+	const auto FinishWithError = [this, EventStream, Observability, &Request, StartCycles, &BatchResult](const FMCPDiagnostic& Diagnostic, const TCHAR* Phase)
+	{
+		BatchResult.Status = EMCPResponseStatus::Error;
+		BatchResult.Diagnostics.Add(Diagnostic);
+		if (Observability != nullptr)
+		{
+			Observability->RecordToolExecution(Request.Tool, EMCPResponseStatus::Error, MCPTime::MicrosecondsSince(StartCycles), false);
+		}
+		if (EventStream != nullptr)
+		{
+			EventStream->EmitLog(Request.RequestId, Diagnostic.Severity, Diagnostic.Message);
+			EventStream->EmitProgress(Request.RequestId, 100.0, Phase);
+		}
+
+		const FString ResponseJson = MCPJson::BuildResponseEnvelope(Request, BatchResult, TEXT(""), MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, BatchResult.Status);
+		return ResponseJson;
+	};
+
+	if (Request.Context.bAsync)
+	{
+		FMCPDiagnostic Diagnostic;
+		Diagnostic.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
+		Diagnostic.Message = TEXT("context.async is not supported for mcp.batch.");
+		Diagnostic.Suggestion = TEXT("Submit read-only calls individually with context.async=true.");
+		return FinishWithError(Diagnostic, TEXT("request.failed.async"));
+	}
+
+	FString Mode = TEXT("stop_on_error");
+	const TArray<TSharedPtr<FJsonValue>>* CallValues = nullptr;
+	if (Request.Params.IsValid())
+	{
+		Request.Params->TryGetStringField(TEXT("mode"), Mode);
+		Request.Params->TryGetArrayField(TEXT("calls"), CallValues);
+	}
+	const bool bStopOnError = !Mode.Equals(TEXT("continue"), ESearchCase::CaseSensitive);
+	const int32 CallCount = CallValues != nullptr ? CallValues->Num() : 0;
+
+	struct FBatchCall
+	{
+		FMCPRequestEnvelope Envelope;
+		FMCPToolExecutionResult Result;
+		bool bWriteTool = false;
+		bool bRunnable = true;
+		bool bSkipped = false;
+	};
+
+	TArray<FBatchCall> Calls;
+	Calls.SetNum(CallCount);
+	TArray<FString> BatchLockKeys;
+
+	// Validate and authorize every call up front so a stop_on_error batch never applies a prefix of its writes.
+	for (int32 CallIndex = 0; CallIndex < CallCount; ++CallIndex)
+	{
+		FBatchCall& Call = Calls[CallIndex];
+		const TSharedPtr<FJsonObject>* CallObject = nullptr;
+		(*CallValues)[CallIndex]->TryGetObject(CallObject);
+
+		FString CallRequestId;
+		const TSharedPtr<FJsonObject>* CallParams = nullptr;
+		if (CallObject != nullptr && CallObject->IsValid())
+		{
+			(*CallObject)->TryGetStringField(TEXT("tool"), Call.Envelope.Tool);
+			(*CallObject)->TryGetStringField(TEXT("request_id"), CallRequestId);
+			(*CallObject)->TryGetObjectField(TEXT("params"), CallParams);
+		}
+
+		Call.Envelope.Protocol = Request.Protocol;
+		Call.Envelope.SessionId = Request.SessionId;
+		Call.Envelope.RequestId = CallRequestId.IsEmpty() ? FString::Printf(TEXT("%s.%d"), *Request.RequestId, CallIndex) : CallRequestId;
+		Call.Envelope.Params = CallParams != nullptr && CallParams->IsValid() ? *CallParams : MakeShared<FJsonObject>();
+		Call.Envelope.Context = Request.Context;
+		Call.Envelope.Context.IdempotencyKey.Empty();
+		Call.Envelope.Context.CancelToken.Empty();
+		Call.Envelope.Context.bHasCancelToken = false;
+
+		FMCPDiagnostic CallDiagnostic;
+		bool bCallValid = true;
+		if (Call.Envelope.Tool.Equals(BatchToolName, ESearchCase::CaseSensitive))
+		{
+			CallDiagnostic.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
+			CallDiagnostic.Message = TEXT("mcp.batch calls cannot be nested.");
+			bCallValid = false;
+		}
+		else
+		{
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::SchemaValidate, Call.Envelope.RequestId, Call.Envelope.Tool);
+			bCallValid = ToolRegistry->ValidateRequest(Call.Envelope, CallDiagnostic);
+		}
+
+		if (bCallValid)
+		{
+			Call.bWriteTool = ToolRegistry->IsWriteTool(Call.Envelope.Tool);
+			if (Call.bWriteTool)
+			{
+				const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Policy, Call.Envelope.RequestId, Call.Envelope.Tool);
+				bCallValid = PolicySubsystem->PreflightAuthorize(Call.Envelope, CallDiagnostic);
+				if (!bCallValid && Observability != nullptr)
+				{
+					Observability->RecordPolicyDenied(CallDiagnostic.Code.Equals(MCPErrorCodes::EDITOR_UNSAFE_STATE, ESearchCase::CaseSensitive));
+				}
+			}
+		}
+		else if (Observability != nullptr)
+		{
+			Observability->RecordSchemaValidationError();
+		}
+
+		if (!bCallValid)
+		{
+			if (bStopOnError)
+			{
+				FMCPDiagnostic PreflightDiagnostic = CallDiagnostic;
+				PreflightDiagnostic.Message = FString::Printf(TEXT("Batch call %d (%s) failed preflight; no calls were executed: %s"), CallIndex, *Call.Envelope.Tool, *CallDiagnostic.Message);
+				return FinishWithError(PreflightDiagnostic, TEXT("request.failed.batch_preflight"));
+			}
+
+			Call.bRunnable = false;
+			Call.Result.Status = EMCPResponseStatus::Error;
+			Call.Result.Diagnostics.Add(CallDiagnostic);
+			continue;
+		}
+
+		if (Call.bWriteTool)
+		{
+			for (const FString& LockKey : TryResolveLockKeys(Call.Envelope))
+			{
+				BatchLockKeys.AddUnique(LockKey);
+			}
+		}
+	}
+
+	// One sorted acquisition for the whole batch keeps lock order consistent across concurrent batches.
+	BatchLockKeys.Sort();
+	TArray<FString> AcquiredLockKeys;
+	ON_SCOPE_EXIT
+	{
+		for (const FString& LockKey : AcquiredLockKeys)
+		{
+			LockSubsystem->ReleaseLock(LockKey, Request.RequestId);
+		}
+	};
+
+	FMCPDiagnostic LockDiagnostic;
+	bool bLocksAcquired = true;
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Lock, Request.RequestId, Request.Tool);
+		for (const FString& LockKey : BatchLockKeys)
+		{
+			if (!LockSubsystem->AcquireLock(LockKey, Request.RequestId, BatchLockLeaseMs, LockDiagnostic))
+			{
+				bLocksAcquired = false;
+				break;
+			}
+
+			AcquiredLockKeys.Add(LockKey);
+		}
+	}
+	if (!bLocksAcquired)
+	{
+		return FinishWithError(LockDiagnostic, TEXT("request.failed.lock"));
+	}
+
+	TSharedPtr<FMCPCancellationToken> Cancellation;
+	if ((Request.Context.bHasTimeoutOverride && Request.Context.TimeoutMs > 0) || Request.Context.bHasCancelToken)
+	{
+		Cancellation = MakeShared<FMCPCancellationToken>();
+		if (Request.Context.bHasTimeoutOverride)
+		{
+			Cancellation->SetDeadlineCycles(StartCycles + MCPTime::MillisecondsToCycles(Request.Context.TimeoutMs));
+		}
+		if (Request.Context.bHasCancelToken)
+		{
+			JobSubsystem->RegisterCancellationToken(Request.Context.CancelToken, Cancellation.ToSharedRef());
+		}
+	}
+	ON_SCOPE_EXIT
+	{
+		if (Cancellation.IsValid() && Request.Context.bHasCancelToken)
+		{
+			JobSubsystem->UnregisterCancellationToken(Request.Context.CancelToken, Cancellation.ToSharedRef());
+		}
+	};
+
+	int32 ExecutedCount = 0;
+	int32 SucceededCount = 0;
+	int32 FailedCount = 0;
+	int32 SkippedCount = 0;
+	int32 FirstFailedIndex = INDEX_NONE;
+	bool bHalted = false;
+	bool bAnyWriteSucceeded = false;
+	UMCPBlueprintCompileSubsystem* BlueprintCompileSubsystem = GEditor->GetEditorSubsystem<UMCPBlueprintCompileSubsystem>();
+	if (BlueprintCompileSubsystem != nullptr)
+	{
+		BlueprintCompileSubsystem->BeginBatchScope();
+	}
+	UMCPSnapshotStoreSubsystem* SnapshotStore = !Request.Context.bDryRun ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+	if (SnapshotStore != nullptr)
+	{
+		SnapshotStore->BeginCapture();
+	}
+
+	for (int32 CallIndex = 0; CallIndex < CallCount; ++CallIndex)
+	{
+		FBatchCall& Call = Calls[CallIndex];
+		if (!Call.bRunnable)
+		{
+			++FailedCount;
+			FirstFailedIndex = FirstFailedIndex == INDEX_NONE ? CallIndex : FirstFailedIndex;
+			continue;
+		}
+
+		if (bHalted || (Cancellation.IsValid() && Cancellation->ShouldStop()))
+		{
+			Call.bSkipped = true;
+			++SkippedCount;
+			continue;
+		}
+
+		if (EventStream != nullptr)
+		{
+			EventStream->RegisterRequestSession(Call.Envelope.RequestId, Request.SessionId);
+			EventStream->EmitProgress(Request.RequestId, 10.0 + 80.0 * static_cast<double>(CallIndex) / static_cast<double>(CallCount), TEXT("batch.call"));
+		}
+
+		Call.Result.Cancellation = Cancellation;
+		const uint64 CallBeginCycles = MCPTime::NowCycles();
+		{
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::Execute, Call.Envelope.RequestId, Call.Envelope.Tool);
+			ToolRegistry->ExecuteTool(Call.Envelope, Call.Result);
+		}
+		if (Call.Result.Status != EMCPResponseStatus::Error)
+		{
+			PolicySubsystem->PostflightApply(Call.Envelope, Call.Result);
+		}
+		if (Observability != nullptr)
+		{
+			Observability->RecordToolExecution(Call.Envelope.Tool, Call.Result.Status, MCPTime::MicrosecondsSince(CallBeginCycles), false);
+		}
+
+		++ExecutedCount;
+		if (Call.Result.Status == EMCPResponseStatus::Error)
+		{
+			++FailedCount;
+			FirstFailedIndex = FirstFailedIndex == INDEX_NONE ? CallIndex : FirstFailedIndex;
+			bHalted = bStopOnError;
+			continue;
+		}
+
+		++SucceededCount;
+		bAnyWriteSucceeded |= Call.bWriteTool;
+		for (const FString& TouchedPackage : Call.Result.TouchedPackages)
+		{
+			BatchResult.TouchedPackages.AddUnique(TouchedPackage);
+		}
+		BatchResult.Artifacts.Append(Call.Result.Artifacts);
+	}
+
+	// Blueprints modified by calls in this batch are compiled once here, while the batch locks are still held.
+	FMCPBlueprintFlushResult BlueprintFlushResult;
+	if (BlueprintCompileSubsystem != nullptr)
+	{
+		BlueprintCompileSubsystem->EndBatchScope(BlueprintFlushResult);
+	}
+
+	// Ends after the blueprint flush so its saves are captured before they overwrite the package files.
+	TArray<FMCPPackageSnapshot> PackageSnapshots;
+	if (SnapshotStore != nullptr)
+	{
+		SnapshotStore->EndCapture(bAnyWriteSucceeded ? BatchResult.TouchedPackages : TArray<FString>(), PackageSnapshots);
+	}
+
+	if (SucceededCount == CallCount)
+	{
+		BatchResult.Status = EMCPResponseStatus::Ok;
+	}
+	else
+	{
+		BatchResult.Status = SucceededCount > 0 ? EMCPResponseStatus::Partial : EMCPResponseStatus::Error;
+	}
+
+	if (FailedCount > 0)
+	{
+		FMCPDiagnostic FailedDiagnostic;
+		FailedDiagnostic.Code = MCPErrorCodes::BATCH_CALL_FAILED;
+		FailedDiagnostic.Severity = BatchResult.Status == EMCPResponseStatus::Error ? TEXT("error") : TEXT("warning");
+		FailedDiagnostic.Message = FString::Printf(TEXT("%d of %d batch calls failed."), FailedCount, CallCount);
+		FailedDiagnostic.Detail = FString::Printf(TEXT("first_failed_index=%d tool=%s mode=%s"), FirstFailedIndex, *Calls[FirstFailedIndex].Envelope.Tool, *Mode);
+		FailedDiagnostic.Suggestion = TEXT("Inspect results[].diagnostics for the failing calls.");
+		BatchResult.Diagnostics.Add(FailedDiagnostic);
+	}
+
+	const EMCPStopReason StopReason = Cancellation.IsValid() ? Cancellation->GetStopReason() : EMCPStopReason::None;
+	if (StopReason != EMCPStopReason::None)
+	{
+		FMCPDiagnostic StopDiagnostic;
+		StopDiagnostic.Code = StopReason == EMCPStopReason::Canceled ? MCPErrorCodes::JOB_CANCELED : MCPErrorCodes::JOB_TIMEOUT;
+		StopDiagnostic.Severity = TEXT("warning");
+		StopDiagnostic.Message = StopReason == EMCPStopReason::Canceled ? TEXT("Batch was canceled; remaining calls were skipped.") : TEXT("Batch exceeded timeout_ms; remaining calls were skipped.");
+		StopDiagnostic.Detail = FString::Printf(TEXT("executed=%d skipped=%d"), ExecutedCount, SkippedCount);
+		StopDiagnostic.bRetriable = StopReason == EMCPStopReason::DeadlineExceeded;
+		BatchResult.Diagnostics.Add(StopDiagnostic);
+		if (Observability != nullptr && StopReason == EMCPStopReason::DeadlineExceeded)
+		{
+			Observability->RecordTimeoutExceeded();
+		}
+	}
+
+	FString ChangeSetId;
+	if (bAnyWriteSucceeded && !Request.Context.bDryRun)
+	{
+		FMCPDiagnostic ChangeSetDiagnostic;
+		FMCPChangeSetRecordStats ChangeSetStats;
+		bool bChangeSetCreated = false;
+		{
+			const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::ChangeSetWrite, Request.RequestId, Request.Tool);
+			bChangeSetCreated = ChangeSetSubsystem->CreateChangeSetRecord(
+				Request,
+				BatchResult,
+				PolicySubsystem->GetPolicyVersion(),
+				ToolRegistry->GetSchemaHash(),
+				PackageSnapshots,
+				ChangeSetId,
+				ChangeSetStats,
+				ChangeSetDiagnostic);
+		}
+		if (!bChangeSetCreated)
+		{
+			BatchResult.Status = EMCPResponseStatus::Error;
+			BatchResult.Diagnostics.Add(ChangeSetDiagnostic);
+		}
+		else
+		{
+			const FString ChangeSetPath = ChangeSetSubsystem->GetChangeSetLocation(ChangeSetId);
+			if (EventStream != nullptr)
+			{
+				EventStream->EmitChangeSetCreated(Request.RequestId, ChangeSetId, ChangeSetPath);
+			}
+			if (Observability != nullptr)
+			{
+				Observability->RecordChangeSetCreated(ChangeSetStats.ApproximateBytes, ChangeSetStats.SnapshotCount);
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> CallResultValues;
+	CallResultValues.Reserve(CallCount);
+	for (int32 CallIndex = 0; CallIndex < CallCount; ++CallIndex)
+	{
+		FBatchCall& Call = Calls[CallIndex];
+		if (!Call.Result.ResultObject.IsValid() && !Call.Result.ResultJson.IsEmpty())
+		{
+			const TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(Call.Result.ResultJson);
+			FJsonSerializer::Deserialize(ResultReader, Call.Result.ResultObject);
+		}
+
+		TArray<TSharedPtr<FJsonValue>> TouchedPackageValues;
+		for (const FString& TouchedPackage : Call.Result.TouchedPackages)
+		{
+			TouchedPackageValues.Add(MakeShared<FJsonValueString>(TouchedPackage));
+		}
+
+		TSharedRef<FJsonObject> CallResultObject = MakeShared<FJsonObject>();
+		CallResultObject->SetNumberField(TEXT("index"), CallIndex);
+		CallResultObject->SetStringField(TEXT("tool"), Call.Envelope.Tool);
+		CallResultObject->SetStringField(TEXT("request_id"), Call.Envelope.RequestId);
+		CallResultObject->SetStringField(TEXT("status"), Call.bSkipped ? TEXT("skipped") : MCPJson::StatusToString(Call.Result.Status));
+		CallResultObject->SetObjectField(TEXT("result"), Call.Result.ResultObject.IsValid() ? Call.Result.ResultObject.ToSharedRef() : MakeShared<FJsonObject>());
+		CallResultObject->SetObjectField(TEXT("diagnostics"), MCPJson::BuildDiagnosticsObject(Call.Result.Diagnostics));
+		CallResultObject->SetArrayField(TEXT("touched_packages"), TouchedPackageValues);
+		CallResultValues.Add(MakeShared<FJsonValueObject>(CallResultObject));
+	}
+
+	BatchResult.ResultObject = MakeShared<FJsonObject>();
+	BatchResult.ResultObject->SetStringField(TEXT("mode"), bStopOnError ? TEXT("stop_on_error") : TEXT("continue"));
+	BatchResult.ResultObject->SetNumberField(TEXT("call_count"), CallCount);
+	BatchResult.ResultObject->SetNumberField(TEXT("executed_count"), ExecutedCount);
+	BatchResult.ResultObject->SetNumberField(TEXT("succeeded_count"), SucceededCount);
+	BatchResult.ResultObject->SetNumberField(TEXT("failed_count"), FailedCount);
+	BatchResult.ResultObject->SetNumberField(TEXT("skipped_count"), SkippedCount);
+
+	TArray<TSharedPtr<FJsonValue>> CompiledBlueprintValues;
+	for (const FString& CompiledObjectPath : BlueprintFlushResult.CompiledObjectPaths)
+	{
+		CompiledBlueprintValues.Add(MakeShared<FJsonValueString>(CompiledObjectPath));
+	}
+	TSharedRef<FJsonObject> BlueprintCompileObject = MakeShared<FJsonObject>();
+	BlueprintCompileObject->SetArrayField(TEXT("compiled"), CompiledBlueprintValues);
+	BlueprintCompileObject->SetNumberField(TEXT("coalesced_request_count"), BlueprintFlushResult.CoalescedRequestCount);
+	BlueprintCompileObject->SetNumberField(TEXT("compile_ms"), MCPTime::MicrosecondsToMilliseconds(BlueprintFlushResult.CompileDurationUs));
+	BatchResult.ResultObject->SetObjectField(TEXT("blueprint_compile"), BlueprintCompileObject);
+	for (const FString& PackageName : BlueprintFlushResult.FailedSavePackages)
+	{
+		FMCPDiagnostic SaveDiagnostic;
+		SaveDiagnostic.Code = MCPErrorCodes::SAVE_FAILED;
+		SaveDiagnostic.Severity = TEXT("warning");
+		SaveDiagnostic.Message = TEXT("Package save failed after blueprint compile.");
+		SaveDiagnostic.Detail = PackageName;
+		SaveDiagnostic.bRetriable = true;
+		BatchResult.Diagnostics.Add(SaveDiagnostic);
+	}
+	BatchResult.ResultObject->SetArrayField(TEXT("results"), CallResultValues);
+
+	if (EventStream != nullptr)
+	{
+		for (const FString& TouchedPackage : BatchResult.TouchedPackages)
+		{
+			EventStream->EmitArtifact(Request.RequestId, TouchedPackage, TEXT("touched_package"));
+		}
+		EventStream->EmitLog(
+			Request.RequestId,
+			TEXT("info"),
+			FString::Printf(TEXT("Completed batch of %d calls with status %s"), CallCount, *MCPJson::StatusToString(BatchResult.Status)));
+		EventStream->EmitProgress(Request.RequestId, 100.0, TEXT("request.completed"));
+	}
+	if (Observability != nullptr)
+	{
+		Observability->RecordToolExecution(Request.Tool, BatchResult.Status, MCPTime::MicrosecondsSince(StartCycles), false);
+	}
+
+	FString ResponseJson;
+	{
+		const FMCPPhaseScope PhaseScope(Observability, EMCPLatencyPhase::ResponseBuild, Request.RequestId, Request.Tool);
+		ResponseJson = MCPJson::BuildResponseEnvelope(Request, BatchResult, ChangeSetId, MCPTime::MicrosecondsSince(StartCycles));
+		CacheIdempotencyResponse(Request, ResponseJson, BatchResult.Status);
+	}
+	bOutSuccess = BatchResult.Status != EMCPResponseStatus::Error;
+	return ResponseJson;
+}
+
+void UMCPCommandRouterSubsystem::ScheduleAsyncJob(const FMCPRequestEnvelope& Request, const FString& JobId)
+{
+	const TWeakObjectPtr<UMCPCommandRouterSubsystem> WeakThis(this);
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis, Request, JobId](float)
+	{
+		if (UMCPCommandRouterSubsystem* Router = WeakThis.Get())
+		{
+			Router->RunAsyncJob(Request, JobId);
+		}
+		else
+		{
+			CancelOrphanedAsyncJob(Request, JobId, nullptr);
+		}
+		return false;
+	}));
+}
+
+void UMCPCommandRouterSubsystem::RunAsyncJob(const FMCPRequestEnvelope& Request, const FString& JobId)
+{
+	UMCPToolRegistrySubsystem* ToolRegistry = GEditor ? GEditor->GetEditorSubsystem<UMCPToolRegistrySubsystem>() : nullptr;
+	UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+	if (ToolRegistry == nullptr || JobSubsystem == nullptr)
+	{
+		return;
+	}
+
+	FMCPJobRecord QueuedRecord;
+	if (!JobSubsystem->GetJob(JobId, QueuedRecord) || QueuedRecord.Status != EMCPJobStatus::Queued)
+	{
+		return;
+	}
+
+	const uint64 BeginCycles = MCPTime::NowCycles();
+	const TSharedRef<FMCPToolExecutionResult> Execution = MakeShared<FMCPToolExecutionResult>();
+	const TSharedRef<FMCPCancellationToken> Cancellation = MakeShared<FMCPCancellationToken>();
+	if (Request.Context.bHasTimeoutOverride && Request.Context.TimeoutMs > 0)
+	{
+		Cancellation->SetDeadlineCycles(BeginCycles + MCPTime::MillisecondsToCycles(Request.Context.TimeoutMs));
+	}
+	JobSubsystem->RegisterCancellationToken(JobId, Cancellation);
+	if (Request.Context.bHasCancelToken)
+	{
+		JobSubsystem->RegisterCancellationToken(Request.Context.CancelToken, Cancellation);
+	}
+	Execution->Cancellation = Cancellation;
+
+	JobSubsystem->UpdateJobStatus(JobId, EMCPJobStatus::Running, 10.0);
+	{
+		const FMCPPhaseScope PhaseScope(GetObservabilitySubsystem(), EMCPLatencyPhase::Execute, Request.RequestId, Request.Tool);
+		ToolRegistry->ExecuteTool(Request, *Execution);
+	}
+
+	if (!Execution->WorkerStage || Execution->Status == EMCPResponseStatus::Error)
+	{
+		CompleteAsyncJob(Request, JobId, Execution, BeginCycles);
+		return;
+	}
+
+	JobSubsystem->UpdateJobStatus(JobId, EMCPJobStatus::Running, 40.0);
+	const TWeakObjectPtr<UMCPCommandRouterSubsystem> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, Request, JobId, Execution, BeginCycles]()
+	{
+		{
+			const FMCPTraceScope WorkerTraceScope(TEXT("mcp.stage"), TEXT("worker"), Request.RequestId, Request.Tool);
+			Execution->RunWorkerStage();
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Request, JobId, Execution, BeginCycles]()
+		{
+			if (UMCPCommandRouterSubsystem* Router = WeakThis.Get())
+			{
+				Router->CompleteAsyncJob(Request, JobId, Execution, BeginCycles);
+			}
+			else
+			{
+				CancelOrphanedAsyncJob(Request, JobId, Execution->Cancellation);
+			}
+		});
+	});
+}
+
+void UMCPCommandRouterSubsystem::CompleteAsyncJob(
+	const FMCPRequestEnvelope& Request,
+	const FString& JobId,
+	const TSharedRef<FMCPToolExecutionResult>& Execution,
+	const uint64 BeginCycles)
+{
+	UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+	if (JobSubsystem == nullptr)
+	{
+		return;
+	}
+
+	if (Execution->Status != EMCPResponseStatus::Error)
+	{
+		JobSubsystem->UpdateJobStatus(JobId, EMCPJobStatus::Running, 80.0);
+		Execution->RunCommitStage();
+	}
+
+	const EMCPStopReason StopReason = Execution->Cancellation.IsValid() ? Execution->Cancellation->GetStopReason() : EMCPStopReason::None;
+	if (Execution->Cancellation.IsValid())
+	{
+		const TSharedRef<FMCPCancellationToken> Cancellation = Execution->Cancellation.ToSharedRef();
+		JobSubsystem->UnregisterCancellationToken(JobId, Cancellation);
+		if (Request.Context.bHasCancelToken)
+		{
+			JobSubsystem->UnregisterCancellationToken(Request.Context.CancelToken, Cancellation);
+		}
+	}
+
+	if (StopReason != EMCPStopReason::None)
+	{
+		FMCPDiagnostic StopDiagnostic;
+		StopDiagnostic.Severity = TEXT("warning");
+		if (StopReason == EMCPStopReason::Canceled)
+		{
+			StopDiagnostic.Code = MCPErrorCodes::JOB_CANCELED;
+			StopDiagnostic.Message = TEXT("Execution was canceled; results are partial.");
+		}
+		else
+		{
+			StopDiagnostic.Code = MCPErrorCodes::JOB_TIMEOUT;
+			StopDiagnostic.Message = TEXT("Execution exceeded timeout_ms.");
+			StopDiagnostic.Suggestion = TEXT("Increase timeout_ms or narrow the request.");
+			StopDiagnostic.bRetriable = true;
+		}
+		StopDiagnostic.Detail = FString::Printf(TEXT("job_id=%s stopped_early=true"), *JobId);
+		Execution->Diagnostics.Add(StopDiagnostic);
+		if (Execution->Status == EMCPResponseStatus::Ok)
+		{
+			Execution->Status = EMCPResponseStatus::Partial;
+		}
+	}
+
+	if (!Execution->ResultObject.IsValid() && !Execution->ResultJson.IsEmpty())
+	{
+		const TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(Execution->ResultJson);
+		FJsonSerializer::Deserialize(ResultReader, Execution->ResultObject);
+		Execution->ResultJson.Empty();
+	}
+	if (!Execution->ResultObject.IsValid())
+	{
+		Execution->ResultObject = MakeShared<FJsonObject>();
+	}
+
+	const EMCPJobStatus FinalJobStatus = StopReason == EMCPStopReason::Canceled ? EMCPJobStatus::Canceled : ToJobStatus(Execution->Status);
+	JobSubsystem->FinalizeJob(JobId, FinalJobStatus, Execution->ResultObject, Execution->Diagnostics);
+
+	if (UMCPObservabilitySubsystem* Observability = GetObservabilitySubsystem())
+	{
+		Observability->RecordToolExecution(Request.Tool, Execution->Status, MCPTime::MicrosecondsSince(BeginCycles), false);
+	}
+
+	if (UMCPEventStreamSubsystem* EventStream = GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>())
+	{
+		EventStream->EmitLog(
+			Request.RequestId,
+			TEXT("info"),
+			FString::Printf(TEXT("Completed async job %s for tool %s with status %s"), *JobId, *Request.Tool, *MCPJson::StatusToString(Execution->Status)));
+	}
+}
+
 bool UMCPCommandRouterSubsystem::ValidateProtocol(const FString& Protocol, FMCPDiagnostic& OutDiagnostic) const
 {
 	if (Protocol.StartsWith(TEXT("unreal-mcp/1")))
@@ -664,67 +1511,41 @@ bool UMCPCommandRouterSubsystem::ValidateProtocol(const FString& Protocol, FMCPD
 bool UMCPCommandRouterSubsystem::CheckIdempotencyReplay(
 	const FMCPRequestEnvelope& Request,
 	FString& OutCachedResponse,
+	EMCPResponseStatus& OutCachedStatus,
 	bool& bOutConflict,
 	FMCPDiagnostic& OutConflictDiagnostic)
 {
 	bOutConflict = false;
 	OutCachedResponse.Empty();
 
-	if (Request.Context.IdempotencyKey.IsEmpty())
+	if (Request.Context.IdempotencyKey.IsEmpty() || !IdempotencyCache.IsValid())
 	{
 		return false;
 	}
 
 	const FString BaseKey = BuildIdempotencyBaseKey(Request);
-	const FString FullKey = BuildIdempotencyFullKey(Request);
-	const FString ParamsHash = MCPJson::HashJsonObject(Request.Params);
-
-	FScopeLock ScopeLock(&IdempotencyGuard);
-
-	if (const FString* ExistingHash = ParamsHashByIdempotencyBaseKey.Find(BaseKey))
-	{
-		if (*ExistingHash != ParamsHash)
-		{
-			bOutConflict = true;
-			OutConflictDiagnostic.Code = MCPErrorCodes::IDEMPOTENCY_CONFLICT;
-			OutConflictDiagnostic.Message = TEXT("Idempotency key was reused with a different payload.");
-			OutConflictDiagnostic.Detail = BaseKey;
-			OutConflictDiagnostic.Suggestion = TEXT("Use a new idempotency_key for different params.");
-			return false;
-		}
-	}
-
-	if (const FString* CachedResponse = CachedResponsesByIdempotencyKey.Find(FullKey))
+	const EMCPToolResultCacheLookup Lookup = IdempotencyCache->Find(BaseKey, Request.ParamsHash, MCPTime::GetUnixTimestampMs(), OutCachedStatus, OutCachedResponse);
+	if (Lookup == EMCPToolResultCacheLookup::Conflict)
 	{
-		OutCachedResponse = *CachedResponse;
-
-		TSharedPtr<FJsonObject> RootObject;
-		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(OutCachedResponse);
-		if (FJsonSerializer::Deserialize(Reader, RootObject) && RootObject.IsValid())
-		{
-			RootObject->SetBoolField(TEXT("idempotent_replay"), true);
-			OutCachedResponse = MCPJson::SerializeJsonObject(RootObject);
-		}
-		return true;
+		bOutConflict = true;
+		OutConflictDiagnostic.Code = MCPErrorCodes::IDEMPOTENCY_CONFLICT;
+		OutConflictDiagnostic.Message = TEXT("Idempotency key was reused with a different payload.");
+		OutConflictDiagnostic.Detail = BaseKey;
+		OutConflictDiagnostic.Suggestion = TEXT("Use a new idempotency_key for different params.");
+		return false;
 	}
 
-	return false;
+	return Lookup == EMCPToolResultCacheLookup::Hit;
 }
 
-void UMCPCommandRouterSubsystem::CacheIdempotencyResponse(const FMCPRequestEnvelope& Request, const FString& ResponseJson)
+void UMCPCommandRouterSubsystem::CacheIdempotencyResponse(const FMCPRequestEnvelope& Request, const FString& ResponseJson, const EMCPResponseStatus Status)
 {
-	if (Request.Context.IdempotencyKey.IsEmpty())
+	if (Request.Context.IdempotencyKey.IsEmpty() || !IdempotencyCache.IsValid())
 	{
 		return;
 	}
 
-	const FString BaseKey = BuildIdempotencyBaseKey(Request);
-	const FString FullKey = BuildIdempotencyFullKey(Request);
-	const FString ParamsHash = MCPJson::HashJsonObject(Request.Params);
-
-	FScopeLock ScopeLock(&IdempotencyGuard);
-	ParamsHashByIdempotencyBaseKey.FindOrAdd(BaseKey) = ParamsHash;
-	CachedResponsesByIdempotencyKey.FindOrAdd(FullKey) = ResponseJson;
+	IdempotencyCache->Add(BuildIdempotencyBaseKey(Request), Request.ParamsHash, Status, BuildReplayResponseJson(ResponseJson), MCPTime::GetUnixTimestampMs());
 }
 
 FString UMCPCommandRouterSubsystem::BuildIdempotencyBaseKey(const FMCPRequestEnvelope& Request) const
@@ -732,7 +1553,43 @@ FString UMCPCommandRouterSubsystem::BuildIdempotencyBaseKey(const FMCPRequestEnv
 	return FString::Printf(TEXT("%s|%s|%s"), *Request.SessionId, *Request.Tool, *Request.Context.IdempotencyKey);
 }
 
-FString UMCPCommandRouterSubsystem::BuildIdempotencyFullKey(const FMCPRequestEnvelope& Request) const
+FMCPToolResultCacheSettings UMCPCommandRouterSubsystem::LoadIdempotencySettings() const
 {
-	return BuildIdempotencyBaseKey(Request) + TEXT("|") + MCPJson::HashJsonObject(Request.Params);
+	const TCHAR* Section = TEXT("UnrealMCP.Idempotency");
+	FMCPToolResultCacheSettings Settings;
+	Settings.SpillDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("Idempotency"));
+	Settings.bReportObservability = true;
+
+	int32 ConfiguredMaxEntries = Settings.MaxEntries;
+	if (GConfig->GetInt(Section, TEXT("MaxEntries"), ConfiguredMaxEntries, GEditorPerProjectIni))
+	{
+		Settings.MaxEntries = FMath::Clamp(ConfiguredMaxEntries, 16, 1000000);
+	}
+
+	int32 ConfiguredMaxMegabytes = static_cast<int32>(Settings.MaxBytes / (1024LL * 1024LL));
+	if (GConfig->GetInt(Section, TEXT("MaxMegabytes"), ConfiguredMaxMegabytes, GEditorPerProjectIni))
+	{
+		Settings.MaxBytes = static_cast<int64>(FMath::Clamp(ConfiguredMaxMegabytes, 1, 4096)) * 1024LL * 1024LL;
+	}
+
+	int32 ConfiguredTtlSeconds = static_cast<int32>(Settings.TtlMs / 1000LL);
+	if (GConfig->GetInt(Section, TEXT("TtlSeconds"), ConfiguredTtlSeconds, GEditorPerProjectIni))
+	{
+		Settings.TtlMs = static_cast<int64>(FMath::Clamp(ConfiguredTtlSeconds, 10, 7 * 24 * 60 * 60)) * 1000LL;
+	}
+
+	int32 ConfiguredCompressionThreshold = Settings.CompressionThresholdBytes;
+	if (GConfig->GetInt(Section, TEXT("CompressionThresholdBytes"), ConfiguredCompressionThreshold, GEditorPerProjectIni))
+	{
+		Settings.CompressionThresholdBytes = FMath::Max(0, ConfiguredCompressionThreshold);
+	}
+
+	bool bConfiguredDiskSpill = Settings.bDiskSpillEnabled;
+	if (GConfig->GetBool(Section, TEXT("bDiskSpillEnabled"), bConfiguredDiskSpill, GEditorPerProjectIni))
+	{
+		Settings.bDiskSpillEnabled = bConfiguredDiskSpill;
+	}
+
+	return Settings;
 }
+
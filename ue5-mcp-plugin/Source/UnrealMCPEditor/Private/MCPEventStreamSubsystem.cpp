@@ -1,18 +1,85 @@
 #include "MCPEventStreamSubsystem.h"
 
+#include "MCPTime.h"
+#include "Misc/ConfigCacheIni.h"
 #include "Misc/Guid.h"
 
 TSharedRef<FJsonObject> FMCPStreamEvent::ToJson() const
 {
+	if (CachedJson.IsValid())
+	{
+		return CachedJson.ToSharedRef();
+	}
+
 	TSharedRef<FJsonObject> EventObject = MakeShared<FJsonObject>();
 	EventObject->SetStringField(TEXT("event_id"), EventId);
 	EventObject->SetStringField(TEXT("event_type"), EventType);
 	EventObject->SetStringField(TEXT("request_id"), RequestId);
+	if (!SessionId.IsEmpty())
+	{
+		EventObject->SetStringField(TEXT("session_id"), SessionId);
+	}
+	EventObject->SetNumberField(TEXT("sequence"), static_cast<double>(Sequence));
 	EventObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(TimestampMs));
 	EventObject->SetObjectField(TEXT("payload"), Payload.IsValid() ? Payload.ToSharedRef() : MakeShared<FJsonObject>());
 	return EventObject;
 }
 
+void UMCPEventStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LoadSettings();
+}
+
+void UMCPEventStreamSubsystem::LoadSettings()
+{
+	const TCHAR* Section = TEXT("UnrealMCP.EventStream");
+
+	bool bConfiguredSuppress = bSuppressReadOnlyIntermediateProgress;
+	if (GConfig->GetBool(Section, TEXT("bSuppressReadOnlyIntermediateProgress"), bConfiguredSuppress, GEditorPerProjectIni))
+	{
+		bSuppressReadOnlyIntermediateProgress = bConfiguredSuppress;
+	}
+
+	int32 ConfiguredMaxBufferedEvents = MaxBufferedEvents;
+	if (GConfig->GetInt(Section, TEXT("MaxBufferedEvents"), ConfiguredMaxBufferedEvents, GEditorPerProjectIni))
+	{
+		MaxBufferedEvents = FMath::Clamp(ConfiguredMaxBufferedEvents, 16, 65536);
+	}
+
+	FScopeLock ScopeLock(&EventGuard);
+	EventRing.Reset();
+	EventRing.SetNum(MaxBufferedEvents);
+}
+
+void UMCPEventStreamSubsystem::RegisterRequestSession(const FString& RequestId, const FString& SessionId)
+{
+	if (RequestId.IsEmpty() || SessionId.IsEmpty())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&EventGuard);
+	if (FString* ExistingSessionId = SessionIdByRequestId.Find(RequestId))
+	{
+		*ExistingSessionId = SessionId;
+		return;
+	}
+
+	if (TrackedSessionRequestIds.Num() < MaxTrackedRequestSessions)
+	{
+		TrackedSessionRequestIds.Add(RequestId);
+	}
+	else
+	{
+		FString& EvictedRequestId = TrackedSessionRequestIds[NextTrackedSessionSlot];
+		SessionIdByRequestId.Remove(EvictedRequestId);
+		EvictedRequestId = RequestId;
+		NextTrackedSessionSlot = (NextTrackedSessionSlot + 1) % MaxTrackedRequestSessions;
+	}
+	SessionIdByRequestId.Add(RequestId, SessionId);
+}
+
 void UMCPEventStreamSubsystem::EmitProgress(const FString& RequestId, const double Percent, const FString& Phase)
 {
 	TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
@@ -51,7 +118,8 @@ void UMCPEventStreamSubsystem::EmitJobStatus(
 	const FString& Status,
 	const double Progress,
 	const FString& StartedAtIso8601,
-	const FString& UpdatedAtIso8601)
+	const FString& UpdatedAtIso8601,
+	const TSharedPtr<FJsonObject>& Result)
 {
 	TSharedRef<FJsonObject> Payload = MakeShared<FJsonObject>();
 	Payload->SetStringField(TEXT("job_id"), JobId);
@@ -59,6 +127,10 @@ void UMCPEventStreamSubsystem::EmitJobStatus(
 	Payload->SetNumberField(TEXT("progress"), FMath::Clamp(Progress, 0.0, 100.0));
 	Payload->SetStringField(TEXT("started_at"), StartedAtIso8601);
 	Payload->SetStringField(TEXT("updated_at"), UpdatedAtIso8601);
+	if (Result.IsValid())
+	{
+		Payload->SetObjectField(TEXT("result"), Result);
+	}
 	EmitEvent(TEXT("event.job.status"), RequestId, Payload);
 }
 
@@ -71,50 +143,77 @@ void UMCPEventStreamSubsystem::EmitChangeSetCreated(const FString& RequestId, co
 }
 
 TArray<TSharedPtr<FJsonObject>> UMCPEventStreamSubsystem::GetRecentEvents(const int32 Limit) const
+{
+	const int32 SafeLimit = FMath::Max(Limit, 0);
+	const int64 LatestSequence = GetLatestSequence();
+	bool bGap = false;
+	return GetEventsAfter(FMath::Max<int64>(0, LatestSequence - SafeLimit), SafeLimit, bGap);
+}
+
+TArray<TSharedPtr<FJsonObject>> UMCPEventStreamSubsystem::GetEventsAfter(const int64 AfterSequence, const int32 Limit, bool& bOutGap) const
 {
 	TArray<TSharedPtr<FJsonObject>> OutEvents;
-	const int32 SafeLimit = FMath::Clamp(Limit, 0, MaxBufferedEvents);
-	if (SafeLimit <= 0)
+	bOutGap = false;
+
+	FScopeLock ScopeLock(&EventGuard);
+	const int32 Capacity = EventRing.Num();
+	if (Capacity <= 0 || Limit <= 0)
 	{
 		return OutEvents;
 	}
 
-	FScopeLock ScopeLock(&EventGuard);
-	const int32 Count = FMath::Min(SafeLimit, EventBuffer.Num());
-	OutEvents.Reserve(Count);
-	for (int32 Index = EventBuffer.Num() - Count; Index < EventBuffer.Num(); ++Index)
+	const int64 OldestSequence = FMath::Max<int64>(1, TotalEmittedEvents - Capacity + 1);
+	int64 FirstSequence = FMath::Max<int64>(AfterSequence + 1, 1);
+	if (FirstSequence < OldestSequence)
+	{
+		bOutGap = true;
+		FirstSequence = OldestSequence;
+	}
+
+	const int64 LastSequence = FMath::Min<int64>(TotalEmittedEvents, FirstSequence + Limit - 1);
+	if (LastSequence < FirstSequence)
 	{
-		OutEvents.Add(EventBuffer[Index].ToJson());
+		return OutEvents;
+	}
+
+	OutEvents.Reserve(static_cast<int32>(LastSequence - FirstSequence + 1));
+	for (int64 Sequence = FirstSequence; Sequence <= LastSequence; ++Sequence)
+	{
+		OutEvents.Add(EventRing[static_cast<int32>((Sequence - 1) % Capacity)]);
 	}
 	return OutEvents;
 }
 
+int64 UMCPEventStreamSubsystem::GetLatestSequence() const
+{
+	FScopeLock ScopeLock(&EventGuard);
+	return TotalEmittedEvents;
+}
+
 TSharedRef<FJsonObject> UMCPEventStreamSubsystem::BuildSnapshot(const int32 RecentLimit) const
 {
 	TSharedRef<FJsonObject> Snapshot = MakeShared<FJsonObject>();
 	Snapshot->SetBoolField(TEXT("supported"), true);
 
-	TArray<TSharedPtr<FJsonObject>> RecentEvents;
-	int32 BufferedEventCount = 0;
+	int32 Capacity = 0;
 	int64 TotalEmitted = 0;
 	int64 Dropped = 0;
+	TArray<TSharedPtr<FJsonObject>> RecentEvents;
 	{
 		FScopeLock ScopeLock(&EventGuard);
-		BufferedEventCount = EventBuffer.Num();
+		Capacity = EventRing.Num();
 		TotalEmitted = TotalEmittedEvents;
 		Dropped = DroppedEvents;
-
-		const int32 Count = FMath::Min(FMath::Clamp(RecentLimit, 0, MaxBufferedEvents), EventBuffer.Num());
-		RecentEvents.Reserve(Count);
-		for (int32 Index = EventBuffer.Num() - Count; Index < EventBuffer.Num(); ++Index)
-		{
-			RecentEvents.Add(EventBuffer[Index].ToJson());
-		}
+		RecentEvents = GetRecentEvents(RecentLimit);
 	}
+	const int64 BufferedEventCount = FMath::Min<int64>(TotalEmitted, Capacity);
 
 	Snapshot->SetNumberField(TEXT("buffered_event_count"), static_cast<double>(BufferedEventCount));
+	Snapshot->SetNumberField(TEXT("buffer_capacity"), static_cast<double>(Capacity));
 	Snapshot->SetNumberField(TEXT("total_emitted_event_count"), static_cast<double>(TotalEmitted));
 	Snapshot->SetNumberField(TEXT("dropped_event_count"), static_cast<double>(Dropped));
+	Snapshot->SetNumberField(TEXT("oldest_sequence"), static_cast<double>(BufferedEventCount > 0 ? TotalEmitted - BufferedEventCount + 1 : 0));
+	Snapshot->SetNumberField(TEXT("latest_sequence"), static_cast<double>(TotalEmitted));
 
 	TArray<TSharedPtr<FJsonValue>> RecentEventValues;
 	RecentEventValues.Reserve(RecentEvents.Num());
@@ -132,7 +231,7 @@ TSharedRef<FJsonObject> UMCPEventStreamSubsystem::BuildSnapshot(const int32 Rece
 int32 UMCPEventStreamSubsystem::GetBufferedEventCount() const
 {
 	FScopeLock ScopeLock(&EventGuard);
-	return EventBuffer.Num();
+	return static_cast<int32>(FMath::Min<int64>(TotalEmittedEvents, EventRing.Num()));
 }
 
 int64 UMCPEventStreamSubsystem::GetTotalEmittedEventCount() const
@@ -147,6 +246,11 @@ int64 UMCPEventStreamSubsystem::GetDroppedEventCount() const
 	return DroppedEvents;
 }
 
+bool UMCPEventStreamSubsystem::ShouldSuppressReadOnlyIntermediateProgress() const
+{
+	return bSuppressReadOnlyIntermediateProgress;
+}
+
 FMCPStreamEventDelegate& UMCPEventStreamSubsystem::OnEventEmitted()
 {
 	return EventDelegate;
@@ -158,25 +262,31 @@ void UMCPEventStreamSubsystem::EmitEvent(const FString& EventType, const FString
 	Event.EventId = FString::Printf(TEXT("evt-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
 	Event.EventType = EventType;
 	Event.RequestId = RequestId;
-	Event.TimestampMs = GetCurrentUnixTimestampMs();
+	Event.TimestampMs = MCPTime::GetUnixTimestampMs();
 	Event.Payload = Payload;
 
 	{
 		FScopeLock ScopeLock(&EventGuard);
-		++TotalEmittedEvents;
-		if (EventBuffer.Num() >= MaxBufferedEvents)
+		if (const FString* SessionId = SessionIdByRequestId.Find(RequestId))
+		{
+			Event.SessionId = *SessionId;
+		}
+
+		if (EventRing.Num() == 0)
+		{
+			EventRing.SetNum(MaxBufferedEvents);
+		}
+
+		Event.Sequence = ++TotalEmittedEvents;
+		TSharedPtr<FJsonObject>& Slot = EventRing[static_cast<int32>((Event.Sequence - 1) % EventRing.Num())];
+		if (Slot.IsValid())
 		{
-			EventBuffer.RemoveAt(0);
 			++DroppedEvents;
 		}
-		EventBuffer.Add(Event);
+		Event.CachedJson = Event.ToJson();
+		Slot = Event.CachedJson;
 	}
 
 	EventDelegate.Broadcast(Event);
 }
 
-int64 UMCPEventStreamSubsystem::GetCurrentUnixTimestampMs()
-{
-	return FDateTime::UtcNow().ToUnixTimestamp() * 1000LL;
-}
-
@@ -3,14 +3,47 @@
 #include "Editor.h"
 #include "MCPErrorCodes.h"
 #include "MCPEventStreamSubsystem.h"
+#include "MCPLog.h"
 #include "MCPObservabilitySubsystem.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 namespace
 {
-	void PublishJobStatusEvent(
-		const FString& RequestId,
-		const FMCPJobRecord& Record)
+	bool IsTerminalJobStatus(const EMCPJobStatus Status)
+	{
+		return Status == EMCPJobStatus::Succeeded || Status == EMCPJobStatus::Failed || Status == EMCPJobStatus::Canceled;
+	}
+
+	struct FJobStatusEvent
+	{
+		FString RequestId;
+		FString JobId;
+		EMCPJobStatus Status = EMCPJobStatus::Queued;
+		double Progress = 0.0;
+		FDateTime StartedAtUtc;
+		FDateTime UpdatedAtUtc;
+	};
+
+	FJobStatusEvent MakeJobStatusEvent(const FMCPJobRecord& Record)
+	{
+		FJobStatusEvent Event;
+		Event.RequestId = Record.RequestId;
+		Event.JobId = Record.JobId;
+		Event.Status = Record.Status;
+		Event.Progress = Record.Progress;
+		Event.StartedAtUtc = Record.StartedAtUtc;
+		Event.UpdatedAtUtc = Record.UpdatedAtUtc;
+		return Event;
+	}
+
+	void PublishJobStatusEvent(const FJobStatusEvent& Event, const TSharedPtr<FJsonObject>& PushedResult = nullptr)
 	{
 		if (GEditor == nullptr)
 		{
@@ -20,61 +53,114 @@ namespace
 		if (UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>())
 		{
 			EventStreamSubsystem->EmitJobStatus(
-				RequestId,
-				Record.JobId,
-				UMCPJobSubsystem::StatusToString(Record.Status),
-				Record.Progress,
-				Record.StartedAtUtc.ToIso8601(),
-				Record.UpdatedAtUtc.ToIso8601());
+				Event.RequestId,
+				Event.JobId,
+				UMCPJobSubsystem::StatusToString(Event.Status),
+				Event.Progress,
+				Event.StartedAtUtc.ToIso8601(),
+				Event.UpdatedAtUtc.ToIso8601(),
+				PushedResult);
 		}
 
 		if (UMCPObservabilitySubsystem* ObservabilitySubsystem = GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>())
 		{
-			ObservabilitySubsystem->RecordJobStatus(UMCPJobSubsystem::StatusToString(Record.Status));
+			ObservabilitySubsystem->RecordJobStatus(UMCPJobSubsystem::StatusToString(Event.Status));
+		}
+	}
+
+	void PublishJobStoreUsage(
+		const int32 RetainedCount,
+		const int64 ResultBytes,
+		const int32 CapacityEvictions,
+		const int32 ExpiredEvictions,
+		const bool bSpilledResult)
+	{
+		UMCPObservabilitySubsystem* ObservabilitySubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
+		if (ObservabilitySubsystem == nullptr)
+		{
+			return;
+		}
+
+		if (CapacityEvictions > 0 || ExpiredEvictions > 0)
+		{
+			ObservabilitySubsystem->RecordJobEvictions(CapacityEvictions, ExpiredEvictions);
 		}
+		if (bSpilledResult)
+		{
+			ObservabilitySubsystem->RecordJobResultSpill();
+		}
+		ObservabilitySubsystem->RecordJobStoreUsage(RetainedCount, ResultBytes);
+	}
+
+	int64 GetStoredResultBytes(const FString& ResultJson)
+	{
+		return static_cast<int64>(ResultJson.Len()) * sizeof(TCHAR);
 	}
 }
 
-FString UMCPJobSubsystem::CreateJob()
+void UMCPJobSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LoadRetentionSettings();
+
+	// Job records only live for the editor session, so spilled results from earlier sessions are unreachable.
+	IFileManager::Get().DeleteDirectory(*GetResultSpillDir(), false, true);
+}
+
+FString UMCPJobSubsystem::CreateJob(const FString& RequestId, const bool bAsync)
 {
-	FMCPJobRecord Record;
+	FJobStatusEvent Event;
+	int32 CapacityEvictions = 0;
+	int32 ExpiredEvictions = 0;
+	int32 RetainedCount = 0;
+	int64 ResultBytes = 0;
 	{
 		FScopeLock ScopeLock(&JobGuard);
-		Record.JobId = FString::Printf(TEXT("job-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+		const FString JobId = FString::Printf(TEXT("job-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+		FMCPJobRecord& Record = Jobs.Add(JobId).Record;
+		Record.JobId = JobId;
+		Record.RequestId = RequestId;
+		Record.bAsync = bAsync;
 		Record.Status = EMCPJobStatus::Queued;
 		Record.Progress = 0.0;
 		Record.StartedAtUtc = FDateTime::UtcNow();
 		Record.UpdatedAtUtc = Record.StartedAtUtc;
-		Record.Result = MakeShared<FJsonObject>();
-		Jobs.Add(Record.JobId, Record);
+		Event = MakeJobStatusEvent(Record);
+
+		EnforceRetentionLocked(CapacityEvictions, ExpiredEvictions);
+		RetainedCount = Jobs.Num();
+		ResultBytes = RetainedResultBytes;
 	}
-	PublishJobStatusEvent(TEXT(""), Record);
-	return Record.JobId;
+
+	PublishJobStatusEvent(Event);
+	PublishJobStoreUsage(RetainedCount, ResultBytes, CapacityEvictions, ExpiredEvictions, false);
+	return Event.JobId;
 }
 
 bool UMCPJobSubsystem::UpdateJobStatus(const FString& JobId, const EMCPJobStatus Status, const double Progress)
 {
-	FMCPJobRecord PublishedRecord;
-	bool bShouldPublish = false;
+	FJobStatusEvent Event;
 	{
 		FScopeLock ScopeLock(&JobGuard);
-		if (FMCPJobRecord* Record = Jobs.Find(JobId))
+		FStoredJob* StoredJob = Jobs.Find(JobId);
+		if (StoredJob == nullptr || IsTerminalJobStatus(StoredJob->Record.Status))
 		{
-			Record->Status = Status;
-			Record->Progress = FMath::Clamp(Progress, 0.0, 100.0);
-			Record->UpdatedAtUtc = FDateTime::UtcNow();
-			PublishedRecord = *Record;
-			bShouldPublish = true;
+			return false;
 		}
-	}
 
-	if (bShouldPublish)
-	{
-		PublishJobStatusEvent(TEXT(""), PublishedRecord);
-		return true;
+		FMCPJobRecord& Record = StoredJob->Record;
+		Record.Status = Status;
+		Record.Progress = FMath::Clamp(Progress, 0.0, 100.0);
+		Record.UpdatedAtUtc = FDateTime::UtcNow();
+		if (IsTerminalJobStatus(Status))
+		{
+			TerminalJobOrder.AddTail(JobId);
+		}
+		Event = MakeJobStatusEvent(Record);
 	}
 
-	return false;
+	PublishJobStatusEvent(Event);
+	return true;
 }
 
 bool UMCPJobSubsystem::FinalizeJob(
@@ -83,50 +169,98 @@ bool UMCPJobSubsystem::FinalizeJob(
 	const TSharedPtr<FJsonObject>& Result,
 	const TArray<FMCPDiagnostic>& Diagnostics)
 {
-	FMCPJobRecord PublishedRecord;
-	bool bShouldPublish = false;
+	FString ResultJson = Result.IsValid() ? MCPJson::SerializeJsonObject(Result) : FString();
+
+	FJobStatusEvent Event;
+	bool bAsync = false;
+	bool bSpilledResult = false;
+	int32 CapacityEvictions = 0;
+	int32 ExpiredEvictions = 0;
+	int32 RetainedCount = 0;
+	int64 ResultBytes = 0;
 	{
 		FScopeLock ScopeLock(&JobGuard);
-		if (FMCPJobRecord* Record = Jobs.Find(JobId))
+		FStoredJob* StoredJob = Jobs.Find(JobId);
+		if (StoredJob == nullptr)
+		{
+			return false;
+		}
+
+		FMCPJobRecord& Record = StoredJob->Record;
+		if (!IsTerminalJobStatus(Record.Status))
 		{
-			Record->Status = Status;
-			Record->Progress = (Status == EMCPJobStatus::Succeeded) ? 100.0 : Record->Progress;
-			Record->UpdatedAtUtc = FDateTime::UtcNow();
-			Record->Result = Result.IsValid() ? Result : MakeShared<FJsonObject>();
-			Record->Diagnostics = Diagnostics;
-			PublishedRecord = *Record;
-			bShouldPublish = true;
+			TerminalJobOrder.AddTail(JobId);
 		}
+		Record.Status = Status;
+		Record.Progress = (Status == EMCPJobStatus::Succeeded) ? 100.0 : Record.Progress;
+		Record.UpdatedAtUtc = FDateTime::UtcNow();
+		Record.Diagnostics = Diagnostics;
+		bSpilledResult = StoreTerminalResultLocked(*StoredJob, MoveTemp(ResultJson));
+		bAsync = Record.bAsync;
+		Event = MakeJobStatusEvent(Record);
+
+		EnforceRetentionLocked(CapacityEvictions, ExpiredEvictions);
+		RetainedCount = Jobs.Num();
+		ResultBytes = RetainedResultBytes;
 	}
 
-	if (bShouldPublish)
+	TSharedPtr<FJsonObject> PushedResult;
+	if (bAsync)
 	{
-		PublishJobStatusEvent(TEXT(""), PublishedRecord);
-		return true;
+		PushedResult = Result.IsValid() ? Result : MakeShared<FJsonObject>();
 	}
-
-	return false;
+	PublishJobStatusEvent(Event, PushedResult);
+	PublishJobStoreUsage(RetainedCount, ResultBytes, CapacityEvictions, ExpiredEvictions, bSpilledResult);
+	return true;
 }
 
 bool UMCPJobSubsystem::GetJob(const FString& JobId, FMCPJobRecord& OutRecord) const
 {
-	FScopeLock ScopeLock(&JobGuard);
-	if (const FMCPJobRecord* Found = Jobs.Find(JobId))
+	FString ResultJson;
+	bool bResultSpilled = false;
+	{
+		FScopeLock ScopeLock(&JobGuard);
+		const FStoredJob* Found = Jobs.Find(JobId);
+		if (Found == nullptr)
+		{
+			return false;
+		}
+
+		OutRecord = Found->Record;
+		ResultJson = Found->ResultJson;
+		bResultSpilled = Found->bResultSpilled;
+	}
+
+	if (bResultSpilled && !FFileHelper::LoadFileToString(ResultJson, *GetResultSpillFilePath(JobId)))
 	{
-		OutRecord = *Found;
-		return true;
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Spilled result for job %s could not be read."), *JobId);
 	}
 
-	return false;
+	if (!ResultJson.IsEmpty())
+	{
+		const TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(ResultJson);
+		FJsonSerializer::Deserialize(ResultReader, OutRecord.Result);
+	}
+	if (!OutRecord.Result.IsValid())
+	{
+		OutRecord.Result = MakeShared<FJsonObject>();
+	}
+	return true;
+}
+
+int32 UMCPJobSubsystem::GetRetainedJobCount() const
+{
+	FScopeLock ScopeLock(&JobGuard);
+	return Jobs.Num();
 }
 
 bool UMCPJobSubsystem::CancelJob(const FString& JobId, FMCPJobRecord& OutRecord, FMCPDiagnostic& OutDiagnostic)
 {
-	bool bShouldPublish = false;
+	FJobStatusEvent Event;
 	{
 		FScopeLock ScopeLock(&JobGuard);
-		FMCPJobRecord* Record = Jobs.Find(JobId);
-		if (Record == nullptr)
+		FStoredJob* StoredJob = Jobs.Find(JobId);
+		if (StoredJob == nullptr)
 		{
 			OutDiagnostic.Code = MCPErrorCodes::JOB_NOT_FOUND;
 			OutDiagnostic.Message = TEXT("Requested job was not found.");
@@ -135,23 +269,54 @@ bool UMCPJobSubsystem::CancelJob(const FString& JobId, FMCPJobRecord& OutRecord,
 			return false;
 		}
 
-		if (Record->Status == EMCPJobStatus::Succeeded || Record->Status == EMCPJobStatus::Failed || Record->Status == EMCPJobStatus::Canceled)
+		FMCPJobRecord& Record = StoredJob->Record;
+		if (IsTerminalJobStatus(Record.Status))
 		{
-			OutRecord = *Record;
+			OutRecord = Record;
 			return true;
 		}
 
-		Record->Status = EMCPJobStatus::Canceled;
-		Record->UpdatedAtUtc = FDateTime::UtcNow();
-		OutRecord = *Record;
-		bShouldPublish = true;
+		Record.Status = EMCPJobStatus::Canceled;
+		Record.UpdatedAtUtc = FDateTime::UtcNow();
+		TerminalJobOrder.AddTail(JobId);
+		OutRecord = Record;
+		Event = MakeJobStatusEvent(Record);
+
+		for (auto It = ActiveCancellationTokens.CreateKeyIterator(JobId); It; ++It)
+		{
+			It.Value()->Cancel();
+		}
+	}
+
+	PublishJobStatusEvent(Event);
+	return true;
+}
+
+void UMCPJobSubsystem::RegisterCancellationToken(const FString& JobId, const TSharedRef<FMCPCancellationToken>& Token)
+{
+	if (JobId.IsEmpty())
+	{
+		return;
 	}
 
-	if (bShouldPublish)
+	FScopeLock ScopeLock(&JobGuard);
+	const FStoredJob* StoredJob = Jobs.Find(JobId);
+	if (StoredJob != nullptr && StoredJob->Record.Status == EMCPJobStatus::Canceled)
 	{
-		PublishJobStatusEvent(TEXT(""), OutRecord);
+		Token->Cancel();
 	}
-	return true;
+	ActiveCancellationTokens.Add(JobId, Token);
+}
+
+void UMCPJobSubsystem::UnregisterCancellationToken(const FString& JobId, const TSharedRef<FMCPCancellationToken>& Token)
+{
+	if (JobId.IsEmpty())
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&JobGuard);
+	ActiveCancellationTokens.RemoveSingle(JobId, Token);
 }
 
 FString UMCPJobSubsystem::StatusToString(const EMCPJobStatus Status)
@@ -170,3 +335,117 @@ FString UMCPJobSubsystem::StatusToString(const EMCPJobStatus Status)
 		return TEXT("canceled");
 	}
 }
+
+void UMCPJobSubsystem::LoadRetentionSettings()
+{
+	const TCHAR* Section = TEXT("UnrealMCP.Jobs");
+
+	int32 ConfiguredMaxRetainedJobs = MaxRetainedJobs;
+	if (GConfig->GetInt(Section, TEXT("MaxRetainedJobs"), ConfiguredMaxRetainedJobs, GEditorPerProjectIni))
+	{
+		MaxRetainedJobs = FMath::Clamp(ConfiguredMaxRetainedJobs, 16, 1000000);
+	}
+
+	int32 ConfiguredRetentionSeconds = static_cast<int32>(JobRetentionMs / 1000LL);
+	if (GConfig->GetInt(Section, TEXT("RetentionSeconds"), ConfiguredRetentionSeconds, GEditorPerProjectIni))
+	{
+		JobRetentionMs = static_cast<int64>(FMath::Clamp(ConfiguredRetentionSeconds, 10, 7 * 24 * 60 * 60)) * 1000LL;
+	}
+
+	int32 ConfiguredSpillThreshold = ResultSpillThresholdBytes;
+	if (GConfig->GetInt(Section, TEXT("ResultSpillThresholdBytes"), ConfiguredSpillThreshold, GEditorPerProjectIni))
+	{
+		ResultSpillThresholdBytes = FMath::Max(1024, ConfiguredSpillThreshold);
+	}
+
+	bool bConfiguredResultSpill = bResultSpillEnabled;
+	if (GConfig->GetBool(Section, TEXT("bResultSpillEnabled"), bConfiguredResultSpill, GEditorPerProjectIni))
+	{
+		bResultSpillEnabled = bConfiguredResultSpill;
+	}
+}
+
+bool UMCPJobSubsystem::StoreTerminalResultLocked(FStoredJob& StoredJob, FString&& ResultJson)
+{
+	const FString SpillFilePath = GetResultSpillFilePath(StoredJob.Record.JobId);
+	if (StoredJob.bResultSpilled)
+	{
+		IFileManager::Get().Delete(*SpillFilePath, false, true, true);
+		StoredJob.bResultSpilled = false;
+	}
+	RetainedResultBytes -= GetStoredResultBytes(StoredJob.ResultJson);
+
+	StoredJob.ResultJson = MoveTemp(ResultJson);
+	if (bResultSpillEnabled && GetStoredResultBytes(StoredJob.ResultJson) >= ResultSpillThresholdBytes)
+	{
+		IFileManager::Get().MakeDirectory(*GetResultSpillDir(), true);
+		if (FFileHelper::SaveStringToFile(StoredJob.ResultJson, *SpillFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			StoredJob.ResultJson.Empty();
+			StoredJob.bResultSpilled = true;
+		}
+	}
+
+	RetainedResultBytes += GetStoredResultBytes(StoredJob.ResultJson);
+	return StoredJob.bResultSpilled;
+}
+
+void UMCPJobSubsystem::EnforceRetentionLocked(int32& OutCapacityEvictions, int32& OutExpiredEvictions)
+{
+	const FDateTime NowUtc = FDateTime::UtcNow();
+	while (TDoubleLinkedList<FString>::TDoubleLinkedListNode* OldestNode = TerminalJobOrder.GetHead())
+	{
+		const FString OldestJobId = OldestNode->GetValue();
+		const FStoredJob* OldestJob = Jobs.Find(OldestJobId);
+		if (OldestJob == nullptr)
+		{
+			TerminalJobOrder.RemoveNode(OldestNode);
+			continue;
+		}
+
+		// Only terminal jobs are queued here, so running jobs are never evicted.
+		const bool bExpired = (NowUtc - OldestJob->Record.UpdatedAtUtc).GetTotalMilliseconds() > static_cast<double>(JobRetentionMs);
+		const bool bOverCapacity = Jobs.Num() > MaxRetainedJobs;
+		if (!bExpired && !bOverCapacity)
+		{
+			break;
+		}
+
+		if (bExpired)
+		{
+			++OutExpiredEvictions;
+		}
+		else
+		{
+			++OutCapacityEvictions;
+		}
+		TerminalJobOrder.RemoveNode(OldestNode);
+		RemoveStoredJobLocked(OldestJobId);
+	}
+}
+
+void UMCPJobSubsystem::RemoveStoredJobLocked(const FString& JobId)
+{
+	const FStoredJob* StoredJob = Jobs.Find(JobId);
+	if (StoredJob == nullptr)
+	{
+		return;
+	}
+
+	RetainedResultBytes -= GetStoredResultBytes(StoredJob->ResultJson);
+	if (StoredJob->bResultSpilled)
+	{
+		IFileManager::Get().Delete(*GetResultSpillFilePath(JobId), false, true, true);
+	}
+	Jobs.Remove(JobId);
+}
+
+FString UMCPJobSubsystem::GetResultSpillDir() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("jobs"));
+}
+
+FString UMCPJobSubsystem::GetResultSpillFilePath(const FString& JobId) const
+{
+	return FPaths::Combine(GetResultSpillDir(), JobId + TEXT(".json"));
+}
@@ -1,17 +1,93 @@
 #include "MCPObservabilitySubsystem.h"
 
+#include "MCPTime.h"
+
+namespace
+{
+	int32 GetLatencyBucketIndex(const int64 ValueUs)
+	{
+		const uint64 Value = static_cast<uint64>(FMath::Max<int64>(0, ValueUs));
+		if (Value < static_cast<uint64>(FMCPLatencyHistogram::SubBucketCount))
+		{
+			return static_cast<int32>(Value);
+		}
+
+		const int32 Exponent = static_cast<int32>(FPlatformMath::FloorLog2_64(Value));
+		const int32 SubBucket = static_cast<int32>((Value >> (Exponent - FMCPLatencyHistogram::SubBucketBits)) & (FMCPLatencyHistogram::SubBucketCount - 1));
+		return (Exponent - FMCPLatencyHistogram::SubBucketBits + 1) * FMCPLatencyHistogram::SubBucketCount + SubBucket;
+	}
+
+	int64 GetLatencyBucketUpperBound(const int32 BucketIndex)
+	{
+		if (BucketIndex < FMCPLatencyHistogram::SubBucketCount)
+		{
+			return BucketIndex;
+		}
+
+		const int32 Group = BucketIndex / FMCPLatencyHistogram::SubBucketCount;
+		const int32 SubBucket = BucketIndex % FMCPLatencyHistogram::SubBucketCount;
+		const int32 Shift = Group - 1;
+		const uint64 LowerBound = static_cast<uint64>(FMCPLatencyHistogram::SubBucketCount + SubBucket) << Shift;
+		return static_cast<int64>(LowerBound + (1ULL << Shift) - 1);
+	}
+}
+
+void FMCPLatencyHistogram::Record(const int64 ValueUs)
+{
+	const int64 ClampedValue = FMath::Max<int64>(0, ValueUs);
+	++Counts[GetLatencyBucketIndex(ClampedValue)];
+	MinUs = TotalCount == 0 ? ClampedValue : FMath::Min(MinUs, ClampedValue);
+	MaxUs = FMath::Max(MaxUs, ClampedValue);
+	TotalUs += ClampedValue;
+	++TotalCount;
+}
+
+int64 FMCPLatencyHistogram::GetValueAtPercentile(const double Percentile) const
+{
+	if (TotalCount <= 0)
+	{
+		return 0;
+	}
+
+	const int64 TargetCount = FMath::Clamp<int64>(static_cast<int64>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 100.0) / 100.0 * static_cast<double>(TotalCount))), 1, TotalCount);
+	int64 SeenCount = 0;
+	for (int32 BucketIndex = 0; BucketIndex < BucketCount; ++BucketIndex)
+	{
+		SeenCount += Counts[BucketIndex];
+		if (SeenCount >= TargetCount)
+		{
+			return FMath::Min(GetLatencyBucketUpperBound(BucketIndex), MaxUs);
+		}
+	}
+	return MaxUs;
+}
+
+TSharedRef<FJsonObject> FMCPLatencyHistogram::ToJson() const
+{
+	TSharedRef<FJsonObject> HistogramObject = MakeShared<FJsonObject>();
+	HistogramObject->SetNumberField(TEXT("count"), static_cast<double>(TotalCount));
+	HistogramObject->SetNumberField(TEXT("min_ms"), MCPTime::MicrosecondsToMilliseconds(MinUs));
+	HistogramObject->SetNumberField(TEXT("mean_ms"), TotalCount > 0 ? MCPTime::MicrosecondsToMilliseconds(TotalUs) / static_cast<double>(TotalCount) : 0.0);
+	HistogramObject->SetNumberField(TEXT("max_ms"), MCPTime::MicrosecondsToMilliseconds(MaxUs));
+	HistogramObject->SetNumberField(TEXT("p50_ms"), MCPTime::MicrosecondsToMilliseconds(GetValueAtPercentile(50.0)));
+	HistogramObject->SetNumberField(TEXT("p90_ms"), MCPTime::MicrosecondsToMilliseconds(GetValueAtPercentile(90.0)));
+	HistogramObject->SetNumberField(TEXT("p99_ms"), MCPTime::MicrosecondsToMilliseconds(GetValueAtPercentile(99.0)));
+	HistogramObject->SetNumberField(TEXT("p999_ms"), MCPTime::MicrosecondsToMilliseconds(GetValueAtPercentile(99.9)));
+	return HistogramObject;
+}
+
 void UMCPObservabilitySubsystem::RecordToolExecution(
 	const FString& ToolName,
 	const EMCPResponseStatus Status,
-	const int64 DurationMs,
+	const int64 DurationUs,
 	const bool bIdempotentReplay)
 {
 	FScopeLock ScopeLock(&MetricsGuard);
 	FMCPToolObservabilityMetrics& ToolMetric = ToolMetrics.FindOrAdd(ToolName);
 	++ToolMetric.TotalRequests;
-	ToolMetric.TotalDurationMs += FMath::Max<int64>(0, DurationMs);
-	ToolMetric.LastDurationMs = FMath::Max<int64>(0, DurationMs);
-	ToolMetric.MaxDurationMs = FMath::Max(ToolMetric.MaxDurationMs, ToolMetric.LastDurationMs);
+	ToolMetric.TotalDurationUs += FMath::Max<int64>(0, DurationUs);
+	ToolMetric.LastDurationUs = FMath::Max<int64>(0, DurationUs);
+	ToolMetric.MaxDurationUs = FMath::Max(ToolMetric.MaxDurationUs, ToolMetric.LastDurationUs);
 
 	if (bIdempotentReplay)
 	{
@@ -30,6 +106,21 @@ void UMCPObservabilitySubsystem::RecordToolExecution(
 		++ToolMetric.ErrorCount;
 		break;
 	}
+
+	if (IsInGameThread())
+	{
+		ToolLatencyHistograms.FindOrAdd(ToolName).Record(DurationUs);
+	}
+}
+
+void UMCPObservabilitySubsystem::RecordPhaseLatency(const EMCPLatencyPhase Phase, const int64 DurationUs)
+{
+	if (!IsInGameThread() || Phase == EMCPLatencyPhase::Count)
+	{
+		return;
+	}
+
+	PhaseLatencyHistograms[static_cast<int32>(Phase)].Record(DurationUs);
 }
 
 void UMCPObservabilitySubsystem::RecordPolicyDenied(const bool bSafeModeBlocked)
@@ -83,6 +174,38 @@ void UMCPObservabilitySubsystem::RecordIdempotencyConflict()
 	++IdempotencyConflictCount;
 }
 
+void UMCPObservabilitySubsystem::RecordIdempotencyCacheEviction(const bool bExpired)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	if (bExpired)
+	{
+		++IdempotencyExpiredEvictionCount;
+	}
+	else
+	{
+		++IdempotencyCapacityEvictionCount;
+	}
+}
+
+void UMCPObservabilitySubsystem::RecordIdempotencyCacheSpill(const int32 SpilledCount)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	IdempotencySpillCount += FMath::Max<int32>(0, SpilledCount);
+}
+
+void UMCPObservabilitySubsystem::RecordIdempotencyCacheRestore()
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	++IdempotencyRestoreCount;
+}
+
+void UMCPObservabilitySubsystem::RecordIdempotencyCacheUsage(const int32 EntryCount, const int64 Bytes)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	IdempotencyCacheEntryCount = FMath::Max<int32>(0, EntryCount);
+	IdempotencyCacheBytes = FMath::Max<int64>(0, Bytes);
+}
+
 void UMCPObservabilitySubsystem::RecordChangeSetCreated(const int64 ApproximateBytes, const int32 SnapshotCount)
 {
 	FScopeLock ScopeLock(&MetricsGuard);
@@ -104,17 +227,70 @@ void UMCPObservabilitySubsystem::RecordRollbackResult(const bool bSucceeded)
 	}
 }
 
+void UMCPObservabilitySubsystem::RecordChangeSetGarbageCollected(const int32 DeletedCount, const int64 ReclaimedBytes)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	++ChangeSetGCRunCount;
+	ChangeSetGCDeletedCount += FMath::Max<int32>(0, DeletedCount);
+	ChangeSetGCReclaimedBytes += FMath::Max<int64>(0, ReclaimedBytes);
+}
+
+void UMCPObservabilitySubsystem::RecordChangeSetWriteFailure(const int32 FailedCount)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	ChangeSetWriteFailureCount += FMath::Max<int32>(0, FailedCount);
+}
+
 void UMCPObservabilitySubsystem::RecordJobStatus(const FString& Status)
 {
 	FScopeLock ScopeLock(&MetricsGuard);
 	JobStatusCounts.FindOrAdd(Status) += 1;
 }
 
+void UMCPObservabilitySubsystem::RecordJobEvictions(const int32 CapacityEvictions, const int32 ExpiredEvictions)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	JobCapacityEvictionCount += FMath::Max<int32>(0, CapacityEvictions);
+	JobExpiredEvictionCount += FMath::Max<int32>(0, ExpiredEvictions);
+}
+
+void UMCPObservabilitySubsystem::RecordJobResultSpill()
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	++JobResultSpillCount;
+}
+
+void UMCPObservabilitySubsystem::RecordJobStoreUsage(const int32 RetainedCount, const int64 ResultBytes)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	JobRetainedCount = FMath::Max<int32>(0, RetainedCount);
+	JobResultBytes = FMath::Max<int64>(0, ResultBytes);
+}
+
+void UMCPObservabilitySubsystem::RecordBlueprintCompile(const int32 CoalescedRequestCount, const int64 DurationUs)
+{
+	{
+		FScopeLock ScopeLock(&MetricsGuard);
+		++BlueprintCompileCount;
+		BlueprintCompileRequestCount += FMath::Max<int32>(1, CoalescedRequestCount);
+		BlueprintCompileTotalUs += FMath::Max<int64>(0, DurationUs);
+	}
+
+	RecordPhaseLatency(EMCPLatencyPhase::BlueprintCompile, DurationUs);
+}
+
+void UMCPObservabilitySubsystem::RecordBlueprintSaveFailure(const int32 FailedCount)
+{
+	FScopeLock ScopeLock(&MetricsGuard);
+	BlueprintSaveFailureCount += FMath::Max(0, FailedCount);
+}
+
 TSharedRef<FJsonObject> UMCPObservabilitySubsystem::BuildSnapshot() const
 {
 	FScopeLock ScopeLock(&MetricsGuard);
 
 	TSharedRef<FJsonObject> Snapshot = MakeShared<FJsonObject>();
+	const bool bCanReadHistograms = IsInGameThread();
 
 	TArray<FString> ToolNames;
 	ToolMetrics.GetKeys(ToolNames);
@@ -137,9 +313,17 @@ TSharedRef<FJsonObject> UMCPObservabilitySubsystem::BuildSnapshot() const
 		ToolObject->SetNumberField(TEXT("error"), static_cast<double>(ToolMetric->ErrorCount));
 		ToolObject->SetNumberField(TEXT("partial"), static_cast<double>(ToolMetric->PartialCount));
 		ToolObject->SetNumberField(TEXT("replay"), static_cast<double>(ToolMetric->ReplayCount));
-		ToolObject->SetNumberField(TEXT("avg_duration_ms"), ToolMetric->TotalRequests > 0 ? static_cast<double>(ToolMetric->TotalDurationMs) / static_cast<double>(ToolMetric->TotalRequests) : 0.0);
-		ToolObject->SetNumberField(TEXT("max_duration_ms"), static_cast<double>(ToolMetric->MaxDurationMs));
-		ToolObject->SetNumberField(TEXT("last_duration_ms"), static_cast<double>(ToolMetric->LastDurationMs));
+		ToolObject->SetNumberField(TEXT("avg_duration_ms"), ToolMetric->TotalRequests > 0 ? MCPTime::MicrosecondsToMilliseconds(ToolMetric->TotalDurationUs) / static_cast<double>(ToolMetric->TotalRequests) : 0.0);
+		ToolObject->SetNumberField(TEXT("max_duration_ms"), MCPTime::MicrosecondsToMilliseconds(ToolMetric->MaxDurationUs));
+		ToolObject->SetNumberField(TEXT("last_duration_ms"), MCPTime::MicrosecondsToMilliseconds(ToolMetric->LastDurationUs));
+		const FMCPLatencyHistogram* ToolHistogram = bCanReadHistograms ? ToolLatencyHistograms.Find(ToolName) : nullptr;
+		if (ToolHistogram != nullptr)
+		{
+			ToolObject->SetNumberField(TEXT("p50_ms"), MCPTime::MicrosecondsToMilliseconds(ToolHistogram->GetValueAtPercentile(50.0)));
+			ToolObject->SetNumberField(TEXT("p90_ms"), MCPTime::MicrosecondsToMilliseconds(ToolHistogram->GetValueAtPercentile(90.0)));
+			ToolObject->SetNumberField(TEXT("p99_ms"), MCPTime::MicrosecondsToMilliseconds(ToolHistogram->GetValueAtPercentile(99.0)));
+			ToolObject->SetNumberField(TEXT("p999_ms"), MCPTime::MicrosecondsToMilliseconds(ToolHistogram->GetValueAtPercentile(99.9)));
+		}
 		ToolMetricValues.Add(MakeShared<FJsonValueObject>(ToolObject));
 	}
 	Snapshot->SetArrayField(TEXT("tool_metrics"), ToolMetricValues);
@@ -163,12 +347,25 @@ TSharedRef<FJsonObject> UMCPObservabilitySubsystem::BuildSnapshot() const
 	RequestErrorsObject->SetNumberField(TEXT("idempotency_conflict"), static_cast<double>(IdempotencyConflictCount));
 	Snapshot->SetObjectField(TEXT("request_errors"), RequestErrorsObject);
 
+	TSharedRef<FJsonObject> IdempotencyCacheObject = MakeShared<FJsonObject>();
+	IdempotencyCacheObject->SetNumberField(TEXT("entry_count"), static_cast<double>(IdempotencyCacheEntryCount));
+	IdempotencyCacheObject->SetNumberField(TEXT("bytes"), static_cast<double>(IdempotencyCacheBytes));
+	IdempotencyCacheObject->SetNumberField(TEXT("capacity_eviction_count"), static_cast<double>(IdempotencyCapacityEvictionCount));
+	IdempotencyCacheObject->SetNumberField(TEXT("expired_eviction_count"), static_cast<double>(IdempotencyExpiredEvictionCount));
+	IdempotencyCacheObject->SetNumberField(TEXT("spill_count"), static_cast<double>(IdempotencySpillCount));
+	IdempotencyCacheObject->SetNumberField(TEXT("restore_count"), static_cast<double>(IdempotencyRestoreCount));
+	Snapshot->SetObjectField(TEXT("idempotency_cache"), IdempotencyCacheObject);
+
 	TSharedRef<FJsonObject> ChangeSetObject = MakeShared<FJsonObject>();
 	ChangeSetObject->SetNumberField(TEXT("created_count"), static_cast<double>(ChangeSetCreatedCount));
 	ChangeSetObject->SetNumberField(TEXT("bytes"), static_cast<double>(ChangeSetBytes));
 	ChangeSetObject->SetNumberField(TEXT("snapshot_count"), static_cast<double>(SnapshotCreatedCount));
 	ChangeSetObject->SetNumberField(TEXT("rollback_success_count"), static_cast<double>(RollbackSucceededCount));
 	ChangeSetObject->SetNumberField(TEXT("rollback_failed_count"), static_cast<double>(RollbackFailedCount));
+	ChangeSetObject->SetNumberField(TEXT("gc_run_count"), static_cast<double>(ChangeSetGCRunCount));
+	ChangeSetObject->SetNumberField(TEXT("gc_deleted_count"), static_cast<double>(ChangeSetGCDeletedCount));
+	ChangeSetObject->SetNumberField(TEXT("gc_reclaimed_bytes"), static_cast<double>(ChangeSetGCReclaimedBytes));
+	ChangeSetObject->SetNumberField(TEXT("write_failed_count"), static_cast<double>(ChangeSetWriteFailureCount));
 	Snapshot->SetObjectField(TEXT("changeset"), ChangeSetObject);
 
 	TArray<FString> JobStatuses;
@@ -192,6 +389,101 @@ TSharedRef<FJsonObject> UMCPObservabilitySubsystem::BuildSnapshot() const
 	}
 	Snapshot->SetArrayField(TEXT("job_status_counts"), JobValues);
 
+	TSharedRef<FJsonObject> JobStoreObject = MakeShared<FJsonObject>();
+	JobStoreObject->SetNumberField(TEXT("retained_count"), static_cast<double>(JobRetainedCount));
+	JobStoreObject->SetNumberField(TEXT("result_bytes"), static_cast<double>(JobResultBytes));
+	JobStoreObject->SetNumberField(TEXT("capacity_eviction_count"), static_cast<double>(JobCapacityEvictionCount));
+	JobStoreObject->SetNumberField(TEXT("expired_eviction_count"), static_cast<double>(JobExpiredEvictionCount));
+	JobStoreObject->SetNumberField(TEXT("result_spill_count"), static_cast<double>(JobResultSpillCount));
+	Snapshot->SetObjectField(TEXT("job_store"), JobStoreObject);
+
+	TSharedRef<FJsonObject> BlueprintCompileObject = MakeShared<FJsonObject>();
+	BlueprintCompileObject->SetNumberField(TEXT("compile_count"), static_cast<double>(BlueprintCompileCount));
+	BlueprintCompileObject->SetNumberField(TEXT("requested_count"), static_cast<double>(BlueprintCompileRequestCount));
+	BlueprintCompileObject->SetNumberField(TEXT("coalesced_count"), static_cast<double>(BlueprintCompileRequestCount - BlueprintCompileCount));
+	BlueprintCompileObject->SetNumberField(TEXT("total_ms"), MCPTime::MicrosecondsToMilliseconds(BlueprintCompileTotalUs));
+	BlueprintCompileObject->SetNumberField(TEXT("save_failed_count"), static_cast<double>(BlueprintSaveFailureCount));
+	Snapshot->SetObjectField(TEXT("blueprint_compile"), BlueprintCompileObject);
+
+	if (bCanReadHistograms)
+	{
+		TSharedRef<FJsonObject> PhaseLatencyObject = MakeShared<FJsonObject>();
+		for (int32 PhaseIndex = 0; PhaseIndex < static_cast<int32>(EMCPLatencyPhase::Count); ++PhaseIndex)
+		{
+			PhaseLatencyObject->SetObjectField(
+				LatencyPhaseToString(static_cast<EMCPLatencyPhase>(PhaseIndex)),
+				PhaseLatencyHistograms[PhaseIndex].ToJson());
+		}
+		Snapshot->SetObjectField(TEXT("phase_latency"), PhaseLatencyObject);
+	}
+
+	return Snapshot;
+}
+
+TSharedRef<FJsonObject> UMCPObservabilitySubsystem::BuildLatencySnapshot(const FString& ToolFilter, const bool bIncludeTools) const
+{
+	TSharedRef<FJsonObject> Snapshot = MakeShared<FJsonObject>();
+	Snapshot->SetStringField(TEXT("unit"), TEXT("ms"));
+
+	TSharedRef<FJsonObject> PhasesObject = MakeShared<FJsonObject>();
+	TSharedRef<FJsonObject> ToolsObject = MakeShared<FJsonObject>();
+	if (IsInGameThread())
+	{
+		for (int32 PhaseIndex = 0; PhaseIndex < static_cast<int32>(EMCPLatencyPhase::Count); ++PhaseIndex)
+		{
+			PhasesObject->SetObjectField(
+				LatencyPhaseToString(static_cast<EMCPLatencyPhase>(PhaseIndex)),
+				PhaseLatencyHistograms[PhaseIndex].ToJson());
+		}
+
+		if (bIncludeTools)
+		{
+			TArray<FString> ToolNames;
+			ToolLatencyHistograms.GetKeys(ToolNames);
+			ToolNames.Sort();
+			for (const FString& ToolName : ToolNames)
+			{
+				if (!ToolFilter.IsEmpty() && !ToolName.Equals(ToolFilter, ESearchCase::IgnoreCase))
+				{
+					continue;
+				}
+
+				ToolsObject->SetObjectField(ToolName, ToolLatencyHistograms.FindChecked(ToolName).ToJson());
+			}
+		}
+	}
+
+	Snapshot->SetObjectField(TEXT("phases"), PhasesObject);
+	Snapshot->SetObjectField(TEXT("tools"), ToolsObject);
 	return Snapshot;
 }
 
+const TCHAR* UMCPObservabilitySubsystem::LatencyPhaseToString(const EMCPLatencyPhase Phase)
+{
+	switch (Phase)
+	{
+	case EMCPLatencyPhase::Parse:
+		return TEXT("parse");
+	case EMCPLatencyPhase::SchemaValidate:
+		return TEXT("schema_validate");
+	case EMCPLatencyPhase::Idempotency:
+		return TEXT("idempotency");
+	case EMCPLatencyPhase::Policy:
+		return TEXT("policy");
+	case EMCPLatencyPhase::Lock:
+		return TEXT("lock");
+	case EMCPLatencyPhase::Execute:
+		return TEXT("execute");
+	case EMCPLatencyPhase::ChangeSetWrite:
+		return TEXT("changeset_write");
+	case EMCPLatencyPhase::ResponseBuild:
+		return TEXT("response_build");
+	case EMCPLatencyPhase::WsSend:
+		return TEXT("ws_send");
+	case EMCPLatencyPhase::BlueprintCompile:
+		return TEXT("blueprint_compile");
+	default:
+		return TEXT("unknown");
+	}
+}
+
@@ -0,0 +1,101 @@
+#include "MCPPageSnapshotSubsystem.h"
+
+#include "MCPTime.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopeLock.h"
+
+void UMCPPageSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LoadSettings();
+
+	// Seed from the clock so cursors handed out by a previous editor session miss instead of aliasing.
+	NextSnapshotId = (MCPTime::NowCycles() << 16) | 1;
+}
+
+void UMCPPageSnapshotSubsystem::Deinitialize()
+{
+	{
+		FScopeLock ScopeLock(&SnapshotGuard);
+		Snapshots.Reset();
+	}
+	Super::Deinitialize();
+}
+
+uint64 UMCPPageSnapshotSubsystem::StoreSnapshot(const TSharedRef<const FMCPPageSnapshot>& Snapshot)
+{
+	FScopeLock ScopeLock(&SnapshotGuard);
+	EvictLocked(true);
+
+	const uint64 SnapshotId = NextSnapshotId++;
+	FSnapshotEntry& Entry = Snapshots.Add(SnapshotId);
+	Entry.Snapshot = Snapshot;
+	Entry.LastAccessCycles = MCPTime::NowCycles();
+	return SnapshotId;
+}
+
+TSharedPtr<const FMCPPageSnapshot> UMCPPageSnapshotSubsystem::FindSnapshot(const uint64 SnapshotId, const uint32 QueryHash)
+{
+	FScopeLock ScopeLock(&SnapshotGuard);
+	EvictLocked(false);
+
+	FSnapshotEntry* Entry = Snapshots.Find(SnapshotId);
+	if (Entry == nullptr || !Entry->Snapshot.IsValid() || Entry->Snapshot->QueryHash != QueryHash)
+	{
+		return nullptr;
+	}
+
+	Entry->LastAccessCycles = MCPTime::NowCycles();
+	return Entry->Snapshot;
+}
+
+int32 UMCPPageSnapshotSubsystem::GetSnapshotCount() const
+{
+	FScopeLock ScopeLock(&SnapshotGuard);
+	return Snapshots.Num();
+}
+
+void UMCPPageSnapshotSubsystem::LoadSettings()
+{
+	const TCHAR* Section = TEXT("UnrealMCP.Paging");
+
+	int32 ConfiguredSnapshotTtlSeconds = SnapshotTtlSeconds;
+	if (GConfig->GetInt(Section, TEXT("SnapshotTtlSeconds"), ConfiguredSnapshotTtlSeconds, GEditorPerProjectIni))
+	{
+		SnapshotTtlSeconds = FMath::Clamp(ConfiguredSnapshotTtlSeconds, 1, 3600);
+	}
+
+	int32 ConfiguredMaxSnapshots = MaxSnapshots;
+	if (GConfig->GetInt(Section, TEXT("MaxSnapshots"), ConfiguredMaxSnapshots, GEditorPerProjectIni))
+	{
+		MaxSnapshots = FMath::Clamp(ConfiguredMaxSnapshots, 1, 1024);
+	}
+}
+
+void UMCPPageSnapshotSubsystem::EvictLocked(const bool bReserveSlot)
+{
+	const uint64 NowCycles = MCPTime::NowCycles();
+	const uint64 TtlCycles = MCPTime::MillisecondsToCycles(static_cast<int64>(SnapshotTtlSeconds) * 1000);
+	for (auto It = Snapshots.CreateIterator(); It; ++It)
+	{
+		if (NowCycles - It->Value.LastAccessCycles > TtlCycles)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	while (bReserveSlot && Snapshots.Num() >= MaxSnapshots)
+	{
+		uint64 OldestSnapshotId = 0;
+		uint64 OldestAccessCycles = MAX_uint64;
+		for (const TPair<uint64, FSnapshotEntry>& Pair : Snapshots)
+		{
+			if (Pair.Value.LastAccessCycles < OldestAccessCycles)
+			{
+				OldestSnapshotId = Pair.Key;
+				OldestAccessCycles = Pair.Value.LastAccessCycles;
+			}
+		}
+		Snapshots.Remove(OldestSnapshotId);
+	}
+}
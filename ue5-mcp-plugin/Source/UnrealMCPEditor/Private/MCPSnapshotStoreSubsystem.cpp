@@ -0,0 +1,376 @@
+#include "MCPSnapshotStoreSubsystem.h"
+
+#include "HAL/FileManager.h"
+#include "MCPErrorCodes.h"
+#include "MCPLog.h"
+#include "Misc/Guid.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/Archive.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr int64 CopyChunkBytes = 1024 * 1024;
+
+	bool IsValidBlobHash(const FString& BlobHash)
+	{
+		if (BlobHash.Len() != FSHA1::DigestSize * 2)
+		{
+			return false;
+		}
+
+		for (const TCHAR Character : BlobHash)
+		{
+			if (!FChar::IsHexDigit(Character))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FString GetRestoreTempPath(const FString& Filename)
+	{
+		return Filename + TEXT(".mcp_restore");
+	}
+}
+
+void UMCPSnapshotStoreSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	PreSavePackageHandle = UPackage::PreSavePackageWithContextEvent.AddUObject(this, &UMCPSnapshotStoreSubsystem::HandlePreSavePackage);
+}
+
+void UMCPSnapshotStoreSubsystem::Deinitialize()
+{
+	UPackage::PreSavePackageWithContextEvent.Remove(PreSavePackageHandle);
+
+	{
+		FScopeLock ScopeLock(&StoreGuard);
+		StoredStateByFilename.Reset();
+		LastStoredUtcByBlobHash.Reset();
+		CapturedSnapshots.Reset();
+		CaptureDepth = 0;
+	}
+
+	Super::Deinitialize();
+}
+
+void UMCPSnapshotStoreSubsystem::BeginCapture()
+{
+	FScopeLock ScopeLock(&StoreGuard);
+	++CaptureDepth;
+}
+
+void UMCPSnapshotStoreSubsystem::EndCapture(const TArray<FString>& TouchedPackages, TArray<FMCPPackageSnapshot>& OutSnapshots)
+{
+	OutSnapshots.Reset();
+
+	TMap<FString, FMCPPackageSnapshot> Captured;
+	{
+		FScopeLock ScopeLock(&StoreGuard);
+		if (CaptureDepth == 0)
+		{
+			return;
+		}
+
+		if (--CaptureDepth == 0)
+		{
+			Captured = MoveTemp(CapturedSnapshots);
+			CapturedSnapshots.Reset();
+		}
+		else
+		{
+			Captured = CapturedSnapshots;
+		}
+	}
+
+	OutSnapshots.Reserve(TouchedPackages.Num());
+	for (const FString& PackageName : TouchedPackages)
+	{
+		if (FMCPPackageSnapshot* ExistingSnapshot = Captured.Find(PackageName))
+		{
+			OutSnapshots.Add(*ExistingSnapshot);
+			continue;
+		}
+
+		FMCPPackageSnapshot Snapshot;
+		if (SnapshotPackage(PackageName, Snapshot))
+		{
+			OutSnapshots.Add(MoveTemp(Snapshot));
+		}
+	}
+}
+
+void UMCPSnapshotStoreSubsystem::CapturePackage(const FString& PackageName)
+{
+	{
+		FScopeLock ScopeLock(&StoreGuard);
+		if (CaptureDepth == 0 || CapturedSnapshots.Contains(PackageName))
+		{
+			return;
+		}
+	}
+
+	FMCPPackageSnapshot Snapshot;
+	if (!SnapshotPackage(PackageName, Snapshot))
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&StoreGuard);
+	if (CaptureDepth > 0)
+	{
+		CapturedSnapshots.Add(PackageName, MoveTemp(Snapshot));
+	}
+}
+
+bool UMCPSnapshotStoreSubsystem::StoreFile(const FString& Filename, FString& OutBlobHash, int64& OutSizeBytes)
+{
+	OutBlobHash.Reset();
+	OutSizeBytes = 0;
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FFileStatData StatData = FileManager.GetStatData(*Filename);
+	if (!StatData.bIsValid || StatData.bIsDirectory)
+	{
+		return false;
+	}
+
+	{
+		// Unchanged since it was last stored: the blob already holds these bytes.
+		FScopeLock ScopeLock(&StoreGuard);
+		const FStoredFileState* StoredState = StoredStateByFilename.Find(Filename);
+		if (StoredState != nullptr
+			&& StoredState->SizeBytes == StatData.FileSize
+			&& StoredState->TimeStamp == StatData.ModificationTime
+			&& FileManager.FileExists(*GetBlobPath(StoredState->BlobHash)))
+		{
+			LastStoredUtcByBlobHash.Add(StoredState->BlobHash, FDateTime::UtcNow());
+			OutBlobHash = StoredState->BlobHash;
+			OutSizeBytes = StoredState->SizeBytes;
+			return true;
+		}
+	}
+
+	// Hash while copying into a temp blob so the package is read once; the temp is dropped if the content is already stored.
+	const FString BlobRootDir = GetBlobRootDir();
+	const FString TempBlobPath = FPaths::Combine(BlobRootDir, FString::Printf(TEXT("%s.tmp"), *FGuid::NewGuid().ToString(EGuidFormats::Digits)));
+	FileManager.MakeDirectory(*BlobRootDir, true);
+
+	TUniquePtr<FArchive> Reader(FileManager.CreateFileReader(*Filename, FILEREAD_Silent));
+	TUniquePtr<FArchive> Writer(FileManager.CreateFileWriter(*TempBlobPath, FILEWRITE_Silent));
+	if (!Reader.IsValid() || !Writer.IsValid())
+	{
+		Writer.Reset();
+		FileManager.Delete(*TempBlobPath, false, true, true);
+		return false;
+	}
+
+	FSHA1 Sha1;
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(CopyChunkBytes, FMath::Max<int64>(1, Reader->TotalSize()))));
+	int64 RemainingBytes = Reader->TotalSize();
+	while (RemainingBytes > 0)
+	{
+		const int64 ChunkBytes = FMath::Min<int64>(RemainingBytes, Buffer.Num());
+		Reader->Serialize(Buffer.GetData(), ChunkBytes);
+		Sha1.Update(Buffer.GetData(), static_cast<uint64>(ChunkBytes));
+		Writer->Serialize(Buffer.GetData(), ChunkBytes);
+		RemainingBytes -= ChunkBytes;
+	}
+	Sha1.Final();
+
+	const bool bReadFailed = Reader->IsError();
+	const int64 StoredBytes = Reader->TotalSize();
+	Reader.Reset();
+	const bool bWriteFailed = !Writer->Close() || Writer->IsError();
+	Writer.Reset();
+	if (bReadFailed || bWriteFailed)
+	{
+		FileManager.Delete(*TempBlobPath, false, true, true);
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to snapshot package file: %s"), *Filename);
+		return false;
+	}
+
+	uint8 Digest[FSHA1::DigestSize];
+	Sha1.GetHash(Digest);
+	const FString BlobHash = BytesToHex(Digest, UE_ARRAY_COUNT(Digest)).ToLower();
+	const FString BlobPath = GetBlobPath(BlobHash);
+	if (FileManager.FileExists(*BlobPath))
+	{
+		FileManager.Delete(*TempBlobPath, false, true, true);
+	}
+	else if (!FileManager.Move(*BlobPath, *TempBlobPath, true, true) && !FileManager.FileExists(*BlobPath))
+	{
+		FileManager.Delete(*TempBlobPath, false, true, true);
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to store snapshot blob: %s"), *BlobPath);
+		return false;
+	}
+
+	{
+		FScopeLock ScopeLock(&StoreGuard);
+		FStoredFileState& StoredState = StoredStateByFilename.FindOrAdd(Filename);
+		StoredState.SizeBytes = StatData.FileSize;
+		StoredState.TimeStamp = StatData.ModificationTime;
+		StoredState.BlobHash = BlobHash;
+		LastStoredUtcByBlobHash.Add(BlobHash, FDateTime::UtcNow());
+	}
+
+	OutBlobHash = BlobHash;
+	OutSizeBytes = StoredBytes;
+	return true;
+}
+
+bool UMCPSnapshotStoreSubsystem::StageRestore(const FString& BlobHash, const FString& Filename, FMCPDiagnostic& OutDiagnostic) const
+{
+	IFileManager& FileManager = IFileManager::Get();
+	const FString BlobPath = GetBlobPath(BlobHash);
+	if (!IsValidBlobHash(BlobHash) || !FileManager.FileExists(*BlobPath))
+	{
+		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_ROLLBACK_FAILED;
+		OutDiagnostic.Message = TEXT("Snapshot blob is missing.");
+		OutDiagnostic.Detail = FString::Printf(TEXT("blob=%s file=%s"), *BlobHash, *Filename);
+		OutDiagnostic.Suggestion = TEXT("The snapshot may have been garbage collected; use VCS-based revert.");
+		return false;
+	}
+
+	// Copied next to the target so a failed copy never leaves a truncated package behind.
+	const FString RestoreTempPath = GetRestoreTempPath(Filename);
+	if (FileManager.Copy(*RestoreTempPath, *BlobPath, true, true) != COPY_OK)
+	{
+		FileManager.Delete(*RestoreTempPath, false, true, true);
+		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_ROLLBACK_FAILED;
+		OutDiagnostic.Message = TEXT("Failed to stage package file from snapshot.");
+		OutDiagnostic.Detail = Filename;
+		OutDiagnostic.Suggestion = TEXT("Check free disk space and that the package directory is writable.");
+		return false;
+	}
+	return true;
+}
+
+bool UMCPSnapshotStoreSubsystem::CommitRestore(const FString& Filename, FMCPDiagnostic& OutDiagnostic) const
+{
+	const FString RestoreTempPath = GetRestoreTempPath(Filename);
+	if (!IFileManager::Get().Move(*Filename, *RestoreTempPath, true, true))
+	{
+		DiscardRestore(Filename);
+		OutDiagnostic.Code = MCPErrorCodes::CHANGESET_ROLLBACK_FAILED;
+		OutDiagnostic.Message = TEXT("Failed to restore package file from snapshot.");
+		OutDiagnostic.Detail = Filename;
+		OutDiagnostic.Suggestion = TEXT("Check that the package file is writable and not checked in read-only.");
+		return false;
+	}
+	return true;
+}
+
+void UMCPSnapshotStoreSubsystem::DiscardRestore(const FString& Filename) const
+{
+	IFileManager::Get().Delete(*GetRestoreTempPath(Filename), false, true, true);
+}
+
+bool UMCPSnapshotStoreSubsystem::HasBlob(const FString& BlobHash) const
+{
+	return IsValidBlobHash(BlobHash) && IFileManager::Get().FileExists(*GetBlobPath(BlobHash));
+}
+
+int32 UMCPSnapshotStoreSubsystem::DeleteUnreferencedBlobs(const TSet<FString>& ReferencedBlobHashes, const FTimespan& MinAge, int64& OutReclaimedBytes)
+{
+	OutReclaimedBytes = 0;
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString BlobRootDir = GetBlobRootDir();
+	if (!FileManager.DirectoryExists(*BlobRootDir))
+	{
+		return 0;
+	}
+
+	const FDateTime CutoffUtc = FDateTime::UtcNow() - MinAge;
+	TArray<TPair<FString, int64>> Candidates;
+	FileManager.IterateDirectoryStatRecursively(*BlobRootDir, [&Candidates, &ReferencedBlobHashes, &CutoffUtc](const TCHAR* Path, const FFileStatData& StatData)
+	{
+		const FString BlobHash = FPaths::GetCleanFilename(Path);
+		if (!StatData.bIsDirectory
+			&& IsValidBlobHash(BlobHash)
+			&& !ReferencedBlobHashes.Contains(BlobHash)
+			&& StatData.ModificationTime < CutoffUtc)
+		{
+			Candidates.Emplace(Path, StatData.FileSize);
+		}
+		return true;
+	});
+
+	int32 DeletedCount = 0;
+	for (const TPair<FString, int64>& Candidate : Candidates)
+	{
+		const FString BlobHash = FPaths::GetCleanFilename(Candidate.Key);
+
+		// Held across the delete so a concurrent StoreFile cannot reuse the blob in between.
+		FScopeLock ScopeLock(&StoreGuard);
+		const FDateTime* LastStoredUtc = LastStoredUtcByBlobHash.Find(BlobHash);
+		if (LastStoredUtc != nullptr && *LastStoredUtc >= CutoffUtc)
+		{
+			continue;
+		}
+
+		LastStoredUtcByBlobHash.Remove(BlobHash);
+		if (FileManager.Delete(*Candidate.Key, false, true, true))
+		{
+			++DeletedCount;
+			OutReclaimedBytes += FMath::Max<int64>(0, Candidate.Value);
+		}
+	}
+	return DeletedCount;
+}
+
+FString UMCPSnapshotStoreSubsystem::GetBlobRootDir() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/blobs"));
+}
+
+FString UMCPSnapshotStoreSubsystem::GetBlobPath(const FString& BlobHash) const
+{
+	return FPaths::Combine(GetBlobRootDir(), BlobHash.Left(2), BlobHash);
+}
+
+void UMCPSnapshotStoreSubsystem::HandlePreSavePackage(UPackage* Package, FObjectPreSaveContext SaveContext)
+{
+	if (Package == nullptr || SaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	CapturePackage(Package->GetName());
+}
+
+bool UMCPSnapshotStoreSubsystem::SnapshotPackage(const FString& PackageName, FMCPPackageSnapshot& OutSnapshot)
+{
+	OutSnapshot = FMCPPackageSnapshot();
+	OutSnapshot.PackageName = PackageName;
+
+	FString Filename;
+	if (!FPackageName::DoesPackageExist(PackageName, &Filename))
+	{
+		// New package: recorded without a blob so rollback can report it instead of guessing.
+		FString Extension = FPackageName::GetAssetPackageExtension();
+		FString DiskFilename;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName, DiskFilename, Extension))
+		{
+			return false;
+		}
+		Filename = MoveTemp(DiskFilename);
+	}
+	else if (!StoreFile(FPaths::ConvertRelativePathToFull(Filename), OutSnapshot.BlobHash, OutSnapshot.SizeBytes))
+	{
+		return false;
+	}
+
+	Filename = FPaths::ConvertRelativePathToFull(Filename);
+	FPaths::MakePathRelativeTo(Filename, *FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+	OutSnapshot.RelativeFilename = MoveTemp(Filename);
+	return true;
+}
@@ -8,6 +8,7 @@
 #include "MCPLog.h"
 #include "MCPObjectUtils.h"
 #include "MCPObservabilitySubsystem.h"
+#include "MCPTraceSubsystem.h"
 #include "Tools/Common/MCPToolCommonJson.h"
 #include "Tools/Common/MCPToolAssetUtils.h"
 #include "Tools/Common/MCPToolDiagnostics.h"
@@ -39,6 +40,7 @@
 #include "Factories/FbxImportUI.h"
 #include "GameFramework/Actor.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 #include "ObjectTools.h"
 #include "WidgetBlueprint.h"
 #include "Engine/Blueprint.h"
@@ -75,6 +77,8 @@
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "UObject/ObjectRedirector.h"
 #include "UObject/GarbageCollection.h"
 #include "UObject/Package.h"
@@ -86,9 +90,96 @@
 
 namespace
 {
-	using MCPToolCommonJson::ParseCursor;
 	using MCPToolCommonJson::ToJsonStringArray;
 
+	constexpr uint32 SchemaBundleMagic = 0x4D435342;
+	constexpr int32 SchemaBundleVersion = 1;
+	constexpr int32 MaxCachedToolsListResults = 64;
+
+	FString GetSchemaBundleCachePath(const FString& SourcePath)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("SchemaCache"), FPaths::GetBaseFilename(SourcePath) + TEXT(".bin"));
+	}
+
+	void AppendSchemaToBlob(const TSharedPtr<FJsonObject>& SchemaObject, TArray<uint8>& Blob, int32& OutOffset, int32& OutLength)
+	{
+		OutOffset = INDEX_NONE;
+		OutLength = 0;
+		if (!SchemaObject.IsValid())
+		{
+			return;
+		}
+
+		const FString SerializedSchema = MCPJson::SerializeJsonObject(SchemaObject);
+		FTCHARToUTF8 Utf8Data(*SerializedSchema);
+		OutOffset = Blob.Num();
+		OutLength = Utf8Data.Length();
+		Blob.Append(reinterpret_cast<const uint8*>(Utf8Data.Get()), Utf8Data.Length());
+	}
+
+	bool CompileSchemaBundle(
+		const FString& SchemaContent,
+		const FString& SourcePath,
+		int64 SourceSize,
+		int64 SourceTimestampTicks,
+		TArray<uint8>& OutBundleBytes)
+	{
+		TSharedPtr<FJsonObject> RootObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SchemaContent);
+		if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+		{
+			return false;
+		}
+
+		TArray<FString> ToolNames;
+		TArray<FMCPSchemaBundleEntry> Entries;
+		TArray<uint8> Blob;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : RootObject->Values)
+		{
+			const TSharedPtr<FJsonObject> ToolSchema = Entry.Value.IsValid() && Entry.Value->Type == EJson::Object ? Entry.Value->AsObject() : nullptr;
+			if (!ToolSchema.IsValid())
+			{
+				continue;
+			}
+
+			const TSharedPtr<FJsonObject>* ParamsSchemaField = nullptr;
+			const TSharedPtr<FJsonObject>* ResultSchemaField = nullptr;
+			const TSharedPtr<FJsonObject> ParamsSchema = ToolSchema->TryGetObjectField(TEXT("params_schema"), ParamsSchemaField) ? *ParamsSchemaField : TSharedPtr<FJsonObject>();
+			const TSharedPtr<FJsonObject> ResultSchema = ToolSchema->TryGetObjectField(TEXT("result_schema"), ResultSchemaField) ? *ResultSchemaField : TSharedPtr<FJsonObject>();
+
+			FMCPSchemaBundleEntry BundleEntry;
+			AppendSchemaToBlob(ParamsSchema, Blob, BundleEntry.ParamsOffset, BundleEntry.ParamsLength);
+			AppendSchemaToBlob(ResultSchema, Blob, BundleEntry.ResultOffset, BundleEntry.ResultLength);
+
+			FXxHash128Builder Builder;
+			MCPJson::AppendCanonicalJsonHash(Builder, ParamsSchema);
+			MCPJson::AppendCanonicalJsonHash(Builder, ResultSchema);
+			const FXxHash128 SchemaHash = Builder.Finalize();
+			BundleEntry.HashLow = SchemaHash.LowBits;
+			BundleEntry.HashHigh = SchemaHash.HighBits;
+
+			ToolNames.Add(Entry.Key);
+			Entries.Add(BundleEntry);
+		}
+
+		OutBundleBytes.Reset();
+		FMemoryWriter Writer(OutBundleBytes);
+		uint32 Magic = SchemaBundleMagic;
+		int32 Version = SchemaBundleVersion;
+		FString StoredSourcePath = SourcePath;
+		int32 ToolCount = ToolNames.Num();
+		Writer << Magic << Version << StoredSourcePath << SourceSize << SourceTimestampTicks << ToolCount;
+		for (int32 Index = 0; Index < ToolCount; ++Index)
+		{
+			Writer << ToolNames[Index] << Entries[Index];
+		}
+
+		int64 BlobSize = Blob.Num();
+		Writer << BlobSize;
+		OutBundleBytes.Append(Blob);
+		return !Writer.IsError();
+	}
+
 	FString HashToHexSha1(const FString& Input)
 	{
 		FTCHARToUTF8 Utf8Data(*Input);
@@ -794,7 +885,7 @@ void UMCPToolRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UMCPToolRegistrySubsystem::Deinitialize()
 {
 	RegisteredTools.Reset();
-	BundleSchemas.Reset();
+	ResetSchemaBundle();
 	CachedSchemaHash.Empty();
 	Super::Deinitialize();
 }
@@ -811,16 +902,16 @@ bool UMCPToolRegistrySubsystem::ValidateRequest(const FMCPRequestEnvelope& Reque
 		return false;
 	}
 
-	if (!ToolDefinition->ParamsSchema.IsValid())
+	const TSharedPtr<const FMCPMaterializedToolSchemas> ToolSchemas = MaterializeToolSchemas(Request.Tool);
+	if (!ToolSchemas.IsValid() || !ToolSchemas->CompiledParamsSchema.IsValid())
 	{
 		return true;
 	}
 
 	const TSharedPtr<FJsonObject> ParamsObject = Request.Params.IsValid() ? Request.Params : MakeShared<FJsonObject>();
-	const TSharedPtr<FJsonValueObject> ParamsValue = MakeShared<FJsonValueObject>(ParamsObject);
 
 	FString SchemaError;
-	if (!MCPToolSchemaValidator::ValidateJsonValueAgainstSchema(ParamsValue, ToolDefinition->ParamsSchema, TEXT("params"), SchemaError))
+	if (!MCPToolSchemaValidator::ValidateJsonObjectAgainstCompiledSchema(ParamsObject, *ToolSchemas->CompiledParamsSchema, TEXT("params"), SchemaError))
 	{
 		OutDiagnostic.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
 		OutDiagnostic.Message = TEXT("Request params failed schema validation.");
@@ -849,7 +940,25 @@ bool UMCPToolRegistrySubsystem::ExecuteTool(const FMCPRequestEnvelope& Request,
 		return false;
 	}
 
-	const bool bSuccess = ToolDefinition->Executor(Request, OutResult);
+	bool bSuccess = false;
+	{
+		const FMCPTraceScope ToolTraceScope(TEXT("mcp.tool"), *Request.Tool, Request.RequestId, Request.Tool);
+		bSuccess = ToolDefinition->Executor(Request, OutResult);
+	}
+
+	if (!Request.Context.bAsync)
+	{
+		if (bSuccess)
+		{
+			OutResult.RunWorkerStage();
+			OutResult.RunCommitStage();
+		}
+		else
+		{
+			OutResult.WorkerStage = nullptr;
+			OutResult.CommitStage = nullptr;
+		}
+	}
 	if (!bSuccess && OutResult.Diagnostics.Num() == 0)
 	{
 		FMCPDiagnostic Diagnostic;
@@ -907,15 +1016,16 @@ bool UMCPToolRegistrySubsystem::BuildToolsList(
 		ToolObject->SetBoolField(TEXT("enabled"), ToolDefinition->bEnabled);
 		ToolObject->SetBoolField(TEXT("write"), ToolDefinition->bWriteTool);
 
-		if (bIncludeSchemas)
+		const TSharedPtr<const FMCPMaterializedToolSchemas> ToolSchemas = bIncludeSchemas ? MaterializeToolSchemas(ToolName) : nullptr;
+		if (ToolSchemas.IsValid())
 		{
-			if (ToolDefinition->ParamsSchema.IsValid())
+			if (ToolSchemas->ParamsSchema.IsValid())
 			{
-				ToolObject->SetObjectField(TEXT("params_schema"), ToolDefinition->ParamsSchema.ToSharedRef());
+				ToolObject->SetObjectField(TEXT("params_schema"), ToolSchemas->ParamsSchema.ToSharedRef());
 			}
-			if (ToolDefinition->ResultSchema.IsValid())
+			if (ToolSchemas->ResultSchema.IsValid())
 			{
-				ToolObject->SetObjectField(TEXT("result_schema"), ToolDefinition->ResultSchema.ToSharedRef());
+				ToolObject->SetObjectField(TEXT("result_schema"), ToolSchemas->ResultSchema.ToSharedRef());
 			}
 		}
 
@@ -925,6 +1035,36 @@ bool UMCPToolRegistrySubsystem::BuildToolsList(
 	return true;
 }
 
+FString UMCPToolRegistrySubsystem::GetToolsListResultJson(const bool bIncludeSchemas, const FString& DomainFilter) const
+{
+	const FString CacheKey = FString::Printf(TEXT("%s|%d|%s"), *CachedSchemaHash, bIncludeSchemas ? 1 : 0, *DomainFilter.ToLower());
+	{
+		FScopeLock ScopeLock(&ToolsListCacheGuard);
+		if (const FString* CachedResult = CachedToolsListResults.Find(CacheKey))
+		{
+			return *CachedResult;
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Tools;
+	BuildToolsList(bIncludeSchemas, DomainFilter, Tools);
+
+	TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+	ResultObject->SetStringField(TEXT("protocol_version"), GetProtocolVersion());
+	ResultObject->SetStringField(TEXT("schema_hash"), GetSchemaHash());
+	ResultObject->SetArrayField(TEXT("capabilities"), ToJsonStringArray(GetCapabilities()));
+	ResultObject->SetArrayField(TEXT("tools"), Tools);
+	const FString ResultJson = MCPJson::SerializeJsonObject(ResultObject);
+
+	FScopeLock ScopeLock(&ToolsListCacheGuard);
+	if (CachedToolsListResults.Num() >= MaxCachedToolsListResults)
+	{
+		CachedToolsListResults.Reset();
+	}
+	CachedToolsListResults.Add(CacheKey, ResultJson);
+	return ResultJson;
+}
+
 FString UMCPToolRegistrySubsystem::GetSchemaHash() const
 {
 	return CachedSchemaHash;
@@ -954,7 +1094,16 @@ TArray<FString> UMCPToolRegistrySubsystem::GetCapabilities() const
 		TEXT("live_coding_compile_v1"),
 		TEXT("umg_widget_event_k2_v1"),
 		TEXT("sequencer_core_v1"),
-		TEXT("sequencer_keys_v1")
+		TEXT("sequencer_keys_v1"),
+		TEXT("batch_v1"),
+		TEXT("umg_deferred_compile_v1"),
+		TEXT("asset_index_v1"),
+		TEXT("page_cursor_v1"),
+		TEXT("changeset_index_v1"),
+		TEXT("package_snapshot_v1"),
+		TEXT("changeset_journal_v1"),
+		TEXT("changeset_retention_v1"),
+		TEXT("changeset_pin_v1")
 	};
 }
 
@@ -984,6 +1133,8 @@ void UMCPToolRegistrySubsystem::RegisterBuiltInToolsImpl()
 	static const FToolSpec ToolSpecs[] = {
 		{ TEXT("tools.list"), false, &UMCPToolRegistrySubsystem::HandleToolsList },
 		{ TEXT("system.health"), false, &UMCPToolRegistrySubsystem::HandleSystemHealth },
+		{ TEXT("metrics.get"), false, &UMCPToolRegistrySubsystem::HandleMetricsGet },
+		{ TEXT("mcp.batch"), true, &UMCPToolRegistrySubsystem::HandleBatch },
 		{ TEXT("editor.livecoding.compile"), true, &UMCPToolRegistrySubsystem::HandleEditorLiveCodingCompile },
 		{ TEXT("asset.find"), false, &UMCPToolRegistrySubsystem::HandleAssetFind },
 		{ TEXT("asset.load"), false, &UMCPToolRegistrySubsystem::HandleAssetLoad },
@@ -1038,6 +1189,7 @@ void UMCPToolRegistrySubsystem::RegisterBuiltInToolsImpl()
 		{ TEXT("seq.validate"), false, &UMCPToolRegistrySubsystem::HandleSeqValidate },
 		{ TEXT("umg.blueprint.create"), true, &UMCPToolRegistrySubsystem::HandleUMGBlueprintCreate },
 		{ TEXT("umg.blueprint.patch"), true, &UMCPToolRegistrySubsystem::HandleUMGBlueprintPatch },
+		{ TEXT("umg.blueprint.compile"), true, &UMCPToolRegistrySubsystem::HandleUMGBlueprintCompile },
 		{ TEXT("umg.blueprint.reparent"), true, &UMCPToolRegistrySubsystem::HandleUMGBlueprintReparent },
 		{ TEXT("umg.widget.class.list"), false, &UMCPToolRegistrySubsystem::HandleUMGWidgetClassList },
 		{ TEXT("umg.tree.get"), false, &UMCPToolRegistrySubsystem::HandleUMGTreeGet },
@@ -1066,6 +1218,8 @@ void UMCPToolRegistrySubsystem::RegisterBuiltInToolsImpl()
 		{ TEXT("changeset.get"), false, &UMCPToolRegistrySubsystem::HandleChangeSetGet },
 		{ TEXT("changeset.rollback.preview"), false, &UMCPToolRegistrySubsystem::HandleChangeSetRollbackPreview },
 		{ TEXT("changeset.rollback.apply"), true, &UMCPToolRegistrySubsystem::HandleChangeSetRollbackApply },
+		{ TEXT("changeset.pin"), false, &UMCPToolRegistrySubsystem::HandleChangeSetPin },
+		{ TEXT("changeset.unpin"), false, &UMCPToolRegistrySubsystem::HandleChangeSetUnpin },
 		{ TEXT("job.get"), false, &UMCPToolRegistrySubsystem::HandleJobGet },
 		{ TEXT("job.cancel"), true, &UMCPToolRegistrySubsystem::HandleJobCancel },
 	};
@@ -1079,8 +1233,6 @@ void UMCPToolRegistrySubsystem::RegisterBuiltInToolsImpl()
 			TEXT("1.0.0"),
 			true,
 			ToolSpec.bWriteTool,
-			nullptr,
-			nullptr,
 			[this, Handler](const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
 			{
 				return (this->*Handler)(Request, OutResult);
@@ -1092,14 +1244,12 @@ void UMCPToolRegistrySubsystem::RegisterBuiltInToolsImpl()
 void UMCPToolRegistrySubsystem::RegisterTool(FMCPToolDefinition Definition)
 {
 	Definition.Domain = ExtractDomain(Definition.Name);
-	Definition.ParamsSchema = FindSchemaObject(Definition.Name, TEXT("params_schema"));
-	Definition.ResultSchema = FindSchemaObject(Definition.Name, TEXT("result_schema"));
 	RegisteredTools.Add(Definition.Name, MoveTemp(Definition));
 }
 
 void UMCPToolRegistrySubsystem::LoadSchemaBundle()
 {
-	BundleSchemas.Reset();
+	ResetSchemaBundle();
 
 	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealMCP"));
 	if (!Plugin.IsValid())
@@ -1110,57 +1260,243 @@ void UMCPToolRegistrySubsystem::LoadSchemaBundle()
 
 	const FString SchemaFilePath30 = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources/schemas_30_tools.json"));
 	const FString SchemaFilePath26 = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources/schemas_26_tools.json"));
-	const FString PreferredSchemaFilePath = FPaths::FileExists(SchemaFilePath30) ? SchemaFilePath30 : SchemaFilePath26;
-
-	FString SchemaContent;
-	if (!FFileHelper::LoadFileToString(SchemaContent, *PreferredSchemaFilePath))
+	if (FPaths::FileExists(SchemaFilePath30))
 	{
-		if (!PreferredSchemaFilePath.Equals(SchemaFilePath26, ESearchCase::CaseSensitive) ||
-			!FFileHelper::LoadFileToString(SchemaContent, *SchemaFilePath26))
+		if (LoadSchemaBundleFile(SchemaFilePath30))
 		{
-			UE_LOG(LogUnrealMCP, Warning, TEXT("Could not load schema bundle file: %s"), *PreferredSchemaFilePath);
 			return;
 		}
+		UE_LOG(LogUnrealMCP, Error, TEXT("Falling back to schema bundle: %s"), *SchemaFilePath26);
 	}
 
-	TSharedPtr<FJsonObject> RootObject;
-	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SchemaContent);
-	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	LoadSchemaBundleFile(SchemaFilePath26);
+}
+
+bool UMCPToolRegistrySubsystem::LoadSchemaBundleFile(const FString& SchemaFilePath)
+{
+	ResetSchemaBundle();
+
+	const int64 SourceSize = IFileManager::Get().FileSize(*SchemaFilePath);
+	const int64 SourceTimestampTicks = IFileManager::Get().GetTimeStamp(*SchemaFilePath).GetTicks();
+	const FString CachePath = GetSchemaBundleCachePath(SchemaFilePath);
+	if (SourceSize >= 0 && LoadSchemaBundleCache(CachePath, SchemaFilePath, SourceSize, SourceTimestampTicks))
 	{
-		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to parse schema bundle JSON."));
-		return;
+		UE_LOG(LogUnrealMCP, Log, TEXT("Loaded precompiled schema bundle. tools=%d"), BundleEntries.Num());
+		return true;
 	}
 
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : RootObject->Values)
+	FString SchemaContent;
+	if (!FFileHelper::LoadFileToString(SchemaContent, *SchemaFilePath))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Could not load schema bundle file: %s"), *SchemaFilePath);
+		return false;
+	}
+
+	TArray<uint8> CompiledBundle;
+	if (!CompileSchemaBundle(SchemaContent, SchemaFilePath, SourceSize, SourceTimestampTicks, CompiledBundle))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to parse schema bundle JSON: %s"), *SchemaFilePath);
+		return false;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(CompiledBundle, *CachePath))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Could not write precompiled schema bundle: %s"), *CachePath);
+	}
+
+	BundleBytes = MoveTemp(CompiledBundle);
+	if (!ReadSchemaBundleIndex(BundleBytes.GetData(), BundleBytes.Num(), SchemaFilePath, SourceSize, SourceTimestampTicks))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Compiled schema bundle failed validation."));
+		ResetSchemaBundle();
+		return false;
+	}
+
+	UE_LOG(LogUnrealMCP, Log, TEXT("Compiled schema bundle. tools=%d bytes=%d"), BundleEntries.Num(), BundleBytes.Num());
+	return true;
+}
+
+bool UMCPToolRegistrySubsystem::LoadSchemaBundleCache(
+	const FString& CachePath,
+	const FString& SourcePath,
+	const int64 SourceSize,
+	const int64 SourceTimestampTicks)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*CachePath))
 	{
-		TSharedPtr<FJsonObject> ToolSchema = Entry.Value.IsValid() ? Entry.Value->AsObject() : nullptr;
-		if (ToolSchema.IsValid())
+		return false;
+	}
+
+	BundleMappedFile.Reset(PlatformFile.OpenMapped(*CachePath));
+	if (BundleMappedFile.IsValid() && BundleMappedFile->GetFileSize() > 0)
+	{
+		BundleMappedRegion.Reset(BundleMappedFile->MapRegion(0, BundleMappedFile->GetFileSize()));
+	}
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	if (BundleMappedRegion.IsValid())
+	{
+		Data = BundleMappedRegion->GetMappedPtr();
+		DataSize = BundleMappedRegion->GetMappedSize();
+	}
+	else
+	{
+		BundleMappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(BundleBytes, *CachePath))
 		{
-			BundleSchemas.Add(Entry.Key, ToolSchema);
+			return false;
 		}
+		Data = BundleBytes.GetData();
+		DataSize = BundleBytes.Num();
 	}
 
-	UE_LOG(LogUnrealMCP, Log, TEXT("Loaded schema bundle. tools=%d"), BundleSchemas.Num());
+	if (!ReadSchemaBundleIndex(Data, DataSize, SourcePath, SourceSize, SourceTimestampTicks))
+	{
+		ResetSchemaBundle();
+		return false;
+	}
+	return true;
 }
 
-TSharedPtr<FJsonObject> UMCPToolRegistrySubsystem::FindSchemaObject(const FString& ToolName, const FString& SchemaKey) const
+bool UMCPToolRegistrySubsystem::ReadSchemaBundleIndex(
+	const uint8* Data,
+	const int64 DataSize,
+	const FString& SourcePath,
+	const int64 SourceSize,
+	const int64 SourceTimestampTicks)
 {
-	if (const TSharedPtr<FJsonObject>* ToolSchema = BundleSchemas.Find(ToolName))
+	BundleEntries.Reset();
+	BundleBlobData = nullptr;
+	BundleBlobSize = 0;
+	if (Data == nullptr || DataSize <= 0 || DataSize > MAX_int32)
+	{
+		return false;
+	}
+
+	FMemoryReaderView Reader(MakeArrayView(Data, static_cast<int32>(DataSize)));
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Reader.IsError() || Magic != SchemaBundleMagic || Version != SchemaBundleVersion)
 	{
-		const TSharedPtr<FJsonObject>* SchemaObject = nullptr;
-		if ((*ToolSchema).IsValid() && (*ToolSchema)->TryGetObjectField(SchemaKey, SchemaObject) && SchemaObject != nullptr && SchemaObject->IsValid())
+		return false;
+	}
+
+	FString StoredSourcePath;
+	int64 StoredSourceSize = 0;
+	int64 StoredSourceTimestampTicks = 0;
+	int32 ToolCount = 0;
+	Reader << StoredSourcePath << StoredSourceSize << StoredSourceTimestampTicks << ToolCount;
+	if (Reader.IsError() ||
+		ToolCount < 0 ||
+		StoredSourceSize != SourceSize ||
+		StoredSourceTimestampTicks != SourceTimestampTicks ||
+		!StoredSourcePath.Equals(SourcePath, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	BundleEntries.Reserve(ToolCount);
+	for (int32 Index = 0; Index < ToolCount && !Reader.IsError(); ++Index)
+	{
+		FString ToolName;
+		FMCPSchemaBundleEntry Entry;
+		Reader << ToolName << Entry;
+		BundleEntries.Add(MoveTemp(ToolName), Entry);
+	}
+
+	int64 BlobSize = 0;
+	Reader << BlobSize;
+	const int64 BlobOffset = Reader.Tell();
+	if (Reader.IsError() || BlobSize < 0 || BlobOffset + BlobSize != DataSize)
+	{
+		BundleEntries.Reset();
+		return false;
+	}
+
+	for (const TPair<FString, FMCPSchemaBundleEntry>& Entry : BundleEntries)
+	{
+		const bool bParamsInRange = Entry.Value.ParamsOffset == INDEX_NONE ||
+			(Entry.Value.ParamsOffset >= 0 && Entry.Value.ParamsLength >= 0 && Entry.Value.ParamsOffset + static_cast<int64>(Entry.Value.ParamsLength) <= BlobSize);
+		const bool bResultInRange = Entry.Value.ResultOffset == INDEX_NONE ||
+			(Entry.Value.ResultOffset >= 0 && Entry.Value.ResultLength >= 0 && Entry.Value.ResultOffset + static_cast<int64>(Entry.Value.ResultLength) <= BlobSize);
+		if (!bParamsInRange || !bResultInRange)
 		{
-			return *SchemaObject;
+			BundleEntries.Reset();
+			return false;
 		}
 	}
 
-	return nullptr;
+	BundleBlobData = Data + BlobOffset;
+	BundleBlobSize = BlobSize;
+	return true;
+}
+
+void UMCPToolRegistrySubsystem::ResetSchemaBundle()
+{
+	BundleEntries.Reset();
+	BundleBlobData = nullptr;
+	BundleBlobSize = 0;
+	BundleMappedRegion.Reset();
+	BundleMappedFile.Reset();
+	BundleBytes.Reset();
+
+	{
+		FScopeLock ScopeLock(&SchemaMaterializationGuard);
+		MaterializedSchemas.Reset();
+	}
+
+	FScopeLock ScopeLock(&ToolsListCacheGuard);
+	CachedToolsListResults.Reset();
+}
+
+TSharedPtr<FJsonObject> UMCPToolRegistrySubsystem::ParseSchemaBundleSlice(const int32 Offset, const int32 Length) const
+{
+	if (Offset == INDEX_NONE || BundleBlobData == nullptr || Offset + static_cast<int64>(Length) > BundleBlobSize)
+	{
+		return nullptr;
+	}
+
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(BundleBlobData + Offset), Length);
+	const FString SchemaJson(Converted.Length(), Converted.Get());
+
+	TSharedPtr<FJsonObject> SchemaObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SchemaJson);
+	if (!FJsonSerializer::Deserialize(Reader, SchemaObject) || !SchemaObject.IsValid())
+	{
+		return nullptr;
+	}
+	return SchemaObject;
+}
+
+TSharedPtr<const FMCPMaterializedToolSchemas> UMCPToolRegistrySubsystem::MaterializeToolSchemas(const FString& ToolName) const
+{
+	FScopeLock ScopeLock(&SchemaMaterializationGuard);
+	if (const TSharedPtr<const FMCPMaterializedToolSchemas>* Existing = MaterializedSchemas.Find(ToolName))
+	{
+		return *Existing;
+	}
+
+	const FMCPSchemaBundleEntry* Entry = BundleEntries.Find(ToolName);
+	if (Entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FMCPMaterializedToolSchemas> Materialized = MakeShared<FMCPMaterializedToolSchemas>();
+	Materialized->ParamsSchema = ParseSchemaBundleSlice(Entry->ParamsOffset, Entry->ParamsLength);
+	Materialized->ResultSchema = ParseSchemaBundleSlice(Entry->ResultOffset, Entry->ResultLength);
+	Materialized->CompiledParamsSchema = MCPToolSchemaValidator::CompileSchema(Materialized->ParamsSchema);
+	MaterializedSchemas.Add(ToolName, Materialized);
+	return Materialized;
 }
 
 void UMCPToolRegistrySubsystem::RebuildSchemaHash()
 {
 	TArray<FString> ToolNames = GetRegisteredToolNames();
-	FString HashMaterial;
+	FXxHash128Builder Builder;
 	for (const FString& ToolName : ToolNames)
 	{
 		const FMCPToolDefinition* ToolDefinition = RegisteredTools.Find(ToolName);
@@ -1169,18 +1505,18 @@ void UMCPToolRegistrySubsystem::RebuildSchemaHash()
 			continue;
 		}
 
-		HashMaterial += ToolDefinition->Name;
-		HashMaterial += TEXT("|");
-		HashMaterial += MCPJson::SerializeJsonObject(ToolDefinition->ParamsSchema);
-		HashMaterial += TEXT("|");
-		HashMaterial += MCPJson::SerializeJsonObject(ToolDefinition->ResultSchema);
-		HashMaterial += TEXT("\n");
+		const FMCPSchemaBundleEntry* BundleEntry = BundleEntries.Find(ToolName);
+		const uint64 SchemaHashLow = BundleEntry != nullptr ? BundleEntry->HashLow : 0;
+		const uint64 SchemaHashHigh = BundleEntry != nullptr ? BundleEntry->HashHigh : 0;
+		MCPJson::AppendHashString(Builder, ToolDefinition->Name);
+		Builder.Update(&SchemaHashLow, sizeof(SchemaHashLow));
+		Builder.Update(&SchemaHashHigh, sizeof(SchemaHashHigh));
 	}
 
-	FTCHARToUTF8 Utf8Data(*HashMaterial);
-	uint8 Digest[FSHA1::DigestSize];
-	FSHA1::HashBuffer(Utf8Data.Get(), Utf8Data.Length(), Digest);
-	CachedSchemaHash = BytesToHex(Digest, UE_ARRAY_COUNT(Digest));
+	CachedSchemaHash = MCPJson::HashToHex(Builder.Finalize());
+
+	FScopeLock ScopeLock(&ToolsListCacheGuard);
+	CachedToolsListResults.Reset();
 }
 
 bool UMCPToolRegistrySubsystem::HandleToolsList(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
@@ -1193,6 +1529,16 @@ bool UMCPToolRegistrySubsystem::HandleSystemHealth(const FMCPRequestEnvelope& Re
 	return FMCPToolsCoreHandler::HandleSystemHealth(*this, RegisteredTools.Num(), Request, OutResult);
 }
 
+bool UMCPToolRegistrySubsystem::HandleMetricsGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
+{
+	return FMCPToolsCoreHandler::HandleMetricsGet(Request, OutResult);
+}
+
+bool UMCPToolRegistrySubsystem::HandleBatch(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
+{
+	return FMCPToolsCoreHandler::HandleBatch(Request, OutResult);
+}
+
 bool UMCPToolRegistrySubsystem::HandleEditorLiveCodingCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
 {
 	return FMCPToolsCoreHandler::HandleEditorLiveCodingCompile(Request, OutResult);
@@ -1496,6 +1842,14 @@ bool UMCPToolRegistrySubsystem::HandleUMGBlueprintPatch(const FMCPRequestEnvelop
 		});
 }
 
+bool UMCPToolRegistrySubsystem::HandleUMGBlueprintCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
+{
+	return FMCPToolsUMGStructureHandler::HandleBlueprintCompile(
+		Request,
+		OutResult,
+		[](const FString& ObjectPath) { return LoadWidgetBlueprintByPath(ObjectPath); });
+}
+
 bool UMCPToolRegistrySubsystem::HandleUMGBlueprintReparent(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
 {
 	return FMCPToolsUMGStructureHandler::HandleBlueprintReparent(
@@ -2536,6 +2890,16 @@ bool UMCPToolRegistrySubsystem::HandleChangeSetRollbackApply(const FMCPRequestEn
 	return FMCPToolsOpsHandler::HandleChangeSetRollbackApply(Request, OutResult);
 }
 
+bool UMCPToolRegistrySubsystem::HandleChangeSetPin(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
+{
+	return FMCPToolsOpsHandler::HandleChangeSetPin(Request, true, OutResult);
+}
+
+bool UMCPToolRegistrySubsystem::HandleChangeSetUnpin(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
+{
+	return FMCPToolsOpsHandler::HandleChangeSetPin(Request, false, OutResult);
+}
+
 bool UMCPToolRegistrySubsystem::HandleJobGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const
 {
 	return FMCPToolsOpsHandler::HandleJobGet(Request, OutResult);
@@ -0,0 +1,328 @@
+#include "MCPToolResultCache.h"
+
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "MCPObservabilitySubsystem.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr int32 SpillFileVersion = 3;
+}
+
+FMCPToolResultCache::FMCPToolResultCache(const FMCPToolResultCacheSettings& InSettings)
+	: Settings(InSettings)
+{
+	if (Settings.bDiskSpillEnabled)
+	{
+		PruneSpillDir();
+	}
+}
+
+EMCPToolResultCacheLookup FMCPToolResultCache::Find(
+	const FString& Key,
+	const FString& ParamsHash,
+	const int64 NowMs,
+	EMCPResponseStatus& OutStatus,
+	FString& OutResponseJson)
+{
+	OutResponseJson.Empty();
+
+	FScopeLock ScopeLock(&CacheGuard);
+	const FEntry* Entry = FindEntryLocked(Key, NowMs);
+	if (Entry == nullptr)
+	{
+		return EMCPToolResultCacheLookup::Miss;
+	}
+
+	if (Entry->ParamsHash != ParamsHash)
+	{
+		return EMCPToolResultCacheLookup::Conflict;
+	}
+
+	if (!DecodeResponse(*Entry, OutResponseJson))
+	{
+		RemoveEntryLocked(Key, false);
+		PublishUsageLocked();
+		return EMCPToolResultCacheLookup::Miss;
+	}
+
+	OutStatus = Entry->Status;
+	return EMCPToolResultCacheLookup::Hit;
+}
+
+bool FMCPToolResultCache::Add(const FString& Key, const FString& ParamsHash, const EMCPResponseStatus Status, const FString& ResponseJson, const int64 NowMs)
+{
+	FEntry Entry;
+	Entry.ParamsHash = ParamsHash;
+	Entry.Status = Status;
+	Entry.CreatedAtMs = NowMs;
+	if (!EncodeResponse(ResponseJson, Entry))
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&CacheGuard);
+	AddEntryLocked(Key, MoveTemp(Entry));
+	EnforceLimitsLocked(NowMs);
+	PublishUsageLocked();
+	return true;
+}
+
+void FMCPToolResultCache::EvictAll()
+{
+	FScopeLock ScopeLock(&CacheGuard);
+	TArray<FString> Keys;
+	EntriesByKey.GetKeys(Keys);
+	for (const FString& Key : Keys)
+	{
+		RemoveEntryLocked(Key, Settings.bDiskSpillEnabled);
+	}
+	PublishUsageLocked();
+}
+
+int32 FMCPToolResultCache::Num() const
+{
+	FScopeLock ScopeLock(&CacheGuard);
+	return EntriesByKey.Num();
+}
+
+int64 FMCPToolResultCache::GetTotalBytes() const
+{
+	FScopeLock ScopeLock(&CacheGuard);
+	return TotalBytes;
+}
+
+FMCPToolResultCache::FEntry* FMCPToolResultCache::FindEntryLocked(const FString& Key, const int64 NowMs)
+{
+	UMCPObservabilitySubsystem* Observability = Settings.bReportObservability && GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
+
+	FEntry* Entry = EntriesByKey.Find(Key);
+	if (Entry == nullptr && Settings.bDiskSpillEnabled && SpilledFileNames.Remove(GetSpillFileName(Key)) > 0)
+	{
+		FEntry RestoredEntry;
+		const bool bRestored = ReadSpillFile(Key, RestoredEntry);
+		IFileManager::Get().Delete(*GetSpillFilePath(Key), false, true, true);
+		if (bRestored && NowMs - RestoredEntry.CreatedAtMs <= Settings.TtlMs)
+		{
+			AddEntryLocked(Key, MoveTemp(RestoredEntry));
+			EnforceLimitsLocked(NowMs);
+			PublishUsageLocked();
+			if (Observability != nullptr)
+			{
+				Observability->RecordIdempotencyCacheRestore();
+			}
+			Entry = EntriesByKey.Find(Key);
+		}
+	}
+
+	if (Entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (NowMs - Entry->CreatedAtMs > Settings.TtlMs)
+	{
+		RemoveEntryLocked(Key, false);
+		PublishUsageLocked();
+		if (Observability != nullptr)
+		{
+			Observability->RecordIdempotencyCacheEviction(true);
+		}
+		return nullptr;
+	}
+
+	if (Entry->LruNode != LruList.GetHead())
+	{
+		LruList.RemoveNode(Entry->LruNode);
+		LruList.AddHead(Key);
+		Entry->LruNode = LruList.GetHead();
+	}
+	return Entry;
+}
+
+void FMCPToolResultCache::AddEntryLocked(const FString& Key, FEntry&& Entry)
+{
+	RemoveEntryLocked(Key, false);
+
+	LruList.AddHead(Key);
+	Entry.LruNode = LruList.GetHead();
+	TotalBytes += Entry.ResponseBytes.Num();
+	EntriesByKey.Add(Key, MoveTemp(Entry));
+}
+
+void FMCPToolResultCache::RemoveEntryLocked(const FString& Key, const bool bSpillToDisk)
+{
+	FEntry Entry;
+	if (!EntriesByKey.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	TotalBytes -= Entry.ResponseBytes.Num();
+	if (Entry.LruNode != nullptr)
+	{
+		LruList.RemoveNode(Entry.LruNode);
+	}
+
+	if (bSpillToDisk && WriteSpillFile(Key, Entry))
+	{
+		SpilledFileNames.Add(GetSpillFileName(Key));
+		if (UMCPObservabilitySubsystem* Observability = Settings.bReportObservability && GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+		{
+			Observability->RecordIdempotencyCacheSpill(1);
+		}
+	}
+}
+
+void FMCPToolResultCache::EnforceLimitsLocked(const int64 NowMs)
+{
+	UMCPObservabilitySubsystem* Observability = Settings.bReportObservability && GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
+	while (EntriesByKey.Num() > Settings.MaxEntries || TotalBytes > Settings.MaxBytes)
+	{
+		const TDoubleLinkedList<FString>::TDoubleLinkedListNode* TailNode = LruList.GetTail();
+		if (TailNode == nullptr)
+		{
+			break;
+		}
+
+		const FString EvictedKey = TailNode->GetValue();
+		const FEntry* EvictedEntry = EntriesByKey.Find(EvictedKey);
+		const bool bExpired = EvictedEntry != nullptr && NowMs - EvictedEntry->CreatedAtMs > Settings.TtlMs;
+		RemoveEntryLocked(EvictedKey, Settings.bDiskSpillEnabled && !bExpired);
+		if (Observability != nullptr)
+		{
+			Observability->RecordIdempotencyCacheEviction(bExpired);
+		}
+	}
+}
+
+void FMCPToolResultCache::PublishUsageLocked() const
+{
+	if (UMCPObservabilitySubsystem* Observability = Settings.bReportObservability && GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr)
+	{
+		Observability->RecordIdempotencyCacheUsage(EntriesByKey.Num(), TotalBytes);
+	}
+}
+
+bool FMCPToolResultCache::EncodeResponse(const FString& ResponseJson, FEntry& OutEntry) const
+{
+	const FTCHARToUTF8 Utf8Response(*ResponseJson);
+	const int32 Utf8Length = Utf8Response.Length();
+	OutEntry.UncompressedSize = Utf8Length;
+	OutEntry.bCompressed = false;
+
+	if (Utf8Length >= Settings.CompressionThresholdBytes && Settings.CompressionThresholdBytes > 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Utf8Length);
+		OutEntry.ResponseBytes.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Zlib, OutEntry.ResponseBytes.GetData(), CompressedSize, Utf8Response.Get(), Utf8Length)
+			&& CompressedSize < Utf8Length)
+		{
+			OutEntry.ResponseBytes.SetNum(CompressedSize);
+			OutEntry.bCompressed = true;
+			return true;
+		}
+	}
+
+	OutEntry.ResponseBytes.Reset();
+	OutEntry.ResponseBytes.Append(reinterpret_cast<const uint8*>(Utf8Response.Get()), Utf8Length);
+	return true;
+}
+
+bool FMCPToolResultCache::DecodeResponse(const FEntry& Entry, FString& OutResponseJson) const
+{
+	TArray<uint8> Utf8Bytes;
+	const TArray<uint8>* SourceBytes = &Entry.ResponseBytes;
+	if (Entry.bCompressed)
+	{
+		Utf8Bytes.SetNumUninitialized(Entry.UncompressedSize);
+		if (!FCompression::UncompressMemory(NAME_Zlib, Utf8Bytes.GetData(), Entry.UncompressedSize, Entry.ResponseBytes.GetData(), Entry.ResponseBytes.Num()))
+		{
+			return false;
+		}
+		SourceBytes = &Utf8Bytes;
+	}
+
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(SourceBytes->GetData()), SourceBytes->Num());
+	OutResponseJson = FString(Converter.Length(), Converter.Get());
+	return true;
+}
+
+FString FMCPToolResultCache::GetSpillFileName(const FString& Key) const
+{
+	return FMD5::HashAnsiString(*Key) + TEXT(".bin");
+}
+
+FString FMCPToolResultCache::GetSpillFilePath(const FString& Key) const
+{
+	return FPaths::Combine(Settings.SpillDir, GetSpillFileName(Key));
+}
+
+bool FMCPToolResultCache::WriteSpillFile(const FString& Key, const FEntry& Entry) const
+{
+	TArray<uint8> FileBytes;
+	FMemoryWriter Writer(FileBytes);
+	int32 Version = SpillFileVersion;
+	FString StoredKey = Key;
+	FString ParamsHash = Entry.ParamsHash;
+	int64 CreatedAtMs = Entry.CreatedAtMs;
+	uint8 Status = static_cast<uint8>(Entry.Status);
+	int32 UncompressedSize = Entry.UncompressedSize;
+	bool bCompressed = Entry.bCompressed;
+	TArray<uint8> ResponseBytes = Entry.ResponseBytes;
+	Writer << Version << StoredKey << ParamsHash << CreatedAtMs << Status << UncompressedSize << bCompressed << ResponseBytes;
+
+	IFileManager::Get().MakeDirectory(*Settings.SpillDir, true);
+	return FFileHelper::SaveArrayToFile(FileBytes, *GetSpillFilePath(Key));
+}
+
+bool FMCPToolResultCache::ReadSpillFile(const FString& Key, FEntry& OutEntry) const
+{
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *GetSpillFilePath(Key), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileBytes);
+	int32 Version = 0;
+	FString StoredKey;
+	Reader << Version;
+	if (Version != SpillFileVersion)
+	{
+		return false;
+	}
+
+	uint8 Status = 0;
+	Reader << StoredKey << OutEntry.ParamsHash << OutEntry.CreatedAtMs << Status << OutEntry.UncompressedSize << OutEntry.bCompressed << OutEntry.ResponseBytes;
+	OutEntry.Status = static_cast<EMCPResponseStatus>(Status);
+	return !Reader.IsError() && StoredKey == Key;
+}
+
+void FMCPToolResultCache::PruneSpillDir()
+{
+	SpilledFileNames.Reset();
+	TArray<FString> SpillFiles;
+	IFileManager::Get().FindFiles(SpillFiles, *FPaths::Combine(Settings.SpillDir, TEXT("*.bin")), true, false);
+
+	const FDateTime ExpiredBefore = FDateTime::UtcNow() - FTimespan::FromMilliseconds(static_cast<double>(Settings.TtlMs));
+	for (const FString& SpillFile : SpillFiles)
+	{
+		const FString SpillFilePath = FPaths::Combine(Settings.SpillDir, SpillFile);
+		if (IFileManager::Get().GetTimeStamp(*SpillFilePath) < ExpiredBefore)
+		{
+			IFileManager::Get().Delete(*SpillFilePath, false, true, true);
+		}
+		else
+		{
+			SpilledFileNames.Add(SpillFile);
+		}
+	}
+}
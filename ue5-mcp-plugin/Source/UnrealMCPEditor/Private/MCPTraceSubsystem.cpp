@@ -0,0 +1,384 @@
+#include "MCPTraceSubsystem.h"
+
+#include "MCPLog.h"
+#include "MCPTime.h"
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Serialization/JsonWriter.h"
+
+UE_TRACE_CHANNEL_DEFINE(MCPChannel);
+
+UE_TRACE_EVENT_BEGIN(UnrealMCP, RequestBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, RequestId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Tool)
+UE_TRACE_EVENT_END()
+
+UMCPTraceSubsystem* UMCPTraceSubsystem::ActiveRecorder = nullptr;
+
+void UMCPTraceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	BackgroundWritesIdleEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	LoadSettings();
+
+	if (bChromeTraceEnabled)
+	{
+		StartRecording();
+		UE_LOG(LogUnrealMCP, Log, TEXT("MCP Chrome trace recorder enabled: %s"), *GetTraceDir());
+	}
+}
+
+void UMCPTraceSubsystem::Deinitialize()
+{
+	StopRecording();
+
+	// Chunk writes already handed to the task graph are waited out; anything recorded afterwards is written inline.
+	bool bWaitForBackgroundWrites = false;
+	{
+		FScopeLock ScopeLock(&TraceGuard);
+		bShuttingDown = true;
+		bWaitForBackgroundWrites = InFlightBackgroundWrites > 0;
+	}
+	if (bWaitForBackgroundWrites)
+	{
+		BackgroundWritesIdleEvent->Wait();
+	}
+	FPlatformProcess::ReturnSynchEventToPool(BackgroundWritesIdleEvent);
+	BackgroundWritesIdleEvent = nullptr;
+
+	FString FlushedFilePath;
+	FlushChromeTrace(FlushedFilePath);
+	Super::Deinitialize();
+}
+
+UMCPTraceSubsystem* UMCPTraceSubsystem::GetActiveRecorder()
+{
+	return ActiveRecorder;
+}
+
+void UMCPTraceSubsystem::TraceRequestBegin(const FString& RequestId, const FString& Tool)
+{
+	UE_TRACE_LOG(UnrealMCP, RequestBegin, MCPChannel)
+		<< RequestBegin.Cycle(FPlatformTime::Cycles64())
+		<< RequestBegin.RequestId(*RequestId, RequestId.Len())
+		<< RequestBegin.Tool(*Tool, Tool.Len());
+}
+
+void UMCPTraceSubsystem::RecordEvent(FMCPChromeTraceEvent&& Event)
+{
+	TArray<FMCPChromeTraceEvent> EventsToWrite;
+	{
+		FScopeLock ScopeLock(&TraceGuard);
+		BufferedEvents.Add(MoveTemp(Event));
+		if (BufferedEvents.Num() < MaxBufferedEvents)
+		{
+			return;
+		}
+
+		EventsToWrite = MoveTemp(BufferedEvents);
+		BufferedEvents.Reset();
+	}
+
+	// Serializing a full buffer takes long enough to stall the request that tipped it over, so it goes to the task graph.
+	ScheduleChunkWrite(MoveTemp(EventsToWrite));
+}
+
+bool UMCPTraceSubsystem::FlushChromeTrace(FString& OutFilePath)
+{
+	TArray<FMCPChromeTraceEvent> EventsToWrite;
+	int32 ChunkIndex = 0;
+	{
+		FScopeLock ScopeLock(&TraceGuard);
+		if (BufferedEvents.Num() == 0)
+		{
+			return false;
+		}
+
+		EventsToWrite = MoveTemp(BufferedEvents);
+		BufferedEvents.Reset();
+		ChunkIndex = FlushedChunkCount++;
+	}
+
+	return WriteChromeTraceFile(EventsToWrite, ChunkIndex, OutFilePath);
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+bool UMCPTraceSubsystem::IsChromeTraceEnabled() const
+{
+	return ActiveRecorder == this;
+}
+
+void UMCPTraceSubsystem::SetChromeTraceEnabled(const bool bEnabled)
+{
+	if (bEnabled)
+	{
+		StartRecording();
+	}
+	else
+	{
+		StopRecording();
+		FString FlushedFilePath;
+		FlushChromeTrace(FlushedFilePath);
+	}
+}
+#endif
+
+void UMCPTraceSubsystem::StartRecording()
+{
+	if (ActiveRecorder == this)
+	{
+		return;
+	}
+
+	// The session keeps its name and time base across toggles so chunk files of one editor run stay comparable.
+	if (SessionName.IsEmpty())
+	{
+		BaseCycles = MCPTime::NowCycles();
+		SessionName = FString::Printf(TEXT("mcp_trace_%s_%u"), *FDateTime::UtcNow().ToString(TEXT("%Y%m%d_%H%M%S")), FPlatformProcess::GetCurrentProcessId());
+		BufferedEvents.Reserve(FMath::Min(MaxBufferedEvents, 4096));
+		PruneTraceDir();
+	}
+
+	if (FlushIntervalSeconds > 0.0f && !FlushTickHandle.IsValid())
+	{
+		FlushTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UMCPTraceSubsystem::HandleFlushTicker),
+			FlushIntervalSeconds);
+	}
+
+	ActiveRecorder = this;
+}
+
+void UMCPTraceSubsystem::StopRecording()
+{
+	if (ActiveRecorder == this)
+	{
+		ActiveRecorder = nullptr;
+	}
+
+	if (FlushTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushTickHandle);
+		FlushTickHandle.Reset();
+	}
+}
+
+bool UMCPTraceSubsystem::HandleFlushTicker(float DeltaSeconds)
+{
+	(void)DeltaSeconds;
+
+	TArray<FMCPChromeTraceEvent> EventsToWrite;
+	{
+		FScopeLock ScopeLock(&TraceGuard);
+		if (BufferedEvents.Num() == 0)
+		{
+			return true;
+		}
+
+		EventsToWrite = MoveTemp(BufferedEvents);
+		BufferedEvents.Reset();
+	}
+
+	ScheduleChunkWrite(MoveTemp(EventsToWrite));
+	return true;
+}
+
+void UMCPTraceSubsystem::ScheduleChunkWrite(TArray<FMCPChromeTraceEvent>&& Events)
+{
+	int32 ChunkIndex = 0;
+	bool bWriteInline = false;
+	{
+		FScopeLock ScopeLock(&TraceGuard);
+		ChunkIndex = FlushedChunkCount++;
+		bWriteInline = bShuttingDown;
+		if (!bWriteInline)
+		{
+			++InFlightBackgroundWrites;
+		}
+	}
+
+	if (bWriteInline)
+	{
+		FString FlushedFilePath;
+		WriteChromeTraceFile(Events, ChunkIndex, FlushedFilePath);
+		return;
+	}
+
+	const TWeakObjectPtr<UMCPTraceSubsystem> WeakThis(this);
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [WeakThis, ChunkIndex, Events = MoveTemp(Events)]()
+	{
+		// Deinitialize waits for counted writes, so the subsystem outlives every chunk scheduled before it.
+		if (UMCPTraceSubsystem* TraceSubsystem = WeakThis.Get())
+		{
+			FString FlushedFilePath;
+			TraceSubsystem->WriteChromeTraceFile(Events, ChunkIndex, FlushedFilePath);
+			TraceSubsystem->FinishBackgroundWrite();
+		}
+	});
+}
+
+void UMCPTraceSubsystem::FinishBackgroundWrite()
+{
+	FScopeLock ScopeLock(&TraceGuard);
+	--InFlightBackgroundWrites;
+	if (InFlightBackgroundWrites == 0 && bShuttingDown && BackgroundWritesIdleEvent != nullptr)
+	{
+		BackgroundWritesIdleEvent->Trigger();
+	}
+}
+
+FString UMCPTraceSubsystem::GetTraceDir() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"), TEXT("traces"));
+}
+
+void UMCPTraceSubsystem::LoadSettings()
+{
+	const TCHAR* Section = TEXT("UnrealMCP.Trace");
+
+	bool bConfiguredEnabled = bChromeTraceEnabled;
+	if (GConfig->GetBool(Section, TEXT("bChromeTraceEnabled"), bConfiguredEnabled, GEditorPerProjectIni))
+	{
+		bChromeTraceEnabled = bConfiguredEnabled;
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("MCPChromeTrace")))
+	{
+		bChromeTraceEnabled = true;
+	}
+
+	int32 ConfiguredMaxBufferedEvents = MaxBufferedEvents;
+	if (GConfig->GetInt(Section, TEXT("MaxBufferedEvents"), ConfiguredMaxBufferedEvents, GEditorPerProjectIni))
+	{
+		MaxBufferedEvents = FMath::Clamp(ConfiguredMaxBufferedEvents, 256, 1000000);
+	}
+
+	float ConfiguredFlushIntervalSeconds = FlushIntervalSeconds;
+	if (GConfig->GetFloat(Section, TEXT("FlushIntervalSeconds"), ConfiguredFlushIntervalSeconds, GEditorPerProjectIni))
+	{
+		// Zero leaves flushing to a full buffer, an explicit FlushChromeTrace, or shutdown.
+		FlushIntervalSeconds = ConfiguredFlushIntervalSeconds > 0.0f ? FMath::Max(ConfiguredFlushIntervalSeconds, 1.0f) : 0.0f;
+	}
+
+	int32 ConfiguredMaxTraceFiles = MaxTraceFiles;
+	if (GConfig->GetInt(Section, TEXT("MaxTraceFiles"), ConfiguredMaxTraceFiles, GEditorPerProjectIni))
+	{
+		MaxTraceFiles = FMath::Clamp(ConfiguredMaxTraceFiles, 1, 4096);
+	}
+}
+
+bool UMCPTraceSubsystem::WriteChromeTraceFile(const TArray<FMCPChromeTraceEvent>& Events, const int32 ChunkIndex, FString& OutFilePath) const
+{
+	if (Events.Num() == 0)
+	{
+		return false;
+	}
+
+	const uint32 ProcessId = FPlatformProcess::GetCurrentProcessId();
+	FString TraceJson;
+	TraceJson.Reserve(Events.Num() * 160);
+
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&TraceJson);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("displayTimeUnit"), TEXT("ms"));
+	Writer->WriteArrayStart(TEXT("traceEvents"));
+	for (const FMCPChromeTraceEvent& Event : Events)
+	{
+		const uint64 RelativeCycles = Event.StartCycles > BaseCycles ? Event.StartCycles - BaseCycles : 0;
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Event.Name);
+		Writer->WriteValue(TEXT("cat"), Event.Category);
+		Writer->WriteValue(TEXT("ph"), TEXT("X"));
+		Writer->WriteValue(TEXT("ts"), MCPTime::CyclesToMicroseconds(RelativeCycles));
+		Writer->WriteValue(TEXT("dur"), Event.DurationUs);
+		Writer->WriteValue(TEXT("pid"), static_cast<int64>(ProcessId));
+		Writer->WriteValue(TEXT("tid"), static_cast<int64>(Event.ThreadId));
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("request_id"), Event.RequestId);
+		Writer->WriteValue(TEXT("tool"), Event.Tool);
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	OutFilePath = FPaths::Combine(GetTraceDir(), FString::Printf(TEXT("%s_%03d.json"), *SessionName, ChunkIndex));
+	IFileManager::Get().MakeDirectory(*GetTraceDir(), true);
+	if (!FFileHelper::SaveStringToFile(TraceJson, *OutFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogUnrealMCP, Warning, TEXT("Failed to write MCP Chrome trace: %s"), *OutFilePath);
+		return false;
+	}
+
+	return true;
+}
+
+void UMCPTraceSubsystem::PruneTraceDir() const
+{
+	const FString TraceDir = GetTraceDir();
+	TArray<FString> TraceFiles;
+	IFileManager::Get().FindFiles(TraceFiles, *FPaths::Combine(TraceDir, TEXT("mcp_trace_*.json")), true, false);
+	if (TraceFiles.Num() <= MaxTraceFiles)
+	{
+		return;
+	}
+
+	// Session names embed a sortable UTC timestamp, so lexical order is chronological.
+	TraceFiles.Sort();
+	const int32 DeleteCount = TraceFiles.Num() - MaxTraceFiles;
+	for (int32 Index = 0; Index < DeleteCount; ++Index)
+	{
+		IFileManager::Get().Delete(*FPaths::Combine(TraceDir, TraceFiles[Index]), false, true, true);
+	}
+}
+
+FMCPTraceScope::FMCPTraceScope(const TCHAR* InCategory, const TCHAR* InName, const FString& InRequestId, const FString& InTool)
+{
+#if CPUPROFILERTRACE_ENABLED
+	bCpuTraceActive = UE_TRACE_CHANNELEXPR_IS_ENABLED(MCPChannel);
+	if (bCpuTraceActive)
+	{
+		FCpuProfilerTrace::OutputBeginDynamicEvent(InName);
+	}
+#endif
+
+	Recorder = UMCPTraceSubsystem::GetActiveRecorder();
+	if (Recorder != nullptr)
+	{
+		Event.Category = InCategory;
+		Event.Name = InName;
+		Event.RequestId = InRequestId;
+		Event.Tool = InTool;
+		Event.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		Event.StartCycles = MCPTime::NowCycles();
+	}
+}
+
+FMCPTraceScope::~FMCPTraceScope()
+{
+	if (Recorder != nullptr && Recorder == UMCPTraceSubsystem::GetActiveRecorder())
+	{
+		Event.DurationUs = MCPTime::MicrosecondsSince(Event.StartCycles);
+		Recorder->RecordEvent(MoveTemp(Event));
+	}
+
+#if CPUPROFILERTRACE_ENABLED
+	if (bCpuTraceActive)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+}
@@ -4,7 +4,6 @@
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
-#include "Misc/SecureHash.h"
 
 TSharedRef<FJsonObject> FMCPDiagnostic::ToJson() const
 {
@@ -33,6 +32,8 @@ namespace
 		ContextObject->TryGetBoolField(TEXT("deterministic"), OutContext.bDeterministic);
 		ContextObject->TryGetBoolField(TEXT("dry_run"), OutContext.bDryRun);
 		ContextObject->TryGetStringField(TEXT("idempotency_key"), OutContext.IdempotencyKey);
+		ContextObject->TryGetBoolField(TEXT("async"), OutContext.bAsync);
+		ContextObject->TryGetStringField(TEXT("durability"), OutContext.Durability);
 		if (ContextObject->TryGetStringField(TEXT("cancel_token"), OutContext.CancelToken))
 		{
 			OutContext.bHasCancelToken = true;
@@ -85,6 +86,19 @@ bool MCPJson::ParseRequestEnvelope(const FString& RequestJson, FMCPRequestEnvelo
 		return false;
 	}
 
+	return ParseRequestEnvelopeObject(RootObject, OutRequest, OutError);
+}
+
+bool MCPJson::ParseRequestEnvelopeObject(const TSharedPtr<FJsonObject>& RootObject, FMCPRequestEnvelope& OutRequest, FMCPDiagnostic& OutError)
+{
+	if (!RootObject.IsValid())
+	{
+		OutError.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
+		OutError.Message = TEXT("Request envelope must be a JSON object.");
+		OutError.Suggestion = TEXT("Check request JSON format and required fields.");
+		return false;
+	}
+
 	if (!RootObject->TryGetStringField(TEXT("protocol"), OutRequest.Protocol))
 	{
 		OutRequest.Protocol = TEXT("unreal-mcp/1.0");
@@ -127,6 +141,11 @@ bool MCPJson::ParseRequestEnvelope(const FString& RequestJson, FMCPRequestEnvelo
 		ParseContext(*ContextObject, OutRequest.Context);
 	}
 
+	if (!OutRequest.Context.IdempotencyKey.IsEmpty())
+	{
+		OutRequest.ParamsHash = HashJsonObject(OutRequest.Params);
+	}
+
 	return true;
 }
 
@@ -134,7 +153,7 @@ FString MCPJson::BuildResponseEnvelope(
 	const FMCPRequestEnvelope& Request,
 	const FMCPToolExecutionResult& Result,
 	const FString& ChangeSetId,
-	int64 DurationMs)
+	int64 DurationUs)
 {
 	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
 	RootObject->SetStringField(TEXT("request_id"), Request.RequestId);
@@ -157,16 +176,7 @@ FString MCPJson::BuildResponseEnvelope(
 	}
 	RootObject->SetArrayField(TEXT("touched_packages"), TouchedPackageValues);
 
-	TArray<TSharedPtr<FJsonValue>> ErrorValues;
-	TArray<TSharedPtr<FJsonValue>> WarningValues;
-	TArray<TSharedPtr<FJsonValue>> InfoValues;
-	AddDiagnosticsBySeverity(Result.Diagnostics, ErrorValues, WarningValues, InfoValues);
-
-	TSharedRef<FJsonObject> DiagnosticsObject = MakeShared<FJsonObject>();
-	DiagnosticsObject->SetArrayField(TEXT("errors"), ErrorValues);
-	DiagnosticsObject->SetArrayField(TEXT("warnings"), WarningValues);
-	DiagnosticsObject->SetArrayField(TEXT("infos"), InfoValues);
-	RootObject->SetObjectField(TEXT("diagnostics"), DiagnosticsObject);
+	RootObject->SetObjectField(TEXT("diagnostics"), BuildDiagnosticsObject(Result.Diagnostics));
 
 	TArray<TSharedPtr<FJsonValue>> ArtifactValues;
 	for (const TSharedPtr<FJsonObject>& ArtifactObject : Result.Artifacts)
@@ -179,20 +189,142 @@ FString MCPJson::BuildResponseEnvelope(
 	RootObject->SetArrayField(TEXT("artifacts"), ArtifactValues);
 
 	TSharedRef<FJsonObject> MetricsObject = MakeShared<FJsonObject>();
-	MetricsObject->SetNumberField(TEXT("duration_ms"), static_cast<double>(DurationMs));
+	MetricsObject->SetNumberField(TEXT("duration_ms"), static_cast<double>(DurationUs) / 1000.0);
+	MetricsObject->SetNumberField(TEXT("duration_us"), static_cast<double>(DurationUs));
 	RootObject->SetObjectField(TEXT("metrics"), MetricsObject);
 	RootObject->SetBoolField(TEXT("idempotent_replay"), Result.bIdempotentReplay);
 
-	return SerializeJsonObject(RootObject);
+	const FString ResponseJson = SerializeJsonObject(RootObject);
+	const bool bHasResultFields = Result.ResultObject.IsValid() && Result.ResultObject->Values.Num() > 0;
+	if (Result.ResultJson.IsEmpty() || bHasResultFields)
+	{
+		return ResponseJson;
+	}
+
+	static const FString EmptyResultField = TEXT("\"result\":{}");
+	const int32 ResultFieldIndex = ResponseJson.Find(EmptyResultField, ESearchCase::CaseSensitive);
+	if (ResultFieldIndex == INDEX_NONE)
+	{
+		return ResponseJson;
+	}
+
+	return ResponseJson.Left(ResultFieldIndex) + TEXT("\"result\":") + Result.ResultJson + ResponseJson.Mid(ResultFieldIndex + EmptyResultField.Len());
+}
+
+TSharedRef<FJsonObject> MCPJson::BuildDiagnosticsObject(const TArray<FMCPDiagnostic>& Diagnostics)
+{
+	TArray<TSharedPtr<FJsonValue>> ErrorValues;
+	TArray<TSharedPtr<FJsonValue>> WarningValues;
+	TArray<TSharedPtr<FJsonValue>> InfoValues;
+	AddDiagnosticsBySeverity(Diagnostics, ErrorValues, WarningValues, InfoValues);
+
+	TSharedRef<FJsonObject> DiagnosticsObject = MakeShared<FJsonObject>();
+	DiagnosticsObject->SetArrayField(TEXT("errors"), ErrorValues);
+	DiagnosticsObject->SetArrayField(TEXT("warnings"), WarningValues);
+	DiagnosticsObject->SetArrayField(TEXT("infos"), InfoValues);
+	return DiagnosticsObject;
 }
 
 FString MCPJson::HashJsonObject(const TSharedPtr<FJsonObject>& JsonObject)
 {
-	const FString SerializedJson = SerializeJsonObject(JsonObject);
-	FTCHARToUTF8 Utf8Data(*SerializedJson);
-	uint8 Digest[FSHA1::DigestSize];
-	FSHA1::HashBuffer(Utf8Data.Get(), Utf8Data.Length(), Digest);
-	return BytesToHex(Digest, UE_ARRAY_COUNT(Digest));
+	FXxHash128Builder Builder;
+	AppendCanonicalJsonHash(Builder, JsonObject);
+	return HashToHex(Builder.Finalize());
+}
+
+void MCPJson::AppendCanonicalJsonHash(FXxHash128Builder& Builder, const TSharedPtr<FJsonObject>& JsonObject)
+{
+	const uint8 Tag = JsonObject.IsValid() ? static_cast<uint8>(EJson::Object) : static_cast<uint8>(EJson::Null);
+	Builder.Update(&Tag, sizeof(Tag));
+	if (!JsonObject.IsValid())
+	{
+		return;
+	}
+
+	TArray<const TPair<FString, TSharedPtr<FJsonValue>>*, TInlineAllocator<16>> SortedFields;
+	SortedFields.Reserve(JsonObject->Values.Num());
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : JsonObject->Values)
+	{
+		SortedFields.Add(&Field);
+	}
+	SortedFields.Sort([](const TPair<FString, TSharedPtr<FJsonValue>>& Left, const TPair<FString, TSharedPtr<FJsonValue>>& Right)
+	{
+		return FCString::Strcmp(*Left.Key, *Right.Key) < 0;
+	});
+
+	const uint32 FieldCount = static_cast<uint32>(SortedFields.Num());
+	Builder.Update(&FieldCount, sizeof(FieldCount));
+	for (const TPair<FString, TSharedPtr<FJsonValue>>* Field : SortedFields)
+	{
+		AppendHashString(Builder, Field->Key);
+		AppendCanonicalJsonHash(Builder, Field->Value);
+	}
+}
+
+void MCPJson::AppendCanonicalJsonHash(FXxHash128Builder& Builder, const TSharedPtr<FJsonValue>& JsonValue)
+{
+	const EJson Type = JsonValue.IsValid() ? JsonValue->Type : EJson::Null;
+	switch (Type)
+	{
+	case EJson::Object:
+		AppendCanonicalJsonHash(Builder, JsonValue->AsObject());
+		return;
+	case EJson::Array:
+	{
+		const uint8 Tag = static_cast<uint8>(EJson::Array);
+		Builder.Update(&Tag, sizeof(Tag));
+		const TArray<TSharedPtr<FJsonValue>>& Elements = JsonValue->AsArray();
+		const uint32 ElementCount = static_cast<uint32>(Elements.Num());
+		Builder.Update(&ElementCount, sizeof(ElementCount));
+		for (const TSharedPtr<FJsonValue>& Element : Elements)
+		{
+			AppendCanonicalJsonHash(Builder, Element);
+		}
+		return;
+	}
+	case EJson::String:
+	{
+		const uint8 Tag = static_cast<uint8>(EJson::String);
+		Builder.Update(&Tag, sizeof(Tag));
+		AppendHashString(Builder, JsonValue->AsString());
+		return;
+	}
+	case EJson::Number:
+	{
+		const uint8 Tag = static_cast<uint8>(EJson::Number);
+		Builder.Update(&Tag, sizeof(Tag));
+		// -0 and 0 serialize identically, so they must hash identically too.
+		const double Number = JsonValue->AsNumber() + 0.0;
+		Builder.Update(&Number, sizeof(Number));
+		return;
+	}
+	case EJson::Boolean:
+	{
+		const uint8 Tag = static_cast<uint8>(EJson::Boolean);
+		const uint8 Value = JsonValue->AsBool() ? 1 : 0;
+		Builder.Update(&Tag, sizeof(Tag));
+		Builder.Update(&Value, sizeof(Value));
+		return;
+	}
+	default:
+	{
+		const uint8 Tag = static_cast<uint8>(EJson::Null);
+		Builder.Update(&Tag, sizeof(Tag));
+		return;
+	}
+	}
+}
+
+void MCPJson::AppendHashString(FXxHash128Builder& Builder, const FString& Value)
+{
+	const uint32 Length = static_cast<uint32>(Value.Len());
+	Builder.Update(&Length, sizeof(Length));
+	Builder.Update(*Value, Length * sizeof(TCHAR));
+}
+
+FString MCPJson::HashToHex(const FXxHash128& Hash)
+{
+	return FString::Printf(TEXT("%016llx%016llx"), Hash.HighBits, Hash.LowBits);
 }
 
 FString MCPJson::SerializeJsonObject(const TSharedPtr<FJsonObject>& JsonObject)
@@ -5,8 +5,13 @@
 #include "IWebSocketNetworkingModule.h"
 #include "IWebSocketServer.h"
 #include "MCPCommandRouterSubsystem.h"
+#include "MCPErrorCodes.h"
 #include "MCPEventStreamSubsystem.h"
 #include "MCPLog.h"
+#include "MCPObservabilitySubsystem.h"
+#include "MCPTime.h"
+#include "MCPToolRegistrySubsystem.h"
+#include "MCPTraceSubsystem.h"
 #include "MCPTypes.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
@@ -16,8 +21,10 @@
 #include "Misc/Paths.h"
 #include "Misc/App.h"
 #include "Misc/Guid.h"
+#include "Misc/ScopeExit.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "Containers/Set.h"
 #include "Policies/CondensedJsonPrintPolicy.h"
 #include "Serialization/JsonReader.h"
@@ -35,6 +42,35 @@ namespace
 		return SerializedJson;
 	}
 
+	TArray<FString> ReadStringArrayField(const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName)
+	{
+		TArray<FString> Values;
+		const TArray<TSharedPtr<FJsonValue>>* JsonValues = nullptr;
+		if (Object.IsValid() && Object->TryGetArrayField(FieldName, JsonValues) && JsonValues != nullptr)
+		{
+			for (const TSharedPtr<FJsonValue>& JsonValue : *JsonValues)
+			{
+				FString Value;
+				if (JsonValue.IsValid() && JsonValue->TryGetString(Value) && !Value.IsEmpty())
+				{
+					Values.Add(Value);
+				}
+			}
+		}
+		return Values;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ToJsonStringArray(const TArray<FString>& Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonValues;
+		JsonValues.Reserve(Values.Num());
+		for (const FString& Value : Values)
+		{
+			JsonValues.Add(MakeShared<FJsonValueString>(Value));
+		}
+		return JsonValues;
+	}
+
 	FString NormalizeConnectHost(const FString& BindAddress)
 	{
 		if (BindAddress.IsEmpty()
@@ -256,7 +292,7 @@ void UMCPWebSocketTransportSubsystem::Initialize(FSubsystemCollectionBase& Colle
 
 	LoadSettings();
 	InstanceId = FGuid::NewGuid().ToString(EGuidFormats::DigitsLower);
-	InstanceStartedAtMs = GetCurrentUnixTimestampMs();
+	InstanceStartedAtMs = MCPTime::GetUnixTimestampMs();
 	LastConnectionInfoWriteMs = 0;
 
 	if (GEditor != nullptr)
@@ -317,6 +353,18 @@ int32 UMCPWebSocketTransportSubsystem::GetClientCount() const
 	return Connections.Num();
 }
 
+int32 UMCPWebSocketTransportSubsystem::GetQueuedRequestCount() const
+{
+	FScopeLock ScopeLock(&RequestQueueGuard);
+	return QueuedRequestCount;
+}
+
+int64 UMCPWebSocketTransportSubsystem::GetCoalescedEventCount() const
+{
+	FScopeLock ScopeLock(&OutboundEventGuard);
+	return CoalescedEventCount;
+}
+
 void UMCPWebSocketTransportSubsystem::LoadSettings()
 {
 	const TCHAR* Section = TEXT("UnrealMCP.WebSocketTransport");
@@ -356,6 +404,30 @@ void UMCPWebSocketTransportSubsystem::LoadSettings()
 	{
 		InstanceRegistryStaleTtlMs = FMath::Clamp<int64>(ConfiguredRegistryStaleTtlMs, 1000, 600000);
 	}
+
+	int32 ConfiguredMaxInFlight = MaxInFlightRequestsPerConnection;
+	if (GConfig->GetInt(Section, TEXT("MaxInFlightRequestsPerConnection"), ConfiguredMaxInFlight, GEditorPerProjectIni))
+	{
+		MaxInFlightRequestsPerConnection = FMath::Clamp(ConfiguredMaxInFlight, 1, 1024);
+	}
+
+	float ConfiguredTimeSliceMs = static_cast<float>(DispatchTimeSliceMs);
+	if (GConfig->GetFloat(Section, TEXT("DispatchTimeSliceMs"), ConfiguredTimeSliceMs, GEditorPerProjectIni))
+	{
+		DispatchTimeSliceMs = FMath::Clamp<double>(ConfiguredTimeSliceMs, 0.5, 1000.0);
+	}
+
+	int32 ConfiguredMaxWritesPerTick = MaxWriteRequestsPerTick;
+	if (GConfig->GetInt(Section, TEXT("MaxWriteRequestsPerTick"), ConfiguredMaxWritesPerTick, GEditorPerProjectIni))
+	{
+		MaxWriteRequestsPerTick = FMath::Clamp(ConfiguredMaxWritesPerTick, 1, 64);
+	}
+
+	int32 ConfiguredEventFlushIntervalMs = EventFlushIntervalMs;
+	if (GConfig->GetInt(Section, TEXT("EventFlushIntervalMs"), ConfiguredEventFlushIntervalMs, GEditorPerProjectIni))
+	{
+		EventFlushIntervalMs = FMath::Clamp(ConfiguredEventFlushIntervalMs, 0, 5000);
+	}
 }
 
 void UMCPWebSocketTransportSubsystem::StartServer()
@@ -374,7 +446,7 @@ void UMCPWebSocketTransportSubsystem::StartServer()
 	IWebSocketNetworkingModule& WebSocketModule = FModuleManager::LoadModuleChecked<IWebSocketNetworkingModule>(TEXT("WebSocketNetworking"));
 
 	const uint32 StartPort = static_cast<uint32>(PreferredPort);
-	const int64 CurrentTimestampMs = GetCurrentUnixTimestampMs();
+	const int64 CurrentTimestampMs = MCPTime::GetUnixTimestampMs();
 	const int32 CurrentProcessId = FPlatformProcess::GetCurrentProcessId();
 	const FString IndexFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/instances/index.json"));
 	TSet<uint16> ReservedPorts;
@@ -438,7 +510,7 @@ void UMCPWebSocketTransportSubsystem::StartServer()
 	}
 	if (InstanceStartedAtMs <= 0)
 	{
-		InstanceStartedAtMs = GetCurrentUnixTimestampMs();
+		InstanceStartedAtMs = MCPTime::GetUnixTimestampMs();
 	}
 	LastConnectionInfoWriteMs = 0;
 	WriteConnectionInfoFile();
@@ -460,6 +532,8 @@ void UMCPWebSocketTransportSubsystem::StopServer()
 		FScopeLock ScopeLock(&ConnectionGuard);
 		Connections.GenerateValueArray(SocketsToDelete);
 		Connections.Reset();
+		ObjectResponseConnections.Reset();
+		EventSubscriptionsByConnection.Reset();
 	}
 
 	for (INetworkingWebSocket* Socket : SocketsToDelete)
@@ -467,6 +541,20 @@ void UMCPWebSocketTransportSubsystem::StopServer()
 		delete Socket;
 	}
 
+	{
+		FScopeLock ScopeLock(&RequestQueueGuard);
+		RequestQueuesByConnection.Reset();
+		ReadyReadHeap.Reset();
+		ReadyWriteHeap.Reset();
+		QueuedRequestCount = 0;
+	}
+
+	{
+		FScopeLock ScopeLock(&OutboundEventGuard);
+		PendingOutboundEvents.Reset();
+		PendingProgressIndexByRequestId.Reset();
+	}
+
 	CleanupConnectionInfoFiles();
 	Server.Reset();
 	bListening = false;
@@ -481,7 +569,12 @@ bool UMCPWebSocketTransportSubsystem::HandleTicker(float DeltaSeconds)
 	if (Server.IsValid())
 	{
 		Server->Tick();
-		const int64 CurrentTimestampMs = GetCurrentUnixTimestampMs();
+		DispatchQueuedRequests();
+		if ((FPlatformTime::Seconds() - LastEventFlushSeconds) * 1000.0 >= EventFlushIntervalMs)
+		{
+			FlushOutboundEvents();
+		}
+		const int64 CurrentTimestampMs = MCPTime::GetUnixTimestampMs();
 		if (LastConnectionInfoWriteMs <= 0
 			|| (CurrentTimestampMs - LastConnectionInfoWriteMs) >= ConnectionInfoHeartbeatIntervalMs)
 		{
@@ -495,12 +588,51 @@ bool UMCPWebSocketTransportSubsystem::HandleTicker(float DeltaSeconds)
 
 void UMCPWebSocketTransportSubsystem::HandleStreamEvent(const FMCPStreamEvent& Event)
 {
-	if (!bListening)
+	if (!bListening || GetClientCount() == 0)
 	{
 		return;
 	}
 
-	BroadcastToClients(SerializeJsonObject(Event.ToJson()));
+	FScopeLock ScopeLock(&OutboundEventGuard);
+	if (Event.EventType.Equals(TEXT("event.progress")))
+	{
+		int32& PendingIndex = PendingProgressIndexByRequestId.FindOrAdd(Event.RequestId, INDEX_NONE);
+		if (PendingOutboundEvents.IsValidIndex(PendingIndex))
+		{
+			PendingOutboundEvents[PendingIndex].EventType.Reset();
+			++CoalescedEventCount;
+		}
+		PendingIndex = PendingOutboundEvents.Add(Event);
+		return;
+	}
+
+	PendingOutboundEvents.Add(Event);
+}
+
+void UMCPWebSocketTransportSubsystem::FlushOutboundEvents()
+{
+	LastEventFlushSeconds = FPlatformTime::Seconds();
+
+	TArray<FMCPStreamEvent> EventsToSend;
+	{
+		FScopeLock ScopeLock(&OutboundEventGuard);
+		if (PendingOutboundEvents.Num() == 0)
+		{
+			return;
+		}
+
+		EventsToSend = MoveTemp(PendingOutboundEvents);
+		PendingOutboundEvents.Reset();
+		PendingProgressIndexByRequestId.Reset();
+	}
+
+	for (const FMCPStreamEvent& Event : EventsToSend)
+	{
+		if (!Event.EventType.IsEmpty())
+		{
+			BroadcastEvent(Event);
+		}
+	}
 }
 
 void UMCPWebSocketTransportSubsystem::OnClientConnected(INetworkingWebSocket* Socket)
@@ -553,49 +685,235 @@ void UMCPWebSocketTransportSubsystem::OnClientPacketReceived(void* Data, int32 S
 	{
 		TSharedRef<FJsonObject> PongObject = MakeShared<FJsonObject>();
 		PongObject->SetStringField(TEXT("type"), TEXT("pong"));
-		PongObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(GetCurrentUnixTimestampMs()));
+		PongObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(MCPTime::GetUnixTimestampMs()));
 		SendToConnection(ConnectionId, SerializeJsonObject(PongObject));
 		return;
 	}
 
+	if (MessageType.Equals(TEXT("mcp.transport.configure"), ESearchCase::IgnoreCase))
+	{
+		HandleConfigureMessage(ConnectionId, RequestObject);
+		return;
+	}
+
+	if (MessageType.Equals(TEXT("subscribe"), ESearchCase::IgnoreCase))
+	{
+		HandleSubscribeMessage(ConnectionId, RequestObject);
+		return;
+	}
+
 	if (!MessageType.Equals(TEXT("mcp.request"), ESearchCase::IgnoreCase))
 	{
 		SendToConnection(ConnectionId, BuildErrorPayload(TEXT("MCP.TOOL.NOT_FOUND"), TEXT("Unsupported websocket message type.")));
 		return;
 	}
 
-	UMCPCommandRouterSubsystem* Router = GEditor ? GEditor->GetEditorSubsystem<UMCPCommandRouterSubsystem>() : nullptr;
-	if (Router == nullptr)
+	EnqueueRequest(ConnectionId, RequestObject);
+}
+
+void UMCPWebSocketTransportSubsystem::EnqueueRequest(const uint16 ConnectionId, const TSharedPtr<FJsonObject>& RequestObject)
+{
+	FQueuedRequest QueuedRequest;
+	QueuedRequest.ConnectionId = ConnectionId;
+
+	const TSharedPtr<FJsonObject>* RequestEnvelopePtr = nullptr;
+	if (RequestObject->TryGetObjectField(TEXT("request"), RequestEnvelopePtr) && RequestEnvelopePtr != nullptr && RequestEnvelopePtr->IsValid())
+	{
+		QueuedRequest.RequestEnvelope = *RequestEnvelopePtr;
+	}
+	else if (RequestObject->TryGetStringField(TEXT("request_json"), QueuedRequest.RequestJson) && !QueuedRequest.RequestJson.IsEmpty())
+	{
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(QueuedRequest.RequestJson);
+		if (FJsonSerializer::Deserialize(Reader, QueuedRequest.RequestEnvelope) && QueuedRequest.RequestEnvelope.IsValid())
+		{
+			QueuedRequest.RequestJson.Reset();
+		}
+	}
+
+	if (!QueuedRequest.RequestEnvelope.IsValid() && QueuedRequest.RequestJson.IsEmpty())
 	{
-		SendToConnection(ConnectionId, BuildErrorPayload(TEXT("MCP.INTERNAL.EXCEPTION"), TEXT("Command router subsystem is unavailable.")));
+		SendToConnection(ConnectionId, BuildErrorPayload(TEXT("MCP.SCHEMA.INVALID_PARAMS"), TEXT("mcp.request requires request_json or request object.")));
 		return;
 	}
 
-	FString RequestJson;
-	RequestObject->TryGetStringField(TEXT("request_json"), RequestJson);
-	if (RequestJson.IsEmpty())
+	if (QueuedRequest.RequestEnvelope.IsValid())
+	{
+		QueuedRequest.RequestEnvelope->TryGetStringField(TEXT("request_id"), QueuedRequest.RequestId);
+		QueuedRequest.RequestEnvelope->TryGetStringField(TEXT("tool"), QueuedRequest.Tool);
+	}
+
+	if (const UMCPToolRegistrySubsystem* ToolRegistry = GEditor ? GEditor->GetEditorSubsystem<UMCPToolRegistrySubsystem>() : nullptr)
+	{
+		QueuedRequest.bWriteTool = ToolRegistry->IsWriteTool(QueuedRequest.Tool);
+	}
+
 	{
-		const TSharedPtr<FJsonObject>* RequestEnvelope = nullptr;
-		if (RequestObject->TryGetObjectField(TEXT("request"), RequestEnvelope) && RequestEnvelope != nullptr && RequestEnvelope->IsValid())
+		FScopeLock ScopeLock(&RequestQueueGuard);
+		FConnectionRequestQueue& Queue = RequestQueuesByConnection.FindOrAdd(ConnectionId);
+		if (Queue.InFlightCount < MaxInFlightRequestsPerConnection)
 		{
-			RequestJson = MCPJson::SerializeJsonObject(*RequestEnvelope);
+			++Queue.InFlightCount;
+			++QueuedRequestCount;
+			QueuedRequest.Sequence = ++NextRequestSequence;
+			const bool bBecameHead = Queue.IsEmpty();
+			Queue.Requests.Add(MoveTemp(QueuedRequest));
+			if (bBecameHead)
+			{
+				PushReadyHeadLocked(ConnectionId, Queue);
+			}
+			return;
 		}
 	}
 
-	if (RequestJson.IsEmpty())
+	FMCPDiagnostic Diagnostic;
+	Diagnostic.Code = MCPErrorCodes::TRANSPORT_BUSY;
+	Diagnostic.Message = TEXT("Too many in-flight requests on this connection.");
+	Diagnostic.Detail = FString::Printf(TEXT("connection_id=%d max_in_flight=%d"), ConnectionId, MaxInFlightRequestsPerConnection);
+	Diagnostic.Suggestion = TEXT("Wait for pending responses before sending more requests.");
+	Diagnostic.bRetriable = true;
+	SendToConnection(ConnectionId, BuildRequestErrorResponsePayload(ConnectionId, QueuedRequest.RequestId, Diagnostic));
+}
+
+void UMCPWebSocketTransportSubsystem::DispatchQueuedRequests()
+{
+	const double SliceBeginSeconds = FPlatformTime::Seconds();
+	const double SliceBudgetSeconds = DispatchTimeSliceMs / 1000.0;
+	int32 DispatchedWriteCount = 0;
+
+	FQueuedRequest QueuedRequest;
+	while (DequeueNextRequest(DispatchedWriteCount < MaxWriteRequestsPerTick, QueuedRequest))
 	{
-		SendToConnection(ConnectionId, BuildErrorPayload(TEXT("MCP.SCHEMA.INVALID_PARAMS"), TEXT("mcp.request requires request_json or request object.")));
+		if (QueuedRequest.bWriteTool)
+		{
+			++DispatchedWriteCount;
+		}
+
+		ExecuteQueuedRequest(QueuedRequest);
+
+		if ((FPlatformTime::Seconds() - SliceBeginSeconds) >= SliceBudgetSeconds)
+		{
+			break;
+		}
+	}
+}
+
+UMCPWebSocketTransportSubsystem::FQueuedRequest UMCPWebSocketTransportSubsystem::FConnectionRequestQueue::PopHead()
+{
+	FQueuedRequest Request = MoveTemp(Requests[HeadIndex++]);
+	if (IsEmpty())
+	{
+		Requests.Reset();
+		HeadIndex = 0;
+	}
+	else if (HeadIndex >= 32 && HeadIndex * 2 >= Requests.Num())
+	{
+		// A connection that never drains would otherwise grow its array forever.
+		Requests.RemoveAt(0, HeadIndex, EAllowShrinking::No);
+		HeadIndex = 0;
+	}
+	return Request;
+}
+
+bool UMCPWebSocketTransportSubsystem::DequeueNextRequest(const bool bAllowWriteRequest, FQueuedRequest& OutRequest)
+{
+	FScopeLock ScopeLock(&RequestQueueGuard);
+
+	// A read at the head of its connection has no earlier write to wait for, so the oldest one goes
+	// first. Otherwise the oldest head write is also the oldest write overall, since any read queued
+	// ahead of it on its connection would have been picked.
+	if (PopReadyRequestLocked(ReadyReadHeap, OutRequest))
+	{
+		return true;
+	}
+	return bAllowWriteRequest && PopReadyRequestLocked(ReadyWriteHeap, OutRequest);
+}
+
+bool UMCPWebSocketTransportSubsystem::PopReadyRequestLocked(TArray<FReadyRequest>& ReadyHeap, FQueuedRequest& OutRequest)
+{
+	while (ReadyHeap.Num() > 0)
+	{
+		FReadyRequest Ready;
+		ReadyHeap.HeapPop(Ready, EAllowShrinking::No);
+
+		FConnectionRequestQueue* Queue = RequestQueuesByConnection.Find(Ready.ConnectionId);
+		if (Queue == nullptr || Queue->IsEmpty() || Queue->Head().Sequence != Ready.Sequence)
+		{
+			continue;
+		}
+
+		OutRequest = Queue->PopHead();
+		--QueuedRequestCount;
+		if (!Queue->IsEmpty())
+		{
+			PushReadyHeadLocked(Ready.ConnectionId, *Queue);
+		}
+		return true;
+	}
+	return false;
+}
+
+void UMCPWebSocketTransportSubsystem::PushReadyHeadLocked(const uint16 ConnectionId, const FConnectionRequestQueue& Queue)
+{
+	const FQueuedRequest& Head = Queue.Head();
+	FReadyRequest Ready;
+	Ready.Sequence = Head.Sequence;
+	Ready.ConnectionId = ConnectionId;
+	(Head.bWriteTool ? ReadyWriteHeap : ReadyReadHeap).HeapPush(Ready);
+}
+
+void UMCPWebSocketTransportSubsystem::ExecuteQueuedRequest(const FQueuedRequest& QueuedRequest)
+{
+	ON_SCOPE_EXIT
+	{
+		FScopeLock ScopeLock(&RequestQueueGuard);
+		if (FConnectionRequestQueue* Queue = RequestQueuesByConnection.Find(QueuedRequest.ConnectionId))
+		{
+			Queue->InFlightCount = FMath::Max(0, Queue->InFlightCount - 1);
+			if (Queue->InFlightCount == 0 && Queue->IsEmpty())
+			{
+				RequestQueuesByConnection.Remove(QueuedRequest.ConnectionId);
+			}
+		}
+	};
+
+	UMCPCommandRouterSubsystem* Router = GEditor ? GEditor->GetEditorSubsystem<UMCPCommandRouterSubsystem>() : nullptr;
+	if (Router == nullptr)
+	{
+		SendToConnection(QueuedRequest.ConnectionId, BuildErrorPayload(TEXT("MCP.INTERNAL.EXCEPTION"), TEXT("Command router subsystem is unavailable.")));
 		return;
 	}
 
 	bool bSuccess = false;
-	const FString ResponseJson = Router->ExecuteRequestJson(RequestJson, bSuccess);
+	const FString ResponseJson = QueuedRequest.RequestEnvelope.IsValid()
+		? Router->ExecuteRequestObject(QueuedRequest.RequestEnvelope, bSuccess)
+		: Router->ExecuteRequestJson(QueuedRequest.RequestJson, bSuccess);
+	FlushOutboundEvents();
+	const uint64 SendBeginCycles = MCPTime::NowCycles();
+	{
+		const FMCPTraceScope SendTraceScope(TEXT("mcp.phase"), TEXT("ws_send"), QueuedRequest.RequestId, QueuedRequest.Tool);
+		SendToConnection(QueuedRequest.ConnectionId, BuildResponsePayload(QueuedRequest.ConnectionId, bSuccess, ResponseJson));
+	}
+	if (UMCPObservabilitySubsystem* Observability = GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>())
+	{
+		Observability->RecordPhaseLatency(EMCPLatencyPhase::WsSend, MCPTime::MicrosecondsSince(SendBeginCycles));
+	}
+}
 
-	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
-	ResponseObject->SetStringField(TEXT("type"), TEXT("mcp.response"));
-	ResponseObject->SetBoolField(TEXT("ok"), bSuccess);
-	ResponseObject->SetStringField(TEXT("response_json"), ResponseJson);
-	SendToConnection(ConnectionId, SerializeJsonObject(ResponseObject));
+void UMCPWebSocketTransportSubsystem::DropQueuedRequestsForConnection(const uint16 ConnectionId)
+{
+	FScopeLock ScopeLock(&RequestQueueGuard);
+	int32 DroppedCount = 0;
+	FConnectionRequestQueue Queue;
+	if (RequestQueuesByConnection.RemoveAndCopyValue(ConnectionId, Queue))
+	{
+		// Its ready heap entries no longer match a queue head and are skipped when popped.
+		DroppedCount = Queue.Requests.Num() - Queue.HeadIndex;
+		QueuedRequestCount -= DroppedCount;
+	}
+	if (DroppedCount > 0)
+	{
+		UE_LOG(LogUnrealMCP, Log, TEXT("Dropped %d queued MCP requests for closed connection. id=%d"), DroppedCount, ConnectionId);
+	}
 }
 
 void UMCPWebSocketTransportSubsystem::OnClientClosed(uint16 ConnectionId)
@@ -607,6 +925,8 @@ void UMCPWebSocketTransportSubsystem::OnClientClosed(uint16 ConnectionId)
 		{
 			SocketToDelete = *FoundSocket;
 			Connections.Remove(ConnectionId);
+			ObjectResponseConnections.Remove(ConnectionId);
+			EventSubscriptionsByConnection.Remove(ConnectionId);
 		}
 	}
 
@@ -615,9 +935,147 @@ void UMCPWebSocketTransportSubsystem::OnClientClosed(uint16 ConnectionId)
 		delete SocketToDelete;
 	}
 
+	DropQueuedRequestsForConnection(ConnectionId);
 	UE_LOG(LogUnrealMCP, Log, TEXT("MCP WS client disconnected. id=%d"), ConnectionId);
 }
 
+void UMCPWebSocketTransportSubsystem::HandleConfigureMessage(const uint16 ConnectionId, const TSharedPtr<FJsonObject>& MessageObject)
+{
+	FString ResponseEncoding = TEXT("json_string");
+	MessageObject->TryGetStringField(TEXT("response_encoding"), ResponseEncoding);
+
+	const bool bObjectEncoding = ResponseEncoding.Equals(TEXT("object"), ESearchCase::IgnoreCase);
+	if (!bObjectEncoding && !ResponseEncoding.Equals(TEXT("json_string"), ESearchCase::IgnoreCase))
+	{
+		SendToConnection(ConnectionId, BuildErrorPayload(TEXT("MCP.SCHEMA.INVALID_PARAMS"), FString::Printf(TEXT("Unsupported response_encoding: %s"), *ResponseEncoding)));
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&ConnectionGuard);
+		if (bObjectEncoding)
+		{
+			ObjectResponseConnections.Add(ConnectionId);
+		}
+		else
+		{
+			ObjectResponseConnections.Remove(ConnectionId);
+		}
+	}
+
+	TSharedRef<FJsonObject> ConfiguredObject = MakeShared<FJsonObject>();
+	ConfiguredObject->SetStringField(TEXT("type"), TEXT("mcp.transport.configured"));
+	ConfiguredObject->SetStringField(TEXT("response_encoding"), bObjectEncoding ? TEXT("object") : TEXT("json_string"));
+	SendToConnection(ConnectionId, SerializeJsonObject(ConfiguredObject));
+}
+
+void UMCPWebSocketTransportSubsystem::HandleSubscribeMessage(const uint16 ConnectionId, const TSharedPtr<FJsonObject>& MessageObject)
+{
+	const TArray<FString> EventTypes = ReadStringArrayField(MessageObject, TEXT("event_types"));
+	const TArray<FString> RequestIdPrefixes = ReadStringArrayField(MessageObject, TEXT("request_id_prefixes"));
+	TArray<FString> SessionIds = ReadStringArrayField(MessageObject, TEXT("session_ids"));
+	FString SessionId;
+	if (MessageObject->TryGetStringField(TEXT("session_id"), SessionId) && !SessionId.IsEmpty())
+	{
+		SessionIds.AddUnique(SessionId);
+	}
+
+	FEventSubscription Subscription;
+	Subscription.EventTypes.Append(EventTypes);
+	Subscription.RequestIdPrefixes = RequestIdPrefixes;
+	Subscription.SessionIds.Append(SessionIds);
+
+	TArray<TSharedPtr<FJsonObject>> ReplayEvents;
+	bool bReplayGap = false;
+	int64 LatestSequence = 0;
+	double AfterSequence = 0.0;
+	const bool bReplayRequested = MessageObject->TryGetNumberField(TEXT("after_sequence"), AfterSequence);
+	if (UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr)
+	{
+		LatestSequence = EventStreamSubsystem->GetLatestSequence();
+		if (bReplayRequested)
+		{
+			// 아직 flush되지 않은 이벤트도 ring에는 이미 있으므로 replay로 먼저 보내고,
+			// 이후 live 전송에서는 ReplayedThroughSequence 이하를 건너뛰어 순서와 중복을 맞춘다.
+			ReplayEvents = EventStreamSubsystem->GetEventsAfter(static_cast<int64>(AfterSequence), MAX_int32, bReplayGap);
+		}
+	}
+
+	TArray<FString> ReplayMessages;
+	ReplayMessages.Reserve(ReplayEvents.Num());
+	for (const TSharedPtr<FJsonObject>& EventObject : ReplayEvents)
+	{
+		if (!EventObject.IsValid())
+		{
+			continue;
+		}
+
+		double EventSequence = 0.0;
+		if (EventObject->TryGetNumberField(TEXT("sequence"), EventSequence))
+		{
+			Subscription.ReplayedThroughSequence = FMath::Max(Subscription.ReplayedThroughSequence, static_cast<int64>(EventSequence));
+		}
+
+		FString EventType;
+		FString RequestId;
+		FString EventSessionId;
+		EventObject->TryGetStringField(TEXT("event_type"), EventType);
+		EventObject->TryGetStringField(TEXT("request_id"), RequestId);
+		EventObject->TryGetStringField(TEXT("session_id"), EventSessionId);
+		if (Subscription.Matches(EventType, RequestId, EventSessionId))
+		{
+			ReplayMessages.Add(SerializeJsonObject(EventObject.ToSharedRef()));
+		}
+	}
+
+	{
+		FScopeLock ScopeLock(&ConnectionGuard);
+		EventSubscriptionsByConnection.Add(ConnectionId, MoveTemp(Subscription));
+	}
+
+	TSharedRef<FJsonObject> SubscribedObject = MakeShared<FJsonObject>();
+	SubscribedObject->SetStringField(TEXT("type"), TEXT("mcp.transport.subscribed"));
+	SubscribedObject->SetArrayField(TEXT("event_types"), ToJsonStringArray(EventTypes));
+	SubscribedObject->SetArrayField(TEXT("request_id_prefixes"), ToJsonStringArray(RequestIdPrefixes));
+	SubscribedObject->SetArrayField(TEXT("session_ids"), ToJsonStringArray(SessionIds));
+	SubscribedObject->SetNumberField(TEXT("latest_sequence"), static_cast<double>(LatestSequence));
+	SubscribedObject->SetNumberField(TEXT("replayed_count"), static_cast<double>(ReplayMessages.Num()));
+	SubscribedObject->SetBoolField(TEXT("replay_gap"), bReplayGap);
+	SendToConnection(ConnectionId, SerializeJsonObject(SubscribedObject));
+
+	for (const FString& ReplayMessage : ReplayMessages)
+	{
+		SendToConnection(ConnectionId, ReplayMessage);
+	}
+}
+
+bool UMCPWebSocketTransportSubsystem::FEventSubscription::Matches(const FString& EventType, const FString& RequestId, const FString& SessionId) const
+{
+	if (EventTypes.Num() > 0 && !EventTypes.Contains(EventType))
+	{
+		return false;
+	}
+
+	if (SessionIds.Num() > 0 && !SessionIds.Contains(SessionId))
+	{
+		return false;
+	}
+
+	if (RequestIdPrefixes.Num() > 0)
+	{
+		for (const FString& RequestIdPrefix : RequestIdPrefixes)
+		{
+			if (RequestId.StartsWith(RequestIdPrefix, ESearchCase::CaseSensitive))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	return true;
+}
+
 bool UMCPWebSocketTransportSubsystem::SendToConnection(uint16 ConnectionId, const FString& MessageJson)
 {
 	INetworkingWebSocket* Socket = nullptr;
@@ -638,14 +1096,33 @@ bool UMCPWebSocketTransportSubsystem::SendToConnection(uint16 ConnectionId, cons
 	return Socket->Send(reinterpret_cast<const uint8*>(Utf8Message.Get()), static_cast<uint32>(Utf8Message.Length()), false);
 }
 
-void UMCPWebSocketTransportSubsystem::BroadcastToClients(const FString& MessageJson)
+void UMCPWebSocketTransportSubsystem::BroadcastEvent(const FMCPStreamEvent& Event)
 {
 	TArray<uint16> ConnectionIds;
 	{
 		FScopeLock ScopeLock(&ConnectionGuard);
-		Connections.GetKeys(ConnectionIds);
+		ConnectionIds.Reserve(Connections.Num());
+		for (const TPair<uint16, INetworkingWebSocket*>& ConnectionPair : Connections)
+		{
+			const FEventSubscription* Subscription = EventSubscriptionsByConnection.Find(ConnectionPair.Key);
+			if (Subscription != nullptr && Event.Sequence > 0 && Event.Sequence <= Subscription->ReplayedThroughSequence)
+			{
+				continue;
+			}
+
+			if (Subscription == nullptr || Subscription->Matches(Event.EventType, Event.RequestId, Event.SessionId))
+			{
+				ConnectionIds.Add(ConnectionPair.Key);
+			}
+		}
+	}
+
+	if (ConnectionIds.Num() == 0)
+	{
+		return;
 	}
 
+	const FString MessageJson = SerializeJsonObject(Event.ToJson());
 	TArray<uint16> FailedConnectionIds;
 	for (const uint16 ConnectionId : ConnectionIds)
 	{
@@ -668,7 +1145,7 @@ void UMCPWebSocketTransportSubsystem::WriteConnectionInfoFile()
 		return;
 	}
 
-	const int64 CurrentTimestampMs = GetCurrentUnixTimestampMs();
+	const int64 CurrentTimestampMs = MCPTime::GetUnixTimestampMs();
 	const FString ConnectionDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP"));
 	if (!IFileManager::Get().MakeDirectory(*ConnectionDir, true))
 	{
@@ -844,7 +1321,7 @@ void UMCPWebSocketTransportSubsystem::CleanupConnectionInfoFiles()
 	const TArray<TSharedPtr<FJsonValue>>* ExistingInstances = nullptr;
 	if (ExistingIndexRoot->TryGetArrayField(TEXT("instances"), ExistingInstances) && ExistingInstances != nullptr)
 	{
-		const int64 CurrentTimestampMs = GetCurrentUnixTimestampMs();
+		const int64 CurrentTimestampMs = MCPTime::GetUnixTimestampMs();
 		for (const TSharedPtr<FJsonValue>& ExistingValue : *ExistingInstances)
 		{
 			if (!ExistingValue.IsValid() || ExistingValue->Type != EJson::Object)
@@ -876,7 +1353,7 @@ void UMCPWebSocketTransportSubsystem::CleanupConnectionInfoFiles()
 		}
 	}
 
-	ExistingIndexRoot->SetNumberField(TEXT("updated_at_ms"), static_cast<double>(GetCurrentUnixTimestampMs()));
+	ExistingIndexRoot->SetNumberField(TEXT("updated_at_ms"), static_cast<double>(MCPTime::GetUnixTimestampMs()));
 	ExistingIndexRoot->SetArrayField(TEXT("instances"), FilteredInstances);
 	FFileHelper::SaveStringToFile(SerializeJsonObject(ExistingIndexRoot.ToSharedRef()), *IndexFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
 }
@@ -896,7 +1373,13 @@ FString UMCPWebSocketTransportSubsystem::BuildWelcomePayload(const uint16 Connec
 	WelcomeObject->SetStringField(TEXT("instance_id"), InstanceId);
 	WelcomeObject->SetStringField(TEXT("project_dir"), FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
 	WelcomeObject->SetNumberField(TEXT("process_id"), static_cast<double>(FPlatformProcess::GetCurrentProcessId()));
-	WelcomeObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(GetCurrentUnixTimestampMs()));
+	TArray<TSharedPtr<FJsonValue>> ResponseEncodingValues;
+	ResponseEncodingValues.Add(MakeShared<FJsonValueString>(TEXT("json_string")));
+	ResponseEncodingValues.Add(MakeShared<FJsonValueString>(TEXT("object")));
+	WelcomeObject->SetArrayField(TEXT("response_encodings"), ResponseEncodingValues);
+	const UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr;
+	WelcomeObject->SetNumberField(TEXT("latest_event_sequence"), EventStreamSubsystem != nullptr ? static_cast<double>(EventStreamSubsystem->GetLatestSequence()) : 0.0);
+	WelcomeObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(MCPTime::GetUnixTimestampMs()));
 	return SerializeJsonObject(WelcomeObject);
 }
 
@@ -906,11 +1389,38 @@ FString UMCPWebSocketTransportSubsystem::BuildErrorPayload(const FString& Code,
 	ErrorObject->SetStringField(TEXT("type"), TEXT("mcp.transport.error"));
 	ErrorObject->SetStringField(TEXT("code"), Code);
 	ErrorObject->SetStringField(TEXT("message"), Message);
-	ErrorObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(GetCurrentUnixTimestampMs()));
+	ErrorObject->SetNumberField(TEXT("timestamp_ms"), static_cast<double>(MCPTime::GetUnixTimestampMs()));
 	return SerializeJsonObject(ErrorObject);
 }
 
-int64 UMCPWebSocketTransportSubsystem::GetCurrentUnixTimestampMs()
+FString UMCPWebSocketTransportSubsystem::BuildResponsePayload(const uint16 ConnectionId, const bool bOk, const FString& ResponseJson) const
 {
-	return FDateTime::UtcNow().ToUnixTimestamp() * 1000LL;
+	bool bObjectEncoding = false;
+	{
+		FScopeLock ScopeLock(&ConnectionGuard);
+		bObjectEncoding = ObjectResponseConnections.Contains(ConnectionId);
+	}
+
+	if (bObjectEncoding)
+	{
+		return FString::Printf(TEXT("{\"type\":\"mcp.response\",\"ok\":%s,\"response\":%s}"), bOk ? TEXT("true") : TEXT("false"), *ResponseJson);
+	}
+
+	TSharedRef<FJsonObject> ResponseObject = MakeShared<FJsonObject>();
+	ResponseObject->SetStringField(TEXT("type"), TEXT("mcp.response"));
+	ResponseObject->SetBoolField(TEXT("ok"), bOk);
+	ResponseObject->SetStringField(TEXT("response_json"), ResponseJson);
+	return SerializeJsonObject(ResponseObject);
+}
+
+FString UMCPWebSocketTransportSubsystem::BuildRequestErrorResponsePayload(const uint16 ConnectionId, const FString& RequestId, const FMCPDiagnostic& Diagnostic) const
+{
+	FMCPRequestEnvelope Request;
+	Request.RequestId = RequestId.IsEmpty() ? TEXT("invalid-request") : RequestId;
+
+	FMCPToolExecutionResult ErrorResult;
+	ErrorResult.Status = EMCPResponseStatus::Error;
+	ErrorResult.Diagnostics.Add(Diagnostic);
+
+	return BuildResponsePayload(ConnectionId, false, MCPJson::BuildResponseEnvelope(Request, ErrorResult, TEXT(""), 0));
 }
@@ -1,8 +1,23 @@
 #if WITH_DEV_AUTOMATION_TESTS
 
+#include "MCPAssetIndexSubsystem.h"
+#include "MCPBlueprintCompileSubsystem.h"
+#include "MCPChangeSetJournal.h"
+#include "MCPChangeSetSubsystem.h"
 #include "MCPCommandRouterSubsystem.h"
+#include "MCPEventStreamSubsystem.h"
+#include "MCPJobSubsystem.h"
 #include "MCPObjectUtils.h"
-
+#include "MCPObservabilitySubsystem.h"
+#include "MCPSnapshotStoreSubsystem.h"
+#include "MCPToolRegistrySubsystem.h"
+#include "MCPToolResultCache.h"
+#include "MCPTraceSubsystem.h"
+#include "MCPWebSocketTransportSubsystem.h"
+#include "Tools/Common/MCPToolPaging.h"
+#include "Tools/Common/MCPToolSchemaValidator.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "Blueprint/UserWidget.h"
 #include "WidgetBlueprint.h"
 #include "Blueprint/WidgetTree.h"
@@ -13,10 +28,15 @@
 #include "GameFramework/Actor.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Materials/MaterialInstanceConstant.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Guid.h"
+#include "Misc/SecureHash.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Tests/AutomationCommon.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "UObject/Package.h"
 
@@ -80,6 +100,62 @@ namespace
 		return false;
 	}
 
+	TSharedPtr<FJsonValue> BuildSampleValueForSchema(const TSharedPtr<FJsonObject>& SchemaObject, const int32 Depth = 0)
+	{
+		if (!SchemaObject.IsValid() || Depth > 6)
+		{
+			return MakeShared<FJsonValueNull>();
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* EnumValues = nullptr;
+		if (SchemaObject->TryGetArrayField(TEXT("enum"), EnumValues) && EnumValues != nullptr && EnumValues->Num() > 0)
+		{
+			return (*EnumValues)[0];
+		}
+
+		FString TypeName;
+		SchemaObject->TryGetStringField(TEXT("type"), TypeName);
+		if (TypeName.Equals(TEXT("object"), ESearchCase::IgnoreCase))
+		{
+			TSharedPtr<FJsonObject> SampleObject = MakeShared<FJsonObject>();
+			const TSharedPtr<FJsonObject>* PropertiesObject = nullptr;
+			if (SchemaObject->TryGetObjectField(TEXT("properties"), PropertiesObject) && PropertiesObject != nullptr && PropertiesObject->IsValid())
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*PropertiesObject)->Values)
+				{
+					const TSharedPtr<FJsonObject> PropertySchema = Entry.Value.IsValid() && Entry.Value->Type == EJson::Object ? Entry.Value->AsObject() : nullptr;
+					SampleObject->SetField(Entry.Key, BuildSampleValueForSchema(PropertySchema, Depth + 1));
+				}
+			}
+			return MakeShared<FJsonValueObject>(SampleObject);
+		}
+		if (TypeName.Equals(TEXT("array"), ESearchCase::IgnoreCase))
+		{
+			TArray<TSharedPtr<FJsonValue>> SampleItems;
+			const TSharedPtr<FJsonObject>* ItemSchemaObject = nullptr;
+			if (SchemaObject->TryGetObjectField(TEXT("items"), ItemSchemaObject) && ItemSchemaObject != nullptr)
+			{
+				SampleItems.Add(BuildSampleValueForSchema(*ItemSchemaObject, Depth + 1));
+			}
+			return MakeShared<FJsonValueArray>(SampleItems);
+		}
+		if (TypeName.Equals(TEXT("string"), ESearchCase::IgnoreCase))
+		{
+			return MakeShared<FJsonValueString>(TEXT("/Game/MCPRuntimeTests/Sample"));
+		}
+		if (TypeName.Equals(TEXT("number"), ESearchCase::IgnoreCase) || TypeName.Equals(TEXT("integer"), ESearchCase::IgnoreCase))
+		{
+			double Minimum = 1.0;
+			SchemaObject->TryGetNumberField(TEXT("minimum"), Minimum);
+			return MakeShared<FJsonValueNumber>(Minimum);
+		}
+		if (TypeName.Equals(TEXT("boolean"), ESearchCase::IgnoreCase))
+		{
+			return MakeShared<FJsonValueBoolean>(true);
+		}
+		return MakeShared<FJsonValueNull>();
+	}
+
 	UMaterialInstanceConstant* GetOrCreateRuntimeMaterialInstance()
 	{
 		const FString PackageName = TEXT("/Game/MCPRuntimeTests/MI_MCPRuntimeTest");
@@ -318,6 +394,1776 @@ bool FMCPToolsListAutomationTest::RunTest(const FString& Parameters)
 	return true;
 }
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPExecuteRequestObjectAutomationTest,
+	"UnrealMCP.Runtime.ExecuteRequestObject",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPExecuteRequestObjectAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPCommandRouterSubsystem* Router = GEditor ? GEditor->GetEditorSubsystem<UMCPCommandRouterSubsystem>() : nullptr;
+	TestNotNull(TEXT("Command router subsystem"), Router);
+	if (Router == nullptr)
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> RequestObject;
+	TestTrue(TEXT("Parse request envelope"), ParseJsonObject(MakeRequestEnvelope(TEXT("tools.list"), TEXT("{\"include_schemas\":false}")), RequestObject));
+
+	bool bSuccess = false;
+	const FString ResponseJson = Router->ExecuteRequestObject(RequestObject, bSuccess);
+	TestTrue(TEXT("tools.list via request object should be success"), bSuccess);
+
+	TSharedPtr<FJsonObject> ResponseObject;
+	TestTrue(TEXT("Parse tools.list response"), ParseJsonObject(ResponseJson, ResponseObject));
+	FString Status;
+	TestTrue(TEXT("tools.list response has status"), ResponseObject->TryGetStringField(TEXT("status"), Status));
+	TestEqual(TEXT("tools.list response status"), Status, FString(TEXT("ok")));
+
+	bool bInvalidSuccess = true;
+	const FString InvalidResponseJson = Router->ExecuteRequestObject(MakeShared<FJsonObject>(), bInvalidSuccess);
+	TestFalse(TEXT("Envelope without request_id should fail"), bInvalidSuccess);
+	TestTrue(TEXT("Invalid envelope response mentions request_id"), InvalidResponseJson.Contains(TEXT("request_id")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPIdempotencyReplayAutomationTest,
+	"UnrealMCP.Runtime.IdempotencyReplay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPIdempotencyReplayAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	const FString IdempotencyKey = FString::Printf(TEXT("auto-replay-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	const auto MakeKeyedRequest = [&IdempotencyKey](const TCHAR* ParamsJson)
+	{
+		return FString::Printf(
+			TEXT("{\"protocol\":\"unreal-mcp/1.0\",\"request_id\":\"auto-replay-%s\",\"session_id\":\"auto-session\",\"tool\":\"tools.list\",\"params\":%s,\"context\":{\"idempotency_key\":\"%s\"}}"),
+			*FGuid::NewGuid().ToString(EGuidFormats::Digits),
+			ParamsJson,
+			*IdempotencyKey);
+	};
+
+	FString FirstResponseJson;
+	bool bFirstSuccess = false;
+	TestTrue(TEXT("Execute first keyed request"), ExecuteMCPRequest(MakeKeyedRequest(TEXT("{\"include_schemas\":false}")), FirstResponseJson, bFirstSuccess));
+	TestTrue(TEXT("First keyed request should be success"), bFirstSuccess);
+
+	FString ReplayResponseJson;
+	bool bReplaySuccess = false;
+	TestTrue(TEXT("Execute replayed keyed request"), ExecuteMCPRequest(MakeKeyedRequest(TEXT("{\"include_schemas\":false}")), ReplayResponseJson, bReplaySuccess));
+	TestTrue(TEXT("Replayed keyed request should be success"), bReplaySuccess);
+
+	TSharedPtr<FJsonObject> ReplayResponseObject;
+	TestTrue(TEXT("Parse replay response"), ParseJsonObject(ReplayResponseJson, ReplayResponseObject));
+	bool bIdempotentReplay = false;
+	TestTrue(TEXT("Replay response has idempotent_replay"), ReplayResponseObject->TryGetBoolField(TEXT("idempotent_replay"), bIdempotentReplay));
+	TestTrue(TEXT("Replay response is marked as replay"), bIdempotentReplay);
+
+	FString ConflictResponseJson;
+	bool bConflictSuccess = true;
+	TestTrue(TEXT("Execute conflicting keyed request"), ExecuteMCPRequest(MakeKeyedRequest(TEXT("{\"include_schemas\":true}")), ConflictResponseJson, bConflictSuccess));
+	TestFalse(TEXT("Conflicting keyed request should fail"), bConflictSuccess);
+	TestTrue(TEXT("Conflict response carries idempotency conflict code"), ConflictResponseJson.Contains(TEXT("MCP.IDEMPOTENCY.CONFLICT")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPToolResultCacheEvictionAutomationTest,
+	"UnrealMCP.Runtime.ToolResultCacheEviction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPToolResultCacheEvictionAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	constexpr int64 NowMs = 1000000;
+	EMCPResponseStatus Status = EMCPResponseStatus::Ok;
+	FString ResponseJson;
+
+	{
+		FMCPToolResultCacheSettings Settings;
+		Settings.MaxEntries = 2;
+		FMCPToolResultCache Cache(Settings);
+		Cache.Add(TEXT("a"), TEXT("hash"), EMCPResponseStatus::Ok, TEXT("{\"key\":\"a\"}"), NowMs);
+		Cache.Add(TEXT("b"), TEXT("hash"), EMCPResponseStatus::Ok, TEXT("{\"key\":\"b\"}"), NowMs);
+		TestEqual(TEXT("Touch a so b becomes least recently used"), Cache.Find(TEXT("a"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+		Cache.Add(TEXT("c"), TEXT("hash"), EMCPResponseStatus::Ok, TEXT("{\"key\":\"c\"}"), NowMs);
+
+		TestEqual(TEXT("Entry count stays at MaxEntries"), Cache.Num(), 2);
+		TestEqual(TEXT("Least recently used entry is evicted"), Cache.Find(TEXT("b"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Miss);
+		TestEqual(TEXT("Recently used entry survives"), Cache.Find(TEXT("a"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+		TestEqual(TEXT("Newest entry survives"), Cache.Find(TEXT("c"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+	}
+
+	{
+		// Raw storage keeps each 40-byte response at exactly 40 bytes, so two fit in the budget and three do not.
+		const FString Padding = FString::ChrN(29, TEXT('x'));
+		const auto MakeResponse = [&Padding](const TCHAR* Key)
+		{
+			return FString::Printf(TEXT("{\"%s\":\"%s\"}"), Key, *Padding);
+		};
+
+		FMCPToolResultCacheSettings Settings;
+		Settings.MaxEntries = 16;
+		Settings.MaxBytes = 100;
+		Settings.CompressionThresholdBytes = 0;
+		FMCPToolResultCache Cache(Settings);
+		Cache.Add(TEXT("aaaa"), TEXT("hash"), EMCPResponseStatus::Ok, MakeResponse(TEXT("aaaa")), NowMs);
+		Cache.Add(TEXT("bbbb"), TEXT("hash"), EMCPResponseStatus::Ok, MakeResponse(TEXT("bbbb")), NowMs);
+		TestEqual(TEXT("Raw entries are counted at their UTF-8 size"), Cache.GetTotalBytes(), static_cast<int64>(80));
+
+		Cache.Add(TEXT("cccc"), TEXT("hash"), EMCPResponseStatus::Ok, MakeResponse(TEXT("cccc")), NowMs);
+		TestEqual(TEXT("Byte budget evicts down to two entries"), Cache.Num(), 2);
+		TestTrue(TEXT("Stored bytes stay within the budget"), Cache.GetTotalBytes() <= Settings.MaxBytes);
+		TestEqual(TEXT("Oldest entry is evicted for bytes"), Cache.Find(TEXT("aaaa"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Miss);
+		TestEqual(TEXT("Newer entries survive the byte budget"), Cache.Find(TEXT("bbbb"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPToolResultCacheExpiryAutomationTest,
+	"UnrealMCP.Runtime.ToolResultCacheExpiry",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPToolResultCacheExpiryAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPToolResultCacheSettings Settings;
+	Settings.TtlMs = 1000;
+	FMCPToolResultCache Cache(Settings);
+
+	constexpr int64 CreatedAtMs = 1000000;
+	Cache.Add(TEXT("key"), TEXT("hash"), EMCPResponseStatus::Error, TEXT("{\"ok\":false}"), CreatedAtMs);
+
+	EMCPResponseStatus Status = EMCPResponseStatus::Ok;
+	FString ResponseJson;
+	TestEqual(TEXT("Entry is served within the TTL"), Cache.Find(TEXT("key"), TEXT("hash"), CreatedAtMs + Settings.TtlMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+	TestEqual(TEXT("Cached status is replayed"), Status, EMCPResponseStatus::Error);
+	TestEqual(TEXT("Different params hash is a conflict"), Cache.Find(TEXT("key"), TEXT("other"), CreatedAtMs, Status, ResponseJson), EMCPToolResultCacheLookup::Conflict);
+	TestEqual(TEXT("Entry expires after the TTL"), Cache.Find(TEXT("key"), TEXT("hash"), CreatedAtMs + Settings.TtlMs + 1, Status, ResponseJson), EMCPToolResultCacheLookup::Miss);
+	TestEqual(TEXT("Expired entry is dropped"), Cache.Num(), 0);
+	TestEqual(TEXT("Expired entry releases its bytes"), Cache.GetTotalBytes(), static_cast<int64>(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPToolResultCacheCompressionAutomationTest,
+	"UnrealMCP.Runtime.ToolResultCacheCompression",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPToolResultCacheCompressionAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPToolResultCacheSettings Settings;
+	Settings.CompressionThresholdBytes = 64;
+	FMCPToolResultCache Cache(Settings);
+
+	constexpr int64 NowMs = 1000000;
+	const FString SmallResponse = TEXT("{\"ok\":true}");
+	const FString LargeResponse = FString::Printf(TEXT("{\"items\":\"%s\",\"name\":\"\uC5D0\uC14B\"}"), *FString::ChrN(8192, TEXT('x')));
+	const int64 LargeUtf8Bytes = FTCHARToUTF8(*LargeResponse).Length();
+
+	Cache.Add(TEXT("small"), TEXT("hash"), EMCPResponseStatus::Ok, SmallResponse, NowMs);
+	TestEqual(TEXT("Responses under the threshold are stored raw"), Cache.GetTotalBytes(), static_cast<int64>(SmallResponse.Len()));
+
+	Cache.Add(TEXT("large"), TEXT("hash"), EMCPResponseStatus::Ok, LargeResponse, NowMs);
+	const int64 LargeStoredBytes = Cache.GetTotalBytes() - SmallResponse.Len();
+	TestTrue(TEXT("Responses over the threshold are stored compressed"), LargeStoredBytes > 0 && LargeStoredBytes < LargeUtf8Bytes / 4);
+
+	EMCPResponseStatus Status = EMCPResponseStatus::Error;
+	FString ResponseJson;
+	TestEqual(TEXT("Compressed entry is found"), Cache.Find(TEXT("large"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+	TestEqual(TEXT("Compressed entry round-trips"), ResponseJson, LargeResponse);
+	TestEqual(TEXT("Raw entry is found"), Cache.Find(TEXT("small"), TEXT("hash"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+	TestEqual(TEXT("Raw entry round-trips"), ResponseJson, SmallResponse);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPToolResultCacheSpillAutomationTest,
+	"UnrealMCP.Runtime.ToolResultCacheSpill",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPToolResultCacheSpillAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	const FString TestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	FMCPToolResultCacheSettings Settings;
+	Settings.MaxEntries = 1;
+	Settings.TtlMs = 60 * 1000;
+	Settings.bDiskSpillEnabled = true;
+	Settings.SpillDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/Automation"), TestId));
+
+	constexpr int64 NowMs = 1000000;
+	EMCPResponseStatus Status = EMCPResponseStatus::Ok;
+	FString ResponseJson;
+
+	{
+		FMCPToolResultCache Cache(Settings);
+		Cache.Add(TEXT("first"), TEXT("hash-first"), EMCPResponseStatus::Ok, TEXT("{\"key\":\"first\"}"), NowMs);
+		Cache.Add(TEXT("second"), TEXT("hash-second"), EMCPResponseStatus::Ok, TEXT("{\"key\":\"second\"}"), NowMs);
+		TestEqual(TEXT("Eviction keeps one entry in memory"), Cache.Num(), 1);
+
+		TestEqual(TEXT("Evicted entry is restored from disk"), Cache.Find(TEXT("first"), TEXT("hash-first"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+		TestEqual(TEXT("Restored entry round-trips"), ResponseJson, FString(TEXT("{\"key\":\"first\"}")));
+		TestEqual(TEXT("Restoring evicts the other entry"), Cache.Num(), 1);
+
+		Cache.EvictAll();
+		TestEqual(TEXT("EvictAll empties memory"), Cache.Num(), 0);
+	}
+
+	{
+		// A later session finds both spilled entries on disk.
+		FMCPToolResultCache ReopenedCache(Settings);
+		TestEqual(TEXT("Reopened cache restores a spilled entry"), ReopenedCache.Find(TEXT("second"), TEXT("hash-second"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Hit);
+		TestEqual(TEXT("Spilled entry round-trips"), ResponseJson, FString(TEXT("{\"key\":\"second\"}")));
+		TestEqual(TEXT("Spilled entry keeps its params hash"), ReopenedCache.Find(TEXT("first"), TEXT("hash-other"), NowMs, Status, ResponseJson), EMCPToolResultCacheLookup::Conflict);
+		TestEqual(TEXT("Expired spilled entry is not restored"), ReopenedCache.Find(TEXT("second"), TEXT("hash-second"), NowMs + Settings.TtlMs + 1, Status, ResponseJson), EMCPToolResultCacheLookup::Miss);
+	}
+
+	IFileManager::Get().DeleteDirectory(*Settings.SpillDir, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPCanonicalJsonHashAutomationTest,
+	"UnrealMCP.Runtime.CanonicalJsonHash",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPCanonicalJsonHashAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	TSharedPtr<FJsonObject> OrderedObject;
+	TSharedPtr<FJsonObject> ReorderedObject;
+	TSharedPtr<FJsonObject> ChangedObject;
+	TestTrue(TEXT("Parse ordered params"), ParseJsonObject(TEXT("{\"a\":1,\"b\":[true,null,\"x\"],\"c\":{\"y\":0,\"z\":\"v\"}}"), OrderedObject));
+	TestTrue(TEXT("Parse reordered params"), ParseJsonObject(TEXT("{\"c\":{\"z\":\"v\",\"y\":-0},\"b\":[true,null,\"x\"],\"a\":1}"), ReorderedObject));
+	TestTrue(TEXT("Parse changed params"), ParseJsonObject(TEXT("{\"a\":1,\"b\":[null,true,\"x\"],\"c\":{\"y\":0,\"z\":\"v\"}}"), ChangedObject));
+
+	const FString OrderedHash = MCPJson::HashJsonObject(OrderedObject);
+	TestEqual(TEXT("Hash is 128-bit hex"), OrderedHash.Len(), 32);
+	TestEqual(TEXT("Key order does not change the hash"), MCPJson::HashJsonObject(ReorderedObject), OrderedHash);
+	TestNotEqual(TEXT("Array order changes the hash"), MCPJson::HashJsonObject(ChangedObject), OrderedHash);
+
+	TSharedPtr<FJsonObject> BenchmarkObject = MakeShared<FJsonObject>();
+	for (int32 FieldIndex = 0; FieldIndex < 64; ++FieldIndex)
+	{
+		TSharedPtr<FJsonObject> NestedObject = MakeShared<FJsonObject>();
+		NestedObject->SetStringField(TEXT("object_path"), FString::Printf(TEXT("/Game/MCPRuntimeTests/Asset_%d.Asset_%d"), FieldIndex, FieldIndex));
+		NestedObject->SetNumberField(TEXT("value"), FieldIndex * 0.5);
+		NestedObject->SetBoolField(TEXT("enabled"), (FieldIndex % 2) == 0);
+		BenchmarkObject->SetObjectField(FString::Printf(TEXT("field_%d"), FieldIndex), NestedObject);
+	}
+
+	constexpr int32 Iterations = 2000;
+	FString CanonicalHash;
+	const double CanonicalStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		CanonicalHash = MCPJson::HashJsonObject(BenchmarkObject);
+	}
+	const double CanonicalSeconds = FPlatformTime::Seconds() - CanonicalStartSeconds;
+
+	FString Sha1Hash;
+	const double Sha1StartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		const FString SerializedJson = MCPJson::SerializeJsonObject(BenchmarkObject);
+		FTCHARToUTF8 Utf8Data(*SerializedJson);
+		uint8 Digest[FSHA1::DigestSize];
+		FSHA1::HashBuffer(Utf8Data.Get(), Utf8Data.Length(), Digest);
+		Sha1Hash = BytesToHex(Digest, UE_ARRAY_COUNT(Digest));
+	}
+	const double Sha1Seconds = FPlatformTime::Seconds() - Sha1StartSeconds;
+
+	TestFalse(TEXT("Benchmark produced canonical hash"), CanonicalHash.IsEmpty());
+	TestFalse(TEXT("Benchmark produced sha1 hash"), Sha1Hash.IsEmpty());
+	AddInfo(FString::Printf(
+		TEXT("HashJsonObject x%d: canonical xxh3-128 %.3f ms, sha1-over-string %.3f ms"),
+		Iterations,
+		CanonicalSeconds * 1000.0,
+		Sha1Seconds * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPCompiledSchemaValidationAutomationTest,
+	"UnrealMCP.Runtime.CompiledSchemaValidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPCompiledSchemaValidationAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPToolRegistrySubsystem* Registry = GEditor != nullptr ? GEditor->GetEditorSubsystem<UMCPToolRegistrySubsystem>() : nullptr;
+	TestNotNull(TEXT("Tool registry subsystem should exist"), Registry);
+	if (Registry == nullptr)
+	{
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Tools;
+	Registry->BuildToolsList(true, FString(), Tools);
+
+	struct FCorpusEntry
+	{
+		TSharedPtr<FJsonObject> Schema;
+		TSharedPtr<const MCPToolSchemaValidator::FCompiledSchema> CompiledSchema;
+		TSharedPtr<FJsonValue> Params;
+	};
+
+	TArray<FCorpusEntry> Corpus;
+	for (const TSharedPtr<FJsonValue>& ToolValue : Tools)
+	{
+		const TSharedPtr<FJsonObject> ToolObject = ToolValue.IsValid() ? ToolValue->AsObject() : nullptr;
+		const TSharedPtr<FJsonObject>* ParamsSchema = nullptr;
+		if (!ToolObject.IsValid() || !ToolObject->TryGetObjectField(TEXT("params_schema"), ParamsSchema) || ParamsSchema == nullptr)
+		{
+			continue;
+		}
+
+		const TSharedPtr<const MCPToolSchemaValidator::FCompiledSchema> CompiledSchema = MCPToolSchemaValidator::CompileSchema(*ParamsSchema);
+		const TSharedPtr<FJsonValue> SampleParams = BuildSampleValueForSchema(*ParamsSchema);
+		Corpus.Add({ *ParamsSchema, CompiledSchema, SampleParams });
+		Corpus.Add({ *ParamsSchema, CompiledSchema, MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()) });
+		Corpus.Add({ *ParamsSchema, CompiledSchema, MakeShared<FJsonValueString>(TEXT("not-an-object")) });
+
+		const TSharedPtr<FJsonObject> SampleObject = SampleParams->Type == EJson::Object ? SampleParams->AsObject() : nullptr;
+		if (SampleObject.IsValid())
+		{
+			TSharedPtr<FJsonObject> UnknownFieldObject = MakeShared<FJsonObject>();
+			UnknownFieldObject->Values = SampleObject->Values;
+			UnknownFieldObject->SetNumberField(TEXT("__unexpected_field"), 1.0);
+			Corpus.Add({ *ParamsSchema, CompiledSchema, MakeShared<FJsonValueObject>(UnknownFieldObject) });
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : SampleObject->Values)
+			{
+				TSharedPtr<FJsonObject> WrongTypeObject = MakeShared<FJsonObject>();
+				WrongTypeObject->Values = SampleObject->Values;
+				WrongTypeObject->SetArrayField(Entry.Key, TArray<TSharedPtr<FJsonValue>>());
+				Corpus.Add({ *ParamsSchema, CompiledSchema, MakeShared<FJsonValueObject>(WrongTypeObject) });
+			}
+		}
+	}
+	TestTrue(TEXT("Schema corpus should not be empty"), Corpus.Num() > 0);
+
+	int32 MismatchCount = 0;
+	for (const FCorpusEntry& Entry : Corpus)
+	{
+		FString InterpretedError;
+		FString CompiledError;
+		const bool bInterpretedValid = MCPToolSchemaValidator::ValidateJsonValueAgainstSchema(Entry.Params, Entry.Schema, TEXT("params"), InterpretedError);
+		const bool bCompiledValid = Entry.CompiledSchema.IsValid()
+			? MCPToolSchemaValidator::ValidateJsonValueAgainstCompiledSchema(Entry.Params, *Entry.CompiledSchema, TEXT("params"), CompiledError)
+			: true;
+		if (bInterpretedValid != bCompiledValid || InterpretedError != CompiledError)
+		{
+			++MismatchCount;
+			AddError(FString::Printf(TEXT("Validator mismatch: interpreted=%s compiled=%s"), *InterpretedError, *CompiledError));
+		}
+	}
+	TestEqual(TEXT("Compiled validator should agree with interpreted validator"), MismatchCount, 0);
+
+	constexpr int32 Iterations = 200;
+	FString ScratchError;
+	const double InterpretedStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FCorpusEntry& Entry : Corpus)
+		{
+			MCPToolSchemaValidator::ValidateJsonValueAgainstSchema(Entry.Params, Entry.Schema, TEXT("params"), ScratchError);
+		}
+	}
+	const double InterpretedSeconds = FPlatformTime::Seconds() - InterpretedStartSeconds;
+
+	const double CompiledStartSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FCorpusEntry& Entry : Corpus)
+		{
+			if (Entry.CompiledSchema.IsValid())
+			{
+				MCPToolSchemaValidator::ValidateJsonValueAgainstCompiledSchema(Entry.Params, *Entry.CompiledSchema, TEXT("params"), ScratchError);
+			}
+		}
+	}
+	const double CompiledSeconds = FPlatformTime::Seconds() - CompiledStartSeconds;
+
+	AddInfo(FString::Printf(
+		TEXT("Schema validation x%d over %d requests: interpreted %.3f ms, compiled %.3f ms"),
+		Iterations,
+		Corpus.Num(),
+		InterpretedSeconds * 1000.0,
+		CompiledSeconds * 1000.0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPToolsListCachedResultAutomationTest,
+	"UnrealMCP.Runtime.ToolsListCachedResult",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPToolsListCachedResultAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FString FirstResponseJson;
+	bool bFirstSuccess = false;
+	TestTrue(TEXT("Execute first tools.list request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("tools.list"), TEXT("{\"include_schemas\":true}")), FirstResponseJson, bFirstSuccess));
+	TestTrue(TEXT("First tools.list should be success"), bFirstSuccess);
+
+	FString SecondResponseJson;
+	bool bSecondSuccess = false;
+	TestTrue(TEXT("Execute second tools.list request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("tools.list"), TEXT("{\"include_schemas\":true}")), SecondResponseJson, bSecondSuccess));
+	TestTrue(TEXT("Second tools.list should be success"), bSecondSuccess);
+
+	TSharedPtr<FJsonObject> FirstResponseObject;
+	TSharedPtr<FJsonObject> SecondResponseObject;
+	TestTrue(TEXT("Parse first tools.list response"), ParseJsonObject(FirstResponseJson, FirstResponseObject));
+	TestTrue(TEXT("Parse second tools.list response"), ParseJsonObject(SecondResponseJson, SecondResponseObject));
+
+	const TSharedPtr<FJsonObject>* FirstResultObject = nullptr;
+	const TSharedPtr<FJsonObject>* SecondResultObject = nullptr;
+	TestTrue(TEXT("First tools.list has result"), FirstResponseObject->TryGetObjectField(TEXT("result"), FirstResultObject));
+	TestTrue(TEXT("Second tools.list has result"), SecondResponseObject->TryGetObjectField(TEXT("result"), SecondResultObject));
+	TestEqual(TEXT("Cached tools.list result should match"), MCPJson::SerializeJsonObject(*SecondResultObject), MCPJson::SerializeJsonObject(*FirstResultObject));
+
+	const TArray<TSharedPtr<FJsonValue>>* Tools = nullptr;
+	TestTrue(TEXT("tools.list result has tools"), (*FirstResultObject)->TryGetArrayField(TEXT("tools"), Tools));
+	bool bFoundParamsSchema = false;
+	if (Tools != nullptr)
+	{
+		for (const TSharedPtr<FJsonValue>& ToolValue : *Tools)
+		{
+			const TSharedPtr<FJsonObject> ToolObject = ToolValue.IsValid() ? ToolValue->AsObject() : nullptr;
+			bFoundParamsSchema |= ToolObject.IsValid() && ToolObject->HasTypedField<EJson::Object>(TEXT("params_schema"));
+		}
+	}
+	TestTrue(TEXT("Materialized params schemas should be listed"), bFoundParamsSchema);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPLatencyMetricsAutomationTest,
+	"UnrealMCP.Runtime.LatencyMetrics",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPLatencyMetricsAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPLatencyHistogram Histogram;
+	for (int64 ValueUs = 1; ValueUs <= 10000; ++ValueUs)
+	{
+		Histogram.Record(ValueUs);
+	}
+	TestEqual(TEXT("Histogram should count every sample"), Histogram.TotalCount, static_cast<int64>(10000));
+	TestEqual(TEXT("Histogram max should be exact"), Histogram.GetValueAtPercentile(100.0), static_cast<int64>(10000));
+	const int64 P50Us = Histogram.GetValueAtPercentile(50.0);
+	const int64 P99Us = Histogram.GetValueAtPercentile(99.0);
+	TestTrue(TEXT("p50 should be within bucket precision"), P50Us >= 5000 && P50Us <= 5000 + 5000 / FMCPLatencyHistogram::SubBucketCount);
+	TestTrue(TEXT("p99 should be within bucket precision"), P99Us >= 9900 && P99Us <= 10000);
+
+	FString ToolsResponseJson;
+	bool bToolsSuccess = false;
+	TestTrue(TEXT("Execute tools.list request for latency warmup"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("tools.list"), TEXT("{\"include_schemas\":false}")), ToolsResponseJson, bToolsSuccess));
+	TestTrue(TEXT("tools.list warmup should be success"), bToolsSuccess);
+
+	FString MetricsResponseJson;
+	bool bMetricsSuccess = false;
+	TestTrue(TEXT("Execute metrics.get request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("metrics.get"), TEXT("{\"tool\":\"tools.list\"}")), MetricsResponseJson, bMetricsSuccess));
+	TestTrue(TEXT("metrics.get should be success"), bMetricsSuccess);
+
+	TSharedPtr<FJsonObject> MetricsResponseObject;
+	TestTrue(TEXT("Parse metrics.get response"), ParseJsonObject(MetricsResponseJson, MetricsResponseObject));
+
+	const TSharedPtr<FJsonObject>* ResultObject = nullptr;
+	TestTrue(TEXT("metrics.get response has result"), MetricsResponseObject->TryGetObjectField(TEXT("result"), ResultObject));
+
+	const TSharedPtr<FJsonObject>* PhasesObject = nullptr;
+	TestTrue(TEXT("metrics.get result has phases"), (*ResultObject)->TryGetObjectField(TEXT("phases"), PhasesObject));
+
+	const TSharedPtr<FJsonObject>* ExecutePhaseObject = nullptr;
+	TestTrue(TEXT("phases has execute"), (*PhasesObject)->TryGetObjectField(TEXT("execute"), ExecutePhaseObject));
+
+	double ExecuteCount = 0.0;
+	double ExecuteP99Ms = -1.0;
+	TestTrue(TEXT("execute phase has count"), (*ExecutePhaseObject)->TryGetNumberField(TEXT("count"), ExecuteCount));
+	TestTrue(TEXT("execute phase has p99_ms"), (*ExecutePhaseObject)->TryGetNumberField(TEXT("p99_ms"), ExecuteP99Ms));
+	TestTrue(TEXT("execute phase should have samples"), ExecuteCount > 0.0);
+	TestTrue(TEXT("execute p99 should be non-negative"), ExecuteP99Ms >= 0.0);
+
+	const TSharedPtr<FJsonObject>* ToolsObject = nullptr;
+	TestTrue(TEXT("metrics.get result has tools"), (*ResultObject)->TryGetObjectField(TEXT("tools"), ToolsObject));
+	TestTrue(TEXT("tools should include tools.list"), (*ToolsObject)->HasTypedField<EJson::Object>(TEXT("tools.list")));
+	TestFalse(TEXT("tool filter should exclude other tools"), (*ToolsObject)->HasField(TEXT("metrics.get")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChromeTraceRecorderAutomationTest,
+	"UnrealMCP.Runtime.ChromeTraceRecorder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChromeTraceRecorderAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPTraceSubsystem* TraceRecorder = GEditor ? GEditor->GetEditorSubsystem<UMCPTraceSubsystem>() : nullptr;
+	TestNotNull(TEXT("Trace subsystem should exist"), TraceRecorder);
+	if (TraceRecorder == nullptr)
+	{
+		return false;
+	}
+
+	const bool bWasEnabled = TraceRecorder->IsChromeTraceEnabled();
+	TraceRecorder->SetChromeTraceEnabled(true);
+	TestTrue(TEXT("Trace subsystem should be the active recorder"), UMCPTraceSubsystem::GetActiveRecorder() == TraceRecorder);
+
+	FString DrainedFilePath;
+	TraceRecorder->FlushChromeTrace(DrainedFilePath);
+
+	FString ResponseJson;
+	bool bSuccess = false;
+	TestTrue(TEXT("Execute tools.list request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("tools.list"), TEXT("{\"include_schemas\":false}")), ResponseJson, bSuccess));
+	TestTrue(TEXT("tools.list should be success"), bSuccess);
+
+	FString TraceFilePath;
+	TestTrue(TEXT("Flush should write a trace file"), TraceRecorder->FlushChromeTrace(TraceFilePath));
+
+	FString TraceJson;
+	TestTrue(TEXT("Trace file should be readable"), FFileHelper::LoadFileToString(TraceJson, *TraceFilePath));
+
+	TSharedPtr<FJsonObject> TraceObject;
+	TestTrue(TEXT("Trace file should be JSON"), ParseJsonObject(TraceJson, TraceObject));
+
+	const TArray<TSharedPtr<FJsonValue>>* TraceEvents = nullptr;
+	TestTrue(TEXT("Trace has traceEvents"), TraceObject.IsValid() && TraceObject->TryGetArrayField(TEXT("traceEvents"), TraceEvents));
+
+	bool bFoundToolSpan = false;
+	bool bFoundExecuteSpan = false;
+	if (TraceEvents != nullptr)
+	{
+		for (const TSharedPtr<FJsonValue>& EventValue : *TraceEvents)
+		{
+			const TSharedPtr<FJsonObject> EventObject = EventValue.IsValid() ? EventValue->AsObject() : nullptr;
+			if (!EventObject.IsValid())
+			{
+				continue;
+			}
+
+			const FString EventName = EventObject->GetStringField(TEXT("name"));
+			bFoundToolSpan |= EventName == TEXT("tools.list");
+			bFoundExecuteSpan |= EventName == TEXT("execute");
+		}
+	}
+	TestTrue(TEXT("Trace should contain the tool handler span"), bFoundToolSpan);
+	TestTrue(TEXT("Trace should contain the execute phase span"), bFoundExecuteSpan);
+
+	TraceRecorder->SetChromeTraceEnabled(bWasEnabled);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPCooperativeCancellationAutomationTest,
+	"UnrealMCP.Runtime.CooperativeCancellation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPCooperativeCancellationAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPToolExecutionResult UntrackedResult;
+	TestFalse(TEXT("Results without a token never stop"), UntrackedResult.ShouldStop());
+
+	FMCPToolExecutionResult DeadlineResult;
+	DeadlineResult.Cancellation = MakeShared<FMCPCancellationToken>();
+	DeadlineResult.Cancellation->SetDeadlineCycles(MCPTime::NowCycles() + MCPTime::MillisecondsToCycles(60000));
+	TestFalse(TEXT("Future deadline should not stop"), DeadlineResult.ShouldStop());
+	DeadlineResult.Cancellation->SetDeadlineCycles(1);
+	TestTrue(TEXT("Elapsed deadline should stop"), DeadlineResult.ShouldStop());
+	TestTrue(TEXT("Stop reason should be deadline"), DeadlineResult.Cancellation->GetStopReason() == EMCPStopReason::DeadlineExceeded);
+
+	UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+	TestNotNull(TEXT("Job subsystem should exist"), JobSubsystem);
+	if (JobSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FString JobId = JobSubsystem->CreateJob();
+	JobSubsystem->UpdateJobStatus(JobId, EMCPJobStatus::Running, 0.0);
+	const TSharedRef<FMCPCancellationToken> Cancellation = MakeShared<FMCPCancellationToken>();
+	JobSubsystem->RegisterCancellationToken(JobId, Cancellation);
+	TestFalse(TEXT("Running job token should not stop"), Cancellation->ShouldStop());
+
+	FMCPJobRecord CanceledRecord;
+	FMCPDiagnostic CancelDiagnostic;
+	TestTrue(TEXT("Cancel running job"), JobSubsystem->CancelJob(JobId, CanceledRecord, CancelDiagnostic));
+	TestTrue(TEXT("Canceled job token should stop"), Cancellation->ShouldStop());
+	TestTrue(TEXT("Stop reason should be canceled"), Cancellation->GetStopReason() == EMCPStopReason::Canceled);
+	JobSubsystem->UnregisterCancellationToken(JobId, Cancellation);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPAsyncJobAutomationTest,
+	"UnrealMCP.Runtime.AsyncJob",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPAsyncJobAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPToolExecutionResult StagedResult;
+	int32 StageOrder = 0;
+	StagedResult.WorkerStage = [&StageOrder](FMCPToolExecutionResult& StageResult)
+	{
+		StageOrder = StageOrder * 10 + 1;
+		StageResult.Status = EMCPResponseStatus::Ok;
+	};
+	StagedResult.CommitStage = [&StageOrder](FMCPToolExecutionResult&)
+	{
+		StageOrder = StageOrder * 10 + 2;
+	};
+	StagedResult.RunWorkerStage();
+	StagedResult.RunCommitStage();
+	StagedResult.RunWorkerStage();
+	TestEqual(TEXT("Stages run once, worker before commit"), StageOrder, 12);
+
+	UMCPEventStreamSubsystem* EventStream = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr;
+	const int64 EventSequenceBefore = EventStream != nullptr ? EventStream->GetLatestSequence() : 0;
+
+	FString FindResponseJson;
+	bool bFindSuccess = false;
+	const FString FindRequestJson = MakeRequestEnvelope(TEXT("asset.find"), TEXT("{\"path_glob\":\"/Game/**\",\"limit\":5}"))
+		.Replace(TEXT("\"context\":{"), TEXT("\"context\":{\"async\":true,"));
+	TestTrue(TEXT("Execute async asset.find request"), ExecuteMCPRequest(FindRequestJson, FindResponseJson, bFindSuccess));
+	TestTrue(TEXT("Async asset.find should be accepted"), bFindSuccess);
+
+	TSharedPtr<FJsonObject> FindResponseObject;
+	TestTrue(TEXT("Parse async asset.find response"), ParseJsonObject(FindResponseJson, FindResponseObject));
+	const TSharedPtr<FJsonObject>* FindResultObject = nullptr;
+	FString JobId;
+	if (FindResponseObject.IsValid() && FindResponseObject->TryGetObjectField(TEXT("result"), FindResultObject) && FindResultObject != nullptr)
+	{
+		(*FindResultObject)->TryGetStringField(TEXT("job_id"), JobId);
+		TestFalse(TEXT("Async response should not inline assets"), (*FindResultObject)->HasField(TEXT("assets")));
+	}
+	TestFalse(TEXT("Async response should include job_id"), JobId.IsEmpty());
+
+	UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+	TestNotNull(TEXT("Job subsystem should exist"), JobSubsystem);
+	FMCPJobRecord JobRecord;
+	if (JobSubsystem != nullptr && !JobId.IsEmpty())
+	{
+		TestTrue(TEXT("Async job should be registered"), JobSubsystem->GetJob(JobId, JobRecord));
+		TestTrue(TEXT("Job should be marked async"), JobRecord.bAsync);
+		TestTrue(TEXT("Job should remember its request_id"), JobRecord.RequestId.StartsWith(TEXT("auto-test-")));
+
+		const TWeakObjectPtr<UMCPJobSubsystem> WeakJobSubsystem(JobSubsystem);
+		const TWeakObjectPtr<UMCPEventStreamSubsystem> WeakEventStream(EventStream);
+		const double WaitDeadlineSeconds = FPlatformTime::Seconds() + 30.0;
+		ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, WeakJobSubsystem, WeakEventStream, JobId, EventSequenceBefore, WaitDeadlineSeconds]()
+		{
+			UMCPJobSubsystem* LatentJobSubsystem = WeakJobSubsystem.Get();
+			if (LatentJobSubsystem == nullptr)
+			{
+				AddError(TEXT("Job subsystem went away while waiting for the async job"));
+				return true;
+			}
+
+			FMCPJobRecord LatentRecord;
+			const bool bFound = LatentJobSubsystem->GetJob(JobId, LatentRecord);
+			const bool bTerminal = bFound
+				&& (LatentRecord.Status == EMCPJobStatus::Succeeded
+					|| LatentRecord.Status == EMCPJobStatus::Failed
+					|| LatentRecord.Status == EMCPJobStatus::Canceled);
+			if (!bTerminal)
+			{
+				if (FPlatformTime::Seconds() < WaitDeadlineSeconds)
+				{
+					return false;
+				}
+				AddError(TEXT("Async asset.find job did not finish within 30 seconds"));
+				return true;
+			}
+
+			TestTrue(TEXT("Async job should succeed"), LatentRecord.Status == EMCPJobStatus::Succeeded);
+
+			FString JobGetResponseJson;
+			bool bJobGetSuccess = false;
+			TestTrue(
+				TEXT("Execute job.get request"),
+				ExecuteMCPRequest(MakeRequestEnvelope(TEXT("job.get"), FString::Printf(TEXT("{\"job_id\":\"%s\"}"), *JobId)), JobGetResponseJson, bJobGetSuccess));
+			TestTrue(TEXT("job.get should succeed"), bJobGetSuccess);
+
+			TSharedPtr<FJsonObject> JobGetResponseObject;
+			const TSharedPtr<FJsonObject>* JobGetResultObject = nullptr;
+			const TSharedPtr<FJsonObject>* JobResultObject = nullptr;
+			FString JobStatus;
+			const TArray<TSharedPtr<FJsonValue>>* Assets = nullptr;
+			if (ParseJsonObject(JobGetResponseJson, JobGetResponseObject)
+				&& JobGetResponseObject->TryGetObjectField(TEXT("result"), JobGetResultObject)
+				&& JobGetResultObject != nullptr)
+			{
+				(*JobGetResultObject)->TryGetStringField(TEXT("status"), JobStatus);
+				if ((*JobGetResultObject)->TryGetObjectField(TEXT("result"), JobResultObject) && JobResultObject != nullptr)
+				{
+					(*JobResultObject)->TryGetArrayField(TEXT("assets"), Assets);
+				}
+			}
+			TestEqual(TEXT("job.get reports the terminal status"), JobStatus, FString(TEXT("succeeded")));
+			TestNotNull(TEXT("job.get result should carry the assets payload"), Assets);
+			if (Assets != nullptr)
+			{
+				TestTrue(TEXT("Async asset.find should respect its limit"), Assets->Num() <= 5);
+			}
+
+			bool bSawCompletionEvent = false;
+			if (UMCPEventStreamSubsystem* LatentEventStream = WeakEventStream.Get())
+			{
+				bool bGap = false;
+				for (const TSharedPtr<FJsonObject>& EventObject : LatentEventStream->GetEventsAfter(EventSequenceBefore, 256, bGap))
+				{
+					FString EventType;
+					const TSharedPtr<FJsonObject>* EventPayload = nullptr;
+					FString EventJobId;
+					FString EventStatus;
+					if (EventObject.IsValid()
+						&& EventObject->TryGetStringField(TEXT("event_type"), EventType)
+						&& EventType == TEXT("event.job.status")
+						&& EventObject->TryGetObjectField(TEXT("payload"), EventPayload)
+						&& EventPayload != nullptr
+						&& (*EventPayload)->TryGetStringField(TEXT("job_id"), EventJobId)
+						&& EventJobId == JobId
+						&& (*EventPayload)->TryGetStringField(TEXT("status"), EventStatus)
+						&& EventStatus == TEXT("succeeded"))
+					{
+						bSawCompletionEvent = true;
+					}
+				}
+			}
+			TestTrue(TEXT("Completion should be published as an event.job.status event"), bSawCompletionEvent);
+			return true;
+		}));
+	}
+
+	FString SaveResponseJson;
+	bool bSaveSuccess = true;
+	const FString SaveRequestJson = MakeRequestEnvelope(TEXT("asset.save"), TEXT("{\"packages\":[]}"))
+		.Replace(TEXT("\"context\":{"), TEXT("\"context\":{\"async\":true,"));
+	TestTrue(TEXT("Execute async asset.save request"), ExecuteMCPRequest(SaveRequestJson, SaveResponseJson, bSaveSuccess));
+	TestFalse(TEXT("Async write tools should be rejected"), bSaveSuccess);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPJobRetentionAutomationTest,
+	"UnrealMCP.Runtime.JobRetention",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPJobRetentionAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPJobSubsystem* JobSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPJobSubsystem>() : nullptr;
+	TestNotNull(TEXT("Job subsystem should exist"), JobSubsystem);
+	if (JobSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FString SmallJobId = JobSubsystem->CreateJob();
+	TSharedPtr<FJsonObject> SmallResult = MakeShared<FJsonObject>();
+	SmallResult->SetStringField(TEXT("marker"), TEXT("small"));
+	TestTrue(TEXT("Finalize small job"), JobSubsystem->FinalizeJob(SmallJobId, EMCPJobStatus::Succeeded, SmallResult, {}));
+	TestFalse(TEXT("Terminal jobs should ignore status updates"), JobSubsystem->UpdateJobStatus(SmallJobId, EMCPJobStatus::Running, 50.0));
+
+	FMCPJobRecord SmallRecord;
+	TestTrue(TEXT("Get small job"), JobSubsystem->GetJob(SmallJobId, SmallRecord));
+	TestTrue(TEXT("Small job should stay succeeded"), SmallRecord.Status == EMCPJobStatus::Succeeded);
+	FString SmallMarker;
+	TestTrue(TEXT("Small job result should round-trip"), SmallRecord.Result.IsValid() && SmallRecord.Result->TryGetStringField(TEXT("marker"), SmallMarker));
+	TestEqual(TEXT("Small job marker"), SmallMarker, FString(TEXT("small")));
+
+	const FString LargeJobId = JobSubsystem->CreateJob();
+	TSharedPtr<FJsonObject> LargeResult = MakeShared<FJsonObject>();
+	LargeResult->SetStringField(TEXT("payload"), FString::ChrN(512 * 1024, TEXT('x')));
+	TestTrue(TEXT("Finalize large job"), JobSubsystem->FinalizeJob(LargeJobId, EMCPJobStatus::Succeeded, LargeResult, {}));
+
+	FMCPJobRecord LargeRecord;
+	TestTrue(TEXT("Get large job"), JobSubsystem->GetJob(LargeJobId, LargeRecord));
+	FString LargePayload;
+	if (LargeRecord.Result.IsValid())
+	{
+		LargeRecord.Result->TryGetStringField(TEXT("payload"), LargePayload);
+	}
+	TestEqual(TEXT("Large job result should round-trip"), LargePayload.Len(), 512 * 1024);
+	TestTrue(TEXT("Retained job count should include finalized jobs"), JobSubsystem->GetRetainedJobCount() >= 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPBatchAutomationTest,
+	"UnrealMCP.Runtime.Batch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPBatchAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FString BatchResponseJson;
+	bool bBatchSuccess = false;
+	const FString BatchRequestJson = MakeRequestEnvelope(
+		TEXT("mcp.batch"),
+		TEXT("{\"calls\":[{\"tool\":\"tools.list\",\"params\":{\"include_schemas\":false}},{\"tool\":\"system.health\",\"params\":{}}]}"));
+	TestTrue(TEXT("Execute mcp.batch request"), ExecuteMCPRequest(BatchRequestJson, BatchResponseJson, bBatchSuccess));
+	TestTrue(TEXT("mcp.batch should be success"), bBatchSuccess);
+
+	TSharedPtr<FJsonObject> BatchResponseObject;
+	TestTrue(TEXT("Parse mcp.batch response"), ParseJsonObject(BatchResponseJson, BatchResponseObject));
+	const TSharedPtr<FJsonObject>* BatchResultObject = nullptr;
+	TestTrue(TEXT("mcp.batch response has result"), BatchResponseObject.IsValid() && BatchResponseObject->TryGetObjectField(TEXT("result"), BatchResultObject));
+	if (BatchResultObject == nullptr)
+	{
+		return false;
+	}
+
+	double CallCount = 0.0;
+	double SucceededCount = 0.0;
+	(*BatchResultObject)->TryGetNumberField(TEXT("call_count"), CallCount);
+	(*BatchResultObject)->TryGetNumberField(TEXT("succeeded_count"), SucceededCount);
+	TestEqual(TEXT("mcp.batch call_count"), static_cast<int32>(CallCount), 2);
+	TestEqual(TEXT("mcp.batch succeeded_count"), static_cast<int32>(SucceededCount), 2);
+
+	const TArray<TSharedPtr<FJsonValue>>* CallResults = nullptr;
+	TestTrue(TEXT("mcp.batch result has results"), (*BatchResultObject)->TryGetArrayField(TEXT("results"), CallResults));
+	if (CallResults != nullptr && CallResults->Num() == 2)
+	{
+		const TSharedPtr<FJsonObject> SecondCall = (*CallResults)[1]->AsObject();
+		FString SecondTool;
+		FString SecondRequestId;
+		SecondCall->TryGetStringField(TEXT("tool"), SecondTool);
+		SecondCall->TryGetStringField(TEXT("request_id"), SecondRequestId);
+		TestEqual(TEXT("Batch results keep call order"), SecondTool, FString(TEXT("system.health")));
+		TestTrue(TEXT("Batch call request_id derives from the batch request_id"), SecondRequestId.EndsWith(TEXT(".1")));
+	}
+
+	FString PartialResponseJson;
+	bool bPartialSuccess = false;
+	const FString PartialRequestJson = MakeRequestEnvelope(
+		TEXT("mcp.batch"),
+		TEXT("{\"mode\":\"continue\",\"calls\":[{\"tool\":\"tools.list\",\"params\":{\"include_schemas\":false}},{\"tool\":\"tool.does.not.exist\",\"params\":{}}]}"));
+	TestTrue(TEXT("Execute continue-mode mcp.batch request"), ExecuteMCPRequest(PartialRequestJson, PartialResponseJson, bPartialSuccess));
+
+	TSharedPtr<FJsonObject> PartialResponseObject;
+	TestTrue(TEXT("Parse continue-mode mcp.batch response"), ParseJsonObject(PartialResponseJson, PartialResponseObject));
+	FString PartialStatus;
+	TestTrue(TEXT("Continue-mode mcp.batch has status"), PartialResponseObject.IsValid() && PartialResponseObject->TryGetStringField(TEXT("status"), PartialStatus));
+	TestEqual(TEXT("Continue-mode mcp.batch with a failing call should be partial"), PartialStatus, FString(TEXT("partial")));
+
+	FString NestedResponseJson;
+	bool bNestedSuccess = true;
+	const FString NestedRequestJson = MakeRequestEnvelope(
+		TEXT("mcp.batch"),
+		TEXT("{\"calls\":[{\"tool\":\"tools.list\",\"params\":{}},{\"tool\":\"mcp.batch\",\"params\":{\"calls\":[{\"tool\":\"tools.list\"}]}}]}"));
+	TestTrue(TEXT("Execute nested mcp.batch request"), ExecuteMCPRequest(NestedRequestJson, NestedResponseJson, bNestedSuccess));
+	TestFalse(TEXT("Nested mcp.batch should be rejected"), bNestedSuccess);
+
+	TSharedPtr<FJsonObject> NestedResponseObject;
+	TestTrue(TEXT("Parse nested mcp.batch response"), ParseJsonObject(NestedResponseJson, NestedResponseObject));
+	const TSharedPtr<FJsonObject>* NestedResultObject = nullptr;
+	const bool bHasNestedResults = NestedResponseObject.IsValid()
+		&& NestedResponseObject->TryGetObjectField(TEXT("result"), NestedResultObject)
+		&& (*NestedResultObject)->HasField(TEXT("results"));
+	TestFalse(TEXT("Rejected stop_on_error batch should not execute any call"), bHasNestedResults);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPBlueprintCompileDeferralAutomationTest,
+	"UnrealMCP.Runtime.BlueprintCompileDeferral",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPBlueprintCompileDeferralAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPBlueprintCompileSubsystem* CompileSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPBlueprintCompileSubsystem>() : nullptr;
+	TestNotNull(TEXT("Blueprint compile subsystem should exist"), CompileSubsystem);
+	UWidgetBlueprint* WidgetBlueprint = GetOrCreateRuntimeWidgetBlueprint();
+	TestNotNull(TEXT("Create runtime widget blueprint"), WidgetBlueprint);
+	if (CompileSubsystem == nullptr || WidgetBlueprint == nullptr)
+	{
+		return false;
+	}
+
+	FMCPBlueprintFlushResult InitialFlushResult;
+	CompileSubsystem->Flush(InitialFlushResult);
+	if (!CompileSubsystem->IsDeferredCompileEnabled())
+	{
+		AddInfo(TEXT("Deferred blueprint compile is disabled by config; skipping coalescing checks."));
+		return true;
+	}
+
+	TestTrue(TEXT("First compile request should be deferred"), CompileSubsystem->RequestCompile(WidgetBlueprint, false));
+	TestTrue(TEXT("Second compile request should be deferred"), CompileSubsystem->RequestCompile(WidgetBlueprint, false));
+	TestEqual(TEXT("Repeated requests coalesce into one pending compile"), CompileSubsystem->GetPendingCount(), 1);
+
+	const FString WidgetBlueprintPath = WidgetBlueprint->GetPathName();
+	FString CompileResponseJson;
+	bool bCompileSuccess = false;
+	const FString CompileRequestJson = MakeRequestEnvelope(
+		TEXT("umg.blueprint.compile"),
+		FString::Printf(TEXT("{\"object_path\":\"%s\"}"), *WidgetBlueprintPath),
+		false);
+	TestTrue(TEXT("Execute umg.blueprint.compile request"), ExecuteMCPRequest(CompileRequestJson, CompileResponseJson, bCompileSuccess));
+	TestTrue(TEXT("umg.blueprint.compile should be success"), bCompileSuccess);
+
+	TSharedPtr<FJsonObject> CompileResponseObject;
+	TestTrue(TEXT("Parse umg.blueprint.compile response"), ParseJsonObject(CompileResponseJson, CompileResponseObject));
+	const TSharedPtr<FJsonObject>* CompileResultObject = nullptr;
+	TestTrue(TEXT("umg.blueprint.compile has result"), CompileResponseObject.IsValid() && CompileResponseObject->TryGetObjectField(TEXT("result"), CompileResultObject));
+	if (CompileResultObject == nullptr)
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* CompiledValues = nullptr;
+	TestTrue(TEXT("umg.blueprint.compile result has compiled"), (*CompileResultObject)->TryGetArrayField(TEXT("compiled"), CompiledValues));
+	TestTrue(TEXT("umg.blueprint.compile compiled the pending blueprint"), JsonArrayContainsString(CompiledValues, WidgetBlueprintPath));
+
+	double CoalescedRequestCount = 0.0;
+	double PendingAfter = -1.0;
+	(*CompileResultObject)->TryGetNumberField(TEXT("coalesced_request_count"), CoalescedRequestCount);
+	(*CompileResultObject)->TryGetNumberField(TEXT("pending_after"), PendingAfter);
+	TestEqual(TEXT("Both compile requests were served by one compile"), static_cast<int32>(CoalescedRequestCount), 2);
+	TestEqual(TEXT("No compiles remain pending"), static_cast<int32>(PendingAfter), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPAssetIndexAutomationTest,
+	"UnrealMCP.Runtime.AssetIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPAssetIndexAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPAssetIndexSubsystem* AssetIndex = GEditor ? GEditor->GetEditorSubsystem<UMCPAssetIndexSubsystem>() : nullptr;
+	TestNotNull(TEXT("Asset index subsystem available"), AssetIndex);
+	if (AssetIndex == nullptr)
+	{
+		return false;
+	}
+
+	AssetIndex->PrepareForQuery();
+	TestTrue(TEXT("Asset index is populated"), AssetIndex->GetIndexedAssetCount() > 0);
+
+	const FString PathGlob = TEXT("/Engine/EngineMaterials/*");
+	const FString NameGlob = TEXT("Default*");
+
+	TArray<FAssetData> AssetDataList;
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().GetAllAssets(AssetDataList, true);
+	TArray<FString> ExpectedPaths;
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		const FString ObjectPath = AssetData.GetObjectPathString();
+		if ((ObjectPath.MatchesWildcard(PathGlob) || AssetData.PackagePath.ToString().MatchesWildcard(PathGlob))
+			&& AssetData.AssetName.ToString().MatchesWildcard(NameGlob))
+		{
+			ExpectedPaths.Add(ObjectPath);
+		}
+	}
+	ExpectedPaths.Sort();
+	TestTrue(TEXT("Registry scan finds engine default materials"), ExpectedPaths.Num() > 1);
+
+	FMCPAssetQuery Query;
+	Query.PathGlob = PathGlob;
+	Query.NameGlob = NameGlob;
+	Query.Limit = 500;
+	FMCPAssetQueryResult FullResult;
+	TestTrue(TEXT("Full index query completes"), AssetIndex->Query(Query, FullResult, []() { return false; }));
+	TestEqual(TEXT("Index query matches registry scan count"), FullResult.Rows.Num(), ExpectedPaths.Num());
+	for (int32 Index = 0; Index < FMath::Min(FullResult.Rows.Num(), ExpectedPaths.Num()); ++Index)
+	{
+		TestEqual(TEXT("Index query preserves object path order"), FullResult.Rows[Index].ObjectPath, ExpectedPaths[Index]);
+	}
+
+	Query.Limit = 1;
+	Query.Offset = 1;
+	FMCPAssetQueryResult PageResult;
+	TestTrue(TEXT("Paged index query completes"), AssetIndex->Query(Query, PageResult, []() { return false; }));
+	TestEqual(TEXT("Paged query returns one row"), PageResult.Rows.Num(), 1);
+	TestEqual(TEXT("Paged query reports further pages"), PageResult.bHasMore, ExpectedPaths.Num() > 2);
+	if (PageResult.Rows.Num() == 1 && ExpectedPaths.Num() > 1)
+	{
+		TestEqual(TEXT("Paged query honors offset"), PageResult.Rows[0].ObjectPath, ExpectedPaths[1]);
+	}
+
+	FMCPAssetQuery ClassQuery;
+	ClassQuery.PathGlob = TEXT("/Engine/**");
+	ClassQuery.ClassPaths.Add(TEXT("/Script/Engine.Material"));
+	ClassQuery.NameGlob = TEXT("*DefaultMaterial*");
+	FMCPAssetQueryResult ClassResult;
+	TestTrue(TEXT("Class-filtered index query completes"), AssetIndex->Query(ClassQuery, ClassResult, []() { return false; }));
+	const bool bFoundDefaultMaterial = ClassResult.Rows.ContainsByPredicate([](const FMCPAssetQueryRow& Row)
+	{
+		return Row.ObjectPath == TEXT("/Engine/EngineMaterials/DefaultMaterial.DefaultMaterial");
+	});
+	TestTrue(TEXT("Class and name trigram lookup finds DefaultMaterial"), bFoundDefaultMaterial);
+
+	FMCPAssetQuery MissingQuery;
+	MissingQuery.PathGlob = TEXT("/Game/**");
+	MissingQuery.NameGlob = TEXT("*MCPIndexNoSuchAssetXyz*");
+	FMCPAssetQueryResult MissingResult;
+	TestTrue(TEXT("Unmatched trigram query completes"), AssetIndex->Query(MissingQuery, MissingResult, []() { return false; }));
+	TestEqual(TEXT("Unmatched trigram query returns nothing"), MissingResult.Rows.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPPageCursorAutomationTest,
+	"UnrealMCP.Runtime.PageCursor",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPPageCursorAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	FMCPPageCursor SourceCursor;
+	SourceCursor.SnapshotId = 0x1234abcdULL;
+	SourceCursor.Offset = 40;
+	SourceCursor.QueryHash = 0xdeadbeef;
+	SourceCursor.LastSortKey = TEXT("/Script/UMG.Button:with:colons");
+	TSharedRef<FJsonObject> CursorParams = MakeShared<FJsonObject>();
+	CursorParams->SetStringField(TEXT("cursor"), MCPToolPaging::EncodeCursor(SourceCursor));
+
+	FMCPPageCursor ParsedCursor;
+	FMCPDiagnostic CursorDiagnostic;
+	TestTrue(TEXT("Opaque cursor parses"), MCPToolPaging::ParseCursor(CursorParams, ParsedCursor, CursorDiagnostic));
+	TestEqual(TEXT("Cursor keeps snapshot id"), ParsedCursor.SnapshotId, SourceCursor.SnapshotId);
+	TestEqual(TEXT("Cursor keeps offset"), ParsedCursor.Offset, SourceCursor.Offset);
+	TestEqual(TEXT("Cursor keeps query hash"), ParsedCursor.QueryHash, SourceCursor.QueryHash);
+	TestEqual(TEXT("Cursor keeps last sort key"), ParsedCursor.LastSortKey, SourceCursor.LastSortKey);
+
+	CursorParams->SetStringField(TEXT("cursor"), TEXT("17"));
+	TestTrue(TEXT("Legacy offset cursor parses"), MCPToolPaging::ParseCursor(CursorParams, ParsedCursor, CursorDiagnostic));
+	TestEqual(TEXT("Legacy offset cursor keeps offset"), ParsedCursor.Offset, 17);
+
+	const FString FullListRequestJson = MakeRequestEnvelope(TEXT("umg.widget.class.list"), TEXT("{\"name_glob\":\"*\",\"limit\":2000}"));
+	FString FullListResponseJson;
+	bool bFullListSuccess = false;
+	TestTrue(TEXT("Execute full umg.widget.class.list"), ExecuteMCPRequest(FullListRequestJson, FullListResponseJson, bFullListSuccess));
+	TSharedPtr<FJsonObject> FullListResponseObject;
+	TestTrue(TEXT("Parse full class list response"), ParseJsonObject(FullListResponseJson, FullListResponseObject));
+	const TSharedPtr<FJsonObject>* FullListResultObject = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* FullClassValues = nullptr;
+	if (!FullListResponseObject.IsValid()
+		|| !FullListResponseObject->TryGetObjectField(TEXT("result"), FullListResultObject)
+		|| !(*FullListResultObject)->TryGetArrayField(TEXT("classes"), FullClassValues)
+		|| FullClassValues->Num() < 3)
+	{
+		AddError(TEXT("Full widget class list should return at least three classes."));
+		return false;
+	}
+
+	TArray<FString> PagedClassPaths;
+	FString Cursor;
+	for (int32 PageIndex = 0; PageIndex < FullClassValues->Num(); ++PageIndex)
+	{
+		const FString CursorField = Cursor.IsEmpty() ? FString() : FString::Printf(TEXT(",\"cursor\":\"%s\""), *Cursor);
+		const FString PageRequestJson = MakeRequestEnvelope(
+			TEXT("umg.widget.class.list"),
+			FString::Printf(TEXT("{\"name_glob\":\"*\",\"limit\":2%s}"), *CursorField));
+		FString PageResponseJson;
+		bool bPageSuccess = false;
+		ExecuteMCPRequest(PageRequestJson, PageResponseJson, bPageSuccess);
+		TestTrue(TEXT("Paged class list request should succeed"), bPageSuccess);
+
+		TSharedPtr<FJsonObject> PageResponseObject;
+		const TSharedPtr<FJsonObject>* PageResultObject = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* PageClassValues = nullptr;
+		if (!ParseJsonObject(PageResponseJson, PageResponseObject)
+			|| !PageResponseObject->TryGetObjectField(TEXT("result"), PageResultObject)
+			|| !(*PageResultObject)->TryGetArrayField(TEXT("classes"), PageClassValues))
+		{
+			AddError(TEXT("Paged class list response is missing classes."));
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& ClassValue : *PageClassValues)
+		{
+			PagedClassPaths.Add(ClassValue->AsObject()->GetStringField(TEXT("class_path")));
+		}
+
+		Cursor.Reset();
+		if (!(*PageResultObject)->TryGetStringField(TEXT("next_cursor"), Cursor))
+		{
+			break;
+		}
+		TestTrue(TEXT("next_cursor is opaque"), Cursor.StartsWith(TEXT("c1.")));
+	}
+
+	TestEqual(TEXT("Paging visits every class exactly once"), PagedClassPaths.Num(), FullClassValues->Num());
+	for (int32 Index = 0; Index < FMath::Min(PagedClassPaths.Num(), FullClassValues->Num()); ++Index)
+	{
+		TestEqual(TEXT("Paged order matches full list"), PagedClassPaths[Index], (*FullClassValues)[Index]->AsObject()->GetStringField(TEXT("class_path")));
+	}
+
+	FString FirstPageResponseJson;
+	bool bFirstPageSuccess = false;
+	ExecuteMCPRequest(MakeRequestEnvelope(TEXT("umg.widget.class.list"), TEXT("{\"name_glob\":\"*\",\"limit\":1}")), FirstPageResponseJson, bFirstPageSuccess);
+	TSharedPtr<FJsonObject> FirstPageResponseObject;
+	const TSharedPtr<FJsonObject>* FirstPageResultObject = nullptr;
+	FString FirstPageCursor;
+	if (ParseJsonObject(FirstPageResponseJson, FirstPageResponseObject)
+		&& FirstPageResponseObject->TryGetObjectField(TEXT("result"), FirstPageResultObject)
+		&& (*FirstPageResultObject)->TryGetStringField(TEXT("next_cursor"), FirstPageCursor))
+	{
+		FString MismatchResponseJson;
+		bool bMismatchSuccess = true;
+		ExecuteMCPRequest(
+			MakeRequestEnvelope(
+				TEXT("umg.widget.class.list"),
+				FString::Printf(TEXT("{\"name_glob\":\"*Button*\",\"cursor\":\"%s\"}"), *FirstPageCursor)),
+			MismatchResponseJson,
+			bMismatchSuccess);
+		TestFalse(TEXT("Cursor from a different query is rejected"), bMismatchSuccess);
+	}
+	else
+	{
+		AddError(TEXT("First class list page should return next_cursor."));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChangeSetIndexAutomationTest,
+	"UnrealMCP.Runtime.ChangeSetIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChangeSetIndexAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>() : nullptr;
+	TestNotNull(TEXT("ChangeSet subsystem should exist"), ChangeSetSubsystem);
+	if (ChangeSetSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FString SessionId = FString::Printf(TEXT("changeset-index-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	TArray<FString> CreatedIds;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		FMCPRequestEnvelope Request;
+		Request.RequestId = FString::Printf(TEXT("%s-%d"), *SessionId, Index);
+		Request.SessionId = SessionId;
+		Request.Tool = Index == 1 ? TEXT("test.changeset_index.other") : TEXT("test.changeset_index.write");
+
+		FMCPToolExecutionResult Result;
+		Result.Status = EMCPResponseStatus::Ok;
+
+		// The last record asks for a synchronous write; the others go through the background writer.
+		Request.Context.Durability = Index == 2 ? TEXT("sync") : TEXT("async");
+
+		FString ChangeSetId;
+		FMCPChangeSetRecordStats Stats;
+		FMCPDiagnostic Diagnostic;
+		TestTrue(TEXT("CreateChangeSetRecord should succeed"), ChangeSetSubsystem->CreateChangeSetRecord(Request, Result, TEXT("test"), TEXT("test"), TArray<FMCPPackageSnapshot>(), ChangeSetId, Stats, Diagnostic));
+		TestTrue(TEXT("Changeset record bytes are counted"), Stats.ApproximateBytes > 0);
+		CreatedIds.Add(ChangeSetId);
+
+		if (Index == 2)
+		{
+			TestTrue(TEXT("Sync durability reports a durable record"), Stats.bDurable);
+			TestTrue(TEXT("Sync durability writes meta.json before returning"),
+				IFileManager::Get().FileExists(*FPaths::Combine(ChangeSetSubsystem->GetChangeSetRootDir(), ChangeSetId, TEXT("meta.json"))));
+		}
+	}
+	ChangeSetSubsystem->FlushPendingWrites();
+	TestEqual(TEXT("Changeset writer queue drains"), ChangeSetSubsystem->GetPendingWriteCount(), 0);
+	TestTrue(TEXT("Changeset index file should exist"), IFileManager::Get().FileExists(*ChangeSetSubsystem->GetChangeSetIndexPath()));
+
+	FMCPChangeSetListQuery Query;
+	Query.SessionId = SessionId;
+	Query.Limit = 2;
+
+	TArray<TSharedPtr<FJsonObject>> FirstPage;
+	FString NextSortKey;
+	FMCPDiagnostic ListDiagnostic;
+	TestTrue(TEXT("ListChangeSets first page should succeed"), ChangeSetSubsystem->ListChangeSets(Query, FirstPage, NextSortKey, ListDiagnostic));
+	TestEqual(TEXT("First page respects limit"), FirstPage.Num(), 2);
+	TestFalse(TEXT("First page reports more results"), NextSortKey.IsEmpty());
+
+	FString NewestId;
+	if (FirstPage.Num() > 0)
+	{
+		FirstPage[0]->TryGetStringField(TEXT("changeset_id"), NewestId);
+	}
+	TestEqual(TEXT("Newest changeset is listed first"), NewestId, CreatedIds.Last());
+
+	Query.AfterSortKey = NextSortKey;
+	TArray<TSharedPtr<FJsonObject>> SecondPage;
+	TestTrue(TEXT("ListChangeSets second page should succeed"), ChangeSetSubsystem->ListChangeSets(Query, SecondPage, NextSortKey, ListDiagnostic));
+	TestEqual(TEXT("Second page holds the remaining changeset"), SecondPage.Num(), 1);
+	TestTrue(TEXT("Second page is the last page"), NextSortKey.IsEmpty());
+
+	FString OldestId;
+	if (SecondPage.Num() > 0)
+	{
+		SecondPage[0]->TryGetStringField(TEXT("changeset_id"), OldestId);
+	}
+	TestEqual(TEXT("Oldest changeset is listed last"), OldestId, CreatedIds[0]);
+
+	FMCPChangeSetListQuery ToolQuery;
+	ToolQuery.SessionId = SessionId;
+	ToolQuery.ToolGlob = TEXT("test.changeset_index.w*");
+	ToolQuery.StatusFilter.Add(TEXT("ok"));
+	TArray<TSharedPtr<FJsonObject>> ToolItems;
+	TestTrue(TEXT("ListChangeSets with filters should succeed"), ChangeSetSubsystem->ListChangeSets(ToolQuery, ToolItems, NextSortKey, ListDiagnostic));
+	TestEqual(TEXT("Tool glob and status filters apply"), ToolItems.Num(), 2);
+
+	FString ListResponseJson;
+	bool bListSuccess = false;
+	const FString ListParamsJson = FString::Printf(TEXT("{\"session_id\":\"%s\",\"limit\":1}"), *SessionId);
+	TestTrue(TEXT("Execute changeset.list request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("changeset.list"), ListParamsJson), ListResponseJson, bListSuccess));
+	TestTrue(TEXT("changeset.list status should be success"), bListSuccess);
+
+	TSharedPtr<FJsonObject> ListResponseObject;
+	TestTrue(TEXT("Parse changeset.list response"), ParseJsonObject(ListResponseJson, ListResponseObject));
+	const TSharedPtr<FJsonObject>* ListResultObject = nullptr;
+	TestTrue(TEXT("changeset.list has result"), ListResponseObject.IsValid() && ListResponseObject->TryGetObjectField(TEXT("result"), ListResultObject));
+	FString NextCursor;
+	TestTrue(TEXT("changeset.list returns an opaque next_cursor"),
+		ListResultObject != nullptr && (*ListResultObject)->TryGetStringField(TEXT("next_cursor"), NextCursor) && NextCursor.StartsWith(TEXT("c1.")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPSnapshotStoreAutomationTest,
+	"UnrealMCP.Runtime.SnapshotStore",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPSnapshotStoreAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPSnapshotStoreSubsystem* SnapshotStore = GEditor ? GEditor->GetEditorSubsystem<UMCPSnapshotStoreSubsystem>() : nullptr;
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>() : nullptr;
+	TestNotNull(TEXT("Snapshot store subsystem should exist"), SnapshotStore);
+	TestNotNull(TEXT("ChangeSet subsystem should exist"), ChangeSetSubsystem);
+	if (SnapshotStore == nullptr || ChangeSetSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FString TestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	const FString WorkDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/Automation"), TestId));
+	const FString FirstFile = FPaths::Combine(WorkDir, TEXT("First.uasset"));
+	const FString SecondFile = FPaths::Combine(WorkDir, TEXT("Second.uasset"));
+	const FString OriginalContent = FString::Printf(TEXT("snapshot-store-%s"), *TestId);
+	TestTrue(TEXT("Write first package file"), FFileHelper::SaveStringToFile(OriginalContent, *FirstFile));
+	TestTrue(TEXT("Write second package file"), FFileHelper::SaveStringToFile(OriginalContent, *SecondFile));
+
+	FString FirstHash;
+	FString SecondHash;
+	FString RepeatHash;
+	int64 SizeBytes = 0;
+	TestTrue(TEXT("Store first file"), SnapshotStore->StoreFile(FirstFile, FirstHash, SizeBytes));
+	TestTrue(TEXT("Store second file"), SnapshotStore->StoreFile(SecondFile, SecondHash, SizeBytes));
+	TestTrue(TEXT("Store unchanged first file again"), SnapshotStore->StoreFile(FirstFile, RepeatHash, SizeBytes));
+	TestEqual(TEXT("Identical contents share one blob"), SecondHash, FirstHash);
+	TestEqual(TEXT("Unchanged file resolves to the same blob"), RepeatHash, FirstHash);
+	TestTrue(TEXT("Blob exists in the store"), SnapshotStore->HasBlob(FirstHash));
+
+	FString RelativeFilename = FirstFile;
+	FPaths::MakePathRelativeTo(RelativeFilename, *FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()));
+
+	FMCPPackageSnapshot Snapshot;
+	Snapshot.PackageName = FString::Printf(TEXT("/Game/MCPAutomation/Snapshot_%s"), *TestId);
+	Snapshot.RelativeFilename = RelativeFilename;
+	Snapshot.BlobHash = FirstHash;
+	Snapshot.SizeBytes = SizeBytes;
+
+	FMCPRequestEnvelope Request;
+	Request.RequestId = FString::Printf(TEXT("snapshot-store-%s"), *TestId);
+	Request.Tool = TEXT("test.snapshot_store.write");
+	FMCPToolExecutionResult Result;
+	Result.TouchedPackages.Add(Snapshot.PackageName);
+
+	FString ChangeSetId;
+	FMCPChangeSetRecordStats Stats;
+	FMCPDiagnostic Diagnostic;
+	TestTrue(TEXT("CreateChangeSetRecord with snapshots should succeed"),
+		ChangeSetSubsystem->CreateChangeSetRecord(Request, Result, TEXT("test"), TEXT("test"), { Snapshot }, ChangeSetId, Stats, Diagnostic));
+	TestEqual(TEXT("Snapshot refs are counted"), Stats.SnapshotCount, 1);
+
+	TSharedPtr<FJsonObject> PreviewObject;
+	TestTrue(TEXT("PreviewRollback should succeed"), ChangeSetSubsystem->PreviewRollback(ChangeSetId, TEXT("local_snapshot"), PreviewObject, Diagnostic));
+	const TSharedPtr<FJsonObject>* ImpactObject = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* MissingSnapshots = nullptr;
+	TestTrue(TEXT("Preview has impact"), PreviewObject.IsValid() && PreviewObject->TryGetObjectField(TEXT("impact"), ImpactObject));
+	TestTrue(TEXT("Preview reports no missing snapshots"),
+		ImpactObject != nullptr && (*ImpactObject)->TryGetArrayField(TEXT("missing_snapshots"), MissingSnapshots) && MissingSnapshots->Num() == 0);
+
+	TestTrue(TEXT("Modify package file after the write"), FFileHelper::SaveStringToFile(TEXT("modified"), *FirstFile));
+
+	TArray<FString> RolledBackPackages;
+	bool bApplied = false;
+	TestTrue(TEXT("ApplyRollback should succeed"), ChangeSetSubsystem->ApplyRollback(ChangeSetId, TEXT("local_snapshot"), false, RolledBackPackages, bApplied, Diagnostic));
+	TestTrue(TEXT("ApplyRollback reports applied"), bApplied);
+	TestEqual(TEXT("ApplyRollback restores the touched package"), RolledBackPackages.Num(), 1);
+
+	FString RestoredContent;
+	TestTrue(TEXT("Read restored package file"), FFileHelper::LoadFileToString(RestoredContent, *FirstFile));
+	TestEqual(TEXT("Package file holds its pre-write contents"), RestoredContent, OriginalContent);
+
+	IFileManager::Get().DeleteDirectory(*WorkDir, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChangeSetJournalAutomationTest,
+	"UnrealMCP.Runtime.ChangeSetJournal",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChangeSetJournalAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	const FString TestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	const FString JournalDir = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UnrealMCP/Automation"), TestId));
+	const FString FirstPayload = FString::Printf(TEXT("{\"changeset_id\":\"first-%s\",\"pad\":\"%s\"}"), *TestId, *FString::ChrN(40 * 1024, TEXT('a')));
+	const FString SecondPayload = FString::Printf(TEXT("{\"changeset_id\":\"second-%s\",\"pad\":\"%s\"}"), *TestId, *FString::ChrN(40 * 1024, TEXT('b')));
+	const FString ThirdPayload = FString::Printf(TEXT("{\"changeset_id\":\"third-%s\"}"), *TestId);
+
+	{
+		FMCPChangeSetJournal Journal(JournalDir, 64 * 1024);
+		FMCPJournalRecordLocation FirstLocation;
+		FMCPJournalRecordLocation SecondLocation;
+		TestTrue(TEXT("Append first record"), Journal.Append(FirstPayload, FirstLocation));
+		TestTrue(TEXT("Append second record"), Journal.Append(SecondPayload, SecondLocation));
+		TestTrue(TEXT("Flush journal"), Journal.Flush());
+		TestNotEqual(TEXT("A full segment rolls over to the next one"), SecondLocation.SegmentId, FirstLocation.SegmentId);
+
+		FString ReadPayload;
+		TestTrue(TEXT("Read first record"), Journal.Read(FirstLocation, ReadPayload));
+		TestEqual(TEXT("First record round-trips"), ReadPayload, FirstPayload);
+		TestTrue(TEXT("Read second record from the active segment"), Journal.Read(SecondLocation, ReadPayload));
+		TestEqual(TEXT("Second record round-trips"), ReadPayload, SecondPayload);
+
+		Journal.Seal();
+		FMCPJournalRecordLocation ThirdLocation;
+		TestTrue(TEXT("Append after seal"), Journal.Append(ThirdPayload, ThirdLocation));
+		TestTrue(TEXT("Flush journal after seal"), Journal.Flush());
+		TestTrue(TEXT("Sealing starts a new segment"), ThirdLocation.SegmentId > SecondLocation.SegmentId);
+
+		int32 ScannedRecords = 0;
+		Journal.ForEachRecord([&ScannedRecords](const FMCPJournalRecordLocation&, const FString&)
+		{
+			++ScannedRecords;
+		});
+		TestEqual(TEXT("Scan visits every record"), ScannedRecords, 3);
+
+		TestFalse(TEXT("The active segment cannot be deleted"), Journal.DeleteSegment(ThirdLocation.SegmentId));
+		TestTrue(TEXT("A sealed segment can be deleted"), Journal.DeleteSegment(FirstLocation.SegmentId));
+		TestFalse(TEXT("Records in a deleted segment are gone"), Journal.Read(FirstLocation, ReadPayload));
+		TestEqual(TEXT("Deleted segment is no longer listed"), Journal.GetSegmentIds().Num(), 2);
+	}
+
+	{
+		// A later session appends to a fresh segment and still reads earlier ones.
+		FMCPChangeSetJournal ReopenedJournal(JournalDir, 64 * 1024);
+		int32 ScannedRecords = 0;
+		ReopenedJournal.ForEachRecord([&ScannedRecords](const FMCPJournalRecordLocation&, const FString&)
+		{
+			++ScannedRecords;
+		});
+		TestEqual(TEXT("Reopened journal scans surviving records"), ScannedRecords, 2);
+	}
+
+	IFileManager::Get().DeleteDirectory(*JournalDir, false, true);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChangeSetRetentionAutomationTest,
+	"UnrealMCP.Runtime.ChangeSetRetention",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChangeSetRetentionAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>() : nullptr;
+	TestNotNull(TEXT("ChangeSet subsystem should exist"), ChangeSetSubsystem);
+	if (ChangeSetSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const FString SessionId = FString::Printf(TEXT("changeset-retention-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	TArray<FString> CreatedIds;
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		FMCPRequestEnvelope Request;
+		Request.RequestId = FString::Printf(TEXT("%s-%d"), *SessionId, Index);
+		Request.SessionId = SessionId;
+		Request.Tool = TEXT("test.changeset_retention.write");
+		Request.Context.Durability = TEXT("sync");
+
+		FMCPToolExecutionResult Result;
+		Result.Status = EMCPResponseStatus::Ok;
+
+		FString ChangeSetId;
+		FMCPChangeSetRecordStats Stats;
+		FMCPDiagnostic Diagnostic;
+		TestTrue(TEXT("CreateChangeSetRecord should succeed"), ChangeSetSubsystem->CreateChangeSetRecord(Request, Result, TEXT("test"), TEXT("test"), TArray<FMCPPackageSnapshot>(), ChangeSetId, Stats, Diagnostic));
+		CreatedIds.Add(ChangeSetId);
+	}
+	if (CreatedIds.Num() != 3)
+	{
+		return false;
+	}
+
+	const FString& PinnedId = CreatedIds[0];
+	const FString& UnpinnedId = CreatedIds[1];
+	const FString& NewestId = CreatedIds[2];
+	FMCPDiagnostic PinDiagnostic;
+	TestFalse(TEXT("Unknown changesets cannot be pinned"), ChangeSetSubsystem->SetChangeSetPinned(TEXT("cs-missing"), true, PinDiagnostic));
+	TestEqual(TEXT("Pinning an unknown changeset reports not found"), PinDiagnostic.Code, FString(TEXT("MCP.CHANGESET.NOT_FOUND")));
+	TestTrue(TEXT("Pin the older changeset"), ChangeSetSubsystem->SetChangeSetPinned(PinnedId, true, PinDiagnostic));
+	TestTrue(TEXT("Pinned changeset reports pinned"), ChangeSetSubsystem->IsChangeSetPinned(PinnedId));
+
+	FString PinResponseJson;
+	bool bPinSuccess = false;
+	const FString PinParamsJson = FString::Printf(TEXT("{\"changeset_id\":\"%s\"}"), *PinnedId);
+	TestTrue(TEXT("Execute changeset.unpin request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("changeset.unpin"), PinParamsJson), PinResponseJson, bPinSuccess));
+	TestTrue(TEXT("changeset.unpin status should be success"), bPinSuccess);
+	TestFalse(TEXT("changeset.unpin clears the pin"), ChangeSetSubsystem->IsChangeSetPinned(PinnedId));
+	TestTrue(TEXT("Execute changeset.pin request"), ExecuteMCPRequest(MakeRequestEnvelope(TEXT("changeset.pin"), PinParamsJson), PinResponseJson, bPinSuccess));
+	TestTrue(TEXT("changeset.pin status should be success"), bPinSuccess);
+	TestTrue(TEXT("changeset.pin sets the pin"), ChangeSetSubsystem->IsChangeSetPinned(PinnedId));
+
+	// A count limit of one leaves only the newest unpinned changeset; pinned ones are kept on top of it.
+	FMCPChangeSetRetentionPolicy Policy;
+	Policy.MaxAgeDays = 0;
+	Policy.MaxCount = 1;
+	Policy.MaxBytes = 0;
+	Policy.bKeepPinned = true;
+	TArray<FString> PlannedIds;
+	ChangeSetSubsystem->PlanGarbageCollection(Policy, PlannedIds);
+	TestFalse(TEXT("GC plan keeps the pinned changeset"), PlannedIds.Contains(PinnedId));
+	TestTrue(TEXT("GC plan selects the unpinned changeset"), PlannedIds.Contains(UnpinnedId));
+	TestFalse(TEXT("Pinned changesets do not use up the count limit"), PlannedIds.Contains(NewestId));
+
+	Policy.bKeepPinned = false;
+	ChangeSetSubsystem->PlanGarbageCollection(Policy, PlannedIds);
+	TestTrue(TEXT("GC plan without keep-pinned selects the older changeset"), PlannedIds.Contains(PinnedId));
+
+	FMCPChangeSetGCStats GCStats;
+	ChangeSetSubsystem->DeleteChangeSets({ UnpinnedId }, GCStats);
+	TestEqual(TEXT("GC deletes the selected changeset"), GCStats.DeletedChangeSets, 1);
+
+	TSharedPtr<FJsonObject> ChangeSetObject;
+	FMCPDiagnostic Diagnostic;
+	TestFalse(TEXT("Deleted changeset is gone"), ChangeSetSubsystem->GetChangeSet(UnpinnedId, false, false, ChangeSetObject, Diagnostic));
+	TestTrue(TEXT("Pinned changeset survives"), ChangeSetSubsystem->GetChangeSet(PinnedId, false, false, ChangeSetObject, Diagnostic));
+
+	FMCPChangeSetListQuery Query;
+	Query.SessionId = SessionId;
+	TArray<TSharedPtr<FJsonObject>> Items;
+	FString NextSortKey;
+	TestTrue(TEXT("ListChangeSets should succeed"), ChangeSetSubsystem->ListChangeSets(Query, Items, NextSortKey, Diagnostic));
+	TestEqual(TEXT("Index no longer lists the deleted changeset"), Items.Num(), 2);
+
+	ChangeSetSubsystem->DeleteChangeSets({ PinnedId, NewestId }, GCStats);
+	TestFalse(TEXT("Deleting a changeset drops its pin"), ChangeSetSubsystem->IsChangeSetPinned(PinnedId));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChangeSetJournalTombstoneAutomationTest,
+	"UnrealMCP.Runtime.ChangeSetJournalTombstone",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChangeSetJournalTombstoneAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>() : nullptr;
+	TestNotNull(TEXT("ChangeSet subsystem should exist"), ChangeSetSubsystem);
+	if (ChangeSetSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const bool bWasJournalStorage = ChangeSetSubsystem->IsJournalStorage();
+	ChangeSetSubsystem->SetJournalStorage(true);
+
+	const FString SessionId = FString::Printf(TEXT("changeset-tombstone-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	TArray<FString> CreatedIds;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FMCPRequestEnvelope Request;
+		Request.RequestId = FString::Printf(TEXT("%s-%d"), *SessionId, Index);
+		Request.SessionId = SessionId;
+		Request.Tool = TEXT("test.changeset_tombstone.write");
+		Request.Context.Durability = TEXT("sync");
+
+		FMCPToolExecutionResult Result;
+		Result.Status = EMCPResponseStatus::Ok;
+
+		FString ChangeSetId;
+		FMCPChangeSetRecordStats Stats;
+		FMCPDiagnostic Diagnostic;
+		TestTrue(TEXT("CreateChangeSetRecord should succeed"), ChangeSetSubsystem->CreateChangeSetRecord(Request, Result, TEXT("test"), TEXT("test"), TArray<FMCPPackageSnapshot>(), ChangeSetId, Stats, Diagnostic));
+		CreatedIds.Add(ChangeSetId);
+	}
+	ChangeSetSubsystem->SetJournalStorage(bWasJournalStorage);
+	if (CreatedIds.Num() != 2)
+	{
+		return false;
+	}
+
+	const FString& DeletedId = CreatedIds[0];
+	const FString& KeptId = CreatedIds[1];
+	FMCPChangeSetGCStats GCStats;
+	ChangeSetSubsystem->DeleteChangeSets({ DeletedId }, GCStats);
+	TestEqual(TEXT("GC deletes the journaled changeset"), GCStats.DeletedChangeSets, 1);
+
+	// The deleted record is still in its segment; the tombstone keeps a rebuild from listing it again.
+	ChangeSetSubsystem->RebuildIndex();
+
+	TSharedPtr<FJsonObject> ChangeSetObject;
+	FMCPDiagnostic Diagnostic;
+	TestFalse(TEXT("Deleted changeset stays gone after a rebuild"), ChangeSetSubsystem->GetChangeSet(DeletedId, false, false, ChangeSetObject, Diagnostic));
+	TestTrue(TEXT("Kept changeset survives the rebuild"), ChangeSetSubsystem->GetChangeSet(KeptId, false, false, ChangeSetObject, Diagnostic));
+
+	FMCPChangeSetListQuery Query;
+	Query.SessionId = SessionId;
+	TArray<TSharedPtr<FJsonObject>> Items;
+	FString NextSortKey;
+	TestTrue(TEXT("ListChangeSets should succeed"), ChangeSetSubsystem->ListChangeSets(Query, Items, NextSortKey, Diagnostic));
+	TestEqual(TEXT("Rebuilt index lists only the kept changeset"), Items.Num(), 1);
+
+	ChangeSetSubsystem->DeleteChangeSets({ KeptId }, GCStats);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPChangeSetJournalCompactSealedAutomationTest,
+	"UnrealMCP.Runtime.ChangeSetJournalCompactSealed",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPChangeSetJournalCompactSealedAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPChangeSetSubsystem* ChangeSetSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPChangeSetSubsystem>() : nullptr;
+	TestNotNull(TEXT("ChangeSet subsystem should exist"), ChangeSetSubsystem);
+	if (ChangeSetSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	const bool bWasJournalStorage = ChangeSetSubsystem->IsJournalStorage();
+	ChangeSetSubsystem->SetJournalStorage(true);
+
+	const FString SessionId = FString::Printf(TEXT("changeset-compact-sealed-%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits));
+	TArray<FString> CreatedIds;
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FMCPRequestEnvelope Request;
+		Request.RequestId = FString::Printf(TEXT("%s-%d"), *SessionId, Index);
+		Request.SessionId = SessionId;
+		Request.Tool = TEXT("test.changeset_compact_sealed.write");
+		Request.Context.Durability = TEXT("sync");
+
+		FMCPToolExecutionResult Result;
+		Result.Status = EMCPResponseStatus::Ok;
+
+		FString ChangeSetId;
+		FMCPChangeSetRecordStats Stats;
+		FMCPDiagnostic Diagnostic;
+		TestTrue(TEXT("CreateChangeSetRecord should succeed"), ChangeSetSubsystem->CreateChangeSetRecord(Request, Result, TEXT("test"), TEXT("test"), TArray<FMCPPackageSnapshot>(), ChangeSetId, Stats, Diagnostic));
+		CreatedIds.Add(ChangeSetId);
+	}
+	ChangeSetSubsystem->SetJournalStorage(bWasJournalStorage);
+	if (CreatedIds.Num() != 2)
+	{
+		return false;
+	}
+
+	// Both records and their tombstones share the active segment, which GC leaves alone until it is sealed.
+	FMCPChangeSetGCStats GCStats;
+	ChangeSetSubsystem->DeleteChangeSets(CreatedIds, GCStats);
+	TestEqual(TEXT("GC deletes both journaled changesets"), GCStats.DeletedChangeSets, 2);
+	ChangeSetSubsystem->SealJournal();
+
+	const auto CollectTombstoneSegments = [ChangeSetSubsystem, &CreatedIds](TMap<FString, int32>& OutRecordSegments)
+	{
+		OutRecordSegments.Reset();
+		FMCPChangeSetJournal Reader(ChangeSetSubsystem->GetChangeSetJournalDir(), 64 * 1024);
+		Reader.ForEachRecord([&CreatedIds, &OutRecordSegments](const FMCPJournalRecordLocation&, const FString& Payload)
+		{
+			TSharedPtr<FJsonObject> TombstoneObject;
+			bool bTombstone = false;
+			FString ChangeSetId;
+			double RecordSegmentId = 0.0;
+			if (ParseJsonObject(Payload, TombstoneObject)
+				&& TombstoneObject->TryGetBoolField(TEXT("tombstone"), bTombstone) && bTombstone
+				&& TombstoneObject->TryGetStringField(TEXT("changeset_id"), ChangeSetId) && CreatedIds.Contains(ChangeSetId)
+				&& TombstoneObject->TryGetNumberField(TEXT("record_segment"), RecordSegmentId))
+			{
+				OutRecordSegments.Add(ChangeSetId, static_cast<int32>(RecordSegmentId));
+			}
+		});
+		return Reader.GetSegmentIds();
+	};
+
+	TMap<FString, int32> RecordSegments;
+	CollectTombstoneSegments(RecordSegments);
+	TestEqual(TEXT("Both deletions are tombstoned"), RecordSegments.Num(), 2);
+	if (RecordSegments.Num() != 2)
+	{
+		return false;
+	}
+	const int32 RecordSegmentId = RecordSegments.FindChecked(CreatedIds[0]);
+
+	int32 DeletedSegments = 0;
+	int64 ReclaimedBytes = 0;
+	ChangeSetSubsystem->CompactJournal(DeletedSegments, ReclaimedBytes);
+
+	TMap<FString, int32> CarriedRecordSegments;
+	const TArray<int32> RemainingSegmentIds = CollectTombstoneSegments(CarriedRecordSegments);
+	TestFalse(TEXT("The sealed segment with no live records is dropped"), RemainingSegmentIds.Contains(RecordSegmentId));
+
+	// A tombstone is only worth carrying while an older retained segment could still hold its record.
+	const bool bOlderSegmentRetained = RemainingSegmentIds.ContainsByPredicate([RecordSegmentId](const int32 SegmentId)
+	{
+		return SegmentId < RecordSegmentId;
+	});
+	if (!bOlderSegmentRetained)
+	{
+		TestEqual(TEXT("Tombstones for a dropped segment are discarded when nothing older is retained"), CarriedRecordSegments.Num(), 0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FMCPTransportRequestOrderAutomationTest,
+	"UnrealMCP.Runtime.TransportRequestOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMCPTransportRequestOrderAutomationTest::RunTest(const FString& Parameters)
+{
+	(void)Parameters;
+
+	UMCPWebSocketTransportSubsystem* TransportSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPWebSocketTransportSubsystem>() : nullptr;
+	UMCPEventStreamSubsystem* EventStreamSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPEventStreamSubsystem>() : nullptr;
+	TestNotNull(TEXT("Transport subsystem should exist"), TransportSubsystem);
+	TestNotNull(TEXT("EventStream subsystem should exist"), EventStreamSubsystem);
+	if (TransportSubsystem == nullptr || EventStreamSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	// Connection ids no socket uses; responses to them are dropped and execution order is read from the
+	// "Received request" log each request emits when it starts.
+	TArray<FString> QueuedRequestIds;
+	const auto Enqueue = [this, TransportSubsystem, &QueuedRequestIds](const uint16 ConnectionId, const FString& RequestJson)
+	{
+		TSharedPtr<FJsonObject> RequestEnvelope;
+		FString RequestId;
+		if (!TestTrue(TEXT("Parse request envelope"), ParseJsonObject(RequestJson, RequestEnvelope))
+			|| !RequestEnvelope->TryGetStringField(TEXT("request_id"), RequestId))
+		{
+			return FString();
+		}
+
+		TSharedPtr<FJsonObject> MessageObject = MakeShared<FJsonObject>();
+		MessageObject->SetStringField(TEXT("type"), TEXT("mcp.request"));
+		MessageObject->SetObjectField(TEXT("request"), RequestEnvelope);
+		TransportSubsystem->EnqueueRequest(ConnectionId, MessageObject);
+		QueuedRequestIds.Add(RequestId);
+		return RequestId;
+	};
+
+	const FString ReadJson = TEXT("{\"include_schemas\":false}");
+	const FString WriteJson = TEXT("{\"packages\":[]}");
+	const int64 AfterSequence = EventStreamSubsystem->GetLatestSequence();
+	const int32 QueuedBefore = TransportSubsystem->GetQueuedRequestCount();
+
+	// Connection 1 sends a write then a read; connection 2 sends a read after both.
+	// Connection 3 sends a read then a write.
+	const FString WriteOne = Enqueue(64001, MakeRequestEnvelope(TEXT("asset.save"), WriteJson));
+	const FString ReadOne = Enqueue(64001, MakeRequestEnvelope(TEXT("tools.list"), ReadJson));
+	const FString ReadTwo = Enqueue(64002, MakeRequestEnvelope(TEXT("tools.list"), ReadJson));
+	const FString ReadThree = Enqueue(64003, MakeRequestEnvelope(TEXT("tools.list"), ReadJson));
+	const FString WriteThree = Enqueue(64003, MakeRequestEnvelope(TEXT("asset.save"), WriteJson));
+	if (QueuedRequestIds.Num() != 5)
+	{
+		return false;
+	}
+	TestEqual(TEXT("All requests are queued"), TransportSubsystem->GetQueuedRequestCount(), QueuedBefore + 5);
+
+	for (int32 Pass = 0; Pass < 16 && TransportSubsystem->GetQueuedRequestCount() > QueuedBefore; ++Pass)
+	{
+		TransportSubsystem->DispatchQueuedRequests();
+	}
+	TestEqual(TEXT("Dispatch drains the queued requests"), TransportSubsystem->GetQueuedRequestCount(), QueuedBefore);
+
+	TArray<FString> ExecutedRequestIds;
+	bool bGap = false;
+	for (const TSharedPtr<FJsonObject>& EventObject : EventStreamSubsystem->GetEventsAfter(AfterSequence, MAX_int32, bGap))
+	{
+		FString EventType;
+		FString RequestId;
+		const TSharedPtr<FJsonObject>* PayloadObject = nullptr;
+		FString Message;
+		if (EventObject.IsValid()
+			&& EventObject->TryGetStringField(TEXT("event_type"), EventType) && EventType == TEXT("event.log")
+			&& EventObject->TryGetStringField(TEXT("request_id"), RequestId) && QueuedRequestIds.Contains(RequestId)
+			&& EventObject->TryGetObjectField(TEXT("payload"), PayloadObject) && PayloadObject != nullptr
+			&& (*PayloadObject)->TryGetStringField(TEXT("message"), Message) && Message.StartsWith(TEXT("Received request")))
+		{
+			ExecutedRequestIds.Add(RequestId);
+		}
+	}
+	TestFalse(TEXT("Event ring kept every request start"), bGap);
+	TestEqual(TEXT("Every queued request ran once"), ExecutedRequestIds.Num(), 5);
+
+	const int32 WriteOneIndex = ExecutedRequestIds.IndexOfByKey(WriteOne);
+	const int32 ReadOneIndex = ExecutedRequestIds.IndexOfByKey(ReadOne);
+	const int32 ReadTwoIndex = ExecutedRequestIds.IndexOfByKey(ReadTwo);
+	const int32 ReadThreeIndex = ExecutedRequestIds.IndexOfByKey(ReadThree);
+	const int32 WriteThreeIndex = ExecutedRequestIds.IndexOfByKey(WriteThree);
+	TestTrue(TEXT("Read from another connection may pass the queued write"), ReadTwoIndex < WriteOneIndex);
+	TestTrue(TEXT("Write runs before the later read on its own connection"), WriteOneIndex < ReadOneIndex);
+	TestTrue(TEXT("Earlier read on the same connection runs before the write"), ReadThreeIndex < WriteThreeIndex);
+	TestTrue(TEXT("Writes keep their arrival order across connections"), WriteOneIndex < WriteThreeIndex);
+	return true;
+}
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
 	FMCPSystemHealthTelemetryAutomationTest,
 	"UnrealMCP.Runtime.SystemHealthTelemetry",
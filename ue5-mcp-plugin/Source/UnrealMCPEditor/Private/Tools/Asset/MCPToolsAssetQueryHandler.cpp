@@ -1,30 +1,33 @@
 #include "Tools/Asset/MCPToolsAssetQueryHandler.h"
 
+#include "Editor.h"
+#include "MCPAssetIndexSubsystem.h"
 #include "MCPErrorCodes.h"
 #include "Tools/Common/MCPToolCommonJson.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "AssetRegistry/IAssetRegistry.h"
+#include "Tools/Common/MCPToolPaging.h"
 #include "FileHelpers.h"
 #include "Modules/ModuleManager.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
 
-namespace
-{
-	bool MatchesAnyClassPath(const TSet<FString>& AllowedClassPaths, const FString& ClassPath)
-	{
-		return AllowedClassPaths.Num() == 0 || AllowedClassPaths.Contains(ClassPath);
-	}
-}
-
 bool FMCPToolsAssetQueryHandler::HandleFind(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
 {
 	FString PathGlob = TEXT("/Game/**");
 	FString NameGlob;
 	int32 Limit = 50;
-	const int32 Cursor = MCPToolCommonJson::ParseCursor(Request.Params);
 	TSet<FString> AllowedClassPaths;
 
+	FMCPPageCursor Cursor;
+	FMCPDiagnostic CursorDiagnostic;
+	const uint32 QueryHash = MCPToolPaging::ComputeQueryHash(Request.Tool, Request.Params);
+	if (!MCPToolPaging::ParseCursor(Request.Params, Cursor, CursorDiagnostic)
+		|| !MCPToolPaging::ValidateCursorQuery(Cursor, QueryHash, CursorDiagnostic))
+	{
+		OutResult.Diagnostics.Add(CursorDiagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
 	if (Request.Params.IsValid())
 	{
 		Request.Params->TryGetStringField(TEXT("path_glob"), PathGlob);
@@ -47,67 +50,86 @@ bool FMCPToolsAssetQueryHandler::HandleFind(const FMCPRequestEnvelope& Request,
 		}
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<FAssetData> AssetDataList;
-	AssetRegistry.GetAllAssets(AssetDataList, true);
-
-	TArray<TSharedPtr<FJsonObject>> FilteredAssets;
-	for (const FAssetData& AssetData : AssetDataList)
+	UMCPAssetIndexSubsystem* AssetIndex = GEditor ? GEditor->GetEditorSubsystem<UMCPAssetIndexSubsystem>() : nullptr;
+	if (AssetIndex == nullptr)
 	{
-		const FString ObjectPath = AssetData.GetObjectPathString();
-		const FString PackagePath = AssetData.PackagePath.ToString();
-		const FString ClassPath = AssetData.AssetClassPath.ToString();
-		const FString AssetName = AssetData.AssetName.ToString();
+		FMCPDiagnostic Diagnostic;
+		Diagnostic.Code = MCPErrorCodes::INTERNAL_EXCEPTION;
+		Diagnostic.Message = TEXT("Asset index subsystem is unavailable.");
+		OutResult.Diagnostics.Add(Diagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+	AssetIndex->PrepareForQuery();
+
+	FMCPAssetQuery Query;
+	Query.PathGlob = PathGlob;
+	Query.NameGlob = NameGlob;
+	Query.ClassPaths = MoveTemp(AllowedClassPaths);
+	// Opaque cursors resume after the last returned object path, so assets added between pages do not shift results.
+	if (Cursor.LastSortKey.IsEmpty())
+	{
+		Query.Offset = Cursor.Offset;
+	}
+	else
+	{
+		Query.AfterObjectPath = Cursor.LastSortKey;
+	}
+	Query.Limit = Limit;
 
-		if (!PathGlob.IsEmpty() && !ObjectPath.MatchesWildcard(PathGlob) && !PackagePath.MatchesWildcard(PathGlob))
+	// The index lookup only reads the prepared index, so it runs off the game thread for async jobs.
+	TWeakObjectPtr<UMCPAssetIndexSubsystem> WeakAssetIndex(AssetIndex);
+	OutResult.WorkerStage = [WeakAssetIndex, Query = MoveTemp(Query), QueryHash](FMCPToolExecutionResult& StageResult)
+	{
+		FMCPAssetQueryResult QueryResult;
+		bool bCompleted = true;
+		if (const UMCPAssetIndexSubsystem* StageAssetIndex = WeakAssetIndex.Get())
 		{
-			continue;
+			bCompleted = StageAssetIndex->Query(Query, QueryResult, [&StageResult]() { return StageResult.ShouldStop(); });
 		}
 
-		if (!NameGlob.IsEmpty() && !AssetName.MatchesWildcard(NameGlob))
+		TArray<TSharedPtr<FJsonValue>> ResultAssets;
+		ResultAssets.Reserve(QueryResult.Rows.Num());
+		for (const FMCPAssetQueryRow& Row : QueryResult.Rows)
 		{
-			continue;
+			TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+			AssetObject->SetStringField(TEXT("object_path"), Row.ObjectPath);
+			AssetObject->SetStringField(TEXT("class_path"), Row.ClassPath);
+			AssetObject->SetStringField(TEXT("package_path"), Row.PackagePath);
+			AssetObject->SetStringField(TEXT("name"), Row.AssetName);
+			ResultAssets.Add(MakeShared<FJsonValueObject>(AssetObject));
 		}
 
-		if (!MatchesAnyClassPath(AllowedClassPaths, ClassPath))
+		StageResult.ResultObject = MakeShared<FJsonObject>();
+		StageResult.ResultObject->SetArrayField(TEXT("assets"), ResultAssets);
+		// Rows from an interrupted scan are still a sorted prefix, so the cursor resumes after the last one.
+		if ((QueryResult.bHasMore || !bCompleted) && QueryResult.Rows.Num() > 0)
 		{
-			continue;
+			FMCPPageCursor NextCursor;
+			NextCursor.QueryHash = QueryHash;
+			NextCursor.LastSortKey = QueryResult.Rows.Last().ObjectPath;
+			StageResult.ResultObject->SetStringField(TEXT("next_cursor"), MCPToolPaging::EncodeCursor(NextCursor));
 		}
 
-		TSharedRef<FJsonObject> AssetObject = MakeShared<FJsonObject>();
-		AssetObject->SetStringField(TEXT("object_path"), ObjectPath);
-		AssetObject->SetStringField(TEXT("class_path"), ClassPath);
-		AssetObject->SetStringField(TEXT("package_path"), PackagePath);
-		AssetObject->SetStringField(TEXT("name"), AssetName);
-		FilteredAssets.Add(AssetObject);
-	}
-
-	FilteredAssets.Sort([](const TSharedPtr<FJsonObject>& Left, const TSharedPtr<FJsonObject>& Right)
-	{
-		FString LeftPath;
-		FString RightPath;
-		Left->TryGetStringField(TEXT("object_path"), LeftPath);
-		Right->TryGetStringField(TEXT("object_path"), RightPath);
-		return LeftPath < RightPath;
-	});
-
-	const int32 SafeCursor = FMath::Max(0, Cursor);
-	const int32 EndIndex = FMath::Min(SafeCursor + Limit, FilteredAssets.Num());
-
-	TArray<TSharedPtr<FJsonValue>> ResultAssets;
-	for (int32 Index = SafeCursor; Index < EndIndex; ++Index)
-	{
-		ResultAssets.Add(MakeShared<FJsonValueObject>(FilteredAssets[Index].ToSharedRef()));
-	}
+		if (!bCompleted)
+		{
+			const bool bCanceled = StageResult.Cancellation.IsValid() && StageResult.Cancellation->GetStopReason() == EMCPStopReason::Canceled;
+			FMCPDiagnostic StopDiagnostic;
+			StopDiagnostic.Code = bCanceled ? MCPErrorCodes::JOB_CANCELED : MCPErrorCodes::JOB_TIMEOUT;
+			StopDiagnostic.Severity = TEXT("warning");
+			StopDiagnostic.Message = bCanceled
+				? TEXT("asset.find was canceled before the index scan finished; results are partial.")
+				: TEXT("asset.find exceeded timeout_ms before the index scan finished; results are partial.");
+			StopDiagnostic.Detail = FString::Printf(TEXT("scanned=%d returned=%d"), QueryResult.ScannedCount, QueryResult.Rows.Num());
+			StopDiagnostic.Suggestion = TEXT("Narrow path_glob or class_path_in, or continue from next_cursor.");
+			StopDiagnostic.bRetriable = !bCanceled;
+			StageResult.Diagnostics.Add(StopDiagnostic);
+			StageResult.Status = EMCPResponseStatus::Partial;
+			return;
+		}
+		StageResult.Status = EMCPResponseStatus::Ok;
+	};
 
-	OutResult.ResultObject = MakeShared<FJsonObject>();
-	OutResult.ResultObject->SetArrayField(TEXT("assets"), ResultAssets);
-	if (EndIndex < FilteredAssets.Num())
-	{
-		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), FString::FromInt(EndIndex));
-	}
 	OutResult.Status = EMCPResponseStatus::Ok;
 	return true;
 }
@@ -5,28 +5,6 @@
 
 namespace MCPToolCommonJson
 {
-	int32 ParseCursor(const TSharedPtr<FJsonObject>& Params)
-	{
-		if (!Params.IsValid())
-		{
-			return 0;
-		}
-
-		FString CursorString;
-		if (Params->TryGetStringField(TEXT("cursor"), CursorString))
-		{
-			return FCString::Atoi(*CursorString);
-		}
-
-		double CursorNumber = 0;
-		if (Params->TryGetNumberField(TEXT("cursor"), CursorNumber))
-		{
-			return static_cast<int32>(CursorNumber);
-		}
-
-		return 0;
-	}
-
 	TArray<TSharedPtr<FJsonValue>> ToJsonStringArray(const TArray<FString>& Values)
 	{
 		TArray<TSharedPtr<FJsonValue>> OutValues;
@@ -0,0 +1,273 @@
+#include "Tools/Common/MCPToolPaging.h"
+
+#include "Algo/BinarySearch.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Editor.h"
+#include "MCPErrorCodes.h"
+#include "MCPPageSnapshotSubsystem.h"
+#include "Misc/Base64.h"
+#include "Misc/Crc.h"
+#include "Misc/Parse.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	const TCHAR* OpaqueCursorPrefix = TEXT("c1.");
+	constexpr TCHAR SortKeySeparator = TEXT('\x01');
+
+	bool IsSortKeyAfter(const FString& Key, const FString& LastSortKey, const bool bDescending)
+	{
+		const int32 Compare = Key.Compare(LastSortKey, ESearchCase::CaseSensitive);
+		return bDescending ? Compare < 0 : Compare > 0;
+	}
+
+	int32 FindResumeIndex(const FMCPPageSnapshot& Snapshot, const FString& LastSortKey)
+	{
+		return Algo::UpperBoundBy(Snapshot.SortKeys, LastSortKey, [](const FString& Key) -> const FString&
+		{
+			return Key;
+		}, [bDescending = Snapshot.bDescending](const FString& Left, const FString& Right)
+		{
+			return IsSortKeyAfter(Right, Left, bDescending);
+		});
+	}
+
+	void SortSnapshot(FMCPPageSnapshot& Snapshot)
+	{
+		if (Snapshot.SortKeys.Num() != Snapshot.Items.Num())
+		{
+			Snapshot.SortKeys.SetNum(Snapshot.Items.Num());
+		}
+
+		TArray<int32> Order;
+		Order.Reserve(Snapshot.Items.Num());
+		for (int32 Index = 0; Index < Snapshot.Items.Num(); ++Index)
+		{
+			Order.Add(Index);
+		}
+
+		Order.Sort([&Snapshot](const int32 Left, const int32 Right)
+		{
+			return IsSortKeyAfter(Snapshot.SortKeys[Right], Snapshot.SortKeys[Left], Snapshot.bDescending);
+		});
+
+		TArray<TSharedPtr<FJsonValue>> SortedItems;
+		TArray<FString> SortedKeys;
+		SortedItems.Reserve(Order.Num());
+		SortedKeys.Reserve(Order.Num());
+		for (const int32 Index : Order)
+		{
+			SortedItems.Add(MoveTemp(Snapshot.Items[Index]));
+			SortedKeys.Add(MoveTemp(Snapshot.SortKeys[Index]));
+		}
+		Snapshot.Items = MoveTemp(SortedItems);
+		Snapshot.SortKeys = MoveTemp(SortedKeys);
+	}
+
+	void SetInvalidCursorDiagnostic(FMCPDiagnostic& OutDiagnostic, const FString& Message, const FString& Detail)
+	{
+		OutDiagnostic.Code = MCPErrorCodes::SCHEMA_INVALID_PARAMS;
+		OutDiagnostic.Message = Message;
+		OutDiagnostic.Detail = Detail;
+		OutDiagnostic.Suggestion = TEXT("Restart paging without a cursor.");
+	}
+}
+
+namespace MCPToolPaging
+{
+	bool ParseCursor(const TSharedPtr<FJsonObject>& Params, FMCPPageCursor& OutCursor, FMCPDiagnostic& OutDiagnostic)
+	{
+		OutCursor = FMCPPageCursor();
+		if (!Params.IsValid())
+		{
+			return true;
+		}
+
+		double CursorNumber = 0.0;
+		if (Params->TryGetNumberField(TEXT("cursor"), CursorNumber))
+		{
+			OutCursor.Offset = FMath::Max(0, static_cast<int32>(CursorNumber));
+			return true;
+		}
+
+		FString CursorString;
+		if (!Params->TryGetStringField(TEXT("cursor"), CursorString) || CursorString.IsEmpty())
+		{
+			return true;
+		}
+
+		if (!CursorString.StartsWith(OpaqueCursorPrefix, ESearchCase::CaseSensitive))
+		{
+			if (!CursorString.IsNumeric())
+			{
+				SetInvalidCursorDiagnostic(OutDiagnostic, TEXT("cursor is not a valid page cursor."), CursorString);
+				return false;
+			}
+			OutCursor.Offset = FMath::Max(0, FCString::Atoi(*CursorString));
+			return true;
+		}
+
+		TArray<uint8> PayloadBytes;
+		if (!FBase64::Decode(CursorString.Mid(FCString::Strlen(OpaqueCursorPrefix)), PayloadBytes))
+		{
+			SetInvalidCursorDiagnostic(OutDiagnostic, TEXT("cursor could not be decoded."), CursorString);
+			return false;
+		}
+
+		const FUTF8ToTCHAR PayloadConverter(reinterpret_cast<const ANSICHAR*>(PayloadBytes.GetData()), PayloadBytes.Num());
+		const FString Payload(PayloadConverter.Length(), PayloadConverter.Get());
+
+		// Layout: <snapshot id hex>:<offset>:<query hash hex>:<last sort key>. Only the sort key may contain ':'.
+		FString SnapshotIdText;
+		FString OffsetText;
+		FString QueryHashText;
+		FString Remainder;
+		if (!Payload.Split(TEXT(":"), &SnapshotIdText, &Remainder)
+			|| !Remainder.Split(TEXT(":"), &OffsetText, &Remainder)
+			|| !Remainder.Split(TEXT(":"), &QueryHashText, &OutCursor.LastSortKey)
+			|| !OffsetText.IsNumeric())
+		{
+			SetInvalidCursorDiagnostic(OutDiagnostic, TEXT("cursor payload is malformed."), CursorString);
+			return false;
+		}
+
+		OutCursor.SnapshotId = FParse::HexNumber64(*SnapshotIdText);
+		OutCursor.Offset = FMath::Max(0, FCString::Atoi(*OffsetText));
+		OutCursor.QueryHash = FParse::HexNumber(*QueryHashText);
+		return true;
+	}
+
+	FString EncodeCursor(const FMCPPageCursor& Cursor)
+	{
+		const FString Payload = FString::Printf(
+			TEXT("%llx:%d:%08x:%s"),
+			Cursor.SnapshotId,
+			Cursor.Offset,
+			Cursor.QueryHash,
+			*Cursor.LastSortKey);
+		const FTCHARToUTF8 PayloadUtf8(*Payload);
+		const TArray<uint8> PayloadBytes(reinterpret_cast<const uint8*>(PayloadUtf8.Get()), PayloadUtf8.Length());
+		return FString(OpaqueCursorPrefix) + FBase64::Encode(PayloadBytes);
+	}
+
+	uint32 ComputeQueryHash(const FString& Tool, const TSharedPtr<FJsonObject>& Params)
+	{
+		FString ParamsJson;
+		if (Params.IsValid())
+		{
+			const TSharedRef<FJsonObject> QueryParams = MakeShared<FJsonObject>(*Params);
+			QueryParams->RemoveField(TEXT("cursor"));
+			QueryParams->RemoveField(TEXT("limit"));
+
+			const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ParamsJson);
+			FJsonSerializer::Serialize(QueryParams, Writer);
+		}
+
+		const uint32 QueryHash = FCrc::StrCrc32(*ParamsJson, FCrc::StrCrc32(*Tool));
+		return QueryHash != 0 ? QueryHash : 1;
+	}
+
+	bool ValidateCursorQuery(const FMCPPageCursor& Cursor, const uint32 QueryHash, FMCPDiagnostic& OutDiagnostic)
+	{
+		if (Cursor.QueryHash != 0 && Cursor.QueryHash != QueryHash)
+		{
+			SetInvalidCursorDiagnostic(OutDiagnostic, TEXT("cursor was issued for a different query."), FString::Printf(TEXT("%08x"), Cursor.QueryHash));
+			return false;
+		}
+		return true;
+	}
+
+	FString MakeSortKey(const std::initializer_list<FStringView> Parts)
+	{
+		FString SortKey;
+		for (const FStringView& Part : Parts)
+		{
+			if (!SortKey.IsEmpty())
+			{
+				SortKey.AppendChar(SortKeySeparator);
+			}
+			SortKey.Append(Part);
+		}
+		return SortKey;
+	}
+
+	bool ServePage(
+		const FMCPRequestEnvelope& Request,
+		const int32 Limit,
+		TFunctionRef<bool(FMCPPageSnapshot&)> BuildSnapshot,
+		FMCPPage& OutPage,
+		FMCPDiagnostic& OutDiagnostic)
+	{
+		OutPage = FMCPPage();
+
+		FMCPPageCursor Cursor;
+		if (!ParseCursor(Request.Params, Cursor, OutDiagnostic))
+		{
+			return false;
+		}
+
+		const uint32 QueryHash = ComputeQueryHash(Request.Tool, Request.Params);
+		if (!ValidateCursorQuery(Cursor, QueryHash, OutDiagnostic))
+		{
+			return false;
+		}
+
+		UMCPPageSnapshotSubsystem* SnapshotCache = GEditor ? GEditor->GetEditorSubsystem<UMCPPageSnapshotSubsystem>() : nullptr;
+		const int32 SafeLimit = FMath::Max(1, Limit);
+		uint64 SnapshotId = 0;
+		int32 StartIndex = Cursor.Offset;
+
+		TSharedPtr<const FMCPPageSnapshot> Snapshot;
+		if (SnapshotCache != nullptr && Cursor.SnapshotId != 0)
+		{
+			Snapshot = SnapshotCache->FindSnapshot(Cursor.SnapshotId, QueryHash);
+			if (Snapshot.IsValid())
+			{
+				SnapshotId = Cursor.SnapshotId;
+			}
+		}
+
+		if (!Snapshot.IsValid())
+		{
+			const TSharedRef<FMCPPageSnapshot> NewSnapshot = MakeShared<FMCPPageSnapshot>();
+			NewSnapshot->QueryHash = QueryHash;
+			const bool bComplete = BuildSnapshot(*NewSnapshot);
+			SortSnapshot(*NewSnapshot);
+
+			if (!Cursor.LastSortKey.IsEmpty())
+			{
+				StartIndex = FindResumeIndex(*NewSnapshot, Cursor.LastSortKey);
+			}
+
+			if (bComplete && SnapshotCache != nullptr && StartIndex + SafeLimit < NewSnapshot->Items.Num())
+			{
+				SnapshotId = SnapshotCache->StoreSnapshot(NewSnapshot);
+			}
+			Snapshot = NewSnapshot;
+		}
+
+		const int32 ItemCount = Snapshot->Items.Num();
+		StartIndex = FMath::Clamp(StartIndex, 0, ItemCount);
+		const int32 EndIndex = FMath::Min(StartIndex + SafeLimit, ItemCount);
+		OutPage.Items.Reserve(EndIndex - StartIndex);
+		for (int32 Index = StartIndex; Index < EndIndex; ++Index)
+		{
+			OutPage.Items.Add(Snapshot->Items[Index]);
+		}
+		OutPage.TotalCount = ItemCount;
+
+		if (EndIndex < ItemCount)
+		{
+			FMCPPageCursor NextCursor;
+			NextCursor.SnapshotId = SnapshotId;
+			NextCursor.Offset = EndIndex;
+			NextCursor.QueryHash = QueryHash;
+			NextCursor.LastSortKey = Snapshot->SortKeys[EndIndex - 1];
+			OutPage.NextCursor = EncodeCursor(NextCursor);
+		}
+		return true;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPTypes.h"
+
+struct FMCPPageSnapshot;
+
+struct FMCPPageCursor
+{
+	uint64 SnapshotId = 0;
+	int32 Offset = 0;
+	uint32 QueryHash = 0;
+	FString LastSortKey;
+};
+
+struct FMCPPage
+{
+	TArray<TSharedPtr<FJsonValue>> Items;
+	FString NextCursor;
+	int32 TotalCount = 0;
+};
+
+namespace MCPToolPaging
+{
+	// Accepts opaque cursors from EncodeCursor as well as legacy integer offsets.
+	bool ParseCursor(const TSharedPtr<FJsonObject>& Params, FMCPPageCursor& OutCursor, FMCPDiagnostic& OutDiagnostic);
+	FString EncodeCursor(const FMCPPageCursor& Cursor);
+
+	// Hash of tool + params without cursor/limit, so a cursor only resumes the query that produced it.
+	uint32 ComputeQueryHash(const FString& Tool, const TSharedPtr<FJsonObject>& Params);
+	bool ValidateCursorQuery(const FMCPPageCursor& Cursor, uint32 QueryHash, FMCPDiagnostic& OutDiagnostic);
+
+	FString MakeSortKey(std::initializer_list<FStringView> Parts);
+
+	// Serves one page of a list tool. BuildSnapshot fills unsorted items and sort keys and returns false when the
+	// result is partial (e.g. cancelled); it only runs when the cursor's snapshot is missing or expired, in which
+	// case paging resumes after the cursor's last sort key rather than at a shifted offset.
+	bool ServePage(
+		const FMCPRequestEnvelope& Request,
+		int32 Limit,
+		TFunctionRef<bool(FMCPPageSnapshot&)> BuildSnapshot,
+		FMCPPage& OutPage,
+		FMCPDiagnostic& OutDiagnostic);
+}
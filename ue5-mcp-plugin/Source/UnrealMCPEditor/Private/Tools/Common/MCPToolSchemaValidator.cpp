@@ -1,5 +1,8 @@
 #include "Tools/Common/MCPToolSchemaValidator.h"
 
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
 namespace
 {
 	FString GetJsonTypeName(const EJson JsonType)
@@ -56,6 +59,290 @@ namespace
 			return false;
 		}
 	}
+
+	using MCPToolSchemaValidator::ESchemaType;
+	using MCPToolSchemaValidator::FCompiledSchema;
+
+	struct FSchemaPath
+	{
+		const FString* Root = nullptr;
+		const FSchemaPath* Parent = nullptr;
+		const FString* Key = nullptr;
+		int32 Index = INDEX_NONE;
+
+		FString ToString() const
+		{
+			if (Parent == nullptr)
+			{
+				return Root != nullptr ? *Root : FString();
+			}
+
+			FString Result = Parent->ToString();
+			if (Key != nullptr)
+			{
+				Result += TEXT("/");
+				Result += *Key;
+			}
+			else
+			{
+				Result += FString::Printf(TEXT("[%d]"), Index);
+			}
+			return Result;
+		}
+	};
+
+	ESchemaType ParseSchemaType(const FString& TypeName)
+	{
+		if (TypeName.Equals(TEXT("object"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Object;
+		}
+		if (TypeName.Equals(TEXT("array"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Array;
+		}
+		if (TypeName.Equals(TEXT("string"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::String;
+		}
+		if (TypeName.Equals(TEXT("number"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Number;
+		}
+		if (TypeName.Equals(TEXT("integer"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Integer;
+		}
+		if (TypeName.Equals(TEXT("boolean"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Boolean;
+		}
+		if (TypeName.Equals(TEXT("null"), ESearchCase::IgnoreCase))
+		{
+			return ESchemaType::Null;
+		}
+		return ESchemaType::Any;
+	}
+
+	TOptional<int32> ReadOptionalInt(const FJsonObject& SchemaObject, const TCHAR* FieldName)
+	{
+		double Value = 0.0;
+		return SchemaObject.TryGetNumberField(FieldName, Value) ? TOptional<int32>(static_cast<int32>(Value)) : TOptional<int32>();
+	}
+
+	TOptional<double> ReadOptionalNumber(const FJsonObject& SchemaObject, const TCHAR* FieldName)
+	{
+		double Value = 0.0;
+		return SchemaObject.TryGetNumberField(FieldName, Value) ? TOptional<double>(Value) : TOptional<double>();
+	}
+
+	FString DescribeValueType(const TSharedPtr<FJsonValue>& JsonValue)
+	{
+		return GetJsonTypeName(JsonValue.IsValid() ? JsonValue->Type : EJson::None);
+	}
+
+	bool MatchesCompiledEnum(const TSharedPtr<FJsonValue>& JsonValue, const FCompiledSchema& Schema)
+	{
+		if (!JsonValue.IsValid())
+		{
+			return false;
+		}
+
+		switch (JsonValue->Type)
+		{
+		case EJson::String:
+		{
+			FString ValueString;
+			return JsonValue->TryGetString(ValueString) && Schema.EnumStrings.Contains(ValueString);
+		}
+		case EJson::Number:
+		{
+			double ValueNumber = 0.0;
+			if (!JsonValue->TryGetNumber(ValueNumber))
+			{
+				return false;
+			}
+			for (const double EnumNumber : Schema.EnumNumbers)
+			{
+				if (FMath::IsNearlyEqual(ValueNumber, EnumNumber))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+		case EJson::Boolean:
+		{
+			bool bValue = false;
+			return JsonValue->TryGetBool(bValue) && (bValue ? Schema.bEnumAllowsTrue : Schema.bEnumAllowsFalse);
+		}
+		case EJson::Null:
+			return Schema.bEnumAllowsNull;
+		default:
+			return false;
+		}
+	}
+
+	bool ValidateCompiledNode(const TSharedPtr<FJsonValue>& JsonValue, const FCompiledSchema& Schema, const FSchemaPath& Path, FString& OutError);
+
+	bool ValidateCompiledObjectFields(const FJsonObject& ValueObject, const FCompiledSchema& Schema, const FSchemaPath& Path, FString& OutError)
+	{
+		for (const FString& RequiredField : Schema.RequiredFields)
+		{
+			if (!ValueObject.HasField(RequiredField))
+			{
+				OutError = FString::Printf(TEXT("%s/%s is required."), *Path.ToString(), *RequiredField);
+				return false;
+			}
+		}
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : ValueObject.Values)
+		{
+			const TSharedPtr<const FCompiledSchema>* PropertySchema = Schema.Properties.Find(Entry.Key);
+			if (PropertySchema != nullptr)
+			{
+				FSchemaPath ChildPath;
+				ChildPath.Parent = &Path;
+				ChildPath.Key = &Entry.Key;
+				if (!ValidateCompiledNode(Entry.Value, **PropertySchema, ChildPath, OutError))
+				{
+					return false;
+				}
+			}
+			else if (!Schema.bAllowAdditionalProperties)
+			{
+				OutError = FString::Printf(TEXT("%s/%s is not allowed by schema."), *Path.ToString(), *Entry.Key);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ValidateCompiledNode(const TSharedPtr<FJsonValue>& JsonValue, const FCompiledSchema& Schema, const FSchemaPath& Path, FString& OutError)
+	{
+		if (Schema.bHasEnum && !MatchesCompiledEnum(JsonValue, Schema))
+		{
+			OutError = FString::Printf(TEXT("%s does not match enum constraints."), *Path.ToString());
+			return false;
+		}
+
+		switch (Schema.Type)
+		{
+		case ESchemaType::Object:
+		{
+			if (!JsonValue.IsValid() || JsonValue->Type != EJson::Object)
+			{
+				OutError = FString::Printf(TEXT("%s expected object but got %s."), *Path.ToString(), *DescribeValueType(JsonValue));
+				return false;
+			}
+			const TSharedPtr<FJsonObject> ValueObject = JsonValue->AsObject();
+			return !ValueObject.IsValid() || ValidateCompiledObjectFields(*ValueObject, Schema, Path, OutError);
+		}
+		case ESchemaType::Array:
+		{
+			if (!JsonValue.IsValid() || JsonValue->Type != EJson::Array)
+			{
+				OutError = FString::Printf(TEXT("%s expected array but got %s."), *Path.ToString(), *DescribeValueType(JsonValue));
+				return false;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>& ValueArray = JsonValue->AsArray();
+			if (Schema.MinItems.IsSet() && ValueArray.Num() < Schema.MinItems.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected at least %d items."), *Path.ToString(), Schema.MinItems.GetValue());
+				return false;
+			}
+			if (Schema.MaxItems.IsSet() && ValueArray.Num() > Schema.MaxItems.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected at most %d items."), *Path.ToString(), Schema.MaxItems.GetValue());
+				return false;
+			}
+
+			if (Schema.Items.IsValid())
+			{
+				FSchemaPath ChildPath;
+				ChildPath.Parent = &Path;
+				for (int32 Index = 0; Index < ValueArray.Num(); ++Index)
+				{
+					ChildPath.Index = Index;
+					if (!ValidateCompiledNode(ValueArray[Index], *Schema.Items, ChildPath, OutError))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		case ESchemaType::String:
+		{
+			FString ValueString;
+			if (!JsonValue.IsValid() || !JsonValue->TryGetString(ValueString))
+			{
+				OutError = FString::Printf(TEXT("%s expected string but got %s."), *Path.ToString(), *DescribeValueType(JsonValue));
+				return false;
+			}
+			if (Schema.MinLength.IsSet() && ValueString.Len() < Schema.MinLength.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected minimum length %d."), *Path.ToString(), Schema.MinLength.GetValue());
+				return false;
+			}
+			if (Schema.MaxLength.IsSet() && ValueString.Len() > Schema.MaxLength.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected maximum length %d."), *Path.ToString(), Schema.MaxLength.GetValue());
+				return false;
+			}
+			return true;
+		}
+		case ESchemaType::Number:
+		case ESchemaType::Integer:
+		{
+			double ValueNumber = 0.0;
+			if (!JsonValue.IsValid() || !JsonValue->TryGetNumber(ValueNumber))
+			{
+				OutError = FString::Printf(TEXT("%s expected %s but got %s."), *Path.ToString(), *Schema.TypeName, *DescribeValueType(JsonValue));
+				return false;
+			}
+			if (Schema.Type == ESchemaType::Integer && FMath::Abs(ValueNumber - FMath::RoundToDouble(ValueNumber)) > KINDA_SMALL_NUMBER)
+			{
+				OutError = FString::Printf(TEXT("%s expected integer value."), *Path.ToString());
+				return false;
+			}
+			if (Schema.Minimum.IsSet() && ValueNumber < Schema.Minimum.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected value >= %g."), *Path.ToString(), Schema.Minimum.GetValue());
+				return false;
+			}
+			if (Schema.Maximum.IsSet() && ValueNumber > Schema.Maximum.GetValue())
+			{
+				OutError = FString::Printf(TEXT("%s expected value <= %g."), *Path.ToString(), Schema.Maximum.GetValue());
+				return false;
+			}
+			return true;
+		}
+		case ESchemaType::Boolean:
+		{
+			bool bValue = false;
+			if (!JsonValue.IsValid() || !JsonValue->TryGetBool(bValue))
+			{
+				OutError = FString::Printf(TEXT("%s expected boolean but got %s."), *Path.ToString(), *DescribeValueType(JsonValue));
+				return false;
+			}
+			return true;
+		}
+		case ESchemaType::Null:
+		{
+			if (!JsonValue.IsValid() || JsonValue->Type != EJson::Null)
+			{
+				OutError = FString::Printf(TEXT("%s expected null but got %s."), *Path.ToString(), *DescribeValueType(JsonValue));
+				return false;
+			}
+			return true;
+		}
+		default:
+			return true;
+		}
+	}
 }
 
 bool MCPToolSchemaValidator::ValidateJsonValueAgainstSchema(
@@ -269,3 +556,137 @@ bool MCPToolSchemaValidator::ValidateJsonValueAgainstSchema(
 
 	return true;
 }
+
+TSharedPtr<const MCPToolSchemaValidator::FCompiledSchema> MCPToolSchemaValidator::CompileSchema(const TSharedPtr<FJsonObject>& SchemaObject)
+{
+	if (!SchemaObject.IsValid())
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FCompiledSchema> Compiled = MakeShared<FCompiledSchema>();
+
+	const TArray<TSharedPtr<FJsonValue>>* EnumValues = nullptr;
+	if (SchemaObject->TryGetArrayField(TEXT("enum"), EnumValues) && EnumValues != nullptr && EnumValues->Num() > 0)
+	{
+		Compiled->bHasEnum = true;
+		for (const TSharedPtr<FJsonValue>& EnumValue : *EnumValues)
+		{
+			if (!EnumValue.IsValid())
+			{
+				continue;
+			}
+
+			switch (EnumValue->Type)
+			{
+			case EJson::String:
+				Compiled->EnumStrings.Add(EnumValue->AsString());
+				break;
+			case EJson::Number:
+				Compiled->EnumNumbers.Add(EnumValue->AsNumber());
+				break;
+			case EJson::Boolean:
+				(EnumValue->AsBool() ? Compiled->bEnumAllowsTrue : Compiled->bEnumAllowsFalse) = true;
+				break;
+			case EJson::Null:
+				Compiled->bEnumAllowsNull = true;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	SchemaObject->TryGetStringField(TEXT("type"), Compiled->TypeName);
+	Compiled->Type = ParseSchemaType(Compiled->TypeName);
+
+	switch (Compiled->Type)
+	{
+	case ESchemaType::Object:
+	{
+		const TSharedPtr<FJsonObject>* PropertiesObject = nullptr;
+		if (SchemaObject->TryGetObjectField(TEXT("properties"), PropertiesObject) && PropertiesObject != nullptr && PropertiesObject->IsValid())
+		{
+			Compiled->Properties.Reserve((*PropertiesObject)->Values.Num());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*PropertiesObject)->Values)
+			{
+				const TSharedPtr<FJsonObject> PropertySchema = Entry.Value.IsValid() && Entry.Value->Type == EJson::Object ? Entry.Value->AsObject() : nullptr;
+				if (PropertySchema.IsValid())
+				{
+					Compiled->Properties.Add(Entry.Key, CompileSchema(PropertySchema));
+				}
+			}
+		}
+
+		if (SchemaObject->HasField(TEXT("additionalProperties")))
+		{
+			SchemaObject->TryGetBoolField(TEXT("additionalProperties"), Compiled->bAllowAdditionalProperties);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* RequiredFields = nullptr;
+		if (SchemaObject->TryGetArrayField(TEXT("required"), RequiredFields) && RequiredFields != nullptr)
+		{
+			for (const TSharedPtr<FJsonValue>& RequiredFieldValue : *RequiredFields)
+			{
+				FString RequiredField;
+				if (RequiredFieldValue.IsValid() && RequiredFieldValue->TryGetString(RequiredField))
+				{
+					Compiled->RequiredFields.Add(MoveTemp(RequiredField));
+				}
+			}
+		}
+		break;
+	}
+	case ESchemaType::Array:
+	{
+		Compiled->MinItems = ReadOptionalInt(*SchemaObject, TEXT("minItems"));
+		Compiled->MaxItems = ReadOptionalInt(*SchemaObject, TEXT("maxItems"));
+		const TSharedPtr<FJsonObject>* ItemSchemaObject = nullptr;
+		if (SchemaObject->TryGetObjectField(TEXT("items"), ItemSchemaObject) && ItemSchemaObject != nullptr && ItemSchemaObject->IsValid())
+		{
+			Compiled->Items = CompileSchema(*ItemSchemaObject);
+		}
+		break;
+	}
+	case ESchemaType::String:
+		Compiled->MinLength = ReadOptionalInt(*SchemaObject, TEXT("minLength"));
+		Compiled->MaxLength = ReadOptionalInt(*SchemaObject, TEXT("maxLength"));
+		break;
+	case ESchemaType::Number:
+	case ESchemaType::Integer:
+		Compiled->Minimum = ReadOptionalNumber(*SchemaObject, TEXT("minimum"));
+		Compiled->Maximum = ReadOptionalNumber(*SchemaObject, TEXT("maximum"));
+		break;
+	default:
+		break;
+	}
+
+	return Compiled;
+}
+
+bool MCPToolSchemaValidator::ValidateJsonValueAgainstCompiledSchema(
+	const TSharedPtr<FJsonValue>& JsonValue,
+	const FCompiledSchema& Schema,
+	const FString& Path,
+	FString& OutError)
+{
+	FSchemaPath RootPath;
+	RootPath.Root = &Path;
+	return ValidateCompiledNode(JsonValue, Schema, RootPath, OutError);
+}
+
+bool MCPToolSchemaValidator::ValidateJsonObjectAgainstCompiledSchema(
+	const TSharedPtr<FJsonObject>& JsonObject,
+	const FCompiledSchema& Schema,
+	const FString& Path,
+	FString& OutError)
+{
+	if (!JsonObject.IsValid() || Schema.Type != ESchemaType::Object || Schema.bHasEnum)
+	{
+		return ValidateJsonValueAgainstCompiledSchema(MakeShared<FJsonValueObject>(JsonObject), Schema, Path, OutError);
+	}
+
+	FSchemaPath RootPath;
+	RootPath.Root = &Path;
+	return ValidateCompiledObjectFields(*JsonObject, Schema, RootPath, OutError);
+}
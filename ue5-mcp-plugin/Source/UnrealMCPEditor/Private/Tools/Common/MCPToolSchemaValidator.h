@@ -4,9 +4,62 @@
 
 namespace MCPToolSchemaValidator
 {
+	enum class ESchemaType : uint8
+	{
+		Any,
+		Object,
+		Array,
+		String,
+		Number,
+		Integer,
+		Boolean,
+		Null
+	};
+
+	struct FCompiledSchema
+	{
+		ESchemaType Type = ESchemaType::Any;
+		FString TypeName;
+
+		bool bHasEnum = false;
+		TSet<FString> EnumStrings;
+		TArray<double> EnumNumbers;
+		bool bEnumAllowsTrue = false;
+		bool bEnumAllowsFalse = false;
+		bool bEnumAllowsNull = false;
+
+		bool bAllowAdditionalProperties = true;
+		TMap<FString, TSharedPtr<const FCompiledSchema>> Properties;
+		TArray<FString> RequiredFields;
+
+		TOptional<int32> MinItems;
+		TOptional<int32> MaxItems;
+		TSharedPtr<const FCompiledSchema> Items;
+
+		TOptional<int32> MinLength;
+		TOptional<int32> MaxLength;
+
+		TOptional<double> Minimum;
+		TOptional<double> Maximum;
+	};
+
 	bool ValidateJsonValueAgainstSchema(
 		const TSharedPtr<FJsonValue>& JsonValue,
 		const TSharedPtr<FJsonObject>& SchemaObject,
 		const FString& Path,
 		FString& OutError);
+
+	TSharedPtr<const FCompiledSchema> CompileSchema(const TSharedPtr<FJsonObject>& SchemaObject);
+
+	bool ValidateJsonValueAgainstCompiledSchema(
+		const TSharedPtr<FJsonValue>& JsonValue,
+		const FCompiledSchema& Schema,
+		const FString& Path,
+		FString& OutError);
+
+	bool ValidateJsonObjectAgainstCompiledSchema(
+		const TSharedPtr<FJsonObject>& JsonObject,
+		const FCompiledSchema& Schema,
+		const FString& Path,
+		FString& OutError);
 }
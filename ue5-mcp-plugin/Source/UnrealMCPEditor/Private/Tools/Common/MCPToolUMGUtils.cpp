@@ -1,5 +1,7 @@
 #include "Tools/Common/MCPToolUMGUtils.h"
 
+#include "Editor.h"
+#include "MCPBlueprintCompileSubsystem.h"
 #include "MCPErrorCodes.h"
 #include "Tools/Common/MCPToolAssetUtils.h"
 #include "Blueprint/WidgetTree.h"
@@ -8,6 +10,7 @@
 #include "Components/PanelSlot.h"
 #include "Components/PanelWidget.h"
 #include "Components/Widget.h"
+#include "Kismet2/KismetEditorUtilities.h"
 #include "Misc/Guid.h"
 #include "UObject/UObjectGlobals.h"
 #include "WidgetBlueprint.h"
@@ -893,4 +896,36 @@ namespace MCPToolUMGUtils
 
 		return true;
 	}
+
+	TSharedRef<FJsonObject> RequestWidgetBlueprintCompile(
+		UWidgetBlueprint* WidgetBlueprint,
+		const bool bCompile,
+		const bool bAutoSave,
+		const FString& RequestId,
+		bool& bOutSaveDeferred)
+	{
+		bOutSaveDeferred = false;
+		TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
+		if (!bCompile || WidgetBlueprint == nullptr)
+		{
+			CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
+			return CompileObject;
+		}
+
+		UMCPBlueprintCompileSubsystem* CompileSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPBlueprintCompileSubsystem>() : nullptr;
+		if (CompileSubsystem != nullptr && CompileSubsystem->RequestCompile(WidgetBlueprint, bAutoSave, RequestId))
+		{
+			bOutSaveDeferred = bAutoSave;
+			CompileObject->SetStringField(TEXT("status"), TEXT("deferred"));
+			CompileObject->SetBoolField(TEXT("save_deferred"), bOutSaveDeferred);
+			return CompileObject;
+		}
+
+		if (CompileSubsystem == nullptr)
+		{
+			FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+		}
+		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
+		return CompileObject;
+	}
 }
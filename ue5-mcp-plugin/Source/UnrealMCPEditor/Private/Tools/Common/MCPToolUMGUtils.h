@@ -47,4 +47,12 @@ namespace MCPToolUMGUtils
 		UWidgetBlueprint* WidgetBlueprint,
 		UWidget* Widget,
 		FMCPDiagnostic& OutDiagnostic);
+	// Queues the compile on UMCPBlueprintCompileSubsystem when deferral is enabled; a queued compile also takes over auto_save.
+	// RequestId is reported if that deferred save later fails.
+	TSharedRef<FJsonObject> RequestWidgetBlueprintCompile(
+		UWidgetBlueprint* WidgetBlueprint,
+		bool bCompile,
+		bool bAutoSave,
+		const FString& RequestId,
+		bool& bOutSaveDeferred);
 }
@@ -6,7 +6,6 @@
 #include "MCPObservabilitySubsystem.h"
 #include "MCPPolicySubsystem.h"
 #include "MCPWebSocketTransportSubsystem.h"
-#include "Tools/Common/MCPToolCommonJson.h"
 #include "Tools/Common/MCPToolDiagnostics.h"
 #include "Interfaces/IPluginManager.h"
 #include "Modules/ModuleManager.h"
@@ -61,14 +60,7 @@ bool FMCPToolsCoreHandler::HandleToolsList(
 		Request.Params->TryGetStringField(TEXT("domain_filter"), DomainFilter);
 	}
 
-	TArray<TSharedPtr<FJsonValue>> Tools;
-	Registry.BuildToolsList(bIncludeSchemas, DomainFilter, Tools);
-
-	OutResult.ResultObject = MakeShared<FJsonObject>();
-	OutResult.ResultObject->SetStringField(TEXT("protocol_version"), Registry.GetProtocolVersion());
-	OutResult.ResultObject->SetStringField(TEXT("schema_hash"), Registry.GetSchemaHash());
-	OutResult.ResultObject->SetArrayField(TEXT("capabilities"), MCPToolCommonJson::ToJsonStringArray(Registry.GetCapabilities()));
-	OutResult.ResultObject->SetArrayField(TEXT("tools"), Tools);
+	OutResult.ResultJson = Registry.GetToolsListResultJson(bIncludeSchemas, DomainFilter);
 	OutResult.Status = EMCPResponseStatus::Ok;
 	return true;
 }
@@ -122,6 +114,8 @@ bool FMCPToolsCoreHandler::HandleSystemHealth(
 		TransportState->SetStringField(TEXT("bind_address"), WebSocketTransportSubsystem->GetBindAddress());
 		TransportState->SetNumberField(TEXT("port"), static_cast<double>(WebSocketTransportSubsystem->GetListenPort()));
 		TransportState->SetNumberField(TEXT("client_count"), static_cast<double>(WebSocketTransportSubsystem->GetClientCount()));
+		TransportState->SetNumberField(TEXT("queued_request_count"), static_cast<double>(WebSocketTransportSubsystem->GetQueuedRequestCount()));
+		TransportState->SetNumberField(TEXT("coalesced_event_count"), static_cast<double>(WebSocketTransportSubsystem->GetCoalescedEventCount()));
 	}
 	else
 	{
@@ -130,6 +124,8 @@ bool FMCPToolsCoreHandler::HandleSystemHealth(
 		TransportState->SetStringField(TEXT("bind_address"), TEXT(""));
 		TransportState->SetNumberField(TEXT("port"), 0.0);
 		TransportState->SetNumberField(TEXT("client_count"), 0.0);
+		TransportState->SetNumberField(TEXT("queued_request_count"), 0.0);
+		TransportState->SetNumberField(TEXT("coalesced_event_count"), 0.0);
 	}
 	EditorState->SetObjectField(TEXT("event_stream_transport"), TransportState);
 
@@ -143,6 +139,45 @@ bool FMCPToolsCoreHandler::HandleSystemHealth(
 	return true;
 }
 
+bool FMCPToolsCoreHandler::HandleMetricsGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
+{
+	FString ToolFilter;
+	bool bIncludeTools = true;
+	if (Request.Params.IsValid())
+	{
+		Request.Params->TryGetStringField(TEXT("tool"), ToolFilter);
+		Request.Params->TryGetBoolField(TEXT("include_tools"), bIncludeTools);
+	}
+
+	const UMCPObservabilitySubsystem* ObservabilitySubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPObservabilitySubsystem>() : nullptr;
+	if (ObservabilitySubsystem == nullptr)
+	{
+		MCPToolDiagnostics::AddDiagnostic(
+			OutResult.Diagnostics,
+			TEXT("MCP.INTERNAL.EXCEPTION"),
+			TEXT("Observability subsystem is unavailable."));
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
+	OutResult.ResultObject = ObservabilitySubsystem->BuildLatencySnapshot(ToolFilter, bIncludeTools);
+	OutResult.Status = EMCPResponseStatus::Ok;
+	return true;
+}
+
+bool FMCPToolsCoreHandler::HandleBatch(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
+{
+	// The command router expands mcp.batch itself; reaching the registry means it was dispatched directly.
+	MCPToolDiagnostics::AddDiagnostic(
+		OutResult.Diagnostics,
+		TEXT("MCP.INTERNAL.EXCEPTION"),
+		TEXT("mcp.batch must be executed through the command router."),
+		TEXT("error"),
+		Request.RequestId);
+	OutResult.Status = EMCPResponseStatus::Error;
+	return false;
+}
+
 bool FMCPToolsCoreHandler::HandleEditorLiveCodingCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
 {
 	bool bEnsureEnabledForSession = true;
@@ -16,5 +16,7 @@ struct FMCPToolsCoreHandler
 		int32 RegisteredToolCount,
 		const FMCPRequestEnvelope& Request,
 		FMCPToolExecutionResult& OutResult);
+	static bool HandleMetricsGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
+	static bool HandleBatch(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
 	static bool HandleEditorLiveCodingCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
 };
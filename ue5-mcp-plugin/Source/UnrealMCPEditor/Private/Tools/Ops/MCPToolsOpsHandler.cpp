@@ -7,6 +7,7 @@
 #include "MCPObservabilitySubsystem.h"
 #include "Tools/Common/MCPToolCommonJson.h"
 #include "Tools/Common/MCPToolDiagnostics.h"
+#include "Tools/Common/MCPToolPaging.h"
 
 namespace
 {
@@ -79,37 +80,51 @@ bool FMCPToolsOpsHandler::HandleChangeSetList(const FMCPRequestEnvelope& Request
 		}
 	}
 
-	const int32 Cursor = MCPToolCommonJson::ParseCursor(Request.Params);
+	FMCPPageCursor Cursor;
+	FMCPDiagnostic CursorDiagnostic;
+	const uint32 QueryHash = MCPToolPaging::ComputeQueryHash(Request.Tool, Request.Params);
+	if (!MCPToolPaging::ParseCursor(Request.Params, Cursor, CursorDiagnostic)
+		|| !MCPToolPaging::ValidateCursorQuery(Cursor, QueryHash, CursorDiagnostic))
+	{
+		OutResult.Diagnostics.Add(CursorDiagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
+	// The changeset index is append-only and time ordered, so a keyset cursor stays stable without a snapshot.
+	FMCPChangeSetListQuery Query;
+	Query.StatusFilter = MoveTemp(StatusFilter);
+	Query.ToolGlob = ToolGlob;
+	Query.SessionId = SessionId;
+	Query.AfterSortKey = Cursor.LastSortKey;
+	Query.Offset = Cursor.LastSortKey.IsEmpty() ? Cursor.Offset : 0;
+	Query.Limit = FMath::Clamp(Limit, 1, 200);
+
 	TArray<TSharedPtr<FJsonObject>> Items;
-	int32 NextCursor = -1;
-	FMCPDiagnostic Diagnostic;
-	if (!ChangeSetSubsystem->ListChangeSets(
-		Limit,
-		Cursor,
-		StatusFilter,
-		ToolGlob,
-		SessionId,
-		Items,
-		NextCursor,
-		Diagnostic))
+	FString NextSortKey;
+	FMCPDiagnostic ListDiagnostic;
+	if (!ChangeSetSubsystem->ListChangeSets(Query, Items, NextSortKey, ListDiagnostic))
 	{
-		OutResult.Diagnostics.Add(Diagnostic);
+		OutResult.Diagnostics.Add(ListDiagnostic);
 		OutResult.Status = EMCPResponseStatus::Error;
 		return false;
 	}
 
-	TArray<TSharedPtr<FJsonValue>> ItemValues;
-	ItemValues.Reserve(Items.Num());
+	TArray<TSharedPtr<FJsonValue>> ChangeSetValues;
+	ChangeSetValues.Reserve(Items.Num());
 	for (const TSharedPtr<FJsonObject>& Item : Items)
 	{
-		ItemValues.Add(MakeShared<FJsonValueObject>(Item.ToSharedRef()));
+		ChangeSetValues.Add(MakeShared<FJsonValueObject>(Item.ToSharedRef()));
 	}
 
 	OutResult.ResultObject = MakeShared<FJsonObject>();
-	OutResult.ResultObject->SetArrayField(TEXT("changesets"), ItemValues);
-	if (NextCursor >= 0)
+	OutResult.ResultObject->SetArrayField(TEXT("changesets"), ChangeSetValues);
+	if (!NextSortKey.IsEmpty())
 	{
-		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), FString::FromInt(NextCursor));
+		FMCPPageCursor NextCursor;
+		NextCursor.QueryHash = QueryHash;
+		NextCursor.LastSortKey = NextSortKey;
+		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), MCPToolPaging::EncodeCursor(NextCursor));
 	}
 	OutResult.Status = EMCPResponseStatus::Ok;
 	return true;
@@ -259,6 +274,46 @@ bool FMCPToolsOpsHandler::HandleChangeSetRollbackApply(const FMCPRequestEnvelope
 	return true;
 }
 
+bool FMCPToolsOpsHandler::HandleChangeSetPin(const FMCPRequestEnvelope& Request, const bool bPinned, FMCPToolExecutionResult& OutResult)
+{
+	const UMCPChangeSetSubsystem* ChangeSetSubsystem = nullptr;
+	if (!ResolveChangeSetSubsystem(ChangeSetSubsystem, OutResult))
+	{
+		return false;
+	}
+
+	FString ChangeSetId;
+	if (Request.Params.IsValid())
+	{
+		Request.Params->TryGetStringField(TEXT("changeset_id"), ChangeSetId);
+	}
+
+	if (ChangeSetId.IsEmpty())
+	{
+		MCPToolDiagnostics::AddDiagnostic(
+			OutResult.Diagnostics,
+			MCPErrorCodes::SCHEMA_INVALID_PARAMS,
+			TEXT("changeset_id is required."),
+			TEXT("error"));
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
+	FMCPDiagnostic Diagnostic;
+	if (!ChangeSetSubsystem->SetChangeSetPinned(ChangeSetId, bPinned, Diagnostic))
+	{
+		OutResult.Diagnostics.Add(Diagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
+	OutResult.ResultObject = MakeShared<FJsonObject>();
+	OutResult.ResultObject->SetStringField(TEXT("changeset_id"), ChangeSetId);
+	OutResult.ResultObject->SetBoolField(TEXT("pinned"), bPinned);
+	OutResult.Status = EMCPResponseStatus::Ok;
+	return true;
+}
+
 bool FMCPToolsOpsHandler::HandleJobGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult)
 {
 	UMCPJobSubsystem* JobSubsystem = nullptr;
@@ -9,6 +9,7 @@ struct FMCPToolsOpsHandler
 	static bool HandleChangeSetGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
 	static bool HandleChangeSetRollbackPreview(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
 	static bool HandleChangeSetRollbackApply(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
+	static bool HandleChangeSetPin(const FMCPRequestEnvelope& Request, bool bPinned, FMCPToolExecutionResult& OutResult);
 
 	static bool HandleJobGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
 	static bool HandleJobCancel(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult);
@@ -535,6 +535,11 @@ bool FMCPToolsSequencerKeyHandler::HandleKeyBulkSet(const FMCPRequestEnvelope& R
 
 	for (const TSharedPtr<FJsonValue>& KeyValue : *Keys)
 	{
+		if (OutResult.ShouldStop())
+		{
+			break;
+		}
+
 		if (!KeyValue.IsValid() || KeyValue->Type != EJson::Object)
 		{
 			continue;
@@ -617,6 +617,11 @@ bool FMCPToolsSequencerReadHandler::HandleChannelList(const FMCPRequestEnvelope&
 		const TArray<FMovieSceneBinding>& Bindings = MCPSequencerApiCompat::GetBindingsConst(MovieScene);
 		for (const FMovieSceneBinding& Binding : Bindings)
 		{
+			if (OutResult.ShouldStop())
+			{
+				break;
+			}
+
 			for (UMovieSceneTrack* Track : Binding.GetTracks())
 			{
 				if (Track == nullptr)
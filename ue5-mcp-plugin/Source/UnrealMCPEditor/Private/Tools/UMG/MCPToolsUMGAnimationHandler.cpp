@@ -3,6 +3,7 @@
 #include "MCPErrorCodes.h"
 #include "MCPObjectUtils.h"
 #include "Tools/Common/MCPToolCommonJson.h"
+#include "Tools/Common/MCPToolUMGUtils.h"
 #include "Animation/MovieScene2DTransformSection.h"
 #include "Animation/MovieScene2DTransformTrack.h"
 #include "Animation/WidgetAnimation.h"
@@ -11,7 +12,6 @@
 #include "Components/Widget.h"
 #include "KeyParams.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "Kismet2/KismetEditorUtilities.h"
 #include "MovieScene.h"
 #include "ScopedTransaction.h"
 #include "Sections/MovieSceneColorSection.h"
@@ -1184,20 +1184,12 @@ bool FMCPToolsUMGAnimationHandler::HandleAnimationCreate(
 		WidgetBlueprint->MarkPackageDirty();
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1315,20 +1307,12 @@ bool FMCPToolsUMGAnimationHandler::HandleAnimationRemove(
 		WidgetBlueprint->MarkPackageDirty();
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1535,20 +1519,12 @@ bool FMCPToolsUMGAnimationHandler::HandleAnimationTrackAdd(
 		}
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1736,20 +1712,12 @@ bool FMCPToolsUMGAnimationHandler::HandleAnimationKeySet(
 		bKeySet = true;
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1955,21 +1923,13 @@ bool FMCPToolsUMGAnimationHandler::HandleAnimationKeyRemove(
 		RemovedCount = 0;
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
+	bool bSaveDeferred = false;
 	const bool bShouldCompile = bCompileOnSuccess && !Request.Context.bDryRun && RemovedCount > 0;
-	if (bShouldCompile)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bShouldCompile, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave && RemovedCount > 0)
+	if (!Request.Context.bDryRun && bAutoSave && RemovedCount > 0 && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
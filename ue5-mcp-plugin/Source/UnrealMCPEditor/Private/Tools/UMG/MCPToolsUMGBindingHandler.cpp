@@ -3,6 +3,7 @@
 #include "MCPErrorCodes.h"
 #include "MCPObjectUtils.h"
 #include "Tools/Common/MCPToolCommonJson.h"
+#include "Tools/Common/MCPToolUMGUtils.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/Widget.h"
 #include "EdGraph/EdGraph.h"
@@ -381,20 +382,12 @@ bool FMCPToolsUMGBindingHandler::HandleBindingSet(
 		WidgetBlueprint->MarkPackageDirty();
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -505,20 +498,12 @@ bool FMCPToolsUMGBindingHandler::HandleBindingClear(
 		WidgetBlueprint->MarkPackageDirty();
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -702,20 +687,12 @@ bool FMCPToolsUMGBindingHandler::HandleWidgetEventBind(
 		? ResolveEventFunctionName(MatchingNode)
 		: FunctionName;
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -862,20 +839,12 @@ bool FMCPToolsUMGBindingHandler::HandleWidgetEventUnbind(
 		WidgetBlueprint->MarkPackageDirty();
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -2,6 +2,8 @@
 
 #include "MCPErrorCodes.h"
 #include "MCPObjectUtils.h"
+#include "MCPPageSnapshotSubsystem.h"
+#include "Tools/Common/MCPToolPaging.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/ContentWidget.h"
 #include "Components/NamedSlotInterface.h"
@@ -325,9 +327,10 @@ namespace
 		const int32 Depth,
 		const bool bIncludeSlotSummary,
 		const bool bIncludeLayoutSummary,
+		const FMCPToolExecutionResult& ExecutionState,
 		TArray<TSharedPtr<FJsonValue>>& OutNodes)
 	{
-		if (Widget == nullptr || Depth > MaxDepth)
+		if (Widget == nullptr || Depth > MaxDepth || ExecutionState.ShouldStop())
 		{
 			return;
 		}
@@ -402,6 +405,7 @@ namespace
 					Depth + 1,
 					bIncludeSlotSummary,
 					bIncludeLayoutSummary,
+					ExecutionState,
 					OutNodes);
 			}
 		}
@@ -437,6 +441,7 @@ namespace
 					Depth + 1,
 					bIncludeSlotSummary,
 					bIncludeLayoutSummary,
+					ExecutionState,
 					OutNodes);
 			}
 		}
@@ -451,7 +456,6 @@ bool FMCPToolsUMGReadHandler::HandleWidgetClassList(const FMCPRequestEnvelope& R
 	bool bIncludeDeprecated = false;
 	bool bIncludeEditorOnly = false;
 	int32 Limit = 200;
-	int32 Cursor = 0;
 
 	if (Request.Params.IsValid())
 	{
@@ -464,102 +468,84 @@ bool FMCPToolsUMGReadHandler::HandleWidgetClassList(const FMCPRequestEnvelope& R
 		double LimitNumber = static_cast<double>(Limit);
 		Request.Params->TryGetNumberField(TEXT("limit"), LimitNumber);
 		Limit = FMath::Clamp(static_cast<int32>(LimitNumber), 1, 2000);
-
-		double CursorNumber = static_cast<double>(Cursor);
-		Request.Params->TryGetNumberField(TEXT("cursor"), CursorNumber);
-		Cursor = FMath::Max(0, static_cast<int32>(CursorNumber));
 	}
 
-	struct FWidgetClassEntry
-	{
-		FString ClassPath;
-		FString ClassName;
-		FString ModulePath;
-		bool bIsAbstract = false;
-		bool bIsDeprecated = false;
-		bool bIsEditorOnly = false;
-	};
-
-	TArray<FWidgetClassEntry> Entries;
-	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	auto BuildSnapshot = [&](FMCPPageSnapshot& Snapshot)
 	{
-		UClass* WidgetClass = *ClassIt;
-		if (WidgetClass == nullptr || !WidgetClass->IsChildOf(UWidget::StaticClass()))
+		for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
 		{
-			continue;
-		}
+			if (OutResult.ShouldStop())
+			{
+				return false;
+			}
 
-		const FString ClassName = WidgetClass->GetName();
-		if (ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_")))
-		{
-			continue;
-		}
+			UClass* WidgetClass = *ClassIt;
+			if (WidgetClass == nullptr || !WidgetClass->IsChildOf(UWidget::StaticClass()))
+			{
+				continue;
+			}
 
-		const bool bIsAbstract = WidgetClass->HasAnyClassFlags(CLASS_Abstract);
-		const bool bIsDeprecated = WidgetClass->HasAnyClassFlags(CLASS_Deprecated | CLASS_NewerVersionExists);
-		const bool bIsEditorOnly = WidgetClass->IsEditorOnly();
+			const FString ClassName = WidgetClass->GetName();
+			if (ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_")))
+			{
+				continue;
+			}
 
-		if (!bIncludeAbstract && bIsAbstract)
-		{
-			continue;
-		}
-		if (!bIncludeDeprecated && bIsDeprecated)
-		{
-			continue;
-		}
-		if (!bIncludeEditorOnly && bIsEditorOnly)
-		{
-			continue;
-		}
+			const bool bIsAbstract = WidgetClass->HasAnyClassFlags(CLASS_Abstract);
+			const bool bIsDeprecated = WidgetClass->HasAnyClassFlags(CLASS_Deprecated | CLASS_NewerVersionExists);
+			const bool bIsEditorOnly = WidgetClass->IsEditorOnly();
 
-		const FString ClassPath = WidgetClass->GetClassPathName().ToString();
-		if (!ClassPathGlob.IsEmpty() && !ClassPath.MatchesWildcard(ClassPathGlob))
-		{
-			continue;
-		}
-		if (!NameGlob.IsEmpty() && !ClassName.MatchesWildcard(NameGlob))
-		{
-			continue;
-		}
+			if (!bIncludeAbstract && bIsAbstract)
+			{
+				continue;
+			}
+			if (!bIncludeDeprecated && bIsDeprecated)
+			{
+				continue;
+			}
+			if (!bIncludeEditorOnly && bIsEditorOnly)
+			{
+				continue;
+			}
 
-		FWidgetClassEntry Entry;
-		Entry.ClassPath = ClassPath;
-		Entry.ClassName = ClassName;
-		Entry.ModulePath = WidgetClass->GetClassPathName().GetPackageName().ToString();
-		Entry.bIsAbstract = bIsAbstract;
-		Entry.bIsDeprecated = bIsDeprecated;
-		Entry.bIsEditorOnly = bIsEditorOnly;
-		Entries.Add(MoveTemp(Entry));
-	}
+			const FString ClassPath = WidgetClass->GetClassPathName().ToString();
+			if (!ClassPathGlob.IsEmpty() && !ClassPath.MatchesWildcard(ClassPathGlob))
+			{
+				continue;
+			}
+			if (!NameGlob.IsEmpty() && !ClassName.MatchesWildcard(NameGlob))
+			{
+				continue;
+			}
 
-	Entries.Sort([](const FWidgetClassEntry& Left, const FWidgetClassEntry& Right)
-	{
-		return Left.ClassPath < Right.ClassPath;
-	});
-
-	const int32 SafeCursor = FMath::Clamp(Cursor, 0, Entries.Num());
-	const int32 EndIndex = FMath::Min(SafeCursor + Limit, Entries.Num());
-	TArray<TSharedPtr<FJsonValue>> ClassValues;
-	ClassValues.Reserve(EndIndex - SafeCursor);
-	for (int32 Index = SafeCursor; Index < EndIndex; ++Index)
+			TSharedRef<FJsonObject> ClassObject = MakeShared<FJsonObject>();
+			ClassObject->SetStringField(TEXT("class_path"), ClassPath);
+			ClassObject->SetStringField(TEXT("class_name"), ClassName);
+			ClassObject->SetStringField(TEXT("module_path"), WidgetClass->GetClassPathName().GetPackageName().ToString());
+			ClassObject->SetBoolField(TEXT("is_abstract"), bIsAbstract);
+			ClassObject->SetBoolField(TEXT("is_deprecated"), bIsDeprecated);
+			ClassObject->SetBoolField(TEXT("is_editor_only"), bIsEditorOnly);
+			Snapshot.Items.Add(MakeShared<FJsonValueObject>(ClassObject));
+			Snapshot.SortKeys.Add(MCPToolPaging::MakeSortKey({ ClassPath.ToLower(), ClassPath }));
+		}
+		return true;
+	};
+
+	FMCPPage Page;
+	FMCPDiagnostic PageDiagnostic;
+	if (!MCPToolPaging::ServePage(Request, Limit, BuildSnapshot, Page, PageDiagnostic))
 	{
-		const FWidgetClassEntry& Entry = Entries[Index];
-		TSharedRef<FJsonObject> ClassObject = MakeShared<FJsonObject>();
-		ClassObject->SetStringField(TEXT("class_path"), Entry.ClassPath);
-		ClassObject->SetStringField(TEXT("class_name"), Entry.ClassName);
-		ClassObject->SetStringField(TEXT("module_path"), Entry.ModulePath);
-		ClassObject->SetBoolField(TEXT("is_abstract"), Entry.bIsAbstract);
-		ClassObject->SetBoolField(TEXT("is_deprecated"), Entry.bIsDeprecated);
-		ClassObject->SetBoolField(TEXT("is_editor_only"), Entry.bIsEditorOnly);
-		ClassValues.Add(MakeShared<FJsonValueObject>(ClassObject));
+		OutResult.Diagnostics.Add(PageDiagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
 	}
 
 	OutResult.ResultObject = MakeShared<FJsonObject>();
-	OutResult.ResultObject->SetArrayField(TEXT("classes"), ClassValues);
-	OutResult.ResultObject->SetNumberField(TEXT("total_count"), Entries.Num());
-	if (EndIndex < Entries.Num())
+	OutResult.ResultObject->SetArrayField(TEXT("classes"), Page.Items);
+	OutResult.ResultObject->SetNumberField(TEXT("total_count"), Page.TotalCount);
+	if (!Page.NextCursor.IsEmpty())
 	{
-		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), FString::FromInt(EndIndex));
+		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), Page.NextCursor);
 	}
 	OutResult.Status = EMCPResponseStatus::Ok;
 	return true;
@@ -634,6 +620,7 @@ bool FMCPToolsUMGReadHandler::HandleTreeGet(const FMCPRequestEnvelope& Request,
 			0,
 			bIncludeSlotSummary,
 			bIncludeLayoutSummary,
+			OutResult,
 			Nodes);
 	}
 
@@ -686,6 +673,7 @@ bool FMCPToolsUMGReadHandler::HandleTreeGet(const FMCPRequestEnvelope& Request,
 			0,
 			bIncludeSlotSummary,
 			bIncludeLayoutSummary,
+			OutResult,
 			Nodes);
 	}
 
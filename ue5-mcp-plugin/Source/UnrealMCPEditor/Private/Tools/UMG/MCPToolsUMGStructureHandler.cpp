@@ -1,8 +1,12 @@
 #include "Tools/UMG/MCPToolsUMGStructureHandler.h"
 
+#include "Editor.h"
+#include "MCPBlueprintCompileSubsystem.h"
 #include "MCPErrorCodes.h"
 #include "MCPObjectUtils.h"
+#include "MCPTime.h"
 #include "Tools/Common/MCPToolCommonJson.h"
+#include "Tools/Common/MCPToolUMGUtils.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetTree.h"
 #include "Components/ContentWidget.h"
@@ -202,20 +206,12 @@ bool FMCPToolsUMGStructureHandler::HandleBlueprintPatch(
 		MCPToolCommonJson::CollectChangedPropertiesFromPatchOperations(&PatchOperations, ChangedProperties);
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -231,6 +227,91 @@ bool FMCPToolsUMGStructureHandler::HandleBlueprintPatch(
 	return true;
 }
 
+bool FMCPToolsUMGStructureHandler::HandleBlueprintCompile(
+	const FMCPRequestEnvelope& Request,
+	FMCPToolExecutionResult& OutResult,
+	FLoadWidgetBlueprintByPathFn LoadWidgetBlueprintByPath)
+{
+	FString ObjectPath;
+	bool bAutoSave = false;
+	if (Request.Params.IsValid())
+	{
+		Request.Params->TryGetStringField(TEXT("object_path"), ObjectPath);
+		ParseAutoSaveOption(Request.Params, bAutoSave);
+	}
+
+	UWidgetBlueprint* WidgetBlueprint = nullptr;
+	if (!ObjectPath.IsEmpty())
+	{
+		WidgetBlueprint = LoadWidgetBlueprintByPath(ObjectPath);
+		if (WidgetBlueprint == nullptr)
+		{
+			FMCPDiagnostic Diagnostic;
+			Diagnostic.Code = MCPErrorCodes::OBJECT_NOT_FOUND;
+			Diagnostic.Message = TEXT("Widget blueprint not found.");
+			Diagnostic.Detail = ObjectPath;
+			OutResult.Diagnostics.Add(Diagnostic);
+			OutResult.Status = EMCPResponseStatus::Error;
+			return false;
+		}
+	}
+
+	UMCPBlueprintCompileSubsystem* CompileSubsystem = GEditor ? GEditor->GetEditorSubsystem<UMCPBlueprintCompileSubsystem>() : nullptr;
+	if (CompileSubsystem == nullptr)
+	{
+		FMCPDiagnostic Diagnostic;
+		Diagnostic.Code = MCPErrorCodes::INTERNAL_EXCEPTION;
+		Diagnostic.Message = TEXT("Blueprint compile subsystem is unavailable.");
+		OutResult.Diagnostics.Add(Diagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
+	}
+
+	const int32 PendingBefore = CompileSubsystem->GetPendingCount();
+	FMCPBlueprintFlushResult FlushResult;
+	if (!Request.Context.bDryRun)
+	{
+		if (WidgetBlueprint != nullptr)
+		{
+			CompileSubsystem->FlushBlueprint(WidgetBlueprint, bAutoSave, FlushResult);
+		}
+		else
+		{
+			CompileSubsystem->Flush(FlushResult);
+		}
+	}
+
+	for (const FString& CompiledObjectPath : FlushResult.CompiledObjectPaths)
+	{
+		const int32 DotIndex = CompiledObjectPath.Find(TEXT("."), ESearchCase::CaseSensitive);
+		OutResult.TouchedPackages.AddUnique(DotIndex == INDEX_NONE ? CompiledObjectPath : CompiledObjectPath.Left(DotIndex));
+	}
+
+	for (const FString& PackageName : FlushResult.FailedSavePackages)
+	{
+		FMCPDiagnostic Diagnostic;
+		Diagnostic.Code = MCPErrorCodes::SAVE_FAILED;
+		Diagnostic.Severity = TEXT("warning");
+		Diagnostic.Message = TEXT("Package save failed after blueprint compile.");
+		Diagnostic.Detail = PackageName;
+		Diagnostic.bRetriable = true;
+		OutResult.Diagnostics.Add(Diagnostic);
+	}
+
+	OutResult.ResultObject = MakeShared<FJsonObject>();
+	OutResult.ResultObject->SetBoolField(TEXT("dry_run"), Request.Context.bDryRun);
+	OutResult.ResultObject->SetBoolField(TEXT("deferred_compile_enabled"), CompileSubsystem->IsDeferredCompileEnabled());
+	OutResult.ResultObject->SetNumberField(TEXT("pending_before"), PendingBefore);
+	OutResult.ResultObject->SetNumberField(TEXT("pending_after"), CompileSubsystem->GetPendingCount());
+	OutResult.ResultObject->SetArrayField(TEXT("compiled"), MCPToolCommonJson::ToJsonStringArray(FlushResult.CompiledObjectPaths));
+	OutResult.ResultObject->SetNumberField(TEXT("coalesced_request_count"), FlushResult.CoalescedRequestCount);
+	OutResult.ResultObject->SetNumberField(TEXT("compile_ms"), MCPTime::MicrosecondsToMilliseconds(FlushResult.CompileDurationUs));
+	OutResult.ResultObject->SetArrayField(TEXT("saved_packages"), MCPToolCommonJson::ToJsonStringArray(FlushResult.SavedPackages));
+	OutResult.ResultObject->SetArrayField(TEXT("touched_packages"), MCPToolCommonJson::ToJsonStringArray(OutResult.TouchedPackages));
+	OutResult.Status = FlushResult.FailedSavePackages.Num() == 0 ? EMCPResponseStatus::Ok : EMCPResponseStatus::Partial;
+	return true;
+}
+
 bool FMCPToolsUMGStructureHandler::HandleBlueprintReparent(
 	const FMCPRequestEnvelope& Request,
 	FMCPToolExecutionResult& OutResult,
@@ -690,20 +771,12 @@ bool FMCPToolsUMGStructureHandler::HandleWidgetAdd(
 		}
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -810,20 +883,12 @@ bool FMCPToolsUMGStructureHandler::HandleWidgetRemove(
 		EnsureWidgetGuidMap(WidgetBlueprint);
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1134,20 +1199,12 @@ bool FMCPToolsUMGStructureHandler::HandleWidgetReparent(
 		}
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, bAutoSave, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	bool bAllSaved = true;
-	if (!Request.Context.bDryRun && bAutoSave)
+	if (!Request.Context.bDryRun && bAutoSave && !bSaveDeferred)
 	{
 		for (const FString& PackageName : OutResult.TouchedPackages)
 		{
@@ -1239,16 +1296,8 @@ bool FMCPToolsUMGStructureHandler::HandleWidgetPatch(
 		MCPToolCommonJson::CollectChangedPropertiesFromPatchOperations(PatchOperations, ChangedProperties);
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, false, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	OutResult.ResultObject = MakeShared<FJsonObject>();
@@ -1381,16 +1430,8 @@ bool FMCPToolsUMGStructureHandler::HandleWidgetPatchV2(
 		MCPToolCommonJson::CollectChangedPropertiesFromPatchOperations(PatchOperations, ChangedProperties);
 	}
 
-	TSharedRef<FJsonObject> CompileObject = MakeShared<FJsonObject>();
-	if (bCompileOnSuccess && !Request.Context.bDryRun)
-	{
-		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-		CompileObject->SetStringField(TEXT("status"), TEXT("requested"));
-	}
-	else
-	{
-		CompileObject->SetStringField(TEXT("status"), TEXT("skipped"));
-	}
+	bool bSaveDeferred = false;
+	TSharedRef<FJsonObject> CompileObject = MCPToolUMGUtils::RequestWidgetBlueprintCompile(WidgetBlueprint, bCompileOnSuccess && !Request.Context.bDryRun, false, Request.RequestId, bSaveDeferred);
 
 	MCPObjectUtils::AppendTouchedPackage(WidgetBlueprint, OutResult.TouchedPackages);
 	OutResult.ResultObject = MakeShared<FJsonObject>();
@@ -47,6 +47,10 @@ struct FMCPToolsUMGStructureHandler
 		FMCPToolExecutionResult& OutResult,
 		FLoadWidgetBlueprintByPathFn LoadWidgetBlueprintByPath,
 		FSavePackageByNameFn SavePackageByName);
+	static bool HandleBlueprintCompile(
+		const FMCPRequestEnvelope& Request,
+		FMCPToolExecutionResult& OutResult,
+		FLoadWidgetBlueprintByPathFn LoadWidgetBlueprintByPath);
 	static bool HandleBlueprintReparent(
 		const FMCPRequestEnvelope& Request,
 		FMCPToolExecutionResult& OutResult,
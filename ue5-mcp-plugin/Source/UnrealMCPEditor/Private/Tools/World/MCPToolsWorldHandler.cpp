@@ -2,7 +2,9 @@
 
 #include "MCPErrorCodes.h"
 #include "MCPObjectUtils.h"
+#include "MCPPageSnapshotSubsystem.h"
 #include "Tools/Common/MCPToolCommonJson.h"
+#include "Tools/Common/MCPToolPaging.h"
 #include "Editor.h"
 #include "Engine/Selection.h"
 #include "EngineUtils.h"
@@ -68,7 +70,6 @@ bool FMCPToolsWorldHandler::HandleOutlinerList(const FMCPRequestEnvelope& Reques
 	}
 
 	int32 Limit = 200;
-	const int32 Cursor = MCPToolCommonJson::ParseCursor(Request.Params);
 	bool bIncludeClassPath = true;
 	bool bIncludeFolderPath = true;
 	bool bIncludeTags = false;
@@ -110,128 +111,123 @@ bool FMCPToolsWorldHandler::HandleOutlinerList(const FMCPRequestEnvelope& Reques
 		}
 	}
 
-	TArray<TSharedPtr<FJsonObject>> AllNodes;
-	TSet<FString> FolderPaths;
 	USelection* Selection = GEditor ? GEditor->GetSelectedActors() : nullptr;
-
-	for (TActorIterator<AActor> It(World); It; ++It)
+	auto BuildSnapshot = [&](FMCPPageSnapshot& Snapshot)
 	{
-		AActor* Actor = *It;
-		if (Actor == nullptr)
-		{
-			continue;
-		}
+		TSet<FString> FolderPaths;
+		bool bComplete = true;
 
-		const FString ActorLabel = Actor->GetActorLabel();
-		if (!NameGlob.IsEmpty() && !ActorLabel.MatchesWildcard(NameGlob))
+		for (TActorIterator<AActor> It(World); It; ++It)
 		{
-			continue;
-		}
+			if (OutResult.ShouldStop())
+			{
+				bComplete = false;
+				break;
+			}
 
-		const FString ClassPath = Actor->GetClass() ? Actor->GetClass()->GetPathName() : FString();
-		if (AllowedClassPaths.Num() > 0 && !AllowedClassPaths.Contains(ClassPath))
-		{
-			continue;
-		}
+			AActor* Actor = *It;
+			if (Actor == nullptr)
+			{
+				continue;
+			}
 
-		const FString FolderPath = Actor->GetFolderPath().ToString();
-		if (bIncludeFolderPath && !FolderPath.IsEmpty())
-		{
-			FolderPaths.Add(FolderPath);
-		}
+			const FString ActorLabel = Actor->GetActorLabel();
+			if (!NameGlob.IsEmpty() && !ActorLabel.MatchesWildcard(NameGlob))
+			{
+				continue;
+			}
 
-		TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
-		NodeObject->SetStringField(TEXT("node_type"), TEXT("actor"));
-		NodeObject->SetStringField(TEXT("id"), Actor->GetActorGuid().IsValid() ? Actor->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens) : MCPObjectUtils::BuildActorPath(Actor));
-		NodeObject->SetStringField(TEXT("name"), ActorLabel);
-		NodeObject->SetStringField(TEXT("actor_path"), MCPObjectUtils::BuildActorPath(Actor));
-		NodeObject->SetStringField(TEXT("folder_path"), FolderPath);
-		NodeObject->SetStringField(TEXT("parent_id"), FolderPath.IsEmpty() ? TEXT("") : FString::Printf(TEXT("folder:%s"), *FolderPath));
-		NodeObject->SetStringField(TEXT("class_path"), bIncludeClassPath ? ClassPath : TEXT(""));
-		NodeObject->SetBoolField(TEXT("is_selected"), Selection != nullptr && Selection->IsSelected(Actor));
-		NodeObject->SetBoolField(TEXT("is_hidden_in_editor"), Actor->IsHiddenEd());
-
-		if (bIncludeTags)
-		{
-			TArray<FString> TagStrings;
-			TagStrings.Reserve(Actor->Tags.Num());
-			for (const FName& Tag : Actor->Tags)
+			const FString ClassPath = Actor->GetClass() ? Actor->GetClass()->GetPathName() : FString();
+			if (AllowedClassPaths.Num() > 0 && !AllowedClassPaths.Contains(ClassPath))
 			{
-				TagStrings.Add(Tag.ToString());
+				continue;
 			}
-			NodeObject->SetArrayField(TEXT("tags"), MCPToolCommonJson::ToJsonStringArray(TagStrings));
-		}
 
-		if (bIncludeTransform)
-		{
-			const FTransform Transform = Actor->GetActorTransform();
-			TSharedRef<FJsonObject> TransformObject = MakeShared<FJsonObject>();
-			TransformObject->SetStringField(TEXT("location"), Transform.GetLocation().ToCompactString());
-			TransformObject->SetStringField(TEXT("rotation"), Transform.GetRotation().Rotator().ToCompactString());
-			TransformObject->SetStringField(TEXT("scale"), Transform.GetScale3D().ToCompactString());
-			NodeObject->SetObjectField(TEXT("transform"), TransformObject);
-		}
+			const FString FolderPath = Actor->GetFolderPath().ToString();
+			if (bIncludeFolderPath && !FolderPath.IsEmpty())
+			{
+				FolderPaths.Add(FolderPath);
+			}
 
-		AllNodes.Add(NodeObject);
-	}
+			const FString ActorId = Actor->GetActorGuid().IsValid() ? Actor->GetActorGuid().ToString(EGuidFormats::DigitsWithHyphens) : MCPObjectUtils::BuildActorPath(Actor);
+			TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+			NodeObject->SetStringField(TEXT("node_type"), TEXT("actor"));
+			NodeObject->SetStringField(TEXT("id"), ActorId);
+			NodeObject->SetStringField(TEXT("name"), ActorLabel);
+			NodeObject->SetStringField(TEXT("actor_path"), MCPObjectUtils::BuildActorPath(Actor));
+			NodeObject->SetStringField(TEXT("folder_path"), FolderPath);
+			NodeObject->SetStringField(TEXT("parent_id"), FolderPath.IsEmpty() ? TEXT("") : FString::Printf(TEXT("folder:%s"), *FolderPath));
+			NodeObject->SetStringField(TEXT("class_path"), bIncludeClassPath ? ClassPath : TEXT(""));
+			NodeObject->SetBoolField(TEXT("is_selected"), Selection != nullptr && Selection->IsSelected(Actor));
+			NodeObject->SetBoolField(TEXT("is_hidden_in_editor"), Actor->IsHiddenEd());
+
+			if (bIncludeTags)
+			{
+				TArray<FString> TagStrings;
+				TagStrings.Reserve(Actor->Tags.Num());
+				for (const FName& Tag : Actor->Tags)
+				{
+					TagStrings.Add(Tag.ToString());
+				}
+				NodeObject->SetArrayField(TEXT("tags"), MCPToolCommonJson::ToJsonStringArray(TagStrings));
+			}
 
-	if (bIncludeFolderPath)
-	{
-		TArray<FString> SortedFolders = FolderPaths.Array();
-		SortedFolders.Sort();
-		for (const FString& FolderPath : SortedFolders)
-		{
-			TSharedRef<FJsonObject> FolderNode = MakeShared<FJsonObject>();
-			FolderNode->SetStringField(TEXT("node_type"), TEXT("folder"));
-			FolderNode->SetStringField(TEXT("id"), FString::Printf(TEXT("folder:%s"), *FolderPath));
-			FolderNode->SetStringField(TEXT("folder_path"), FolderPath);
-
-			FString ParentFolderPath;
-			FString FolderName = FolderPath;
-			int32 SeparatorIndex = INDEX_NONE;
-			if (FolderPath.FindLastChar(TEXT('/'), SeparatorIndex))
+			if (bIncludeTransform)
 			{
-				FolderName = FolderPath.Mid(SeparatorIndex + 1);
-				ParentFolderPath = FolderPath.Left(SeparatorIndex);
+				const FTransform Transform = Actor->GetActorTransform();
+				TSharedRef<FJsonObject> TransformObject = MakeShared<FJsonObject>();
+				TransformObject->SetStringField(TEXT("location"), Transform.GetLocation().ToCompactString());
+				TransformObject->SetStringField(TEXT("rotation"), Transform.GetRotation().Rotator().ToCompactString());
+				TransformObject->SetStringField(TEXT("scale"), Transform.GetScale3D().ToCompactString());
+				NodeObject->SetObjectField(TEXT("transform"), TransformObject);
 			}
 
-			FolderNode->SetStringField(TEXT("name"), FolderName);
-			FolderNode->SetStringField(TEXT("parent_id"), ParentFolderPath.IsEmpty() ? TEXT("") : FString::Printf(TEXT("folder:%s"), *ParentFolderPath));
-			AllNodes.Add(FolderNode);
+			Snapshot.Items.Add(MakeShared<FJsonValueObject>(NodeObject));
+			Snapshot.SortKeys.Add(MCPToolPaging::MakeSortKey({ TEXT("actor"), ActorLabel.ToLower(), ActorId }));
 		}
-	}
 
-	AllNodes.Sort([](const TSharedPtr<FJsonObject>& Left, const TSharedPtr<FJsonObject>& Right)
-	{
-		FString LeftType;
-		FString RightType;
-		Left->TryGetStringField(TEXT("node_type"), LeftType);
-		Right->TryGetStringField(TEXT("node_type"), RightType);
-		if (LeftType != RightType)
+		if (bIncludeFolderPath)
 		{
-			return LeftType < RightType;
+			for (const FString& FolderPath : FolderPaths)
+			{
+				TSharedRef<FJsonObject> FolderNode = MakeShared<FJsonObject>();
+				FolderNode->SetStringField(TEXT("node_type"), TEXT("folder"));
+				FolderNode->SetStringField(TEXT("id"), FString::Printf(TEXT("folder:%s"), *FolderPath));
+				FolderNode->SetStringField(TEXT("folder_path"), FolderPath);
+
+				FString ParentFolderPath;
+				FString FolderName = FolderPath;
+				int32 SeparatorIndex = INDEX_NONE;
+				if (FolderPath.FindLastChar(TEXT('/'), SeparatorIndex))
+				{
+					FolderName = FolderPath.Mid(SeparatorIndex + 1);
+					ParentFolderPath = FolderPath.Left(SeparatorIndex);
+				}
+
+				FolderNode->SetStringField(TEXT("name"), FolderName);
+				FolderNode->SetStringField(TEXT("parent_id"), ParentFolderPath.IsEmpty() ? TEXT("") : FString::Printf(TEXT("folder:%s"), *ParentFolderPath));
+				Snapshot.Items.Add(MakeShared<FJsonValueObject>(FolderNode));
+				Snapshot.SortKeys.Add(MCPToolPaging::MakeSortKey({ TEXT("folder"), FolderName.ToLower(), FolderPath }));
+			}
 		}
 
-		FString LeftName;
-		FString RightName;
-		Left->TryGetStringField(TEXT("name"), LeftName);
-		Right->TryGetStringField(TEXT("name"), RightName);
-		return LeftName < RightName;
-	});
-
-	const int32 SafeCursor = FMath::Max(0, Cursor);
-	const int32 EndIndex = FMath::Min(SafeCursor + Limit, AllNodes.Num());
-	TArray<TSharedPtr<FJsonValue>> OutputNodes;
-	for (int32 Index = SafeCursor; Index < EndIndex; ++Index)
+		return bComplete;
+	};
+
+	FMCPPage Page;
+	FMCPDiagnostic PageDiagnostic;
+	if (!MCPToolPaging::ServePage(Request, Limit, BuildSnapshot, Page, PageDiagnostic))
 	{
-		OutputNodes.Add(MakeShared<FJsonValueObject>(AllNodes[Index].ToSharedRef()));
+		OutResult.Diagnostics.Add(PageDiagnostic);
+		OutResult.Status = EMCPResponseStatus::Error;
+		return false;
 	}
 
 	OutResult.ResultObject = MakeShared<FJsonObject>();
-	OutResult.ResultObject->SetArrayField(TEXT("nodes"), OutputNodes);
-	if (EndIndex < AllNodes.Num())
+	OutResult.ResultObject->SetArrayField(TEXT("nodes"), Page.Items);
+	if (!Page.NextCursor.IsEmpty())
 	{
-		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), FString::FromInt(EndIndex));
+		OutResult.ResultObject->SetStringField(TEXT("next_cursor"), Page.NextCursor);
 	}
 	OutResult.Status = EMCPResponseStatus::Ok;
 	return true;
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#if __has_include("Subsystems/EditorSubsystem.h")
+#include "Subsystems/EditorSubsystem.h"
+#elif __has_include("EditorSubsystem.h")
+#include "EditorSubsystem.h"
+#else
+#error "EditorSubsystem header not found. Check UnrealEd dependency."
+#endif
+#include "HAL/CriticalSection.h"
+#include "MCPAssetIndexSubsystem.generated.h"
+
+struct FAssetData;
+
+struct FMCPAssetQuery
+{
+	FString PathGlob;
+	FString NameGlob;
+	TSet<FString> ClassPaths;
+	// Keyset cursor: only assets sorting after this object path are returned. Offset still applies afterwards.
+	FString AfterObjectPath;
+	int32 Offset = 0;
+	int32 Limit = 50;
+};
+
+struct FMCPAssetQueryRow
+{
+	FString ObjectPath;
+	FString ClassPath;
+	FString PackagePath;
+	FString AssetName;
+};
+
+struct FMCPAssetQueryResult
+{
+	TArray<FMCPAssetQueryRow> Rows;
+	bool bHasMore = false;
+	int32 ScannedCount = 0;
+};
+
+// Incremental asset.find index fed by asset registry delegates. Object paths are kept sorted
+// (lowercased) so path globs resolve to a binary-searched prefix range, with class and name
+// trigram postings used when they are more selective than the path range. Queries share a read
+// lock; registry events are queued and only applied by PrepareForQuery, so they never wait on a scan.
+// A backlog past the queue cap is dropped and the next PrepareForQuery rebuilds from the registry.
+UCLASS()
+class UNREALMCPEDITOR_API UMCPAssetIndexSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Game thread only. Builds the index on first use and merges registry changes seen since the last query.
+	void PrepareForQuery();
+
+	// Safe to call from worker threads once PrepareForQuery has run. Returns false when ShouldStop interrupted the scan.
+	bool Query(const FMCPAssetQuery& InQuery, FMCPAssetQueryResult& OutResult, TFunctionRef<bool()> ShouldStop) const;
+
+	int32 GetIndexedAssetCount() const;
+
+private:
+	struct FIndexedAsset
+	{
+		FString ObjectPath;
+		FString ObjectPathLower;
+		FString PackagePath;
+		FString ClassPath;
+		FString AssetName;
+		bool bAlive = true;
+	};
+
+	struct FRegistryEvent
+	{
+		FIndexedAsset Asset;
+		// Set for renames; the asset is re-added under its new path.
+		FString OldObjectPath;
+		bool bRemoved = false;
+	};
+
+	static FIndexedAsset MakeIndexedAsset(const FAssetData& AssetData);
+
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void QueueRegistryEvent(FRegistryEvent&& Event);
+	void ApplyRegistryEventsLocked();
+
+	void BuildFromRegistryLocked();
+	void RebuildSecondaryIndexesLocked();
+	int32 AddAssetLocked(FIndexedAsset&& NewAsset);
+	void RemoveAssetLocked(const FString& ObjectPath);
+	void MergePendingLocked();
+	bool LessByPath(int32 LeftId, int32 RightId) const;
+
+	// Writers are PrepareForQuery and Deinitialize on the game thread; Query and counters read.
+	mutable FRWLock IndexLock;
+	TArray<FIndexedAsset> Assets;
+	TMap<FString, int32> IdByObjectPath;
+	TArray<int32> SortedIds;
+	TArray<int32> UnsortedIds;
+	TMap<FString, TArray<int32>> IdsByClassPath;
+	TMap<uint64, TArray<int32>> IdsByNameTrigram;
+	int32 DeadCount = 0;
+	bool bBuilt = false;
+
+	FCriticalSection RegistryEventGuard;
+	TArray<FRegistryEvent> PendingRegistryEvents;
+	// Events before the first build are covered by its GetAllAssets snapshot and are not queued.
+	bool bRecordRegistryEvents = false;
+	// Set when the queue hit its cap; the queued events were discarded and the index must be rebuilt.
+	bool bRegistryEventsOverflowed = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+};
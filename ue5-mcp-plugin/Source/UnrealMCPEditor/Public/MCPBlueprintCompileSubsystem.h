@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#if __has_include("Subsystems/EditorSubsystem.h")
+#include "Subsystems/EditorSubsystem.h"
+#elif __has_include("EditorSubsystem.h")
+#include "EditorSubsystem.h"
+#else
+#error "EditorSubsystem header not found. Check UnrealEd dependency."
+#endif
+#include "Containers/Ticker.h"
+#include "MCPBlueprintCompileSubsystem.generated.h"
+
+class UBlueprint;
+
+struct FMCPBlueprintFlushResult
+{
+	TArray<FString> CompiledObjectPaths;
+	TArray<FString> SavedPackages;
+	TArray<FString> FailedSavePackages;
+	// Requests whose deferred save is among FailedSavePackages.
+	TArray<FString> FailedSaveRequestIds;
+	int32 CoalescedRequestCount = 0;
+	int64 CompileDurationUs = 0;
+};
+
+// Tracks blueprints that UMG write tools have modified and compiles each of them once per flush
+// (end of an mcp.batch, an explicit umg.blueprint.compile, or after the idle debounce). Steady
+// traffic cannot hold a compile back for longer than MaxDeferralMs.
+UCLASS()
+class UNREALMCPEDITOR_API UMCPBlueprintCompileSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	bool IsDeferredCompileEnabled() const;
+
+	// Returns true when the compile (and optional save) was queued; false means it compiled now and the caller still owns the save.
+	// RequestId attributes a later deferred save failure to the request that asked for it.
+	bool RequestCompile(UBlueprint* Blueprint, bool bSaveAfterCompile, const FString& RequestId = FString());
+
+	void BeginBatchScope();
+	void EndBatchScope(FMCPBlueprintFlushResult& OutResult);
+
+	void Flush(FMCPBlueprintFlushResult& OutResult);
+	void FlushBlueprint(UBlueprint* Blueprint, bool bSaveAfterCompile, FMCPBlueprintFlushResult& OutResult);
+	int32 GetPendingCount() const;
+
+private:
+	struct FPendingCompile
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+		int32 RequestCount = 0;
+		bool bSaveAfterCompile = false;
+		TArray<FString> RequestIds;
+	};
+
+	void LoadSettings();
+	bool HandleIdleTicker(float DeltaSeconds);
+	void CompilePending(const FString& ObjectPath, FPendingCompile&& Pending, FMCPBlueprintFlushResult& OutResult);
+	// Idle flushes have no response to attach diagnostics to, so failed saves go to the event stream
+	// under each originating request id.
+	void ReportFailedIdleSaves(const FMCPBlueprintFlushResult& FlushResult) const;
+
+	TMap<FString, FPendingCompile> PendingCompiles;
+	int32 BatchScopeDepth = 0;
+	uint64 LastRequestCycles = 0;
+	uint64 FirstPendingCycles = 0;
+	FTSTicker::FDelegateHandle IdleTickHandle;
+
+	bool bDeferCompile = true;
+	int32 IdleDebounceMs = 750;
+	int32 MaxDeferralMs = 5000;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class IFileHandle;
+
+struct FMCPJournalRecordLocation
+{
+	int32 SegmentId = INDEX_NONE;
+	// Byte offset of the record header within the segment.
+	int64 Offset = 0;
+	// Payload bytes, excluding the record header.
+	int32 Length = 0;
+
+	bool IsValid() const
+	{
+		return SegmentId != INDEX_NONE;
+	}
+};
+
+// Append-only changeset journal split into rolling segment files. Each record is a length and CRC
+// header followed by a UTF-8 JSON payload, so a record is read back with one positioned read and a
+// torn tail is detected on scan. Segments are only ever deleted whole.
+class UNREALMCPEDITOR_API FMCPChangeSetJournal
+{
+public:
+	FMCPChangeSetJournal(const FString& InJournalDir, int64 InMaxSegmentBytes);
+	~FMCPChangeSetJournal();
+
+	// Appends to the active segment, sealing it and opening the next one once it is full.
+	bool Append(const FString& Payload, FMCPJournalRecordLocation& OutLocation);
+	// Makes every appended record durable; writers call this once per batch.
+	bool Flush();
+	bool Read(const FMCPJournalRecordLocation& Location, FString& OutPayload) const;
+	// Sequential scan of every segment, oldest first. Stops at the first torn record of a segment.
+	void ForEachRecord(TFunctionRef<void(const FMCPJournalRecordLocation&, const FString&)> Visitor) const;
+	// Same scan for one segment; false when the segment cannot be read at all.
+	bool ForEachSegmentRecord(int32 SegmentId, TFunctionRef<void(const FMCPJournalRecordLocation&, const FString&)> Visitor) const;
+
+	TArray<int32> GetSegmentIds() const;
+	int32 GetActiveSegmentId() const;
+	int64 GetSegmentSizeBytes(int32 SegmentId) const;
+	bool DeleteSegment(int32 SegmentId);
+	// Seals the active segment so the next append starts a new one.
+	void Seal();
+	FDateTime GetLatestTimeStamp() const;
+
+	const FString& GetJournalDir() const
+	{
+		return JournalDir;
+	}
+
+	static constexpr int64 RecordHeaderBytes = 8;
+
+private:
+	FString GetSegmentPath(int32 SegmentId) const;
+	bool OpenNextSegmentLocked();
+	IFileHandle* GetReadHandleLocked(int32 SegmentId) const;
+
+	FString JournalDir;
+	int64 MaxSegmentBytes = 0;
+
+	mutable FCriticalSection JournalGuard;
+	TUniquePtr<IFileHandle> ActiveHandle;
+	int32 ActiveSegmentId = INDEX_NONE;
+	int64 ActiveSegmentBytes = 0;
+	bool bActiveDirty = false;
+	mutable TMap<int32, TUniquePtr<IFileHandle>> ReadHandles;
+};
@@ -8,31 +8,87 @@
 #else
 #error "EditorSubsystem header not found. Check UnrealEd dependency."
 #endif
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "MCPChangeSetJournal.h"
 #include "MCPTypes.h"
+#include <atomic>
 #include "MCPChangeSetSubsystem.generated.h"
 
+class FEvent;
+struct FMCPPackageSnapshot;
+class UMCPSnapshotStoreSubsystem;
+
+struct FMCPChangeSetListQuery
+{
+	TArray<FString> StatusFilter;
+	FString ToolGlob;
+	FString SessionId;
+	// Keyset cursor from a previous page; only older changesets are returned.
+	FString AfterSortKey;
+	int32 Offset = 0;
+	int32 Limit = 50;
+};
+
+struct FMCPChangeSetRecordStats
+{
+	int64 ApproximateBytes = 0;
+	int32 SnapshotCount = 0;
+	// True when the record was written before CreateChangeSetRecord returned. Journaled records are
+	// flushed to disk by then; changeset directories are left to the OS write cache.
+	bool bDurable = false;
+};
+
+// A limit of zero disables that limit. Pinned changesets kept by bKeepPinned are left out of the count and byte limits.
+struct FMCPChangeSetRetentionPolicy
+{
+	int32 MaxAgeDays = 30;
+	int32 MaxCount = 1000;
+	int64 MaxBytes = 1024ll * 1024 * 1024;
+	bool bKeepPinned = true;
+};
+
+struct FMCPChangeSetGCStats
+{
+	int32 DeletedChangeSets = 0;
+	int32 DeletedSegments = 0;
+	int32 DeletedBlobs = 0;
+	int64 ReclaimedBytes = 0;
+};
+
+// Changeset records are queued to a background writer unless the request (context.durability)
+// or [UnrealMCP.ChangeSets] Durability asks for "sync", which waits for the record to be written
+// (and, for the journal, flushed to disk); the id is valid as soon as it is returned.
+// StorageMode=journal appends records to rolling segment files instead of one directory per
+// changeset; records written in either mode stay readable after switching.
 UCLASS()
 class UNREALMCPEDITOR_API UMCPChangeSetSubsystem : public UEditorSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
 	bool CreateChangeSetRecord(
 		const FMCPRequestEnvelope& Request,
 		const FMCPToolExecutionResult& Result,
 		const FString& PolicyVersion,
 		const FString& SchemaHash,
+		const TArray<FMCPPackageSnapshot>& Snapshots,
 		FString& OutChangeSetId,
+		FMCPChangeSetRecordStats& OutStats,
 		FMCPDiagnostic& OutDiagnostic) const;
 
+	// Blocks until every queued changeset record has been written.
+	void FlushPendingWrites() const;
+	int32 GetPendingWriteCount() const;
+
+	// Served from the changeset index, newest first. OutNextSortKey is empty on the last page.
 	bool ListChangeSets(
-		int32 Limit,
-		int32 Cursor,
-		const TArray<FString>& StatusFilter,
-		const FString& ToolGlob,
-		const FString& SessionId,
+		const FMCPChangeSetListQuery& Query,
 		TArray<TSharedPtr<FJsonObject>>& OutItems,
-		int32& OutNextCursor,
+		FString& OutNextSortKey,
 		FMCPDiagnostic& OutDiagnostic) const;
 
 	bool GetChangeSet(
@@ -56,10 +112,155 @@ public:
 		bool& bOutApplied,
 		FMCPDiagnostic& OutDiagnostic) const;
 
+	// Oldest first: every changeset the policy would delete, skipping pinned and not yet written ones.
+	void PlanGarbageCollection(const FMCPChangeSetRetentionPolicy& Policy, TArray<FString>& OutChangeSetIds) const;
+	// Deletes in batches, dropping each batch from the index before its records are removed and
+	// rewriting the index file after. Journaled records are tombstoned rather than removed, so an index
+	// rebuild skips them. Snapshot blobs no remaining changeset refers to are swept last.
+	void DeleteChangeSets(const TArray<FString>& ChangeSetIds, FMCPChangeSetGCStats& OutStats) const;
+	// Applies the configured retention policy. Runs on the calling thread.
+	void CollectGarbage(FMCPChangeSetGCStats& OutStats) const;
+	// Runs CollectGarbage on a background thread unless a pass is already running.
+	void ScheduleGarbageCollection() const;
+	const FMCPChangeSetRetentionPolicy& GetRetentionPolicy() const;
+
+	// Pinned changesets are skipped by GC while the retention policy keeps pinned ones.
+	bool SetChangeSetPinned(const FString& ChangeSetId, bool bPinned, FMCPDiagnostic& OutDiagnostic) const;
+	bool IsChangeSetPinned(const FString& ChangeSetId) const;
+
+	// Drops sealed journal segments with no live records and rewrites sparse ones into the active segment.
+	// Runs under the GC lock; the record writer is only held off while a single segment is moved.
+	bool CompactJournal(int32& OutDeletedSegments, int64& OutReclaimedBytes) const;
+#if WITH_DEV_AUTOMATION_TESTS
+	// Discards the loaded index and rebuilds it from the changeset directories and the journal.
+	void RebuildIndex() const;
+
+	// Overrides StorageMode for records created from now on; queued records keep the mode they were created with.
+	void SetJournalStorage(bool bEnabled);
+	bool IsJournalStorage() const;
+
+	// Seals the active journal segment, as a new editor session would find it.
+	void SealJournal() const;
+#endif
+
 	FString GetChangeSetRootDir() const;
 
+	FString GetChangeSetIndexPath() const;
+
+	FString GetChangeSetJournalDir() const;
+
+	// Directory of the record, or the journal directory for journaled records.
+	FString GetChangeSetLocation(const FString& ChangeSetId) const;
+
 private:
+	struct FIndexEntry
+	{
+		FString ChangeSetId;
+		FString RequestId;
+		FString SessionId;
+		FString Tool;
+		FString Status;
+		FString CreatedAt;
+		int64 CreatedAtMs = 0;
+		// Breaks ties between changesets created in the same millisecond; zero for older records.
+		int64 Sequence = 0;
+		FString SortKey;
+		int64 SizeBytes = 0;
+		TArray<FString> BlobHashes;
+		// Invalid for records stored as a changeset directory.
+		FMCPJournalRecordLocation JournalLocation;
+	};
+
+	struct FPendingWrite
+	{
+		FString ChangeSetId;
+		// Storage mode captured when the record was created.
+		bool bJournal = false;
+		FString MetaJson;
+		// Snapshot ref file name and contents.
+		TArray<TPair<FString, FString>> SnapshotRefs;
+		FIndexEntry IndexEntry;
+	};
+
+	void LoadSettings();
+	void LoadPins();
+	bool SavePinsLocked() const;
+	FString GetChangeSetPinsPath() const;
+	bool HandleGarbageCollectionTicker(float DeltaSeconds);
+	void ReportGarbageCollected(const FMCPChangeSetGCStats& Stats) const;
+	void SchedulePendingWrites() const;
+	bool IsShuttingDown() const;
+	// Caller must have counted the task in InFlightBackgroundTasks when scheduling it.
+	void FinishBackgroundTask() const;
+	// Records that fail to write are dropped from the index and counted in observability.
+	void DrainPendingWrites() const;
+	void ReportWriteFailures(int32 FailedCount) const;
+	bool WritePendingRecord(const FPendingWrite& Write, FMCPJournalRecordLocation& OutJournalLocation) const;
+	void WaitForPendingWrite(const FString& ChangeSetId) const;
+
+	static FString MakeIndexRecordLine(const FIndexEntry& Entry);
+	void EnsureIndexLoadedLocked() const;
+	bool LoadIndexFileLocked() const;
+	void RebuildIndexLocked() const;
+	// Takes IndexFileGuard, then snapshots the index under IndexGuard and writes it after releasing that.
+	bool RewriteIndexFile() const;
+	FString BuildIndexFileContentLocked() const;
+	// Caller holds IndexFileGuard.
+	bool WriteIndexFile(const FString& IndexContent) const;
+	void AddIndexEntryLocked(FIndexEntry&& Entry) const;
+	void RebuildSecondaryIndexesLocked() const;
+	bool AppendIndexLines(const FString& Lines) const;
+	bool FindJournalLocation(const FString& ChangeSetId, FMCPJournalRecordLocation& OutLocation) const;
+	bool ReadJournalRecord(const FString& ChangeSetId, TSharedPtr<FJsonObject>& OutRecord) const;
+
 	FString BuildChangeSetDirectory(const FString& ChangeSetId) const;
 	bool ReadJsonFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson) const;
-	bool WriteJsonFile(const FString& FilePath, const TSharedRef<FJsonObject>& JsonObject) const;
+	bool LoadSnapshotRefs(const FString& ChangeSetId, TMap<FString, TSharedPtr<FJsonObject>>& OutSnapshotsByPackage) const;
+
+	// The index is a cache over the changeset directories, so const readers may load or rebuild it.
+	mutable FCriticalSection IndexGuard;
+	// Orders index file rewrites and appends; taken before IndexGuard.
+	mutable FCriticalSection IndexFileGuard;
+	mutable TArray<FIndexEntry> IndexEntries;
+	mutable TMap<FString, TArray<int32>> EntriesByStatus;
+	mutable TMap<FString, TArray<int32>> EntriesByTool;
+	mutable TMap<FString, TArray<int32>> EntriesBySession;
+	mutable TMap<FString, int32> EntriesById;
+	mutable bool bIndexLoaded = false;
+	// Set when a rebuild could not write the index file; the next index file writer rewrites it.
+	mutable bool bIndexFileDirty = false;
+	mutable std::atomic<int64> NextChangeSetSequence { 0 };
+
+	mutable FCriticalSection WriterGuard;
+	mutable FCriticalSection DrainGuard;
+	mutable TArray<FPendingWrite> PendingWrites;
+	mutable TSet<FString> PendingChangeSetIds;
+	mutable bool bWriterScheduled = false;
+	// Guarded by WriterGuard. Once set, no background writer or GC task is scheduled, and queued ones
+	// return without touching the journal; Deinitialize waits for InFlightBackgroundTasks to drain.
+	mutable bool bShuttingDown = false;
+	mutable int32 InFlightBackgroundTasks = 0;
+	FEvent* BackgroundTasksIdleEvent = nullptr;
+
+	// Appended to by the writer under DrainGuard; reads lock inside the journal.
+	TUniquePtr<FMCPChangeSetJournal> Journal;
+
+	// Resolved on the game thread so background GC passes never look up subsystems.
+	TWeakObjectPtr<UMCPSnapshotStoreSubsystem> SnapshotStore;
+
+	mutable FCriticalSection PinGuard;
+	mutable TSet<FString> PinnedChangeSetIds;
+
+	// Serializes GC passes; bGarbageCollectionScheduled is guarded by WriterGuard.
+	mutable FCriticalSection GarbageCollectionGuard;
+	mutable bool bGarbageCollectionScheduled = false;
+	FTSTicker::FDelegateHandle GarbageCollectionTickHandle;
+	FMCPChangeSetRetentionPolicy RetentionPolicy;
+	int32 GarbageCollectionBatchSize = 64;
+	float GarbageCollectionIntervalSeconds = 600.0f;
+
+	bool bSyncDurabilityByDefault = false;
+	std::atomic<bool> bJournalStorage { false };
+	int32 MaxWriteBatchRecords = 64;
+	int32 JournalCompactLivePercent = 50;
 };
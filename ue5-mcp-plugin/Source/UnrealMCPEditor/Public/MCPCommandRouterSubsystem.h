@@ -8,6 +8,7 @@
 #else
 #error "EditorSubsystem header not found. Check UnrealEd dependency."
 #endif
+#include "MCPToolResultCache.h"
 #include "MCPTypes.h"
 #include "MCPCommandRouterSubsystem.generated.h"
 
@@ -17,22 +18,37 @@ class UNREALMCPEDITOR_API UMCPCommandRouterSubsystem : public UEditorSubsystem
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
 	UFUNCTION(BlueprintCallable, Category = "UnrealMCP")
 	FString ExecuteRequestJson(const FString& RequestJson, bool& bOutSuccess);
 
+	FString ExecuteRequestObject(const TSharedPtr<FJsonObject>& RequestObject, bool& bOutSuccess);
+
 private:
+	FString ExecuteParsedRequest(const FMCPRequestEnvelope& Request, uint64 StartCycles, bool& bOutSuccess);
+	FString ExecuteBatchRequest(const FMCPRequestEnvelope& Request, uint64 StartCycles, bool& bOutSuccess);
+	FString BuildParseFailureResponse(const FMCPDiagnostic& ParseDiagnostic, uint64 StartCycles) const;
+	void ScheduleAsyncJob(const FMCPRequestEnvelope& Request, const FString& JobId);
+	void RunAsyncJob(const FMCPRequestEnvelope& Request, const FString& JobId);
+	void CompleteAsyncJob(
+		const FMCPRequestEnvelope& Request,
+		const FString& JobId,
+		const TSharedRef<FMCPToolExecutionResult>& Execution,
+		uint64 BeginCycles);
 	bool ValidateProtocol(const FString& Protocol, FMCPDiagnostic& OutDiagnostic) const;
 	bool CheckIdempotencyReplay(
 		const FMCPRequestEnvelope& Request,
 		FString& OutCachedResponse,
+		EMCPResponseStatus& OutCachedStatus,
 		bool& bOutConflict,
 		FMCPDiagnostic& OutConflictDiagnostic);
-	void CacheIdempotencyResponse(const FMCPRequestEnvelope& Request, const FString& ResponseJson);
+	void CacheIdempotencyResponse(const FMCPRequestEnvelope& Request, const FString& ResponseJson, EMCPResponseStatus Status);
 	FString BuildIdempotencyBaseKey(const FMCPRequestEnvelope& Request) const;
-	FString BuildIdempotencyFullKey(const FMCPRequestEnvelope& Request) const;
+
+	FMCPToolResultCacheSettings LoadIdempotencySettings() const;
 
 private:
-	TMap<FString, FString> CachedResponsesByIdempotencyKey;
-	TMap<FString, FString> ParamsHashByIdempotencyBaseKey;
-	FCriticalSection IdempotencyGuard;
+	TUniquePtr<FMCPToolResultCache> IdempotencyCache;
 };
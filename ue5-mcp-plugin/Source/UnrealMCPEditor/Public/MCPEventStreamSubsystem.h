@@ -16,8 +16,11 @@ struct FMCPStreamEvent
 	FString EventId;
 	FString EventType;
 	FString RequestId;
+	FString SessionId;
+	int64 Sequence = 0;
 	int64 TimestampMs = 0;
 	TSharedPtr<FJsonObject> Payload;
+	TSharedPtr<FJsonObject> CachedJson;
 
 	TSharedRef<FJsonObject> ToJson() const;
 };
@@ -30,6 +33,10 @@ class UNREALMCPEDITOR_API UMCPEventStreamSubsystem : public UEditorSubsystem
 	GENERATED_BODY()
 
 public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void RegisterRequestSession(const FString& RequestId, const FString& SessionId);
+
 	void EmitProgress(const FString& RequestId, double Percent, const FString& Phase);
 	void EmitLog(const FString& RequestId, const FString& Level, const FString& Message, const TSharedPtr<FJsonObject>& Detail = nullptr);
 	void EmitArtifact(const FString& RequestId, const FString& ObjectPath, const FString& Action);
@@ -39,28 +46,37 @@ public:
 		const FString& Status,
 		double Progress,
 		const FString& StartedAtIso8601,
-		const FString& UpdatedAtIso8601);
+		const FString& UpdatedAtIso8601,
+		const TSharedPtr<FJsonObject>& Result = nullptr);
 	void EmitChangeSetCreated(const FString& RequestId, const FString& ChangeSetId, const FString& Path);
 
 	TArray<TSharedPtr<FJsonObject>> GetRecentEvents(int32 Limit) const;
+	TArray<TSharedPtr<FJsonObject>> GetEventsAfter(int64 AfterSequence, int32 Limit, bool& bOutGap) const;
+	int64 GetLatestSequence() const;
 	TSharedRef<FJsonObject> BuildSnapshot(int32 RecentLimit) const;
 
 	int32 GetBufferedEventCount() const;
 	int64 GetTotalEmittedEventCount() const;
 	int64 GetDroppedEventCount() const;
+	bool ShouldSuppressReadOnlyIntermediateProgress() const;
 
 	FMCPStreamEventDelegate& OnEventEmitted();
 
 private:
+	void LoadSettings();
 	void EmitEvent(const FString& EventType, const FString& RequestId, const TSharedRef<FJsonObject>& Payload);
-	static int64 GetCurrentUnixTimestampMs();
 
 private:
 	mutable FCriticalSection EventGuard;
-	TArray<FMCPStreamEvent> EventBuffer;
+	TArray<TSharedPtr<FJsonObject>> EventRing;
 	int32 MaxBufferedEvents = 256;
 	int64 TotalEmittedEvents = 0;
 	int64 DroppedEvents = 0;
+	bool bSuppressReadOnlyIntermediateProgress = false;
+	TMap<FString, FString> SessionIdByRequestId;
+	TArray<FString> TrackedSessionRequestIds;
+	int32 NextTrackedSessionSlot = 0;
+	int32 MaxTrackedRequestSessions = 1024;
 	FMCPStreamEventDelegate EventDelegate;
 };
 
@@ -8,6 +8,7 @@
 #else
 #error "EditorSubsystem header not found. Check UnrealEd dependency."
 #endif
+#include "Containers/List.h"
 #include "MCPTypes.h"
 #include "MCPJobSubsystem.generated.h"
 
@@ -24,6 +25,8 @@ enum class EMCPJobStatus : uint8
 struct FMCPJobRecord
 {
 	FString JobId;
+	FString RequestId;
+	bool bAsync = false;
 	EMCPJobStatus Status = EMCPJobStatus::Queued;
 	double Progress = 0.0;
 	FDateTime StartedAtUtc;
@@ -38,7 +41,9 @@ class UNREALMCPEDITOR_API UMCPJobSubsystem : public UEditorSubsystem
 	GENERATED_BODY()
 
 public:
-	FString CreateJob();
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	FString CreateJob(const FString& RequestId = FString(), bool bAsync = false);
 	bool UpdateJobStatus(const FString& JobId, EMCPJobStatus Status, double Progress);
 	bool FinalizeJob(
 		const FString& JobId,
@@ -47,10 +52,36 @@ public:
 		const TArray<FMCPDiagnostic>& Diagnostics);
 	bool GetJob(const FString& JobId, FMCPJobRecord& OutRecord) const;
 	bool CancelJob(const FString& JobId, FMCPJobRecord& OutRecord, FMCPDiagnostic& OutDiagnostic);
+	void RegisterCancellationToken(const FString& JobId, const TSharedRef<FMCPCancellationToken>& Token);
+	void UnregisterCancellationToken(const FString& JobId, const TSharedRef<FMCPCancellationToken>& Token);
+
+	int32 GetRetainedJobCount() const;
 
 	static FString StatusToString(EMCPJobStatus Status);
 
 private:
-	TMap<FString, FMCPJobRecord> Jobs;
+	// Stored records never hold a live Result object; terminal results are kept serialized or spilled to disk.
+	struct FStoredJob
+	{
+		FMCPJobRecord Record;
+		FString ResultJson;
+		bool bResultSpilled = false;
+	};
+
+	void LoadRetentionSettings();
+	bool StoreTerminalResultLocked(FStoredJob& StoredJob, FString&& ResultJson);
+	void EnforceRetentionLocked(int32& OutCapacityEvictions, int32& OutExpiredEvictions);
+	void RemoveStoredJobLocked(const FString& JobId);
+	FString GetResultSpillDir() const;
+	FString GetResultSpillFilePath(const FString& JobId) const;
+
+	TMap<FString, FStoredJob> Jobs;
+	TDoubleLinkedList<FString> TerminalJobOrder;
+	int64 RetainedResultBytes = 0;
+	int32 MaxRetainedJobs = 1024;
+	int64 JobRetentionMs = 60LL * 60LL * 1000LL;
+	int32 ResultSpillThresholdBytes = 256 * 1024;
+	bool bResultSpillEnabled = true;
+	TMultiMap<FString, TSharedPtr<FMCPCancellationToken>> ActiveCancellationTokens;
 	mutable FCriticalSection JobGuard;
 };
@@ -12,6 +12,38 @@
 #include "MCPTypes.h"
 #include "MCPObservabilitySubsystem.generated.h"
 
+enum class EMCPLatencyPhase : uint8
+{
+	Parse,
+	SchemaValidate,
+	Idempotency,
+	Policy,
+	Lock,
+	Execute,
+	ChangeSetWrite,
+	ResponseBuild,
+	WsSend,
+	BlueprintCompile,
+	Count
+};
+
+struct UNREALMCPEDITOR_API FMCPLatencyHistogram
+{
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+	static constexpr int32 BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+	void Record(int64 ValueUs);
+	int64 GetValueAtPercentile(double Percentile) const;
+	TSharedRef<FJsonObject> ToJson() const;
+
+	int64 TotalCount = 0;
+	int64 TotalUs = 0;
+	int64 MinUs = 0;
+	int64 MaxUs = 0;
+	uint32 Counts[BucketCount] = {};
+};
+
 struct FMCPToolObservabilityMetrics
 {
 	int64 TotalRequests = 0;
@@ -19,9 +51,9 @@ struct FMCPToolObservabilityMetrics
 	int64 ErrorCount = 0;
 	int64 PartialCount = 0;
 	int64 ReplayCount = 0;
-	int64 TotalDurationMs = 0;
-	int64 MaxDurationMs = 0;
-	int64 LastDurationMs = 0;
+	int64 TotalDurationUs = 0;
+	int64 MaxDurationUs = 0;
+	int64 LastDurationUs = 0;
 };
 
 UCLASS()
@@ -30,7 +62,8 @@ class UNREALMCPEDITOR_API UMCPObservabilitySubsystem : public UEditorSubsystem
 	GENERATED_BODY()
 
 public:
-	void RecordToolExecution(const FString& ToolName, EMCPResponseStatus Status, int64 DurationMs, bool bIdempotentReplay);
+	void RecordToolExecution(const FString& ToolName, EMCPResponseStatus Status, int64 DurationUs, bool bIdempotentReplay);
+	void RecordPhaseLatency(EMCPLatencyPhase Phase, int64 DurationUs);
 	void RecordPolicyDenied(bool bSafeModeBlocked);
 	void RecordLockAttempt(bool bConflict, int64 WaitMs);
 	void RecordStaleLocksReclaimed(int32 ReclaimedCount);
@@ -38,11 +71,25 @@ public:
 	void RecordTimeoutExceeded();
 	void RecordCancelRejected();
 	void RecordIdempotencyConflict();
+	void RecordIdempotencyCacheEviction(bool bExpired);
+	void RecordIdempotencyCacheSpill(int32 SpilledCount);
+	void RecordIdempotencyCacheRestore();
+	void RecordIdempotencyCacheUsage(int32 EntryCount, int64 Bytes);
 	void RecordChangeSetCreated(int64 ApproximateBytes, int32 SnapshotCount);
 	void RecordRollbackResult(bool bSucceeded);
+	void RecordChangeSetGarbageCollected(int32 DeletedCount, int64 ReclaimedBytes);
+	void RecordChangeSetWriteFailure(int32 FailedCount);
 	void RecordJobStatus(const FString& Status);
+	void RecordJobEvictions(int32 CapacityEvictions, int32 ExpiredEvictions);
+	void RecordJobResultSpill();
+	void RecordJobStoreUsage(int32 RetainedCount, int64 ResultBytes);
+	void RecordBlueprintCompile(int32 CoalescedRequestCount, int64 DurationUs);
+	void RecordBlueprintSaveFailure(int32 FailedCount);
 
 	TSharedRef<FJsonObject> BuildSnapshot() const;
+	TSharedRef<FJsonObject> BuildLatencySnapshot(const FString& ToolFilter, bool bIncludeTools) const;
+
+	static const TCHAR* LatencyPhaseToString(EMCPLatencyPhase Phase);
 
 private:
 	mutable FCriticalSection MetricsGuard;
@@ -58,11 +105,34 @@ private:
 	int64 TimeoutExceededCount = 0;
 	int64 CancelRejectedCount = 0;
 	int64 IdempotencyConflictCount = 0;
+	int64 IdempotencyCapacityEvictionCount = 0;
+	int64 IdempotencyExpiredEvictionCount = 0;
+	int64 IdempotencySpillCount = 0;
+	int64 IdempotencyRestoreCount = 0;
+	int32 IdempotencyCacheEntryCount = 0;
+	int64 IdempotencyCacheBytes = 0;
 	int64 ChangeSetCreatedCount = 0;
 	int64 ChangeSetBytes = 0;
 	int64 SnapshotCreatedCount = 0;
 	int64 RollbackSucceededCount = 0;
 	int64 RollbackFailedCount = 0;
+	int64 ChangeSetGCRunCount = 0;
+	int64 ChangeSetGCDeletedCount = 0;
+	int64 ChangeSetGCReclaimedBytes = 0;
+	int64 ChangeSetWriteFailureCount = 0;
 	TMap<FString, int64> JobStatusCounts;
+	int64 JobCapacityEvictionCount = 0;
+	int64 JobExpiredEvictionCount = 0;
+	int64 JobResultSpillCount = 0;
+	int32 JobRetainedCount = 0;
+	int64 JobResultBytes = 0;
+	int64 BlueprintCompileCount = 0;
+	int64 BlueprintCompileRequestCount = 0;
+	int64 BlueprintCompileTotalUs = 0;
+	int64 BlueprintSaveFailureCount = 0;
+
+	// Histograms are only touched on the game thread, so they are recorded without MetricsGuard.
+	FMCPLatencyHistogram PhaseLatencyHistograms[static_cast<int32>(EMCPLatencyPhase::Count)];
+	TMap<FString, FMCPLatencyHistogram> ToolLatencyHistograms;
 };
 
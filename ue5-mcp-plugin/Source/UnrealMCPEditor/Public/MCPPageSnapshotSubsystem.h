@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#if __has_include("Subsystems/EditorSubsystem.h")
+#include "Subsystems/EditorSubsystem.h"
+#elif __has_include("EditorSubsystem.h")
+#include "EditorSubsystem.h"
+#else
+#error "EditorSubsystem header not found. Check UnrealEd dependency."
+#endif
+#include "HAL/CriticalSection.h"
+#include "MCPPageSnapshotSubsystem.generated.h"
+
+class FJsonValue;
+
+struct FMCPPageSnapshot
+{
+	uint32 QueryHash = 0;
+	bool bDescending = false;
+	TArray<TSharedPtr<FJsonValue>> Items;
+	TArray<FString> SortKeys;
+};
+
+// Short-lived cache of fully sorted list results, so later pages are cut from the same snapshot as the first one.
+UCLASS()
+class UNREALMCPEDITOR_API UMCPPageSnapshotSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	uint64 StoreSnapshot(const TSharedRef<const FMCPPageSnapshot>& Snapshot);
+	TSharedPtr<const FMCPPageSnapshot> FindSnapshot(uint64 SnapshotId, uint32 QueryHash);
+	int32 GetSnapshotCount() const;
+
+private:
+	struct FSnapshotEntry
+	{
+		TSharedPtr<const FMCPPageSnapshot> Snapshot;
+		uint64 LastAccessCycles = 0;
+	};
+
+	void LoadSettings();
+	void EvictLocked(bool bReserveSlot);
+
+	mutable FCriticalSection SnapshotGuard;
+	TMap<uint64, FSnapshotEntry> Snapshots;
+	uint64 NextSnapshotId = 1;
+
+	int32 SnapshotTtlSeconds = 120;
+	int32 MaxSnapshots = 32;
+};
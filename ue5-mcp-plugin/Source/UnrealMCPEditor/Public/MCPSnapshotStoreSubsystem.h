@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#if __has_include("Subsystems/EditorSubsystem.h")
+#include "Subsystems/EditorSubsystem.h"
+#elif __has_include("EditorSubsystem.h")
+#include "EditorSubsystem.h"
+#else
+#error "EditorSubsystem header not found. Check UnrealEd dependency."
+#endif
+#include "HAL/CriticalSection.h"
+#include "MCPTypes.h"
+#include "MCPSnapshotStoreSubsystem.generated.h"
+
+class UPackage;
+class FObjectPreSaveContext;
+
+struct FMCPPackageSnapshot
+{
+	FString PackageName;
+	// Relative to the project directory.
+	FString RelativeFilename;
+	// Empty when the package did not exist on disk before the write.
+	FString BlobHash;
+	int64 SizeBytes = 0;
+};
+
+// Content-addressed store for pre-write package files under Saved/UnrealMCP/blobs. Identical
+// package contents share one blob across changesets, and a file whose size and timestamp have not
+// changed since it was last stored is referenced by hash without being read again.
+UCLASS()
+class UNREALMCPEDITOR_API UMCPSnapshotStoreSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// While a capture is open, every package is snapshotted before its first save.
+	void BeginCapture();
+	// Closes the capture and returns snapshots for the touched packages; packages never saved during the
+	// capture still hold their pre-write contents on disk and are snapshotted now.
+	void EndCapture(const TArray<FString>& TouchedPackages, TArray<FMCPPackageSnapshot>& OutSnapshots);
+	// Call before overwriting a package file outside of a package save. No-op without an open capture.
+	void CapturePackage(const FString& PackageName);
+
+	bool StoreFile(const FString& Filename, FString& OutBlobHash, int64& OutSizeBytes);
+	// Restores run in two steps so a multi-package rollback can stage every file before replacing any:
+	// StageRestore copies the blob next to Filename, CommitRestore moves it over Filename, and
+	// DiscardRestore removes a staged copy that will not be committed.
+	bool StageRestore(const FString& BlobHash, const FString& Filename, FMCPDiagnostic& OutDiagnostic) const;
+	bool CommitRestore(const FString& Filename, FMCPDiagnostic& OutDiagnostic) const;
+	void DiscardRestore(const FString& Filename) const;
+	bool HasBlob(const FString& BlobHash) const;
+	// Deletes blobs outside ReferencedBlobHashes that were neither written nor reused within MinAge,
+	// so snapshots of a capture whose changeset is not indexed yet are never swept.
+	int32 DeleteUnreferencedBlobs(const TSet<FString>& ReferencedBlobHashes, const FTimespan& MinAge, int64& OutReclaimedBytes);
+
+	FString GetBlobRootDir() const;
+	FString GetBlobPath(const FString& BlobHash) const;
+
+private:
+	struct FStoredFileState
+	{
+		int64 SizeBytes = 0;
+		FDateTime TimeStamp;
+		FString BlobHash;
+	};
+
+	void HandlePreSavePackage(UPackage* Package, FObjectPreSaveContext SaveContext);
+	bool SnapshotPackage(const FString& PackageName, FMCPPackageSnapshot& OutSnapshot);
+
+	mutable FCriticalSection StoreGuard;
+	TMap<FString, FStoredFileState> StoredStateByFilename;
+	TMap<FString, FDateTime> LastStoredUtcByBlobHash;
+	TMap<FString, FMCPPackageSnapshot> CapturedSnapshots;
+	int32 CaptureDepth = 0;
+	FDelegateHandle PreSavePackageHandle;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+namespace MCPTime
+{
+	// Monotonic clock for spans, latency metrics and deadlines.
+	inline uint64 NowCycles()
+	{
+		return FPlatformTime::Cycles64();
+	}
+
+	inline int64 CyclesToMicroseconds(const uint64 Cycles)
+	{
+		return static_cast<int64>(FPlatformTime::ToSeconds64(Cycles) * 1000000.0);
+	}
+
+	inline int64 MicrosecondsSince(const uint64 StartCycles)
+	{
+		const uint64 NowValue = NowCycles();
+		return NowValue > StartCycles ? CyclesToMicroseconds(NowValue - StartCycles) : 0;
+	}
+
+	inline uint64 MillisecondsToCycles(const int64 Milliseconds)
+	{
+		return static_cast<uint64>(static_cast<double>(FMath::Max<int64>(0, Milliseconds)) / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+	}
+
+	inline double MicrosecondsToMilliseconds(const int64 Microseconds)
+	{
+		return static_cast<double>(Microseconds) / 1000.0;
+	}
+
+	// Wall clock, only for timestamps that are displayed or persisted.
+	inline int64 GetUnixTimestampMs()
+	{
+		return static_cast<int64>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds());
+	}
+}
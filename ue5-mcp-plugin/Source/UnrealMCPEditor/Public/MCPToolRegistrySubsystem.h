@@ -9,10 +9,17 @@
 #error "EditorSubsystem header not found. Check UnrealEd dependency."
 #endif
 #include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
+#include "Async/MappedFileHandle.h"
 #include "HAL/CriticalSection.h"
 #include "MCPTypes.h"
 #include "MCPToolRegistrySubsystem.generated.h"
 
+namespace MCPToolSchemaValidator
+{
+	struct FCompiledSchema;
+}
+
 struct FMCPToolDefinition
 {
 	using FExecutor = TFunction<bool(const FMCPRequestEnvelope&, FMCPToolExecutionResult&)>;
@@ -22,9 +29,29 @@ struct FMCPToolDefinition
 	FString Version = TEXT("1.0.0");
 	bool bEnabled = true;
 	bool bWriteTool = false;
+	FExecutor Executor;
+};
+
+struct FMCPSchemaBundleEntry
+{
+	int32 ParamsOffset = INDEX_NONE;
+	int32 ParamsLength = 0;
+	int32 ResultOffset = INDEX_NONE;
+	int32 ResultLength = 0;
+	uint64 HashLow = 0;
+	uint64 HashHigh = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FMCPSchemaBundleEntry& Entry)
+	{
+		return Ar << Entry.ParamsOffset << Entry.ParamsLength << Entry.ResultOffset << Entry.ResultLength << Entry.HashLow << Entry.HashHigh;
+	}
+};
+
+struct FMCPMaterializedToolSchemas
+{
 	TSharedPtr<FJsonObject> ParamsSchema;
 	TSharedPtr<FJsonObject> ResultSchema;
-	FExecutor Executor;
+	TSharedPtr<const MCPToolSchemaValidator::FCompiledSchema> CompiledParamsSchema;
 };
 
 UCLASS()
@@ -44,6 +71,7 @@ public:
 		bool bIncludeSchemas,
 		const FString& DomainFilter,
 		TArray<TSharedPtr<FJsonValue>>& OutTools) const;
+	FString GetToolsListResultJson(bool bIncludeSchemas, const FString& DomainFilter) const;
 
 	FString GetSchemaHash() const;
 	FString GetProtocolVersion() const;
@@ -55,11 +83,19 @@ private:
 	void RegisterBuiltInToolsImpl();
 	void RegisterTool(FMCPToolDefinition Definition);
 	void LoadSchemaBundle();
-	TSharedPtr<FJsonObject> FindSchemaObject(const FString& ToolName, const FString& SchemaKey) const;
+	// Loads one bundle source through its precompiled cache; leaves the bundle empty on failure.
+	bool LoadSchemaBundleFile(const FString& SchemaFilePath);
+	bool LoadSchemaBundleCache(const FString& CachePath, const FString& SourcePath, int64 SourceSize, int64 SourceTimestampTicks);
+	bool ReadSchemaBundleIndex(const uint8* Data, int64 DataSize, const FString& SourcePath, int64 SourceSize, int64 SourceTimestampTicks);
+	void ResetSchemaBundle();
+	TSharedPtr<FJsonObject> ParseSchemaBundleSlice(int32 Offset, int32 Length) const;
+	TSharedPtr<const FMCPMaterializedToolSchemas> MaterializeToolSchemas(const FString& ToolName) const;
 	void RebuildSchemaHash();
 
 	bool HandleToolsList(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleSystemHealth(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
+	bool HandleMetricsGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
+	bool HandleBatch(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleEditorLiveCodingCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleAssetFind(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleAssetLoad(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
@@ -69,6 +105,7 @@ private:
 	bool HandleBlueprintClassCreate(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleUMGBlueprintCreate(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleUMGBlueprintPatch(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
+	bool HandleUMGBlueprintCompile(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleUMGBlueprintReparent(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleAssetDuplicate(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleAssetRename(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
@@ -85,6 +122,8 @@ private:
 	bool HandleChangeSetGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleChangeSetRollbackPreview(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleChangeSetRollbackApply(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
+	bool HandleChangeSetPin(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
+	bool HandleChangeSetUnpin(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleJobGet(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleJobCancel(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
 	bool HandleObjectInspect(const FMCPRequestEnvelope& Request, FMCPToolExecutionResult& OutResult) const;
@@ -166,8 +205,17 @@ private:
 
 private:
 	TMap<FString, FMCPToolDefinition> RegisteredTools;
-	TMap<FString, TSharedPtr<FJsonObject>> BundleSchemas;
+	TMap<FString, FMCPSchemaBundleEntry> BundleEntries;
+	TArray<uint8> BundleBytes;
+	TUniquePtr<IMappedFileHandle> BundleMappedFile;
+	TUniquePtr<IMappedFileRegion> BundleMappedRegion;
+	const uint8* BundleBlobData = nullptr;
+	int64 BundleBlobSize = 0;
 	FString CachedSchemaHash;
+	mutable FCriticalSection SchemaMaterializationGuard;
+	mutable TMap<FString, TSharedPtr<const FMCPMaterializedToolSchemas>> MaterializedSchemas;
+	mutable FCriticalSection ToolsListCacheGuard;
+	mutable TMap<FString, FString> CachedToolsListResults;
 	mutable FCriticalSection DeleteConfirmationGuard;
 	mutable TMap<FString, FPendingDeleteConfirmation> PendingDeleteConfirmations;
 	mutable FCriticalSection SettingsConfirmationGuard;
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/List.h"
+#include "HAL/CriticalSection.h"
+#include "MCPTypes.h"
+
+struct FMCPToolResultCacheSettings
+{
+	int32 MaxEntries = 2048;
+	int64 MaxBytes = 64LL * 1024LL * 1024LL;
+	int64 TtlMs = 6LL * 60LL * 60LL * 1000LL;
+	// Responses at or above this many UTF-8 bytes are stored zlib-compressed; zero stores everything raw.
+	int32 CompressionThresholdBytes = 4096;
+	bool bDiskSpillEnabled = false;
+	FString SpillDir;
+	// Evictions, spills, restores and usage are reported to the observability subsystem.
+	bool bReportObservability = false;
+};
+
+enum class EMCPToolResultCacheLookup : uint8
+{
+	Miss,
+	Hit,
+	// The key is cached for a different params hash.
+	Conflict
+};
+
+// Keyed tool response cache behind request idempotency. Entries live on an LRU list bounded by
+// entry count and stored bytes and expire after the TTL. With disk spill enabled, evicted entries
+// are written to SpillDir and restored on a later miss.
+class UNREALMCPEDITOR_API FMCPToolResultCache
+{
+public:
+	explicit FMCPToolResultCache(const FMCPToolResultCacheSettings& InSettings);
+
+	EMCPToolResultCacheLookup Find(
+		const FString& Key,
+		const FString& ParamsHash,
+		int64 NowMs,
+		EMCPResponseStatus& OutStatus,
+		FString& OutResponseJson);
+	bool Add(const FString& Key, const FString& ParamsHash, EMCPResponseStatus Status, const FString& ResponseJson, int64 NowMs);
+	// Drops every entry, spilling them first when disk spill is enabled.
+	void EvictAll();
+
+	int32 Num() const;
+	int64 GetTotalBytes() const;
+
+	const FMCPToolResultCacheSettings& GetSettings() const
+	{
+		return Settings;
+	}
+
+private:
+	struct FEntry
+	{
+		FString ParamsHash;
+		EMCPResponseStatus Status = EMCPResponseStatus::Ok;
+		TArray<uint8> ResponseBytes;
+		int32 UncompressedSize = 0;
+		bool bCompressed = false;
+		int64 CreatedAtMs = 0;
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* LruNode = nullptr;
+	};
+
+	FEntry* FindEntryLocked(const FString& Key, int64 NowMs);
+	void AddEntryLocked(const FString& Key, FEntry&& Entry);
+	void RemoveEntryLocked(const FString& Key, bool bSpillToDisk);
+	void EnforceLimitsLocked(int64 NowMs);
+	void PublishUsageLocked() const;
+	bool EncodeResponse(const FString& ResponseJson, FEntry& OutEntry) const;
+	bool DecodeResponse(const FEntry& Entry, FString& OutResponseJson) const;
+	FString GetSpillFileName(const FString& Key) const;
+	FString GetSpillFilePath(const FString& Key) const;
+	bool WriteSpillFile(const FString& Key, const FEntry& Entry) const;
+	bool ReadSpillFile(const FString& Key, FEntry& OutEntry) const;
+	// Drops expired spill files and records the surviving ones so lookups only read known files.
+	void PruneSpillDir();
+
+	FMCPToolResultCacheSettings Settings;
+
+	mutable FCriticalSection CacheGuard;
+	TMap<FString, FEntry> EntriesByKey;
+	TDoubleLinkedList<FString> LruList;
+	int64 TotalBytes = 0;
+	// Spill file names on disk; a cache miss only touches the disk when its key is listed here.
+	TSet<FString> SpilledFileNames;
+};
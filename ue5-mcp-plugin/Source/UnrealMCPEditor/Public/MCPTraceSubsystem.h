@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#if __has_include("Subsystems/EditorSubsystem.h")
+#include "Subsystems/EditorSubsystem.h"
+#elif __has_include("EditorSubsystem.h")
+#include "EditorSubsystem.h"
+#else
+#error "EditorSubsystem header not found. Check UnrealEd dependency."
+#endif
+#include "Containers/Ticker.h"
+#include "Trace/Trace.h"
+#include "MCPTraceSubsystem.generated.h"
+
+UE_TRACE_CHANNEL_EXTERN(MCPChannel, UNREALMCPEDITOR_API);
+
+class FEvent;
+
+struct FMCPChromeTraceEvent
+{
+	const TCHAR* Category = TEXT("");
+	FString Name;
+	FString RequestId;
+	FString Tool;
+	uint64 StartCycles = 0;
+	int64 DurationUs = 0;
+	uint32 ThreadId = 0;
+};
+
+UCLASS()
+class UNREALMCPEDITOR_API UMCPTraceSubsystem : public UEditorSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static UMCPTraceSubsystem* GetActiveRecorder();
+	static void TraceRequestBegin(const FString& RequestId, const FString& Tool);
+
+	void RecordEvent(FMCPChromeTraceEvent&& Event);
+	bool FlushChromeTrace(FString& OutFilePath);
+	FString GetTraceDir() const;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	bool IsChromeTraceEnabled() const;
+	void SetChromeTraceEnabled(bool bEnabled);
+#endif
+
+private:
+	void LoadSettings();
+	void StartRecording();
+	void StopRecording();
+	bool HandleFlushTicker(float DeltaSeconds);
+	void ScheduleChunkWrite(TArray<FMCPChromeTraceEvent>&& Events);
+	void FinishBackgroundWrite();
+	bool WriteChromeTraceFile(const TArray<FMCPChromeTraceEvent>& Events, int32 ChunkIndex, FString& OutFilePath) const;
+	void PruneTraceDir() const;
+
+	bool bChromeTraceEnabled = false;
+	int32 MaxBufferedEvents = 20000;
+	int32 MaxTraceFiles = 32;
+	float FlushIntervalSeconds = 10.0f;
+	uint64 BaseCycles = 0;
+	FString SessionName;
+	int32 FlushedChunkCount = 0;
+	TArray<FMCPChromeTraceEvent> BufferedEvents;
+	bool bShuttingDown = false;
+	int32 InFlightBackgroundWrites = 0;
+	FEvent* BackgroundWritesIdleEvent = nullptr;
+	FTSTicker::FDelegateHandle FlushTickHandle;
+	mutable FCriticalSection TraceGuard;
+
+	static UMCPTraceSubsystem* ActiveRecorder;
+};
+
+// Emits an Unreal Insights CPU scope on MCPChannel and, when the Chrome recorder is enabled, a complete trace event.
+class UNREALMCPEDITOR_API FMCPTraceScope
+{
+public:
+	FMCPTraceScope(const TCHAR* InCategory, const TCHAR* InName, const FString& InRequestId, const FString& InTool);
+	~FMCPTraceScope();
+
+	FMCPTraceScope(const FMCPTraceScope&) = delete;
+	FMCPTraceScope& operator=(const FMCPTraceScope&) = delete;
+
+private:
+	UMCPTraceSubsystem* Recorder = nullptr;
+	FMCPChromeTraceEvent Event;
+	bool bCpuTraceActive = false;
+};
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Hash/xxhash.h"
+#include "MCPTime.h"
+#include <atomic>
 
 enum class EMCPResponseStatus : uint8
 {
@@ -22,6 +25,56 @@ struct FMCPDiagnostic
 	TSharedRef<FJsonObject> ToJson() const;
 };
 
+enum class EMCPStopReason : uint8
+{
+	None,
+	Canceled,
+	DeadlineExceeded
+};
+
+// Cooperative stop signal for long-running handlers. Cancel() may be called from any thread.
+class FMCPCancellationToken
+{
+public:
+	void SetDeadlineCycles(const uint64 InDeadlineCycles)
+	{
+		DeadlineCycles = InDeadlineCycles;
+	}
+
+	void Cancel()
+	{
+		bCanceled.store(true, std::memory_order_relaxed);
+	}
+
+	bool ShouldStop() const
+	{
+		if (StopReason != EMCPStopReason::None)
+		{
+			return true;
+		}
+
+		if (bCanceled.load(std::memory_order_relaxed))
+		{
+			StopReason = EMCPStopReason::Canceled;
+		}
+		else if (DeadlineCycles != 0 && MCPTime::NowCycles() >= DeadlineCycles)
+		{
+			StopReason = EMCPStopReason::DeadlineExceeded;
+		}
+		return StopReason != EMCPStopReason::None;
+	}
+
+	EMCPStopReason GetStopReason() const
+	{
+		return StopReason;
+	}
+
+private:
+	std::atomic<bool> bCanceled { false };
+	uint64 DeadlineCycles = 0;
+	mutable EMCPStopReason StopReason = EMCPStopReason::None;
+};
+
 struct FMCPRequestContext
 {
 	FString ProjectId;
@@ -34,6 +87,9 @@ struct FMCPRequestContext
 	bool bHasTimeoutOverride = false;
 	FString CancelToken;
 	bool bHasCancelToken = false;
+	bool bAsync = false;
+	// "sync" or "async" changeset persistence; empty uses the configured default.
+	FString Durability;
 };
 
 struct FMCPRequestEnvelope
@@ -43,6 +99,7 @@ struct FMCPRequestEnvelope
 	FString SessionId;
 	FString Tool;
 	TSharedPtr<FJsonObject> Params;
+	FString ParamsHash;
 	FMCPRequestContext Context;
 };
 
@@ -50,21 +107,60 @@ struct FMCPToolExecutionResult
 {
 	EMCPResponseStatus Status = EMCPResponseStatus::Ok;
 	TSharedPtr<FJsonObject> ResultObject;
+	FString ResultJson;
 	TArray<FMCPDiagnostic> Diagnostics;
 	TArray<FString> TouchedPackages;
 	TArray<TSharedPtr<FJsonObject>> Artifacts;
 	bool bIdempotentReplay = false;
+	TSharedPtr<FMCPCancellationToken> Cancellation;
+
+	// Optional pipeline stages; the handler body itself is the game-thread prepare stage.
+	// WorkerStage must not touch UObjects. CommitStage runs back on the game thread.
+	TFunction<void(FMCPToolExecutionResult&)> WorkerStage;
+	TFunction<void(FMCPToolExecutionResult&)> CommitStage;
+
+	// Checkpoint for loop-heavy handlers: stop early and return what was gathered so far.
+	bool ShouldStop() const
+	{
+		return Cancellation.IsValid() && Cancellation->ShouldStop();
+	}
+
+	void RunWorkerStage()
+	{
+		if (WorkerStage)
+		{
+			const TFunction<void(FMCPToolExecutionResult&)> Stage = MoveTemp(WorkerStage);
+			WorkerStage = nullptr;
+			Stage(*this);
+		}
+	}
+
+	void RunCommitStage()
+	{
+		if (CommitStage)
+		{
+			const TFunction<void(FMCPToolExecutionResult&)> Stage = MoveTemp(CommitStage);
+			CommitStage = nullptr;
+			Stage(*this);
+		}
+	}
 };
 
 namespace MCPJson
 {
 	UNREALMCPEDITOR_API bool ParseRequestEnvelope(const FString& RequestJson, FMCPRequestEnvelope& OutRequest, FMCPDiagnostic& OutError);
+	UNREALMCPEDITOR_API bool ParseRequestEnvelopeObject(const TSharedPtr<FJsonObject>& RootObject, FMCPRequestEnvelope& OutRequest, FMCPDiagnostic& OutError);
 	UNREALMCPEDITOR_API FString BuildResponseEnvelope(
 		const FMCPRequestEnvelope& Request,
 		const FMCPToolExecutionResult& Result,
 		const FString& ChangeSetId,
-		int64 DurationMs);
+		int64 DurationUs);
+	UNREALMCPEDITOR_API TSharedRef<FJsonObject> BuildDiagnosticsObject(const TArray<FMCPDiagnostic>& Diagnostics);
 	UNREALMCPEDITOR_API FString HashJsonObject(const TSharedPtr<FJsonObject>& JsonObject);
+	UNREALMCPEDITOR_API void AppendCanonicalJsonHash(FXxHash128Builder& Builder, const TSharedPtr<FJsonObject>& JsonObject);
+	UNREALMCPEDITOR_API void AppendCanonicalJsonHash(FXxHash128Builder& Builder, const TSharedPtr<FJsonValue>& JsonValue);
+	UNREALMCPEDITOR_API void AppendHashString(FXxHash128Builder& Builder, const FString& Value);
+	UNREALMCPEDITOR_API FString HashToHex(const FXxHash128& Hash);
 	UNREALMCPEDITOR_API FString SerializeJsonObject(const TSharedPtr<FJsonObject>& JsonObject);
 	UNREALMCPEDITOR_API FString StatusToString(EMCPResponseStatus Status);
 }
@@ -11,6 +11,7 @@
 #include "IWebSocketServer.h"
 #include "WebSocketNetworkingDelegates.h"
 #include "Containers/Ticker.h"
+#include "MCPTypes.h"
 #include "MCPWebSocketTransportSubsystem.generated.h"
 
 class INetworkingWebSocket;
@@ -30,6 +31,58 @@ public:
 	uint16 GetListenPort() const;
 	FString GetBindAddress() const;
 	int32 GetClientCount() const;
+	int32 GetQueuedRequestCount() const;
+	int64 GetCoalescedEventCount() const;
+
+	// Queues an mcp.request message received on ConnectionId.
+	void EnqueueRequest(uint16 ConnectionId, const TSharedPtr<FJsonObject>& RequestObject);
+	// Runs queued requests within the dispatch time slice. Reads may overtake writes from other
+	// connections, never an earlier write from their own.
+	void DispatchQueuedRequests();
+
+private:
+	struct FQueuedRequest
+	{
+		uint16 ConnectionId = 0;
+		// Arrival order across all connections.
+		uint64 Sequence = 0;
+		FString RequestId;
+		FString Tool;
+		TSharedPtr<FJsonObject> RequestEnvelope;
+		FString RequestJson;
+		bool bWriteTool = false;
+	};
+
+	// Requests from one connection in arrival order; only the head is ever ready to run.
+	struct FConnectionRequestQueue
+	{
+		TArray<FQueuedRequest> Requests;
+		int32 HeadIndex = 0;
+		int32 InFlightCount = 0;
+
+		bool IsEmpty() const { return HeadIndex >= Requests.Num(); }
+		const FQueuedRequest& Head() const { return Requests[HeadIndex]; }
+		FQueuedRequest PopHead();
+	};
+
+	// A connection's head request, ordered by arrival for the ready heaps.
+	struct FReadyRequest
+	{
+		uint64 Sequence = 0;
+		uint16 ConnectionId = 0;
+
+		bool operator<(const FReadyRequest& Other) const { return Sequence < Other.Sequence; }
+	};
+
+	struct FEventSubscription
+	{
+		TSet<FString> EventTypes;
+		TArray<FString> RequestIdPrefixes;
+		TSet<FString> SessionIds;
+		int64 ReplayedThroughSequence = 0;
+
+		bool Matches(const FString& EventType, const FString& RequestId, const FString& SessionId) const;
+	};
 
 private:
 	void LoadSettings();
@@ -38,24 +91,50 @@ private:
 	bool HandleTicker(float DeltaSeconds);
 
 	void HandleStreamEvent(const FMCPStreamEvent& Event);
+	void FlushOutboundEvents();
 	void OnClientConnected(INetworkingWebSocket* Socket);
 	void OnClientPacketReceived(void* Data, int32 Size, uint16 ConnectionId);
 	void OnClientClosed(uint16 ConnectionId);
+	void HandleConfigureMessage(uint16 ConnectionId, const TSharedPtr<FJsonObject>& MessageObject);
+	void HandleSubscribeMessage(uint16 ConnectionId, const TSharedPtr<FJsonObject>& MessageObject);
+
+	bool DequeueNextRequest(bool bAllowWriteRequest, FQueuedRequest& OutRequest);
+	bool PopReadyRequestLocked(TArray<FReadyRequest>& ReadyHeap, FQueuedRequest& OutRequest);
+	void PushReadyHeadLocked(uint16 ConnectionId, const FConnectionRequestQueue& Queue);
+	void ExecuteQueuedRequest(const FQueuedRequest& QueuedRequest);
+	void DropQueuedRequestsForConnection(uint16 ConnectionId);
 
 	bool SendToConnection(uint16 ConnectionId, const FString& MessageJson);
-	void BroadcastToClients(const FString& MessageJson);
+	void BroadcastEvent(const FMCPStreamEvent& Event);
 	void WriteConnectionInfoFile();
 	void CleanupConnectionInfoFiles();
 	FString ResolveConnectHost() const;
 
 	FString BuildWelcomePayload(uint16 ConnectionId) const;
 	FString BuildErrorPayload(const FString& Code, const FString& Message) const;
-	static int64 GetCurrentUnixTimestampMs();
+	FString BuildResponsePayload(uint16 ConnectionId, bool bOk, const FString& ResponseJson) const;
+	FString BuildRequestErrorResponsePayload(uint16 ConnectionId, const FString& RequestId, const FMCPDiagnostic& Diagnostic) const;
 
 private:
 	mutable FCriticalSection ConnectionGuard;
 	TMap<uint16, INetworkingWebSocket*> Connections;
 	uint16 NextConnectionId = 100;
+	TSet<uint16> ObjectResponseConnections;
+	TMap<uint16, FEventSubscription> EventSubscriptionsByConnection;
+
+	mutable FCriticalSection RequestQueueGuard;
+	TMap<uint16, FConnectionRequestQueue> RequestQueuesByConnection;
+	// Heads of the connection queues; entries left behind by a closed connection are skipped when popped.
+	TArray<FReadyRequest> ReadyReadHeap;
+	TArray<FReadyRequest> ReadyWriteHeap;
+	int32 QueuedRequestCount = 0;
+	uint64 NextRequestSequence = 0;
+
+	mutable FCriticalSection OutboundEventGuard;
+	TArray<FMCPStreamEvent> PendingOutboundEvents;
+	TMap<FString, int32> PendingProgressIndexByRequestId;
+	int64 CoalescedEventCount = 0;
+	double LastEventFlushSeconds = 0.0;
 
 	TUniquePtr<IWebSocketServer> Server;
 	FWebSocketClientConnectedCallBack ClientConnectedCallback;
@@ -70,6 +149,10 @@ private:
 	int32 MaxPortScan = 20;
 	int64 ConnectionInfoHeartbeatIntervalMs = 1000;
 	int64 InstanceRegistryStaleTtlMs = 30000;
+	int32 MaxInFlightRequestsPerConnection = 16;
+	double DispatchTimeSliceMs = 8.0;
+	int32 MaxWriteRequestsPerTick = 1;
+	int32 EventFlushIntervalMs = 50;
 	FString InstanceId;
 	int64 InstanceStartedAtMs = 0;
 	int64 LastConnectionInfoWriteMs = 0;